@@ -0,0 +1,60 @@
+# Reporte de tamaños por módulo. Lee primero los presupuestos
+# (configuración, flash y RAM en bytes) y luego la salida de
+# size -B de cada configuración, en build/<configuración>/.
+# La flash es .text + .data y la RAM .data + .bss. Sale con 1
+# si alguna configuración no tiene presupuesto o lo supera.
+
+FNR == NR {
+    if ($1 !~ /^#/ && NF == 3) {
+        flash[$1] = $2
+        ram[$1] = $3
+    }
+    next
+}
+
+FNR == 1 {
+    cerrarConfig()
+    cantidad = split(FILENAME, partes, "/")
+    config = partes[cantidad - 1]
+    texto = 0
+    datos = 0
+    bss = 0
+    printf "%s\n  %-22s %8s %8s %8s\n", config, "modulo", ".text", ".data", ".bss"
+    next
+}
+
+# los módulos que la configuración no compila quedan vacíos
+$1 + $2 + $3 > 0 {
+    modulo = $6
+    sub(/^.*\//, "", modulo)
+    sub(/\.o$/, "", modulo)
+    printf "  %-22s %8d %8d %8d\n", modulo, $1, $2, $3
+    texto += $1
+    datos += $2
+    bss += $3
+}
+
+END {
+    cerrarConfig()
+    exit (fallas > 0)
+}
+
+function cerrarConfig() {
+    if (config == "")
+        return
+
+    printf "  %-22s %8d %8d %8d\n", "total", texto, datos, bss
+    if (!(config in flash)) {
+        printf "  sin presupuesto para %s\n\n", config
+        fallas++
+        return
+    }
+
+    printf "  flash %6d de %6d, RAM %6d de %6d", texto + datos, flash[config], datos + bss,
+           ram[config]
+    if (texto + datos > flash[config] || datos + bss > ram[config]) {
+        printf "  EXCEDE EL PRESUPUESTO"
+        fallas++
+    }
+    printf "\n\n"
+}
@@ -0,0 +1,193 @@
+/**
+ * @file bench_main.c
+ * @brief Medición del costo de CPU por operación de la capa del LCD
+ *        y del codificador, con el port de bench_port.c.
+ *
+ *        El contador es el SysTick a la frecuencia del núcleo. En
+ *        QEMU (BENCH_QEMU) corre con -icount: cada instrucción avanza
+ *        el reloj virtual 2^BENCH_ICOUNT_SHIFT ns, así que la cuenta
+ *        se convierte en instrucciones ejecutadas. QEMU no emula los
+ *        ciclos del Cortex-M4; compilado sin BENCH_QEMU para la placa
+ *        el mismo contador da ciclos del núcleo.
+ */
+
+#include <stdio.h>
+
+#include "API_lcd.h"
+#include "API_lcd_buffer.h"
+#include "API_lcd_stream.h"
+#include "bench_port.h"
+
+#ifndef BENCH_OPT
+#define BENCH_OPT "?"
+#endif
+
+#ifndef BENCH_ICOUNT_SHIFT
+#define BENCH_ICOUNT_SHIFT 0
+#endif
+
+// reloj del SysTick de la mps2-an386
+#ifndef BENCH_RELOJ_HZ
+#define BENCH_RELOJ_HZ 25000000UL
+#endif
+
+// repeticiones de cada operación
+#define BENCH_REPETICIONES 1000
+
+// registros del SysTick
+#define SYST_CSR             (*(volatile uint32_t *)0xE000E010)
+#define SYST_RVR             (*(volatile uint32_t *)0xE000E014)
+#define SYST_CVR             (*(volatile uint32_t *)0xE000E018)
+#define SYST_CSR_ENABLE      (1 << 0)
+#define SYST_CSR_TICKINT     (1 << 1)
+#define SYST_CSR_CLKSOURCE   (1 << 2)
+#define SYST_RECARGA         0x00FFFFFFUL
+
+// celdas que cambian entre los dos cuadros del diff
+#define BENCH_CELDAS_DIFF 8
+
+/**
+ * @brief Una operación medida: se llama con el número de repetición
+ *        y procesa la cantidad indicada de caracteres.
+ */
+typedef struct {
+    const char * nombre;
+    void (*operacion)(uint32_t);
+    uint16_t caracteres;
+} BENCH_OperacionTypedef;
+
+uint32_t SystemCoreClock = BENCH_RELOJ_HZ;
+
+static volatile uint32_t vueltas;
+
+static char * const textos[2] = {"Temperatura 23.5", "Humedad     41 %"};
+static uint8_t tramas[LCD_TRAMAS_X_MENSAJE];
+static LCD_BufferTypedef sombra;
+static LCD_BufferTypedef cuadros[2];
+
+/**
+ * @brief Cuenta las vueltas del SysTick para extenderlo a 64 bits.
+ */
+void SysTick_Handler() {
+    vueltas++;
+}
+
+/**
+ * @brief Cuenta del SysTick desde que se habilitó.
+ */
+static uint64_t bench_ticks() {
+    uint32_t antes;
+    uint32_t valor;
+
+    do {
+        antes = vueltas;
+        valor = SYST_CVR;
+    } while (antes != vueltas);
+
+    return (uint64_t)antes * (SYST_RECARGA + 1) + (SYST_RECARGA - valor);
+}
+
+/**
+ * @brief Convierte una cuenta del SysTick en instrucciones (QEMU)
+ *        o en ciclos (placa), por centésimas.
+ */
+static uint64_t bench_centesimas(uint64_t ticks) {
+#ifdef BENCH_QEMU
+    return (ticks * 100 * (1000000000ULL / BENCH_RELOJ_HZ)) >> BENCH_ICOUNT_SHIFT;
+#else
+    return ticks * 100;
+#endif
+}
+
+static void bench_vacia(uint32_t repeticion) {
+}
+
+static void bench_printChar(uint32_t repeticion) {
+    LCD_printChar('a' + repeticion % 26);
+}
+
+static void bench_printText(uint32_t repeticion) {
+    LCD_printText(textos[repeticion & 1]);
+}
+
+static void bench_printAt(uint32_t repeticion) {
+    LCD_printAt(LCD_FILA_2, 0, textos[repeticion & 1]);
+}
+
+static void bench_encodeMsg(uint32_t repeticion) {
+    LCD_encodeMsg((uint8_t)repeticion, LCD_DATO, tramas);
+}
+
+/**
+ * @brief Pasa a la sombra el cuadro que corresponde, que difiere del
+ *        otro en BENCH_CELDAS_DIFF celdas, y lo envía con el codificador.
+ */
+static void bench_diffFlush(uint32_t repeticion) {
+    LCD_bufferDiff(&sombra, &cuadros[repeticion & 1]);
+    LCD_streamFlush(&sombra);
+}
+
+static const BENCH_OperacionTypedef operaciones[] = {
+    {"LCD_printChar", bench_printChar, 1},
+    {"LCD_printText", bench_printText, 16},
+    {"LCD_printAt", bench_printAt, 16},
+    {"LCD_encodeMsg", bench_encodeMsg, 1},
+    {"diff + flush", bench_diffFlush, BENCH_CELDAS_DIFF},
+};
+
+/**
+ * @brief Cuenta de BENCH_REPETICIONES llamadas a una operación.
+ */
+static uint64_t bench_run(void (*operacion)(uint32_t)) {
+    uint64_t inicio = bench_ticks();
+    for (uint32_t repeticion = 0; repeticion < BENCH_REPETICIONES; repeticion++)
+        operacion(repeticion);
+    return bench_ticks() - inicio;
+}
+
+/**
+ * @brief Muestra un valor en centésimas con dos decimales.
+ */
+static void bench_printValue(uint64_t centesimas) {
+    printf(" %10lu.%02lu", (unsigned long)(centesimas / 100), (unsigned long)(centesimas % 100));
+}
+
+int main() {
+    SYST_RVR = SYST_RECARGA;
+    SYST_CVR = 0;
+    SYST_CSR = SYST_CSR_CLKSOURCE | SYST_CSR_TICKINT | SYST_CSR_ENABLE;
+
+    LCD_init();
+
+    LCD_bufferInit(&sombra, 2, 16);
+    LCD_bufferInit(&cuadros[0], 2, 16);
+    LCD_bufferInit(&cuadros[1], 2, 16);
+    for (uint8_t celda = 0; celda < BENCH_CELDAS_DIFF; celda++)
+        cuadros[1].celdas[celda & 1][celda * 2] = '0' + celda;
+
+    uint64_t base = bench_run(bench_vacia);
+
+#ifdef BENCH_QEMU
+    printf("%s  %-14s %13s %13s %10s\n", BENCH_OPT, "operacion", "instr/op", "instr/car",
+           "tramas/op");
+#else
+    printf("%s  %-14s %13s %13s %10s\n", BENCH_OPT, "operacion", "ciclos/op", "ciclos/car",
+           "tramas/op");
+#endif
+
+    for (uint8_t indice = 0; indice < sizeof(operaciones) / sizeof(operaciones[0]); indice++) {
+        const BENCH_OperacionTypedef * medida = &operaciones[indice];
+
+        bench_portReset();
+        uint64_t ticks = bench_run(medida->operacion);
+        ticks = (ticks > base) ? ticks - base : 0;
+
+        uint64_t porOperacion = bench_centesimas(ticks) / BENCH_REPETICIONES;
+        printf("%s  %-14s", BENCH_OPT, medida->nombre);
+        bench_printValue(porOperacion);
+        bench_printValue(porOperacion / medida->caracteres);
+        printf(" %10lu\n", (unsigned long)(bench_portFrames() / BENCH_REPETICIONES));
+    }
+
+    return 0;
+}
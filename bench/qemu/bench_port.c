@@ -0,0 +1,110 @@
+/**
+ * @file bench_port.c
+ * @brief Port de la medición: no hay bus, cada trama se guarda
+ *        en un buffer circular y se cuenta. Las esperas no hacen
+ *        nada y las transmisiones en segundo plano se hacen dentro
+ *        de la llamada que las inicia, así que lo que se mide es
+ *        sólo el costo de la CPU del driver y del codificador.
+ */
+
+#include "bench_port.h"
+
+static uint8_t direccionI2C = LCD_ADDRESS;
+
+static uint8_t tramas[BENCH_MAX_TRAMAS];
+static uint32_t cantidadTramas;
+
+/**
+ * @brief Guarda una trama sin que el compilador pueda descartarla.
+ */
+static inline void bench_portRecord(uint8_t trama) {
+    tramas[cantidadTramas++ % BENCH_MAX_TRAMAS] = trama;
+}
+
+uint32_t bench_portFrames() {
+    return cantidadTramas;
+}
+
+void bench_portReset() {
+    cantidadTramas = 0;
+}
+
+bool_t port_init() {
+    return true;
+}
+
+void port_setAddress(uint8_t direccion) {
+    direccionI2C = direccion;
+}
+
+uint8_t port_getAddress() {
+    return direccionI2C;
+}
+
+bool_t port_i2cWriteByte(uint8_t _byte) {
+    bench_portRecord(_byte);
+    return true;
+}
+
+bool_t port_i2cWrite(const uint8_t * bytes, uint16_t cantidad) {
+    for (uint16_t indice = 0; indice < cantidad; indice++)
+        bench_portRecord(bytes[indice]);
+    return true;
+}
+
+/**
+ * @brief Lee los pines con el busy flag en cero.
+ */
+bool_t port_i2cReadByte(uint8_t * _byte) {
+    *_byte = 0;
+    return true;
+}
+
+/**
+ * @brief Pide todas las tramas al callback, como la ISR.
+ */
+bool_t port_i2cStreamStart(port_TramaCallbackTypedef trama, port_FinCallbackTypedef fin) {
+    uint8_t siguiente;
+
+    while (trama(&siguiente))
+        bench_portRecord(siguiente);
+
+    if (fin != NULL)
+        fin(true);
+    return true;
+}
+
+/**
+ * @brief Recorre el buffer por mitades, como el DMA circular.
+ */
+bool_t port_i2cDmaStart(const uint8_t * buffer, uint16_t largo, port_MitadCallbackTypedef mitad,
+                        port_FinCallbackTypedef fin) {
+    uint16_t largoMitad = largo / 2;
+    uint8_t actual = 0;
+
+    do {
+        for (uint16_t indice = 0; indice < largoMitad; indice++)
+            bench_portRecord(buffer[actual * largoMitad + indice]);
+        actual = 1 - actual;
+    } while (mitad(1 - actual));
+
+    if (fin != NULL)
+        fin(true);
+    return true;
+}
+
+void port_dmaIRQHandler() {
+}
+
+void port_i2cEvIRQHandler() {
+}
+
+void port_i2cErIRQHandler() {
+}
+
+void port_delay(uint32_t delay) {
+}
+
+uint32_t port_getTick() {
+    return 0;
+}
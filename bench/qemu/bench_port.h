@@ -0,0 +1,25 @@
+/**
+ * @file bench_port.h
+ * @brief Port de la medición en QEMU, que registra las tramas
+ *        en lugar de enviarlas.
+ */
+
+#ifndef BENCH_BENCH_PORT_H_
+#define BENCH_BENCH_PORT_H_
+
+#include "API_lcd_port.h"
+
+// tramas que se guardan; las anteriores se pisan
+#define BENCH_MAX_TRAMAS 256
+
+/**
+ * @brief Tramas registradas desde el último bench_portReset.
+ */
+uint32_t bench_portFrames();
+
+/**
+ * @brief Pone en cero la cuenta de tramas.
+ */
+void bench_portReset();
+
+#endif /* BENCH_BENCH_PORT_H_ */
@@ -0,0 +1,12 @@
+/**
+ * @file API_types.h
+ * @brief Tipos comunes del proyecto para la medición en QEMU.
+ *        bool_t ya lo define stm32f4xx.h.
+ */
+
+#ifndef BENCH_INC_API_TYPES_H_
+#define BENCH_INC_API_TYPES_H_
+
+#include "stm32f4xx.h"
+
+#endif /* BENCH_INC_API_TYPES_H_ */
@@ -0,0 +1,28 @@
+/**
+ * @file stm32f4xx.h
+ * @brief Encabezado mínimo del dispositivo para compilar la capa
+ *        del LCD para el Cortex-M4 de la placa mps2-an386 de QEMU,
+ *        que no es un STM32. Sólo define lo que usan los módulos
+ *        del driver fuera del port, que en la medición se
+ *        reemplaza por bench_port.c.
+ */
+
+#ifndef BENCH_INC_STM32F4XX_H_
+#define BENCH_INC_STM32F4XX_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef bool bool_t;
+
+// interrupciones que nombra API_lcd_port.h
+typedef enum {
+    DMA1_Stream6_IRQn = 17,
+    I2C1_EV_IRQn = 31,
+    I2C1_ER_IRQn = 32
+} IRQn_Type;
+
+extern uint32_t SystemCoreClock;
+
+#endif /* BENCH_INC_STM32F4XX_H_ */
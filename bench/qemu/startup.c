@@ -0,0 +1,67 @@
+/**
+ * @file startup.c
+ * @brief Arranque mínimo para la mps2-an386 de QEMU: tabla de
+ *        vectores, puesta en cero de .bss y salida por semihosting.
+ *        QEMU carga .data directamente en la RAM desde el ELF, así
+ *        que no hace falta copiarla.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+
+extern uint32_t __bss_start__;
+extern uint32_t __bss_end__;
+extern uint32_t __stack_top__;
+
+extern int main();
+extern void initialise_monitor_handles();
+
+void Reset_Handler();
+void SysTick_Handler();
+
+/**
+ * @brief Excepciones sin atención: se queda en un lazo.
+ */
+void Default_Handler() {
+    for (;;)
+        ;
+}
+
+void NMI_Handler() __attribute__((weak, alias("Default_Handler")));
+void HardFault_Handler() __attribute__((weak, alias("Default_Handler")));
+
+__attribute__((section(".vectores"), used)) static void (*const vectores[16])() = {
+    (void (*)())&__stack_top__,
+    Reset_Handler,
+    NMI_Handler,
+    HardFault_Handler,
+    Default_Handler, // MemManage
+    Default_Handler, // BusFault
+    Default_Handler, // UsageFault
+    0,
+    0,
+    0,
+    0,
+    Default_Handler, // SVCall
+    Default_Handler, // DebugMon
+    0,
+    Default_Handler, // PendSV
+    SysTick_Handler,
+};
+
+void Reset_Handler() {
+    for (uint32_t * palabra = &__bss_start__; palabra < &__bss_end__; palabra++)
+        *palabra = 0;
+
+    initialise_monitor_handles();
+    exit(main());
+}
+
+/**
+ * @brief Con -nostartfiles faltan los de crt0, que exit necesita.
+ */
+void _init() {
+}
+
+void _fini() {
+}
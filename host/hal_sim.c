@@ -0,0 +1,223 @@
+/**
+ * @file hal_sim.c
+ * @brief HAL del STM32 para la PC sobre el display simulado sim_lcd.
+ *        Los registros son variables comunes: las transacciones que
+ *        el port arranca por registros se emulan en hal_simProcess
+ *        leyendo y escribiendo esas variables como lo haría el
+ *        periférico, y las banderas que en el micro se borran
+ *        escribiendo en HIFCR se borran después de cada ISR.
+ *
+ *        M0AR tiene 32 bits, como en el micro, así que el buffer del
+ *        DMA tiene que estar en los primeros 4 GB: los programas se
+ *        enlazan sin PIE y el buffer debe ser estático.
+ */
+
+#include "hal_sim.h"
+#include "sim_lcd.h"
+
+I2C_TypeDef hal_simI2c1;
+DMA_TypeDef hal_simDma1;
+DMA_Stream_TypeDef hal_simDma1Stream6;
+DWT_Type hal_simDwt;
+CoreDebug_Type hal_simCoreDebug;
+
+uint32_t SystemCoreClock = 84000000UL;
+
+// valor de DR que indica que la ISR no cargó un byte
+#define DR_VACIO 0x100
+
+/**
+ * @brief Interrupciones habilitadas con HAL_NVIC_EnableIRQ,
+ *        un bit por número de IRQ.
+ */
+static uint64_t habilitadas;
+
+/**
+ * @brief Bytes de la transacción emulada y posición del DMA
+ *        dentro de su buffer circular.
+ */
+static uint8_t bytes[HAL_SIM_MAX_BYTES];
+static uint16_t cantidad;
+static uint32_t indiceDma;
+
+static void hal_simEvent();
+static void hal_simError(uint32_t);
+static void hal_simDmaByte();
+static bool_t hal_simIrqEnabled(IRQn_Type);
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef * hi2c) {
+    if (hi2c == NULL || hi2c->Instance != I2C1)
+        return HAL_ERROR;
+
+    hi2c->Instance->CR1 |= I2C_CR1_PE;
+    sim_lcd.clockI2C = hi2c->Init.ClockSpeed;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef * hi2c, uint16_t direccion,
+                                          uint8_t * datos, uint16_t largo, uint32_t timeout) {
+    if (hi2c->Instance->SR2 & I2C_SR2_BUSY)
+        return HAL_BUSY;
+
+    sim_lcd.direccionPort = direccion >> 1;
+    return sim_i2cWrite(&sim_lcd, datos, largo) ? HAL_OK : HAL_ERROR;
+}
+
+HAL_StatusTypeDef HAL_I2C_Master_Receive(I2C_HandleTypeDef * hi2c, uint16_t direccion,
+                                         uint8_t * datos, uint16_t largo, uint32_t timeout) {
+    if (hi2c->Instance->SR2 & I2C_SR2_BUSY)
+        return HAL_BUSY;
+
+    sim_lcd.direccionPort = direccion >> 1;
+    if (sim_lcd.direccionPort != sim_lcd.direccionBus) {
+        sim_i2cWrite(&sim_lcd, NULL, 0); // cuenta el nack
+        return HAL_ERROR;
+    }
+
+    for (uint16_t indice = 0; indice < largo; indice++)
+        sim_i2cRead(&sim_lcd, &datos[indice]);
+    return HAL_OK;
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type irq) {
+    habilitadas |= 1ULL << irq;
+}
+
+void HAL_NVIC_DisableIRQ(IRQn_Type irq) {
+    habilitadas &= ~(1ULL << irq);
+}
+
+void HAL_Delay(uint32_t milisegundos) {
+    sim_delay(&sim_lcd, milisegundos);
+}
+
+uint32_t HAL_GetTick() {
+    return sim_lcd.tiempoUs / 1000;
+}
+
+/**
+ * @brief Deja los registros como luego de un reset.
+ */
+void hal_simReset() {
+    hal_simI2c1 = (I2C_TypeDef){0};
+    hal_simDma1 = (DMA_TypeDef){0};
+    hal_simDma1Stream6 = (DMA_Stream_TypeDef){0};
+    hal_simDwt = (DWT_Type){0};
+    hal_simCoreDebug = (CoreDebug_Type){0};
+    habilitadas = 0;
+}
+
+/**
+ * @brief Emula la transacción iniciada con START: dirección,
+ *        bytes que carga la ISR del I2C o el DMA, y STOP.
+ * @retval false si no había ninguna transacción pendiente.
+ */
+bool_t hal_simProcess() {
+    I2C_TypeDef * i2c = I2C1;
+
+    if (!(i2c->CR1 & I2C_CR1_START))
+        return false;
+
+    i2c->CR1 &= ~I2C_CR1_START;
+    i2c->SR2 |= I2C_SR2_BUSY;
+    DMA1->HISR &= ~DMA1->HIFCR;
+    DMA1->HIFCR = 0;
+    cantidad = 0;
+    indiceDma = 0;
+
+    // condición de start: la ISR carga la dirección
+    i2c->DR = DR_VACIO;
+    i2c->SR1 = I2C_SR1_SB;
+    hal_simEvent();
+    sim_lcd.direccionPort = (i2c->DR & 0xFF) >> 1;
+
+    if (i2c->DR == DR_VACIO || sim_lcd.direccionPort != sim_lcd.direccionBus) {
+        sim_i2cWrite(&sim_lcd, NULL, 0); // cuenta el nack
+        hal_simError(I2C_SR1_AF);
+    } else {
+        i2c->DR = DR_VACIO;
+        i2c->SR1 = I2C_SR1_ADDR | I2C_SR1_TXE;
+        hal_simEvent();
+
+        while (!(i2c->CR1 & I2C_CR1_STOP) && cantidad < HAL_SIM_MAX_BYTES) {
+            if (i2c->DR != DR_VACIO) {
+                bytes[cantidad++] = i2c->DR;
+                i2c->DR = DR_VACIO;
+            }
+
+            if ((i2c->CR2 & I2C_CR2_DMAEN) && (DMA1_Stream6->CR & DMA_SxCR_EN)) {
+                hal_simDmaByte();
+                continue;
+            }
+
+            // sin datos nuevos el registro de desplazamiento se vacía
+            i2c->SR1 = (i2c->CR2 & I2C_CR2_ITBUFEN) ? I2C_SR1_TXE : I2C_SR1_TXE | I2C_SR1_BTF;
+            hal_simEvent();
+            // la ISR no cargó un byte ni terminó: se corta como lo haría un timeout
+            if (i2c->DR == DR_VACIO && !(i2c->CR1 & I2C_CR1_STOP) &&
+                ((i2c->SR1 & I2C_SR1_BTF) || (i2c->CR2 & I2C_CR2_ITBUFEN)))
+                break;
+        }
+
+        sim_i2cWrite(&sim_lcd, bytes, cantidad);
+    }
+
+    i2c->CR1 &= ~I2C_CR1_STOP;
+    i2c->SR1 = 0;
+    i2c->SR2 &= ~I2C_SR2_BUSY;
+    return true;
+}
+
+/**
+ * @brief Genera una interrupción de eventos si está habilitada.
+ */
+static void hal_simEvent() {
+    if ((I2C1->CR2 & I2C_CR2_ITEVTEN) && hal_simIrqEnabled(I2C1_EV_IRQn))
+        I2C1_EV_IRQHandler();
+}
+
+/**
+ * @brief Marca un error en SR1 y genera la interrupción de errores.
+ */
+static void hal_simError(uint32_t bandera) {
+    I2C1->SR1 |= bandera;
+    if ((I2C1->CR2 & I2C_CR2_ITERREN) && hal_simIrqEnabled(I2C1_ER_IRQn))
+        I2C1_ER_IRQHandler();
+}
+
+/**
+ * @brief El DMA pasa el próximo byte de su buffer circular y, al
+ *        terminar cada mitad, genera su interrupción.
+ */
+static void hal_simDmaByte() {
+    DMA_Stream_TypeDef * stream = DMA1_Stream6;
+    const uint8_t * memoria = (const uint8_t *)(uintptr_t)stream->M0AR;
+    uint32_t bandera = 0;
+
+    bytes[cantidad++] = memoria[indiceDma++];
+
+    if (indiceDma == stream->NDTR / 2 && (stream->CR & DMA_SxCR_HTIE))
+        bandera = DMA_HISR_HTIF6;
+
+    if (indiceDma == stream->NDTR) {
+        indiceDma = 0;
+        if (stream->CR & DMA_SxCR_TCIE)
+            bandera = DMA_HISR_TCIF6;
+    }
+
+    if (bandera == 0)
+        return;
+
+    DMA1->HISR |= bandera;
+    if (hal_simIrqEnabled(DMA1_Stream6_IRQn))
+        DMA1_Stream6_IRQHandler();
+    DMA1->HISR &= ~DMA1->HIFCR;
+    DMA1->HIFCR = 0;
+}
+
+/**
+ * @brief Indica si una IRQ está habilitada en el NVIC.
+ */
+static bool_t hal_simIrqEnabled(IRQn_Type irq) {
+    return (habilitadas >> irq) & 1;
+}
@@ -0,0 +1,263 @@
+/**
+ * @file host_test.c
+ * @brief Pruebas del driver compilado para la PC con el port de la
+ *        HAL, que en los tests de Ceedling se reemplaza por un mock:
+ *        acá los bytes pasan por API_lcd_port.c y hal_sim.c hasta el
+ *        display simulado. Cada prueba se elige por nombre:
+ *
+ *            host_test <prueba>
+ *
+ *        Devuelve 0 si pasa, 1 si falla y HOST_OMITIDA si la
+ *        configuración de compilación no incluye lo que prueba.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "API_lcd.h"
+#include "API_lcd_buffer.h"
+#include "API_lcd_shell.h"
+#include "API_lcd_stream.h"
+#include "hal_sim.h"
+#include "sim_lcd.h"
+
+// código de salida de una prueba omitida, como lo espera ctest
+#define HOST_OMITIDA 77
+
+// espera en ms para que termine el clear con que cierra LCD_init
+#define HOST_ESPERA_CLEAR 2
+
+#define VERIFICAR(condicion)                                                                       \
+    do {                                                                                           \
+        if (!(condicion)) {                                                                        \
+            printf("%s:%d: falla %s\n", __FILE__, __LINE__, #condicion);                           \
+            return 1;                                                                              \
+        }                                                                                          \
+    } while (0)
+
+#define VERIFICAR_LINEA(fila, esperada)                                                            \
+    do {                                                                                           \
+        char linea[SIM_MAX_COLUMNAS + 1];                                                          \
+        sim_getLine(&sim_lcd, fila, linea);                                                        \
+        if (strcmp(linea, esperada) != 0) {                                                        \
+            printf("%s:%d: fila %u \"%s\", se esperaba \"%s\"\n", __FILE__, __LINE__, fila,       \
+                   linea, esperada);                                                               \
+            return 1;                                                                              \
+        }                                                                                          \
+    } while (0)
+
+/**
+ * @brief Una prueba y su nombre en la línea de comandos.
+ */
+typedef struct {
+    const char * nombre;
+    int (*prueba)();
+} HOST_PruebaTypedef;
+
+/**
+ * @brief ISR de la aplicación, como en stm32f4xx_it.c.
+ */
+void I2C1_EV_IRQHandler() {
+    port_i2cEvIRQHandler();
+}
+
+void I2C1_ER_IRQHandler() {
+    port_i2cErIRQHandler();
+}
+
+void DMA1_Stream6_IRQHandler() {
+    port_dmaIRQHandler();
+}
+
+/**
+ * @brief Inicialización y escritura con las transacciones
+ *        bloqueantes de la HAL.
+ */
+static int host_blocking() {
+    VERIFICAR(LCD_init() == LCD_OK);
+    VERIFICAR(LCD_printText("Hola\nmundo") == LCD_OK);
+    VERIFICAR(LCD_printAt(LCD_FILA_2, 10, "123") == LCD_OK);
+
+    VERIFICAR_LINEA(0, "Hola            ");
+    VERIFICAR_LINEA(1, "mundo     123   ");
+    VERIFICAR(sim_lcd.modo4Bits);
+    VERIFICAR(sim_lcd.violaciones == 0);
+    return 0;
+}
+
+/**
+ * @brief Arranque en caliente: la lectura de la DDRAM pasa por
+ *        HAL_I2C_Master_Receive.
+ */
+static int host_reattach() {
+#ifdef LCD_REATTACH
+    VERIFICAR(LCD_reattach() == LCD_OK);
+    VERIFICAR(LCD_printAt(LCD_FILA_1, 3, "Hola") == LCD_OK);
+    uint32_t instrucciones = sim_lcd.instrucciones;
+
+    VERIFICAR(LCD_reattach() == LCD_OK);
+    VERIFICAR_LINEA(0, "   Hola         ");
+    VERIFICAR(LCD_bufferGet(LCD_getBuffer(), 0, 3) == 'H');
+    VERIFICAR(sim_lcd.instrucciones - instrucciones < 10); // sin secuencia de inicio
+    VERIFICAR(sim_lcd.violaciones == 0);
+    return 0;
+#else
+    return HOST_OMITIDA;
+#endif
+}
+
+/**
+ * @brief Envío del buffer por interrupciones: la ISR del I2C pide
+ *        cada trama al codificador.
+ */
+static int host_interrupt() {
+#ifdef LCD_STREAM
+    static LCD_BufferTypedef sombra;
+
+    VERIFICAR(LCD_init() == LCD_OK);
+    LCD_bufferInit(&sombra, LCD_CANTIDAD_FILAS, LCD_CANTIDAD_COLUMNAS);
+    LCD_bufferWrite(&sombra, 0, 0, 'x');
+    LCD_bufferWrite(&sombra, 1, 3, 'H');
+    LCD_bufferWrite(&sombra, 1, 4, 'o');
+    port_delay(HOST_ESPERA_CLEAR);
+    uint32_t transacciones = sim_lcd.transacciones;
+
+    VERIFICAR(LCD_streamFlush(&sombra) == LCD_OK);
+    VERIFICAR(LCD_streamBusy());
+    VERIFICAR(hal_simProcess());
+    VERIFICAR(!LCD_streamBusy());
+    VERIFICAR(LCD_streamResult() == LCD_OK);
+    VERIFICAR(!LCD_bufferIsDirty(&sombra));
+
+    VERIFICAR_LINEA(0, "x               ");
+    VERIFICAR_LINEA(1, "   Ho           ");
+    VERIFICAR(sim_lcd.transacciones - transacciones == 1);
+    VERIFICAR(sim_lcd.violaciones == 0);
+    return 0;
+#else
+    return HOST_OMITIDA;
+#endif
+}
+
+/**
+ * @brief Envío del buffer por DMA circular: la ISR del DMA vuelve
+ *        a llenar cada mitad.
+ */
+static int host_dma() {
+#ifdef LCD_STREAM
+    static LCD_BufferTypedef sombra;
+    static uint8_t tramas[4 * LCD_TRAMAS_X_MENSAJE];
+
+    VERIFICAR(LCD_init() == LCD_OK);
+    LCD_bufferInit(&sombra, LCD_CANTIDAD_FILAS, LCD_CANTIDAD_COLUMNAS);
+    for (uint8_t columna = 0; columna < LCD_CANTIDAD_COLUMNAS; columna++)
+        LCD_bufferWrite(&sombra, columna & 1, columna, 'a' + columna);
+    port_delay(HOST_ESPERA_CLEAR);
+    uint32_t transacciones = sim_lcd.transacciones;
+
+    VERIFICAR(LCD_streamFlushDma(&sombra, tramas, sizeof(tramas)) == LCD_OK);
+    VERIFICAR(hal_simProcess());
+    VERIFICAR(!LCD_streamBusy());
+    VERIFICAR(LCD_streamResult() == LCD_OK);
+
+    VERIFICAR_LINEA(0, "a c e g i k m o ");
+    VERIFICAR_LINEA(1, " b d f h j l n p");
+    VERIFICAR(sim_lcd.transacciones - transacciones == 1);
+    VERIFICAR(sim_lcd.violaciones == 0);
+    return 0;
+#else
+    return HOST_OMITIDA;
+#endif
+}
+
+/**
+ * @brief Sin display en la dirección, la HAL informa el error y la
+ *        transmisión por interrupciones termina con el nack.
+ */
+static int host_nack() {
+    VERIFICAR(LCD_init() == LCD_OK);
+    port_setAddress(LCD_ADDRESS + 1);
+    VERIFICAR(LCD_printChar('x') == LCD_ERROR);
+
+#ifdef LCD_STREAM
+    static LCD_BufferTypedef sombra;
+
+    LCD_bufferInit(&sombra, LCD_CANTIDAD_FILAS, LCD_CANTIDAD_COLUMNAS);
+    LCD_bufferWrite(&sombra, 0, 0, 'x');
+    VERIFICAR(LCD_streamFlush(&sombra) == LCD_OK);
+    VERIFICAR(hal_simProcess());
+    VERIFICAR(!LCD_streamBusy());
+    VERIFICAR(LCD_streamResult() == LCD_ERROR);
+    VERIFICAR(LCD_bufferIsDirty(&sombra));
+#endif
+
+    VERIFICAR(sim_lcd.nacks >= 1);
+    port_setAddress(LCD_ADDRESS);
+    return 0;
+}
+
+#ifdef LCD_SHELL
+static char respuesta[LCD_SHELL_MAX_SALIDA];
+
+/**
+ * @brief Salida de la consola: guarda la última línea.
+ */
+static void host_shellOutput(const char * linea) {
+    strcpy(respuesta, linea);
+}
+#endif
+
+/**
+ * @brief La consola cambia la velocidad del bus reconfigurando el
+ *        periférico por la HAL y mide el port con el contador de
+ *        ciclos.
+ */
+static int host_shell() {
+#ifdef LCD_SHELL
+    VERIFICAR(LCD_init() == LCD_OK);
+    LCD_shellInit(host_shellOutput, NULL);
+
+    VERIFICAR(LCD_shellExecute("bus 400000") == LCD_OK);
+    VERIFICAR(sim_lcd.clockI2C == 400000);
+    VERIFICAR(LCD_shellExecute("bus 500000") == LCD_ERROR);
+    VERIFICAR(port_getClockSpeed() == 400000);
+
+    VERIFICAR(LCD_printAt(LCD_FILA_2, 0, "rapido") == LCD_OK);
+    VERIFICAR(LCD_shellExecute("sombra") == LCD_OK);
+    VERIFICAR(strncmp(respuesta, "1 |rapido ", 10) == 0);
+
+    VERIFICAR(LCD_shellExecute("bench 8") == LCD_OK);
+    VERIFICAR(strstr(respuesta, "errores=0") != NULL);
+
+    VERIFICAR_LINEA(1, "rapido          ");
+    VERIFICAR(sim_lcd.violaciones == 0);
+    return 0;
+#else
+    return HOST_OMITIDA;
+#endif
+}
+
+static const HOST_PruebaTypedef pruebas[] = {
+    {"bloqueante", host_blocking},     {"arranque_en_caliente", host_reattach},
+    {"interrupciones", host_interrupt}, {"dma", host_dma},
+    {"nack", host_nack},                {"consola", host_shell},
+};
+
+int main(int argc, char * argv[]) {
+    if (argc != 2) {
+        printf("uso: %s <prueba>\n", argv[0]);
+        return 1;
+    }
+
+    for (uint8_t indice = 0; indice < sizeof(pruebas) / sizeof(pruebas[0]); indice++) {
+        if (strcmp(argv[1], pruebas[indice].nombre) != 0)
+            continue;
+
+        sim_init(&sim_lcd);
+        hal_simReset();
+        return pruebas[indice].prueba();
+    }
+
+    printf("no existe la prueba %s\n", argv[1]);
+    return 1;
+}
@@ -0,0 +1,12 @@
+/**
+ * @file API_types.h
+ * @brief Tipos comunes del proyecto para la compilación en la PC.
+ *        bool_t ya lo define stm32f4xx.h.
+ */
+
+#ifndef HOST_INC_API_TYPES_H_
+#define HOST_INC_API_TYPES_H_
+
+#include "stm32f4xx.h"
+
+#endif /* HOST_INC_API_TYPES_H_ */
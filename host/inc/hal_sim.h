@@ -0,0 +1,42 @@
+/**
+ * @file hal_sim.h
+ * @brief HAL del STM32 para la PC, conectada al display simulado
+ *        sim_lcd. Las transacciones bloqueantes van directo al
+ *        simulador; las de interrupción y DMA que el port arranca
+ *        por registros se emulan en hal_simProcess, que hace el
+ *        papel del periférico y llama a las ISR de la aplicación:
+ *        I2C1_EV_IRQHandler, I2C1_ER_IRQHandler y
+ *        DMA1_Stream6_IRQHandler, igual que en la placa.
+ *
+ *        El tiempo de HAL_Delay y HAL_GetTick es el del simulador.
+ */
+
+#ifndef HOST_INC_HAL_SIM_H_
+#define HOST_INC_HAL_SIM_H_
+
+#include "stm32f4xx.h"
+
+// bytes de una transacción emulada, para cortar si nunca termina
+#define HAL_SIM_MAX_BYTES 4096
+
+/**
+ * @brief ISR de la aplicación, como en stm32f4xx_it.c.
+ */
+void I2C1_EV_IRQHandler();
+void I2C1_ER_IRQHandler();
+void DMA1_Stream6_IRQHandler();
+
+/**
+ * @brief Deja los registros como luego de un reset.
+ */
+void hal_simReset();
+
+/**
+ * @brief Emula la transacción que el port haya iniciado con START,
+ *        por interrupciones o por DMA, hasta el STOP, y la entrega
+ *        al simulador como una única transacción.
+ * @retval false si no había ninguna transacción pendiente.
+ */
+bool_t hal_simProcess();
+
+#endif /* HOST_INC_HAL_SIM_H_ */
@@ -0,0 +1,177 @@
+/**
+ * @file stm32f4xx.h
+ * @brief Encabezado mínimo del dispositivo para compilar el driver
+ *        en la PC. Define sólo lo que usan los módulos del driver y
+ *        el port de la HAL: los tipos y funciones de la HAL del I2C,
+ *        los registros del I2C1, del DMA1 y del DWT, y las
+ *        instrucciones del núcleo. Los registros son variables de
+ *        hal_sim.c, que implementa la HAL sobre el simulador.
+ */
+
+#ifndef HOST_INC_STM32F4XX_H_
+#define HOST_INC_STM32F4XX_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef bool bool_t;
+
+typedef enum { HAL_OK = 0, HAL_ERROR, HAL_BUSY, HAL_TIMEOUT } HAL_StatusTypeDef;
+
+// interrupciones que nombra API_lcd_port.h
+typedef enum {
+    DMA1_Stream6_IRQn = 17,
+    I2C1_EV_IRQn = 31,
+    I2C1_ER_IRQn = 32
+} IRQn_Type;
+
+/**
+ * @brief Registros de un periférico I2C.
+ */
+typedef struct {
+    volatile uint32_t CR1;
+    volatile uint32_t CR2;
+    volatile uint32_t OAR1;
+    volatile uint32_t OAR2;
+    volatile uint32_t DR;
+    volatile uint32_t SR1;
+    volatile uint32_t SR2;
+    volatile uint32_t CCR;
+    volatile uint32_t TRISE;
+    volatile uint32_t FLTR;
+} I2C_TypeDef;
+
+/**
+ * @brief Registros de un stream y de un controlador de DMA.
+ */
+typedef struct {
+    volatile uint32_t CR;
+    volatile uint32_t NDTR;
+    volatile uint32_t PAR;
+    volatile uint32_t M0AR;
+    volatile uint32_t M1AR;
+    volatile uint32_t FCR;
+} DMA_Stream_TypeDef;
+
+typedef struct {
+    volatile uint32_t LISR;
+    volatile uint32_t HISR;
+    volatile uint32_t LIFCR;
+    volatile uint32_t HIFCR;
+} DMA_TypeDef;
+
+/**
+ * @brief Registros del contador de ciclos.
+ */
+typedef struct {
+    volatile uint32_t CTRL;
+    volatile uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct {
+    volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+extern I2C_TypeDef hal_simI2c1;
+extern DMA_TypeDef hal_simDma1;
+extern DMA_Stream_TypeDef hal_simDma1Stream6;
+extern DWT_Type hal_simDwt;
+extern CoreDebug_Type hal_simCoreDebug;
+
+#define I2C1         (&hal_simI2c1)
+#define DMA1         (&hal_simDma1)
+#define DMA1_Stream6 (&hal_simDma1Stream6)
+#define DWT          (&hal_simDwt)
+#define CoreDebug    (&hal_simCoreDebug)
+
+// bits de los registros del I2C
+#define I2C_CR1_PE      (1UL << 0)
+#define I2C_CR1_START   (1UL << 8)
+#define I2C_CR1_STOP    (1UL << 9)
+#define I2C_CR1_ACK     (1UL << 10)
+#define I2C_CR2_ITERREN (1UL << 8)
+#define I2C_CR2_ITEVTEN (1UL << 9)
+#define I2C_CR2_ITBUFEN (1UL << 10)
+#define I2C_CR2_DMAEN   (1UL << 11)
+#define I2C_CR2_LAST    (1UL << 12)
+#define I2C_SR1_SB      (1UL << 0)
+#define I2C_SR1_ADDR    (1UL << 1)
+#define I2C_SR1_BTF     (1UL << 2)
+#define I2C_SR1_RXNE    (1UL << 6)
+#define I2C_SR1_TXE     (1UL << 7)
+#define I2C_SR1_BERR    (1UL << 8)
+#define I2C_SR1_ARLO    (1UL << 9)
+#define I2C_SR1_AF      (1UL << 10)
+#define I2C_SR1_OVR     (1UL << 11)
+#define I2C_SR2_BUSY    (1UL << 1)
+
+// bits de los registros del DMA
+#define DMA_SxCR_EN        (1UL << 0)
+#define DMA_SxCR_TEIE      (1UL << 2)
+#define DMA_SxCR_HTIE      (1UL << 3)
+#define DMA_SxCR_TCIE      (1UL << 4)
+#define DMA_SxCR_DIR_0     (1UL << 6)
+#define DMA_SxCR_CIRC      (1UL << 8)
+#define DMA_SxCR_MINC      (1UL << 10)
+#define DMA_SxCR_CHSEL_Pos 25
+#define DMA_HISR_TEIF6     (1UL << 19)
+#define DMA_HISR_HTIF6     (1UL << 20)
+#define DMA_HISR_TCIF6     (1UL << 21)
+#define DMA_HIFCR_CTEIF6   (1UL << 19)
+#define DMA_HIFCR_CHTIF6   (1UL << 20)
+#define DMA_HIFCR_CTCIF6   (1UL << 21)
+
+// bits del contador de ciclos
+#define DWT_CTRL_CYCCNTENA_Msk     (1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk (1UL << 24)
+
+// parámetros de HAL_I2C_Init
+#define I2C_DUTYCYCLE_2         0
+#define I2C_ADDRESSINGMODE_7BIT 0
+#define I2C_DUALADDRESS_DISABLE 0
+#define I2C_GENERALCALL_DISABLE 0
+#define I2C_NOSTRETCH_DISABLE   0
+
+/**
+ * @brief Configuración y handle del I2C de la HAL.
+ */
+typedef struct {
+    uint32_t ClockSpeed;
+    uint32_t DutyCycle;
+    uint32_t OwnAddress1;
+    uint32_t AddressingMode;
+    uint32_t DualAddressMode;
+    uint32_t OwnAddress2;
+    uint32_t GeneralCallMode;
+    uint32_t NoStretchMode;
+} I2C_InitTypeDef;
+
+typedef struct {
+    I2C_TypeDef * Instance;
+    I2C_InitTypeDef Init;
+} I2C_HandleTypeDef;
+
+extern uint32_t SystemCoreClock;
+
+HAL_StatusTypeDef HAL_I2C_Init(I2C_HandleTypeDef *);
+HAL_StatusTypeDef HAL_I2C_Master_Transmit(I2C_HandleTypeDef *, uint16_t, uint8_t *, uint16_t,
+                                          uint32_t);
+HAL_StatusTypeDef HAL_I2C_Master_Receive(I2C_HandleTypeDef *, uint16_t, uint8_t *, uint16_t,
+                                         uint32_t);
+void HAL_NVIC_EnableIRQ(IRQn_Type);
+void HAL_NVIC_DisableIRQ(IRQn_Type);
+void HAL_Delay(uint32_t);
+uint32_t HAL_GetTick();
+
+// el reloj del DMA no existe en la PC
+#define __HAL_RCC_DMA1_CLK_ENABLE()                                                                \
+    do {                                                                                           \
+    } while (0)
+
+// instrucciones del núcleo
+#define __WFI()                                                                                    \
+    do {                                                                                           \
+    } while (0)
+
+#endif /* HOST_INC_STM32F4XX_H_ */
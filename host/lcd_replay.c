@@ -0,0 +1,133 @@
+/**
+ * @file lcd_replay.c
+ * @brief Banco de reproducción de un registro de llamadas grabado
+ *        en la placa con LCD_recordStart: reproduce el archivo contra
+ *        el display simulado en modo bloqueante, por lotes, con diff
+ *        y asíncrono, a 100 y 400 kHz, con el driver y su port de la
+ *        HAL, e imprime un reporte por configuración:
+ *
+ *            lcd_replay <registro> [periodo de los cuadros en ms]
+ *
+ *        Se compila con la configuración FULL del CMakeLists.txt.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "API_lcd.h"
+#include "API_lcd_record.h"
+#include "hal_sim.h"
+#include "sim_replay.h"
+
+// período de los cuadros por defecto, en ms
+#define PERIODO_DEFECTO 20
+
+// tamaño máximo del registro
+#define MAX_REGISTRO (256 * 1024)
+
+/**
+ * @brief Nombre de cada modo en el reporte.
+ */
+static const char * const NOMBRES[SIM_MODOS] = {
+    [SIM_MODO_BLOQUEANTE] = "bloqueante",
+    [SIM_MODO_LOTES] = "lotes",
+    [SIM_MODO_DIFF] = "diff",
+    [SIM_MODO_ASINCRONO] = "asincrono",
+};
+
+/**
+ * @brief Velocidades del bus con que se reproduce.
+ */
+static const uint32_t CLOCKS[] = {100000, 400000};
+
+static uint8_t registro[MAX_REGISTRO];
+
+/**
+ * @brief ISR de la aplicación, como en stm32f4xx_it.c.
+ */
+void I2C1_EV_IRQHandler() {
+    port_i2cEvIRQHandler();
+}
+
+void I2C1_ER_IRQHandler() {
+    port_i2cErIRQHandler();
+}
+
+void DMA1_Stream6_IRQHandler() {
+    port_dmaIRQHandler();
+}
+
+/**
+ * @brief El periférico emulado completa el envío por interrupciones.
+ */
+static void atenderInterrupciones() {
+    hal_simProcess();
+}
+
+/**
+ * @brief Lee el registro completo del archivo.
+ * @retval Largo leído, 0 si no se pudo leer o no entra.
+ */
+static uint32_t leerRegistro(const char * ruta) {
+    FILE * archivo = fopen(ruta, "rb");
+    if (archivo == NULL) {
+        perror(ruta);
+        return 0;
+    }
+
+    size_t largo = fread(registro, 1, sizeof(registro), archivo);
+    if (!feof(archivo)) {
+        fprintf(stderr, "%s: el registro supera los %u bytes\n", ruta, MAX_REGISTRO);
+        largo = 0;
+    }
+    fclose(archivo);
+    return largo;
+}
+
+int main(int argc, char ** argv) {
+    LCD_LectorTypedef lector;
+    SIM_ReproduccionTypedef config = {.periodoMs = PERIODO_DEFECTO,
+                                      .atender = atenderInterrupciones};
+    SIM_ReporteTypedef reporte;
+
+    if (argc == 3)
+        config.periodoMs = strtoul(argv[2], NULL, 10);
+    if (argc < 2 || argc > 3 || config.periodoMs == 0) {
+        fprintf(stderr, "uso: %s <registro> [periodo en ms]\n", argv[0]);
+        return 2;
+    }
+
+    uint32_t largo = leerRegistro(argv[1]);
+    if (largo == 0)
+        return 1;
+    if (LCD_recordOpen(&lector, registro, largo) != LCD_OK) {
+        fprintf(stderr, "%s: no es un registro de llamadas\n", argv[1]);
+        return 1;
+    }
+
+    printf("%-10s %4s %8s %8s %11s %8s %8s %8s %8s %8s %8s %9s\n", "modo", "kHz", "llamadas",
+           "bus ms", "bloqueo ms", "bytes", "p50 us", "p95 us", "p99 us", "max us", "cuadros",
+           "perdidos");
+
+    for (config.modo = 0; config.modo < SIM_MODOS; config.modo++) {
+        for (uint8_t clock = 0; clock < sizeof(CLOCKS) / sizeof(CLOCKS[0]); clock++) {
+            config.clockI2C = CLOCKS[clock];
+            hal_simReset();
+            if (!sim_replay(registro, largo, &config, &reporte)) {
+                fprintf(stderr, "%s: registro sin llamadas o con más de %u\n", argv[1],
+                        SIM_REPLAY_MAX_LLAMADAS);
+                return 1;
+            }
+
+            printf("%-10s %4lu %8lu %8.1f %11.1f %8lu %8lu %8lu %8lu %8lu %8lu %9lu\n",
+                   NOMBRES[config.modo], (unsigned long)config.clockI2C / 1000,
+                   (unsigned long)reporte.llamadas, reporte.tiempoBusUs / 1000.0,
+                   reporte.tiempoBloqueadoUs / 1000.0, (unsigned long)reporte.bytesI2C,
+                   (unsigned long)reporte.latenciaP50Us, (unsigned long)reporte.latenciaP95Us,
+                   (unsigned long)reporte.latenciaP99Us, (unsigned long)reporte.latenciaMaximaUs,
+                   (unsigned long)reporte.cuadros, (unsigned long)reporte.cuadrosPerdidos);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,110 @@
+/**
+ * @file lcd_shell.c
+ * @brief Consola de diagnóstico del driver sobre una pty, para
+ *        probar en la PC los comandos que en la placa llegan por
+ *        la UART. Corre una aplicación de ejemplo que muestra un
+ *        contador en el display simulado, redibujado con el
+ *        período de refresco que se cambia desde la consola, y
+ *        deja la pty abierta para conectarse con un terminal:
+ *
+ *            lcd_shell &
+ *            screen /dev/pts/N
+ *
+ *        El tiempo del simulador avanza un ms por vuelta del lazo.
+ *        Se compila con la opción LCD_SHELL del CMakeLists.txt.
+ */
+
+#define _XOPEN_SOURCE 600 // posix_openpt
+
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "API_lcd.h"
+#include "API_lcd_shell.h"
+#include "hal_sim.h"
+#include "sim_lcd.h"
+
+// período de refresco inicial de la aplicación, en ms
+#define PERIODO_INICIAL 100
+
+static int pty = -1;
+static uint32_t periodo = PERIODO_INICIAL;
+
+/**
+ * @brief ISR de la aplicación, como en stm32f4xx_it.c.
+ */
+void I2C1_EV_IRQHandler() {
+    port_i2cEvIRQHandler();
+}
+
+void I2C1_ER_IRQHandler() {
+    port_i2cErIRQHandler();
+}
+
+void DMA1_Stream6_IRQHandler() {
+    port_dmaIRQHandler();
+}
+
+/**
+ * @brief Salida de la consola: escribe la línea en la pty.
+ */
+static void escribirLinea(const char * linea) {
+    if (write(pty, linea, strlen(linea)) < 0)
+        perror("write");
+}
+
+/**
+ * @brief Período de refresco que la aplicación acepta desde la consola.
+ */
+static bool_t cambiarPeriodo(uint32_t nuevo) {
+    if (nuevo == 0 || nuevo > 10000)
+        return false;
+    periodo = nuevo;
+    return true;
+}
+
+int main() {
+    char caracteres[64];
+    uint32_t ultimoDibujo = 0;
+    uint32_t cuenta = 0;
+
+    pty = posix_openpt(O_RDWR | O_NOCTTY);
+    if (pty < 0 || grantpt(pty) < 0 || unlockpt(pty) < 0) {
+        perror("posix_openpt");
+        return 1;
+    }
+    printf("consola en %s\n", ptsname(pty));
+    fflush(stdout);
+
+    sim_init(&sim_lcd);
+    hal_simReset();
+    if (LCD_init() == LCD_ERROR) {
+        printf("no se pudo inicializar el LCD\n");
+        return 1;
+    }
+    LCD_shellInit(escribirLinea, cambiarPeriodo);
+
+    for (;;) {
+        struct pollfd entrada = {.fd = pty, .events = POLLIN};
+
+        if (poll(&entrada, 1, 1) > 0 && (entrada.revents & POLLIN)) {
+            ssize_t leidos = read(pty, caracteres, sizeof(caracteres));
+            for (ssize_t indice = 0; indice < leidos; indice++)
+                LCD_shellInput(caracteres[indice]);
+        }
+        LCD_shellProcess();
+
+        if (port_getTick() - ultimoDibujo >= periodo) {
+            char texto[LCD_CANTIDAD_COLUMNAS + 1];
+
+            ultimoDibujo = port_getTick();
+            snprintf(texto, sizeof(texto), "cuenta %-9lu", (unsigned long)(cuenta++ % 1000000000));
+            LCD_printAt(LCD_FILA_1, 0, texto);
+        }
+        port_delay(1);
+    }
+}
@@ -8,7 +8,11 @@
 #ifndef API_INC_API_LCD_H_
 #define API_INC_API_LCD_H_
 
+#include "API_lcd_config.h"
 #include "API_lcd_port.h"
+#include "API_lcd_buffer.h"
+#include "API_lcd_pool.h"
+#include "API_lcd_profile.h"
 
 // constantes para cantidad de filas y columnas de un lcd 16x2
 #define LCD_CANTIDAD_COLUMNAS 16
@@ -18,11 +22,85 @@
 #define LCD_FILA_1 0x00
 #define LCD_FILA_2 0x40
 
+// constantes para los caracteres definidos por el usuario (CGRAM)
+#define LCD_CANTIDAD_CARACTERES_CGRAM 8
+#define LCD_ALTO_CARACTER             8
+
+// slot de la CGRAM donde LCD_reattach deja su marca; no usarlo con LCD_createChar
+#ifndef LCD_SLOT_MARCADOR
+#define LCD_SLOT_MARCADOR (LCD_CANTIDAD_CARACTERES_CGRAM - 1)
+#endif
+
+// cantidad de tramas del PCF8574 que ocupa un mensaje en modo 4 bits
+#define LCD_TRAMAS_X_MENSAJE 4
+
+// tipo de mensaje para LCD_encodeMsg
+#define LCD_COMANDO 0
+#define LCD_DATO    1
+
 /**
  * @brief Enum para devolver resultado de acciones del LCD.
  */
 typedef enum { LCD_OK, LCD_ERROR } LCD_StatusTypedef;
 
+/**
+ * @brief Modos de la inicialización diferida.
+ */
+typedef enum {
+    LCD_INICIO_EN_SEGUNDO_PLANO, // avanza sólo con LCD_process
+    LCD_INICIO_EN_PRIMER_DIBUJO  // además se completa en el primer dibujo
+} LCD_InicioTypedef;
+
+/**
+ * @brief Modos de energía del LCD. En todos la DDRAM se
+ *        conserva, por lo que volver a LCD_ENERGIA_NORMAL
+ *        no requiere redibujar la pantalla.
+ */
+typedef enum {
+    LCD_ENERGIA_NORMAL,
+    LCD_ENERGIA_PANTALLA_APAGADA,  // DISPLAY_CONTROL sin DISPLAY_ON
+    LCD_ENERGIA_BACKLIGHT_APAGADO, // pantalla encendida sin backlight
+    LCD_ENERGIA_BAJO_CONSUMO       // pantalla y backlight apagados
+} LCD_EnergiaTypedef;
+
+/**
+ * @brief Modos de entrada: hacia dónde se mueve el cursor
+ *        después de cada caracter y si la pantalla se
+ *        desplaza con él. Los valores son los bits I/D y S
+ *        del comando ENTRY MODE del controlador.
+ */
+typedef enum {
+    LCD_ENTRADA_DECREMENTO = 0x00,          // el cursor retrocede
+    LCD_ENTRADA_DECREMENTO_DESPLAZA = 0x01, // retrocede y la pantalla va a la derecha
+    LCD_ENTRADA_INCREMENTO = 0x02,          // el cursor avanza, como tras la inicialización
+    LCD_ENTRADA_INCREMENTO_DESPLAZA = 0x03  // avanza y la pantalla va a la izquierda
+} LCD_EntradaTypedef;
+
+/**
+ * @brief Estadísticas de la cola de pedidos.
+ */
+typedef struct {
+    uint16_t encolados;         // pedidos aceptados
+    uint16_t procesados;        // pedidos enviados al LCD
+    uint16_t descartados;       // pedidos nuevos rechazados por cola o pool llenos
+    uint16_t descartadosViejos; // pedidos pendientes descartados para hacer lugar
+    uint16_t coalescidos;       // pedidos que reemplazaron a uno pendiente de la misma región
+    uint16_t bloqueos;          // veces que el llamador tuvo que esperar lugar
+    uint16_t bloqueosVencidos;  // esperas que superaron el tiempo máximo
+    uint32_t esperaMaxima;      // espera más larga de un llamador, en ms
+    uint8_t pendientes;         // pedidos en espera
+    uint8_t maximoPendientes;   // marca de agua máxima de la cola
+} LCD_ColaStatsTypedef;
+
+/**
+ * @brief Estadísticas del driver, útiles para
+ *        dimensionar la cola y el pool.
+ */
+typedef struct {
+    LCD_PoolStatsTypedef pool;
+    LCD_ColaStatsTypedef cola;
+} LCD_StatsTypedef;
+
 /**
  *	@brief Realiza la inicialización del LCD para
  *		   que quede listo para ser utilizado.
@@ -30,6 +108,69 @@ typedef enum { LCD_OK, LCD_ERROR } LCD_StatusTypedef;
  */
 LCD_StatusTypedef LCD_init();
 
+#ifdef LCD_REATTACH
+/**
+ *	@brief Arranque en caliente: si el LCD sigue configurado
+ *		   desde antes de un reset del MCU (lo indica una marca
+ *		   en la CGRAM), lee la DDRAM para sincronizar el buffer
+ *		   de sombra y la posición del cursor, sin borrar la
+ *		   pantalla. Si no, realiza LCD_init y deja la marca.
+ *		   El estado del cursor visible no se puede leer, por lo
+ *		   que queda apagado para el driver.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_reattach();
+#endif
+
+#ifdef LCD_LAZY_INIT
+/**
+ *	@brief Inicialización diferida: sólo configura el
+ *		   periférico I2C y retorna. La secuencia del LCD
+ *		   avanza con LCD_process y, según el modo, también
+ *		   se completa en el primer dibujo. Lo que se dibuja
+ *		   antes se guarda en el buffer de sombra y se envía
+ *		   al terminar.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_initLazy(LCD_InicioTypedef);
+#endif
+
+/**
+ *	@brief Tarea del driver, para llamar periódicamente
+ *		   desde el lazo principal. Avanza la inicialización
+ *		   diferida sin esperas bloqueantes y aplica el
+ *		   apagado por inactividad, que sólo compara ticks.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_process();
+
+/**
+ *	@brief Indica si el LCD terminó de inicializarse.
+ */
+bool_t LCD_isReady();
+
+/**
+ *	@brief Devuelve el buffer de sombra con el contenido
+ *		   que muestra (o mostrará) la pantalla.
+ */
+const LCD_BufferTypedef * LCD_getBuffer();
+
+/**
+ *	@brief Selecciona el perfil del controlador (por
+ *		   defecto LCD_PERFIL_PCF8574). Se llama antes de
+ *		   inicializar el LCD. Con un perfil nativo no hay
+ *		   backlight ni lectura del controlador, por lo que
+ *		   LCD_reattach hace la inicialización completa, y no
+ *		   se usan las tramas de LCD_encodeMsg.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_setProfile(const LCD_PerfilTypedef *);
+
+/**
+ *	@brief Devuelve el perfil del controlador.
+ */
+const LCD_PerfilTypedef * LCD_getProfile();
+
 /**
  *	@brief Borra el contenido de la
  *		   pantalla del LCD.
@@ -53,6 +194,18 @@ LCD_StatusTypedef LCD_printChar(char);
  */
 LCD_StatusTypedef LCD_printText(char *);
 
+/**
+ *	@brief Escribe un texto a partir de (fila, posición)
+ *		   sin borrar el resto de la pantalla. El texto
+ *		   se corta al llegar al final de la fila. Si el
+ *		   cursor retrocede, se envía desde el último
+ *		   caracter, por lo que queda igual en cualquier modo
+ *		   de entrada; en los modos que desplazan, la
+ *		   pantalla se mueve una posición por caracter.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_printAt(uint8_t, uint8_t, const char *);
+
 /**
  *	@brief Posiciona el cursor del LCD
  *		   en la posición indica por los
@@ -61,6 +214,22 @@ LCD_StatusTypedef LCD_printText(char *);
  */
 LCD_StatusTypedef LCD_setCursor(uint8_t, uint8_t);
 
+/**
+ *	@brief Cambia el modo de entrada. Con LCD_ENTRADA_DECREMENTO
+ *		   un campo alineado a la derecha se escribe desde la
+ *		   cifra menos significativa, y con los modos que
+ *		   desplazan el texto entra por un costado de la
+ *		   pantalla. LCD_clear vuelve a incrementar, como el
+ *		   controlador, y conserva el desplazamiento.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_setEntryMode(LCD_EntradaTypedef);
+
+/**
+ *	@brief Devuelve el modo de entrada actual.
+ */
+LCD_EntradaTypedef LCD_getEntryMode();
+
 /**
  *	@brief Muestra un cursor que parpadea en
  *		   la pantalla del LCD.
@@ -74,4 +243,68 @@ LCD_StatusTypedef LCD_cursorOn();
  */
 LCD_StatusTypedef LCD_cursorOff();
 
+/**
+ *	@brief Carga un caracter definido por el usuario
+ *		   en la CGRAM, en la posición indicada (0 a 7).
+ *		   El patrón tiene LCD_ALTO_CARACTER filas de 5 bits.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_createChar(uint8_t, const uint8_t *);
+
+#ifdef LCD_POWER
+/**
+ *	@brief Cambia el modo de energía. Sólo envía lo que
+ *		   cambia: un comando DISPLAY_CONTROL para la pantalla
+ *		   y una trama sin flanco de E para el backlight. Lo
+ *		   que se dibuja con la pantalla apagada se ve al
+ *		   volver al modo normal.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_setPowerMode(LCD_EnergiaTypedef);
+
+/**
+ *	@brief Devuelve el modo de energía actual.
+ */
+LCD_EnergiaTypedef LCD_getPowerMode();
+
+/**
+ *	@brief Configura el apagado por inactividad: si pasan
+ *		   los ms indicados sin LCD_notifyActivity, LCD_process
+ *		   pasa al modo de energía indicado. Con 0 se deshabilita.
+ */
+void LCD_setIdleTimeout(uint32_t, LCD_EnergiaTypedef);
+
+/**
+ *	@brief Informa actividad del usuario: reinicia el tiempo
+ *		   de inactividad y, si el LCD estaba en un modo de bajo
+ *		   consumo, vuelve al modo normal.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_notifyActivity();
+#endif
+
+/**
+ *	@brief Codifica un mensaje (LCD_COMANDO o LCD_DATO)
+ *		   en las LCD_TRAMAS_X_MENSAJE tramas del PCF8574
+ *		   que lo transmiten en modo 4 bits, con el estado
+ *		   actual del backlight. Sirve para armar envíos por
+ *		   bloques con port_i2cWrite. Sólo vale para el
+ *		   perfil LCD_PERFIL_PCF8574.
+ */
+void LCD_encodeMsg(uint8_t, uint8_t, uint8_t *);
+
+/**
+ *	@brief Registra en el buffer de sombra y en el cursor el
+ *		   efecto de un mensaje (LCD_COMANDO o LCD_DATO) que se
+ *		   transmitió por fuera del driver, por ejemplo con las
+ *		   tramas de LCD_encodeMsg.
+ */
+void LCD_trackMsg(uint8_t, uint8_t);
+
+/**
+ *	@brief Copia las estadísticas del driver.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_getStats(LCD_StatsTypedef *);
+
 #endif /* API_INC_API_LCD_H_ */
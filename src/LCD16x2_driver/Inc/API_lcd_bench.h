@@ -0,0 +1,73 @@
+/**
+ * @file API_lcd_bench.h
+ * @brief Medición en el target del costo del port en
+ *        ciclos de CPU por trama, con el contador de ciclos
+ *        del DWT. Permite comparar la implementación con la
+ *        HAL y la de registros (LCD_PORT_LL) compilando el
+ *        mismo programa con y sin esa definición. También
+ *        mide el diff de cuadros completos de varios
+ *        displays en celdas por microsegundo.
+ */
+
+#ifndef API_INC_API_LCD_BENCH_H_
+#define API_INC_API_LCD_BENCH_H_
+
+#include "API_lcd.h"
+#include "API_lcd_buffer.h"
+
+// cantidad máxima de tramas de la medición en una sola transacción
+#ifndef LCD_BENCH_MAX_TRAMAS
+#define LCD_BENCH_MAX_TRAMAS 64
+#endif
+
+// cantidad máxima de displays de la medición del diff
+#ifndef LCD_BENCH_MAX_PANTALLAS
+#define LCD_BENCH_MAX_PANTALLAS 64
+#endif
+
+/**
+ * @brief Resultado de una medición. Los ciclos de bus son el
+ *        tiempo teórico de la transmisión a la velocidad actual
+ *        del bus; la diferencia con los medidos es el costo del
+ *        software.
+ */
+typedef struct {
+    uint32_t ciclosPorTrama;     // port_i2cWriteByte: una transacción por trama
+    uint32_t ciclosBusPorTrama;  // start + dirección + dato + stop
+    uint32_t ciclosPorTramaLote; // port_i2cWrite: todas las tramas en una transacción
+    uint32_t ciclosBusPorTramaLote;
+    uint16_t errores;
+} LCD_BenchTypedef;
+
+/**
+ * @brief Resultado de la medición del diff. Cada display es un
+ *        buffer de LCD_BUFFER_MAX_FILAS x LCD_BUFFER_MAX_COLUMNAS.
+ */
+typedef struct {
+    uint32_t celdas;             // celdas comparadas en cada pasada
+    uint32_t ciclosDiff;         // LCD_bufferDiff y LCD_bufferDirtyRuns
+    uint32_t ciclosPorCelda;     // LCD_bufferWrite celda por celda y LCD_bufferNextDirtyRun
+    uint32_t celdasPorUsDiff;
+    uint32_t celdasPorUsPorCelda;
+    uint16_t tramos;             // tramos sucios encontrados por el diff
+} LCD_BenchDiffTypedef;
+
+/**
+ *	@brief Envía una cantidad de tramas inocuas (E en bajo)
+ *		   de a una y en una sola transacción, y mide los
+ *		   ciclos promedio por trama de cada forma.
+ *	@retval LCD_ERROR si la cantidad es inválida o falló algún envío.
+ */
+LCD_StatusTypedef LCD_benchPort(uint16_t, LCD_BenchTypedef *);
+
+/**
+ *	@brief Compara un cuadro nuevo de la cantidad indicada de
+ *		   displays, con unas pocas celdas cambiadas por fila,
+ *		   con el diff por palabras y con el chequeo celda por
+ *		   celda, y mide las celdas por microsegundo de cada uno.
+ *		   El diff se compila con LCD_STREAM.
+ *	@retval LCD_ERROR si la cantidad es inválida o no hay diff.
+ */
+LCD_StatusTypedef LCD_benchDiff(uint8_t, LCD_BenchDiffTypedef *);
+
+#endif /* API_INC_API_LCD_BENCH_H_ */
@@ -0,0 +1,133 @@
+/**
+ * @file API_lcd_buffer.h
+ * @brief Buffer de sombra del LCD. Guarda el contenido
+ * 		  que debe mostrar cada celda y un mapa de celdas
+ *		  sucias, es decir, las que el display todavía no
+ *		  muestra. Permite dibujar sin acceder al bus y
+ *		  enviar después sólo lo que cambió.
+ */
+
+#ifndef API_INC_API_LCD_BUFFER_H_
+#define API_INC_API_LCD_BUFFER_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "API_lcd_config.h"
+
+// dimensiones máximas del buffer; por defecto las de un LCD 16x2,
+// o las de un panel de 40x4 si se usa API_lcd_dual (LCD_PANEL_DUAL)
+#ifndef LCD_BUFFER_MAX_FILAS
+#ifdef LCD_PANEL_DUAL
+#define LCD_BUFFER_MAX_FILAS 4
+#else
+#define LCD_BUFFER_MAX_FILAS 2
+#endif
+#endif
+#ifndef LCD_BUFFER_MAX_COLUMNAS
+#ifdef LCD_PANEL_DUAL
+#define LCD_BUFFER_MAX_COLUMNAS 40
+#else
+#define LCD_BUFFER_MAX_COLUMNAS 16
+#endif
+#endif
+
+#if LCD_BUFFER_MAX_COLUMNAS > 64
+#error "El mapa de celdas sucias admite como máximo 64 columnas"
+#endif
+
+/**
+ * @brief Buffer de sombra. Cada bit de sucias corresponde
+ *        a una columna de la fila.
+ */
+typedef struct {
+    uint8_t filas;
+    uint8_t columnas;
+    char celdas[LCD_BUFFER_MAX_FILAS][LCD_BUFFER_MAX_COLUMNAS];
+    uint64_t sucias[LCD_BUFFER_MAX_FILAS];
+} LCD_BufferTypedef;
+
+/**
+ * @brief Tramo de celdas sucias consecutivas de una fila.
+ */
+typedef struct {
+    uint8_t fila;
+    uint8_t inicio;
+    uint8_t largo;
+} LCD_TramoTypedef;
+
+/**
+ *	@brief Inicializa el buffer con la geometría indicada
+ *		   (filas, columnas), en blanco y sin celdas sucias.
+ *		   Las dimensiones se limitan a las máximas.
+ */
+void LCD_bufferInit(LCD_BufferTypedef *, uint8_t, uint8_t);
+
+/**
+ *	@brief Deja el buffer en blanco y sin celdas sucias,
+ *		   como queda el display luego de un borrado.
+ */
+void LCD_bufferClear(LCD_BufferTypedef *);
+
+/**
+ *	@brief Escribe un caracter en (fila, columna) sin enviarlo.
+ *		   Si cambia el contenido, la celda queda sucia.
+ */
+void LCD_bufferWrite(LCD_BufferTypedef *, uint8_t, uint8_t, char);
+
+/**
+ *	@brief Registra un caracter que ya se envió al display
+ *		   en (fila, columna). La celda queda limpia.
+ */
+void LCD_bufferSync(LCD_BufferTypedef *, uint8_t, uint8_t, char);
+
+/**
+ *	@brief Devuelve el caracter de (fila, columna).
+ */
+char LCD_bufferGet(const LCD_BufferTypedef *, uint8_t, uint8_t);
+
+/**
+ *	@brief Marca como limpias las celdas (fila, columna, largo).
+ */
+void LCD_bufferMarkClean(LCD_BufferTypedef *, uint8_t, uint8_t, uint8_t);
+
+/**
+ *	@brief Marca como sucias todas las celdas, para
+ *		   forzar que se vuelva a enviar la pantalla completa.
+ */
+void LCD_bufferMarkAllDirty(LCD_BufferTypedef *);
+
+/**
+ *	@brief Busca en una fila, a partir de una columna, el
+ *		   próximo tramo de celdas sucias consecutivas.
+ *		   Devuelve su columna inicial y su largo por los
+ *		   dos últimos argumentos.
+ *	@retval true si se encontró un tramo.
+ */
+bool LCD_bufferNextDirtyRun(const LCD_BufferTypedef *, uint8_t, uint8_t, uint8_t *, uint8_t *);
+
+/**
+ *	@brief Indica si hay alguna celda sucia.
+ */
+bool LCD_bufferIsDirty(const LCD_BufferTypedef *);
+
+/**
+ *	@brief Compara el buffer con un cuadro nuevo de la misma
+ *		   geometría, dibujado completo en otro buffer. Las
+ *		   celdas que cambiaron se copian y quedan sucias. La
+ *		   comparación es por palabras (SWAR de 32 bits en
+ *		   Cortex-M, de 64 en un host de 64 bits, y SSE2 si
+ *		   está disponible) en lugar de celda por celda.
+ *	@retval Cantidad de celdas que cambiaron; 0 si la geometría no coincide.
+ */
+uint16_t LCD_bufferDiff(LCD_BufferTypedef *, const LCD_BufferTypedef *);
+
+/**
+ *	@brief Carga en la lista los tramos de celdas sucias de
+ *		   todas las filas, en orden, hasta el máximo indicado.
+ *		   Los tramos siguen sucios hasta que se marquen limpios.
+ *	@retval Cantidad de tramos cargados.
+ */
+uint16_t LCD_bufferDirtyRuns(const LCD_BufferTypedef *, LCD_TramoTypedef *, uint16_t);
+
+#endif /* API_INC_API_LCD_BUFFER_H_ */
@@ -0,0 +1,90 @@
+/**
+ * @file API_lcd_clock.h
+ * @brief Reloj HH:MM:SS para la hora del día o un tiempo
+ * 		  transcurrido. El reloj agenda su propio refresco en
+ *		  el borde de cada segundo y LCD_clockProcess, que no
+ *		  bloquea, lo avanza cuando llega; se llama desde el
+ *		  mismo lazo que LCD_process o desde un temporizador
+ *		  periódico.
+ *
+ *		  El segundo avanza como un odómetro con el valor en
+ *		  que cada cifra vuelve a cero precalculado, y sólo
+ *		  se reescriben las cifras que cambian: la mayoría de
+ *		  los segundos cuestan uno o dos caracteres.
+ */
+
+#ifndef API_INC_API_LCD_CLOCK_H_
+#define API_INC_API_LCD_CLOCK_H_
+
+#include "API_lcd.h"
+
+// caracteres de "HH:MM:SS"
+#define LCD_RELOJ_ANCHO 8
+
+// ticks de port_getTick por segundo
+#define LCD_RELOJ_TICKS_X_SEGUNDO 1000
+
+/**
+ * @brief Qué muestra el reloj. La hora del día vuelve a
+ *        00:00:00 a las 24 horas y el cronómetro a las 100.
+ */
+typedef enum { LCD_RELOJ_HORA, LCD_RELOJ_CRONOMETRO } LCD_RelojModoTypedef;
+
+/**
+ * @brief Reloj en pantalla.
+ */
+typedef struct {
+    uint8_t fila;     // LCD_FILA_1 o LCD_FILA_2
+    uint8_t posicion; // columna de la primera cifra de la hora
+    LCD_RelojModoTypedef modo;
+    bool_t enMarcha;
+    uint32_t proximoTick; // borde del próximo segundo
+    char texto[LCD_RELOJ_ANCHO + 1];
+} LCD_RelojTypedef;
+
+/**
+ *	@brief Prepara un reloj detenido en (fila, posición) y lo
+ *		   dibuja en 00:00:00.
+ *	@retval LCD_ERROR si no entra en la pantalla.
+ */
+LCD_StatusTypedef LCD_clockInit(LCD_RelojTypedef *, uint8_t, uint8_t, LCD_RelojModoTypedef);
+
+/**
+ *	@brief Pone el reloj en una cantidad de segundos y reescribe
+ *		   desde la primera cifra distinta.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_clockSet(LCD_RelojTypedef *, uint32_t);
+
+/**
+ *	@brief Pone en marcha el reloj; el primer segundo se
+ *		   cumple LCD_RELOJ_TICKS_X_SEGUNDO ticks después.
+ */
+void LCD_clockStart(LCD_RelojTypedef *);
+
+/**
+ *	@brief Detiene el reloj.
+ */
+void LCD_clockStop(LCD_RelojTypedef *);
+
+/**
+ *	@brief Si pasó el borde del segundo agendado, avanza los
+ *		   segundos cumplidos, reescribe las cifras que cambiaron
+ *		   y agenda el siguiente. Los bordes no se corren aunque
+ *		   la llamada llegue tarde.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_clockProcess(LCD_RelojTypedef *);
+
+/**
+ *	@brief Vuelve a dibujar el reloj completo.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_clockRedraw(const LCD_RelojTypedef *);
+
+/**
+ *	@brief Devuelve la hora del reloj en segundos.
+ */
+uint32_t LCD_clockGet(const LCD_RelojTypedef *);
+
+#endif /* API_INC_API_LCD_CLOCK_H_ */
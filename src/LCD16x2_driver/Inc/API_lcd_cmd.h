@@ -0,0 +1,38 @@
+/**
+ * @file API_lcd_cmd.h
+ * @brief Constantes de los comandos del controlador
+ * 		  HD44780 y de los pines del expansor PCF8574,
+ *		  compartidas por los módulos del driver. Es de
+ *		  uso interno: no se incluye desde API_lcd.h porque
+ *		  nombres como ENABLE chocan con los de la HAL.
+ */
+
+#ifndef API_INC_API_LCD_CMD_H_
+#define API_INC_API_LCD_CMD_H_
+
+// constantes utilizadas para controlar el LCD
+#define _4BIT_MODE      0x28
+#define DISPLAY_CONTROL (1 << 3)
+#define RETURN_HOME     (1 << 1)
+#define ENTRY_MODE      (1 << 2)
+#define AUTOINCREMENT   (1 << 1)
+#define DISPLAY_ON      (1 << 2)
+#define CLR_LCD         1
+#define COMMAND         0
+#define DATA            1
+#define ENABLE          (1 << 2)
+#define POS_BACKLIGHT   (3)
+#define SET_CURSOR      (1 << 7)
+#define CURSOR_ON       1 << 1
+#define CURSOR_BLINK    1
+#define SET_CGRAM       (1 << 6)
+#define READ            (1 << 1)
+#define BUSY_FLAG       (1 << 7)
+#define CURSOR_SHIFT    (1 << 4)
+#define SHIFT_DISPLAY   (1 << 3)
+#define SHIFT_RIGHT     (1 << 2)
+
+// espera en ms que necesitan los comandos CLR_LCD y RETURN_HOME
+#define LCD_ESPERA_CLEAR 2
+
+#endif /* API_INC_API_LCD_CMD_H_ */
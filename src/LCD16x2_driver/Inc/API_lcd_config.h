@@ -0,0 +1,51 @@
+/**
+ * @file API_lcd_config.h
+ * @brief Configuraciones de compilación del driver. Cada una
+ * 		  se elige definiendo una macro y habilita un grupo de
+ *		  funcionalidades; lo que no está habilitado no se
+ *		  compila, para que el driver entre en micros chicos.
+ *
+ *		  LCD_BUILD_MINIMAL:  inicialización bloqueante, texto,
+ *		                      cursor, CGRAM y buffer de sombra,
+ *		                      sólo con el perfil del PCF8574.
+ *		  LCD_BUILD_STANDARD: la mínima, más LCD_LAZY_INIT,
+ *		                      LCD_REATTACH, LCD_POWER y LCD_STREAM.
+ *		  LCD_BUILD_FULL:     la estándar, más LCD_NATIVE,
+ *		                      LCD_QUEUE, LCD_LIST, LCD_WIDGETS y
+ *		                      LCD_TRANSITIONS. Es la que se usa
+ *		                      si no se define ninguna.
+ *
+ *		  Las funcionalidades también se pueden agregar de a
+ *		  una, definiendo su macro en 1 junto con la
+ *		  configuración. LCD_PANEL_DUAL y LCD_RECORDER se
+ *		  siguen habilitando aparte.
+ */
+
+#ifndef API_INC_API_LCD_CONFIG_H_
+#define API_INC_API_LCD_CONFIG_H_
+
+#if !defined(LCD_BUILD_MINIMAL) && !defined(LCD_BUILD_STANDARD) && !defined(LCD_BUILD_FULL)
+#define LCD_BUILD_FULL
+#endif
+
+#ifdef LCD_BUILD_FULL
+#define LCD_NATIVE      1 // perfiles AIP31068 y ST7032
+#define LCD_QUEUE       1 // API_lcd_queue.c, API_lcd_pool.c y LCD_getStats
+#define LCD_LIST        1 // API_lcd_list.c
+#define LCD_WIDGETS     1 // contador, reloj y registro de líneas
+#define LCD_TRANSITIONS 1 // API_lcd_transition.c
+#endif
+
+#if defined(LCD_BUILD_STANDARD) || defined(LCD_BUILD_FULL)
+#define LCD_LAZY_INIT 1 // LCD_initLazy y los pasos de LCD_process
+#define LCD_REATTACH  1 // LCD_reattach y la lectura del controlador
+#define LCD_POWER     1 // modos de energía y apagado por inactividad
+#define LCD_STREAM    1 // API_lcd_stream.c, API_lcd_frame.c y el diff del buffer
+#endif
+
+#if defined(LCD_RECORDER) && !(defined(LCD_LAZY_INIT) && defined(LCD_REATTACH) &&              \
+                               defined(LCD_POWER))
+#error "LCD_RECORDER reproduce toda la API: necesita LCD_LAZY_INIT, LCD_REATTACH y LCD_POWER"
+#endif
+
+#endif /* API_INC_API_LCD_CONFIG_H_ */
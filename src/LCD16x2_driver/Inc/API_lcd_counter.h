@@ -0,0 +1,76 @@
+/**
+ * @file API_lcd_counter.h
+ * @brief Contador tipo odómetro para contadores de eventos
+ * 		  y totalizadores. Guarda sus cifras como caracteres
+ *		  y al sumar propaga el acarreo desde la cifra menos
+ *		  significativa, por lo que sólo reescribe las cifras
+ *		  que cambian: un incremento suele costar un comando
+ *		  de cursor y un caracter, sin volver a formatear el
+ *		  número ni comparar la línea.
+ *
+ *		  Al pasar de su máximo el contador vuelve a cero,
+ *		  como un odómetro.
+ */
+
+#ifndef API_INC_API_LCD_COUNTER_H_
+#define API_INC_API_LCD_COUNTER_H_
+
+#include "API_lcd.h"
+
+// cifras de un uint32_t
+#define LCD_CONTADOR_MAX_CIFRAS 10
+
+/**
+ * @brief Contador en pantalla. texto tiene las cifras de la más
+ *        significativa a la menos, terminadas en '\0'; sin ceros
+ *        a la izquierda las cifras que sobran son blancos.
+ */
+typedef struct {
+    uint8_t fila;     // LCD_FILA_1 o LCD_FILA_2
+    uint8_t posicion; // columna de la cifra más significativa
+    uint8_t cifras;
+    bool_t ceros;     // completa con ceros a la izquierda
+    char texto[LCD_CONTADOR_MAX_CIFRAS + 1];
+} LCD_ContadorTypedef;
+
+/**
+ *	@brief Prepara un contador de cifras caracteres a partir de
+ *		   (fila, posición) y lo dibuja en cero.
+ *	@retval LCD_ERROR si no entra en la pantalla.
+ */
+LCD_StatusTypedef LCD_counterInit(LCD_ContadorTypedef *, uint8_t, uint8_t, uint8_t, bool_t);
+
+/**
+ *	@brief Suma uno y reescribe sólo las cifras que cambian.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_counterIncrement(LCD_ContadorTypedef *);
+
+/**
+ *	@brief Suma un valor cifra por cifra y reescribe desde la
+ *		   cifra más significativa que cambió.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_counterAdd(LCD_ContadorTypedef *, uint32_t);
+
+/**
+ *	@brief Cambia el valor, reescribiendo desde la primera
+ *		   cifra distinta. Los valores que no entran se truncan
+ *		   a las cifras menos significativas.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_counterSet(LCD_ContadorTypedef *, uint32_t);
+
+/**
+ *	@brief Vuelve a dibujar todas las cifras, por ejemplo luego
+ *		   de un error o de limpiar la pantalla.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_counterRedraw(const LCD_ContadorTypedef *);
+
+/**
+ *	@brief Devuelve el valor del contador.
+ */
+uint32_t LCD_counterGet(const LCD_ContadorTypedef *);
+
+#endif /* API_INC_API_LCD_COUNTER_H_ */
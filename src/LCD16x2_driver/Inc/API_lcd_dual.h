@@ -0,0 +1,101 @@
+/**
+ * @file API_lcd_dual.h
+ * @brief Paneles de 40x4 con dos controladores HD44780
+ * 		  que comparten el bus de datos y tienen cada uno
+ *		  su línea de enable (E1 para las filas 1 y 2, E2
+ *		  para las 3 y 4). Se dibuja sobre un único buffer
+ *		  de sombra y el envío intercala los mensajes de los
+ *		  dos controladores en transacciones largas, sin
+ *		  esperas: hasta I2C_CLOCK_MAX las tramas de un mensaje
+ *		  ya duran más que la ejecución del anterior.
+ *
+ *		  E2 usa el pin RW del PCF8574, que en estos paneles
+ *		  queda a masa: el panel es sólo de escritura. El
+ *		  módulo se compila definiendo LCD_PANEL_DUAL, que
+ *		  además agranda el buffer de sombra a 40x4. El panel
+ *		  no usa las funciones LCD_xxx de un solo controlador.
+ */
+
+#ifndef API_INC_API_LCD_DUAL_H_
+#define API_INC_API_LCD_DUAL_H_
+
+#include "API_lcd.h"
+#include "API_lcd_buffer.h"
+
+// geometría de un panel de 40x4
+#define LCD_DUAL_COLUMNAS            40
+#define LCD_DUAL_FILAS               4
+#define LCD_DUAL_CONTROLADORES       2
+#define LCD_DUAL_FILAS_X_CONTROLADOR 2
+
+#if LCD_BUFFER_MAX_FILAS < LCD_DUAL_FILAS || LCD_BUFFER_MAX_COLUMNAS < LCD_DUAL_COLUMNAS
+#error "Un panel de 40x4 requiere definir LCD_PANEL_DUAL o un buffer de 4x40"
+#endif
+
+// pines del PCF8574 conectados a E1 y E2
+#ifndef LCD_DUAL_E1
+#define LCD_DUAL_E1 (1 << 2)
+#endif
+#ifndef LCD_DUAL_E2
+#define LCD_DUAL_E2 (1 << 1)
+#endif
+
+// tramas que se juntan en cada transacción de LCD_dualFlush
+#ifndef LCD_DUAL_TRAMAS_X_BLOQUE
+#define LCD_DUAL_TRAMAS_X_BLOQUE 64
+#endif
+
+/**
+ * @brief Estado de un controlador del panel: su pin de
+ *        enable y la posición del envío en sus dos filas.
+ */
+typedef struct {
+    uint8_t enable;
+    uint8_t fila;    // fila del controlador, 0 o 1
+    uint8_t columna; // próxima columna a revisar
+    bool_t enTramo;  // el cursor ya está en columna
+} LCD_DualControladorTypedef;
+
+/**
+ * @brief Panel de dos controladores con su buffer de sombra.
+ */
+typedef struct {
+    LCD_BufferTypedef buffer;
+    LCD_DualControladorTypedef controladores[LCD_DUAL_CONTROLADORES];
+} LCD_DualTypedef;
+
+/**
+ *	@brief Inicializa el periférico I2C y los dos controladores
+ *		   a la vez, con E1 y E2 en la misma trama, por lo que
+ *		   las esperas de la secuencia se hacen una sola vez.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_dualInit(LCD_DualTypedef *);
+
+/**
+ *	@brief Borra los dos controladores con un único comando
+ *		   y una sola espera, y deja el buffer en blanco.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_dualClear(LCD_DualTypedef *);
+
+/**
+ *	@brief Escribe un texto en el buffer a partir de (fila,
+ *		   columna), con filas de 0 a 3 y columnas de 0 a 39.
+ *		   No accede al bus. El texto se corta al final de la fila.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_dualPrintAt(LCD_DualTypedef *, uint8_t, uint8_t, const char *);
+
+/**
+ *	@brief Envía las celdas sucias intercalando un mensaje de
+ *		   cada controlador, en transacciones de hasta
+ *		   LCD_DUAL_TRAMAS_X_BLOQUE tramas y sin esperas. Entre
+ *		   dos mensajes de un mismo controlador siempre sale uno
+ *		   del otro cuando ambos tienen celdas sucias. Si falla
+ *		   una transacción todo el buffer queda sucio.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_dualFlush(LCD_DualTypedef *);
+
+#endif /* API_INC_API_LCD_DUAL_H_ */
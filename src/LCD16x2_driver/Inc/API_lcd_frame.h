@@ -0,0 +1,85 @@
+/**
+ * @file API_lcd_frame.h
+ * @brief Doble cuadro para separar a quien dibuja de quien
+ * 		  envía. La aplicación dibuja en el cuadro de atrás y
+ *		  lo publica con LCD_frameCommit, que intercambia los
+ *		  índices; el envío (una tarea, la ISR de fin de
+ *		  transmisión o la del DMA) toma una copia del cuadro
+ *		  del frente con LCD_frameSnapshot y la manda desde su
+ *		  propio buffer de sombra, por ejemplo con LCD_streamFlush.
+ *
+ *		  Ninguno de los dos espera al otro: la copia se valida
+ *		  con un contador de secuencia (seqlock) que es impar
+ *		  mientras se publica un cuadro, y si durante la copia
+ *		  se publicó otro se descarta y se reintenta. Así el
+ *		  envío nunca ve un cuadro a medio dibujar, y la
+ *		  aplicación nunca espera a que termine una transferencia.
+ *
+ *		  Hay un solo escritor y un solo lector por cuadro
+ *		  doble. La copia sólo se debe tomar cuando no hay un
+ *		  envío en curso desde el buffer de sombra.
+ */
+
+#ifndef API_INC_API_LCD_FRAME_H_
+#define API_INC_API_LCD_FRAME_H_
+
+#include "API_lcd.h"
+#include "API_lcd_buffer.h"
+
+// intentos de LCD_frameSnapshot antes de desistir
+#ifndef LCD_CUADRO_REINTENTOS
+#define LCD_CUADRO_REINTENTOS 3
+#endif
+
+/**
+ * @brief Cuadro doble. Del mapa de celdas sucias de los
+ *        cuadros no se usa nada: lo que falta enviar lo
+ *        calcula la copia comparando con la sombra.
+ */
+typedef struct {
+    LCD_BufferTypedef cuadros[2];
+    uint32_t secuencia;      // impar mientras se publica un cuadro
+    uint8_t frente;          // índice del cuadro publicado
+    uint32_t secuenciaLeida; // secuencia de la última copia, sólo la modifica el lector
+} LCD_CuadroDobleTypedef;
+
+/**
+ *	@brief Inicializa los dos cuadros con la geometría indicada
+ *		   (filas, columnas), en blanco.
+ */
+void LCD_frameInit(LCD_CuadroDobleTypedef *, uint8_t, uint8_t);
+
+/**
+ *	@brief Cuadro de atrás, en el que dibuja la aplicación
+ *		   con las funciones de API_lcd_buffer. Sólo es
+ *		   válido hasta el próximo LCD_frameCommit.
+ */
+LCD_BufferTypedef * LCD_frameBack(LCD_CuadroDobleTypedef *);
+
+/**
+ *	@brief Publica el cuadro de atrás intercambiando los
+ *		   índices y copia su contenido en el nuevo cuadro
+ *		   de atrás, para seguir dibujando sobre lo publicado.
+ *		   No espera al envío.
+ */
+void LCD_frameCommit(LCD_CuadroDobleTypedef *);
+
+/**
+ *	@brief Indica si se publicó un cuadro desde la última copia.
+ */
+bool_t LCD_framePending(const LCD_CuadroDobleTypedef *);
+
+/**
+ *	@brief Compara el cuadro publicado con el buffer de sombra
+ *		   de la misma geometría, dejando sucias las celdas que
+ *		   cambiaron (LCD_bufferDiff). Si durante la copia se
+ *		   publica otro cuadro se reintenta hasta
+ *		   LCD_CUADRO_REINTENTOS veces; la sombra sólo cambia
+ *		   con una copia coherente.
+ *	@retval LCD_ERROR si no se obtuvo una copia coherente; la
+ *	        sombra queda como estaba. El llamador puede
+ *	        reintentar más tarde sin esperar.
+ */
+LCD_StatusTypedef LCD_frameSnapshot(LCD_CuadroDobleTypedef *, LCD_BufferTypedef *);
+
+#endif /* API_INC_API_LCD_FRAME_H_ */
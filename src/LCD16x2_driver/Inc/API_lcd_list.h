@@ -0,0 +1,120 @@
+/**
+ * @file API_lcd_list.h
+ * @brief Listas de visualización del LCD. Una lista
+ * 		  graba una secuencia de operaciones ya codificada
+ *		  en tramas del PCF8574, que luego se reproduce
+ *		  tantas veces como se quiera con una única
+ *		  transacción I2C por tramo, sin volver a codificar.
+ *		  Los campos variables se reservan como slots y se
+ *		  actualizan en el lugar con LCD_listPatch.
+ *
+ *		  Grabar una lista no accede al hardware, por lo que
+ *		  el buffer de tramas y la tabla de slots también se
+ *		  pueden generar en el host y guardar como constantes.
+ */
+
+#ifndef API_INC_API_LCD_LIST_H_
+#define API_INC_API_LCD_LIST_H_
+
+#include "API_lcd.h"
+
+// cantidad máxima de campos variables por lista
+#ifndef LCD_LISTA_MAX_SLOTS
+#define LCD_LISTA_MAX_SLOTS 4
+#endif
+
+// cantidad máxima de comandos lentos (clear) por lista
+#ifndef LCD_LISTA_MAX_PAUSAS
+#define LCD_LISTA_MAX_PAUSAS 2
+#endif
+
+// tramas que se corrigen por transacción si cambió el backlight
+#ifndef LCD_LISTA_TRAMAS_X_BLOQUE
+#define LCD_LISTA_TRAMAS_X_BLOQUE 32
+#endif
+
+// tamaño de buffer necesario para una cantidad de mensajes
+#define LCD_LISTA_TAM_BUFFER(mensajes) ((mensajes) * LCD_TRAMAS_X_MENSAJE)
+
+/**
+ * @brief Campo variable de una lista: posición de la
+ *        primera trama de datos y cantidad de caracteres.
+ */
+typedef struct {
+    uint16_t inicio;
+    uint8_t ancho;
+} LCD_ListaSlotTypedef;
+
+/**
+ * @brief Lista de visualización. Las pausas son las posiciones
+ *        del buffer tras las que hay que esperar a que termine
+ *        un comando lento antes de seguir transmitiendo.
+ */
+typedef struct {
+    uint8_t * tramas;
+    uint16_t capacidad;
+    uint16_t largo;
+    uint8_t cantidadSlots;
+    LCD_ListaSlotTypedef slots[LCD_LISTA_MAX_SLOTS];
+    uint8_t cantidadPausas;
+    uint16_t pausas[LCD_LISTA_MAX_PAUSAS];
+    bool_t desbordada; // alguna operación no entró en el buffer
+} LCD_ListaTypedef;
+
+/**
+ *	@brief Prepara una lista vacía que graba sus
+ *		   tramas en el buffer indicado.
+ */
+void LCD_listInit(LCD_ListaTypedef *, uint8_t *, uint16_t);
+
+/**
+ *	@brief Graba el borrado de la pantalla.
+ *	@retval LCD_ERROR si la operación no entra en la lista.
+ */
+LCD_StatusTypedef LCD_listClear(LCD_ListaTypedef *);
+
+/**
+ *	@brief Graba un posicionamiento del cursor (fila, posición).
+ *	@retval LCD_ERROR si la operación no entra o es inválida.
+ */
+LCD_StatusTypedef LCD_listSetCursor(LCD_ListaTypedef *, uint8_t, uint8_t);
+
+/**
+ *	@brief Graba la escritura de un caracter.
+ *	@retval LCD_ERROR si la operación no entra en la lista.
+ */
+LCD_StatusTypedef LCD_listPrintChar(LCD_ListaTypedef *, char);
+
+/**
+ *	@brief Graba la escritura de un texto en (fila, posición),
+ *		   con el mismo comportamiento que LCD_printAt.
+ *	@retval LCD_ERROR si la operación no entra o es inválida.
+ */
+LCD_StatusTypedef LCD_listPrintAt(LCD_ListaTypedef *, uint8_t, uint8_t, const char *);
+
+/**
+ *	@brief Reserva un campo variable de un ancho dado en
+ *		   (fila, posición), inicialmente en blanco. Devuelve
+ *		   por el último argumento el número de slot.
+ *	@retval LCD_ERROR si el campo no entra en la lista o en la fila.
+ */
+LCD_StatusTypedef LCD_listSlot(LCD_ListaTypedef *, uint8_t, uint8_t, uint8_t, uint8_t *);
+
+/**
+ *	@brief Reemplaza el contenido de un slot. El texto se
+ *		   completa con espacios o se corta al ancho del slot.
+ *		   Sólo se recodifican las tramas del campo.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_listPatch(LCD_ListaTypedef *, uint8_t, const char *);
+
+/**
+ *	@brief Transmite la lista al LCD con el estado actual del
+ *		   backlight. Los tramos grabados con ese mismo estado
+ *		   salen en una única transacción; los grabados con
+ *		   otro, en transacciones de LCD_LISTA_TRAMAS_X_BLOQUE.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_listReplay(const LCD_ListaTypedef *);
+
+#endif /* API_INC_API_LCD_LIST_H_ */
@@ -0,0 +1,87 @@
+/**
+ * @file API_lcd_log.h
+ * @brief Registro de las últimas líneas de texto para ver
+ * 		  en el LCD eventos pasados, en lugar de perderlos con
+ *		  cada LCD_printText. Las líneas se guardan en un
+ *		  buffer circular de la aplicación, con el ancho de la
+ *		  pantalla y sin terminador; al llenarse se pisan las
+ *		  más viejas.
+ *
+ *		  Agregar una línea es O(1), no accede al hardware y se
+ *		  puede hacer desde cualquier contexto, incluso una
+ *		  interrupción. LCD_logProcess dibuja la vista cuando
+ *		  cambió, reescribiendo en cada fila sólo el tramo que
+ *		  difiere del buffer de sombra del driver.
+ */
+
+#ifndef API_INC_API_LCD_LOG_H_
+#define API_INC_API_LCD_LOG_H_
+
+#include "API_lcd.h"
+
+// tamaño de buffer necesario para una cantidad de líneas
+#define LCD_LOG_TAM_BUFFER(lineas) ((lineas) * LCD_CANTIDAD_COLUMNAS)
+
+/**
+ * @brief Registro de líneas. La vista muestra en la última fila
+ *        la línea que está desplazamiento líneas antes de la más
+ *        nueva; con desplazamiento en 0 sigue a las que llegan.
+ */
+typedef struct {
+    char * lineas;
+    uint16_t capacidad;      // cantidad de líneas del buffer
+    uint32_t reservadas;     // líneas que empezaron a escribirse
+    uint32_t escritas;       // líneas terminadas desde el inicio
+    uint32_t dibujadas;      // valor de escritas en el último dibujo
+    uint32_t referencia;     // valor de escritas al que se refiere desplazamiento
+    uint16_t desplazamiento; // líneas hacia atrás desde la más nueva
+    bool_t vistaCambiada;    // se movió la vista desde el último dibujo
+} LCD_LogTypedef;
+
+/**
+ *	@brief Prepara un registro vacío en el buffer indicado,
+ *		   de LCD_LOG_TAM_BUFFER(líneas) bytes.
+ *	@retval LCD_ERROR si el buffer no alcanza para una pantalla.
+ */
+LCD_StatusTypedef LCD_logInit(LCD_LogTypedef *, char *, uint16_t);
+
+/**
+ *	@brief Agrega una línea, recortada o completada con blancos
+ *		   al ancho de la pantalla. Si dos contextos agregan a la
+ *		   vez, la línea del interrumpido puede verse incompleta
+ *		   hasta el próximo dibujo.
+ */
+void LCD_logAppend(LCD_LogTypedef *, const char *);
+
+/**
+ *	@brief Mueve la vista líneas hacia atrás (positivo) o hacia
+ *		   las más nuevas (negativo), sin salir del registro.
+ */
+void LCD_logScroll(LCD_LogTypedef *, int16_t);
+
+/**
+ *	@brief Mueve la vista de a pantallas completas.
+ */
+void LCD_logPage(LCD_LogTypedef *, int8_t);
+
+/**
+ *	@brief Vuelve la vista a las líneas más nuevas.
+ */
+void LCD_logFollow(LCD_LogTypedef *);
+
+/**
+ *	@brief Copia con terminador la línea que está tantas
+ *		   líneas antes de la más nueva.
+ *	@retval false si esa línea ya no está en el registro.
+ */
+bool_t LCD_logGetLine(const LCD_LogTypedef *, uint16_t, char *);
+
+/**
+ *	@brief Si llegaron líneas o se movió la vista, la dibuja.
+ *		   Mientras la vista está atrás, las líneas nuevas no
+ *		   la mueven.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_logProcess(LCD_LogTypedef *);
+
+#endif /* API_INC_API_LCD_LOG_H_ */
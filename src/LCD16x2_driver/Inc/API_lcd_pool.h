@@ -0,0 +1,83 @@
+/**
+ * @file API_lcd_pool.h
+ * @brief Pool de memoria estático para los pedidos
+ * 		  encolados del LCD. Los bloques se reparten
+ *		  en clases de tamaño fijo, por lo que nunca
+ *		  se utiliza memoria dinámica (heap).
+ */
+
+#ifndef API_INC_API_LCD_POOL_H_
+#define API_INC_API_LCD_POOL_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "API_lcd_config.h"
+
+// cantidad de clases de tamaño del pool
+#define LCD_POOL_CANTIDAD_CLASES 3
+
+// clase 0: movimientos de cursor y caracteres sueltos
+#ifndef LCD_POOL_TAM_CLASE_0
+#define LCD_POOL_TAM_CLASE_0 4
+#endif
+#ifndef LCD_POOL_BLOQUES_CLASE_0
+#define LCD_POOL_BLOQUES_CLASE_0 16
+#endif
+
+// clase 1: carga de CGRAM (posición + 8 filas del patrón)
+#ifndef LCD_POOL_TAM_CLASE_1
+#define LCD_POOL_TAM_CLASE_1 12
+#endif
+#ifndef LCD_POOL_BLOQUES_CLASE_1
+#define LCD_POOL_BLOQUES_CLASE_1 8
+#endif
+
+// clase 2: texto de pantalla completa (32 caracteres + '\n' + '\0')
+#ifndef LCD_POOL_TAM_CLASE_2
+#define LCD_POOL_TAM_CLASE_2 36
+#endif
+#ifndef LCD_POOL_BLOQUES_CLASE_2
+#define LCD_POOL_BLOQUES_CLASE_2 4
+#endif
+
+#if (LCD_POOL_BLOQUES_CLASE_0 > 32) || (LCD_POOL_BLOQUES_CLASE_1 > 32) ||                          \
+    (LCD_POOL_BLOQUES_CLASE_2 > 32)
+#error "El pool admite como máximo 32 bloques por clase"
+#endif
+
+/**
+ * @brief Estadísticas de uso del pool, por clase de tamaño.
+ */
+typedef struct {
+    uint8_t enUso[LCD_POOL_CANTIDAD_CLASES];     // bloques ocupados actualmente
+    uint8_t maximoUso[LCD_POOL_CANTIDAD_CLASES]; // marca de agua máxima desde LCD_poolInit
+    uint16_t fallos;                             // pedidos rechazados por pool agotado
+} LCD_PoolStatsTypedef;
+
+/**
+ *	@brief Libera todos los bloques y reinicia
+ *		   las estadísticas del pool.
+ */
+void LCD_poolInit();
+
+/**
+ *	@brief Reserva un bloque de al menos el tamaño
+ *		   pedido. Si la clase que corresponde está
+ *		   agotada se intenta con la siguiente más grande.
+ *	@retval Puntero al bloque o NULL si no hay lugar.
+ */
+void * LCD_poolAlloc(uint8_t);
+
+/**
+ *	@brief Devuelve un bloque al pool. Ignora punteros
+ *		   que no pertenecen al pool o que ya estaban libres.
+ */
+void LCD_poolFree(void *);
+
+/**
+ *	@brief Copia las estadísticas de uso del pool.
+ */
+void LCD_poolGetStats(LCD_PoolStatsTypedef *);
+
+#endif /* API_INC_API_LCD_POOL_H_ */
@@ -13,8 +13,41 @@
 // constantes para la comunicación I2C
 #define I2C_INSTANCE    I2C1
 #define I2C_CLOCK_SPEED 100000
+#define I2C_CLOCK_MIN   10000  // velocidades aceptadas por port_setClockSpeed
+#define I2C_CLOCK_MAX   400000 // modo rápido del I2C del STM32F4
 #define I2C_TIMEOUT     10
 #define LCD_ADDRESS     0x27
+#define I2C_EV_IRQN     I2C1_EV_IRQn
+#define I2C_ER_IRQN     I2C1_ER_IRQn
+
+// DMA de transmisión del I2C1: DMA1 Stream6, canal 1
+#define DMA_STREAM DMA1_Stream6
+#define DMA_CANAL  1
+#define DMA_IRQN   DMA1_Stream6_IRQn
+
+/**
+ *   @brief Callback que entrega la próxima trama de una
+ *          transmisión por interrupciones. Se llama desde
+ *          la ISR del I2C.
+ *	@retval false si no quedan tramas.
+ */
+typedef bool_t (*port_TramaCallbackTypedef)(uint8_t *);
+
+/**
+ *   @brief Callback de fin de una transmisión por
+ *          interrupciones, con el resultado. Se llama
+ *          desde la ISR del I2C.
+ */
+typedef void (*port_FinCallbackTypedef)(bool_t);
+
+/**
+ *   @brief Callback de una transmisión circular por DMA: la
+ *          mitad indicada (0 o 1) ya se transmitió y se puede
+ *          volver a llenar. Se llama desde la ISR del DMA.
+ *	@retval false para terminar la transmisión, porque la otra
+ *	        mitad ya no tiene datos nuevos.
+ */
+typedef bool_t (*port_MitadCallbackTypedef)(uint8_t);
 
 /**
  *   @brief Inicializa el periférico I2C.
@@ -22,6 +55,31 @@
  **/
 bool_t port_init();
 
+/**
+ *   @brief Cambia la dirección I2C de 7 bits del LCD.
+ *          Por defecto es LCD_ADDRESS, la del PCF8574.
+ */
+void port_setAddress(uint8_t);
+
+/**
+ *   @brief Devuelve la dirección I2C de 7 bits del LCD.
+ */
+uint8_t port_getAddress();
+
+/**
+ *   @brief Cambia la velocidad del bus I2C, en Hz, entre
+ *          I2C_CLOCK_MIN e I2C_CLOCK_MAX, y vuelve a configurar
+ *          el periférico. No se acepta con una transmisión en
+ *          segundo plano en curso.
+ *	@retval Estado de ejecución.
+ */
+bool_t port_setClockSpeed(uint32_t);
+
+/**
+ *   @brief Devuelve la velocidad del bus I2C, en Hz.
+ */
+uint32_t port_getClockSpeed();
+
 /**
  *   @brief Escribe un byte por I2C.
  *	@retval Estado de ejecución.
@@ -29,8 +87,67 @@ bool_t port_init();
 bool_t port_i2cWriteByte(uint8_t);
 
 /**
- *   @brief Implementa un delay bloqueante.
+ *   @brief Escribe varios bytes por I2C en una
+ *          única transacción. El PCF8574 actualiza
+ *          sus salidas con cada byte recibido.
+ *	@retval Estado de ejecución.
+ */
+bool_t port_i2cWrite(const uint8_t *, uint16_t);
+
+/**
+ *   @brief Lee por I2C el estado de los pines del
+ *          expansor. Los pines escritos en 1 funcionan
+ *          como entradas y muestran lo que maneja el LCD.
+ *	@retval Estado de ejecución.
+ */
+bool_t port_i2cReadByte(uint8_t *);
+
+/**
+ *   @brief Inicia una transmisión por interrupciones en la
+ *          que cada byte se pide al callback de trama en el
+ *          momento de cargarlo en el periférico. Requiere que
+ *          I2C1_EV_IRQHandler y I2C1_ER_IRQHandler llamen a
+ *          port_i2cEvIRQHandler y port_i2cErIRQHandler.
+ *	@retval false si hay otra transmisión en curso o el bus está ocupado.
+ */
+bool_t port_i2cStreamStart(port_TramaCallbackTypedef, port_FinCallbackTypedef);
+
+/**
+ *   @brief Inicia una transmisión circular por DMA de un
+ *          buffer (de largo par) dividido en dos mitades. Al
+ *          terminar cada mitad se llama al callback de mitad.
+ *          Requiere además que DMA1_Stream6_IRQHandler llame
+ *          a port_dmaIRQHandler.
+ *	@retval false si hay otra transmisión en curso o el bus está ocupado.
+ */
+bool_t port_i2cDmaStart(const uint8_t *, uint16_t, port_MitadCallbackTypedef,
+                        port_FinCallbackTypedef);
+
+/**
+ *   @brief Atención de la interrupción del DMA del I2C.
+ */
+void port_dmaIRQHandler();
+
+/**
+ *   @brief Atención de la interrupción de eventos del I2C.
+ */
+void port_i2cEvIRQHandler();
+
+/**
+ *   @brief Atención de la interrupción de errores del I2C.
+ */
+void port_i2cErIRQHandler();
+
+/**
+ *   @brief Implementa un delay bloqueante. Definiendo
+ *          PORT_DELAY_WFI el núcleo espera en modo Sleep.
  */
 void port_delay(uint32_t);
 
+/**
+ *   @brief Devuelve el tiempo transcurrido desde
+ *          el arranque, en milisegundos.
+ */
+uint32_t port_getTick();
+
 #endif /* API_INC_API_LCD_PORT_H_ */
@@ -0,0 +1,104 @@
+/**
+ * @file API_lcd_port_sock.h
+ * @brief Port del LCD sobre un socket Unix, para correr en
+ *        la PC la aplicación compilada para el host contra
+ *        los displays simulados del servicio sim_lcdd. Se
+ *        compila en lugar de API_lcd_port.c definiendo
+ *        LCD_PORT_SOCKET: cada transacción I2C, lectura,
+ *        espera o consulta del tick es un pedido al servicio.
+ *
+ *        Define también el protocolo: cada mensaje empieza con
+ *        un SOCK_EncabezadoTypedef seguido de largo bytes de
+ *        contenido. En la respuesta el campo operacion lleva
+ *        el SOCK_RespuestaTypedef. El servicio corre en la
+ *        misma máquina, así que los campos van en el orden de
+ *        bytes nativo.
+ */
+
+#ifndef API_INC_API_LCD_PORT_SOCK_H_
+#define API_INC_API_LCD_PORT_SOCK_H_
+
+#include "API_lcd_port.h"
+
+// socket del servicio si no se configura otro ni está la variable SOCK_VARIABLE_RUTA
+#define SOCK_RUTA_DEFECTO      "/tmp/sim_lcdd.sock"
+#define SOCK_VARIABLE_RUTA     "LCD_SOCKET"
+#define SOCK_VARIABLE_PANTALLA "LCD_PANTALLA"
+
+#define SOCK_MAX_RUTA     108  // largo de sun_path
+#define SOCK_MAX_DATOS    4096 // contenido máximo de un mensaje
+#define SOCK_MAX_COLUMNAS 40   // texto máximo de una fila
+
+/**
+ * @brief Pedidos al servicio.
+ */
+typedef enum {
+    SOCK_OP_ESCRIBIR,     // dirección + bytes de una transacción de escritura
+    SOCK_OP_LEER,         // dirección; responde el byte leído
+    SOCK_OP_ESPERAR,      // uint32_t de milisegundos
+    SOCK_OP_TICK,         // responde un uint32_t de milisegundos simulados
+    SOCK_OP_ESTADISTICAS, // responde un SOCK_EstadisticasTypedef
+    SOCK_OP_LINEA         // fila; responde el texto visible de la fila
+} SOCK_OperacionTypedef;
+
+/**
+ * @brief Resultado de un pedido.
+ */
+typedef enum {
+    SOCK_RESPUESTA_OK,
+    SOCK_RESPUESTA_NACK, // nadie responde a la dirección pedida
+    SOCK_RESPUESTA_ERROR // pedido o display inválido
+} SOCK_RespuestaTypedef;
+
+/**
+ * @brief Encabezado de cada mensaje.
+ */
+typedef struct {
+    uint8_t operacion; // SOCK_OperacionTypedef, o SOCK_RespuestaTypedef en la respuesta
+    uint8_t pantalla;  // display del servicio
+    uint16_t largo;    // bytes de contenido que siguen
+} SOCK_EncabezadoTypedef;
+
+/**
+ * @brief Estadísticas de un display del servicio.
+ */
+typedef struct {
+    uint32_t pedidos;
+    uint32_t transacciones;
+    uint32_t bytesI2C;
+    uint32_t nacks;
+    uint32_t violaciones; // instrucciones recibidas con el controlador ocupado
+    uint32_t tiempoBusUs;
+    uint32_t tiempoEsperaUs;
+    uint32_t clientes;    // conexiones que pidieron algo a este display
+} SOCK_EstadisticasTypedef;
+
+/**
+ *   @brief Elige el socket y el display del servicio antes
+ *          de port_init. Sin llamarla se usan las variables
+ *          de entorno SOCK_VARIABLE_RUTA y SOCK_VARIABLE_PANTALLA,
+ *          o SOCK_RUTA_DEFECTO y el display 0.
+ */
+void port_sockConfig(const char *, uint8_t);
+
+/**
+ *   @brief Cierra la conexión. El próximo port_init se
+ *          vuelve a conectar.
+ */
+void port_sockClose();
+
+/**
+ *   @brief Pide las estadísticas del display.
+ *	@retval Estado de ejecución.
+ */
+bool_t port_sockGetStats(SOCK_EstadisticasTypedef *);
+
+/**
+ *   @brief Pide el texto visible de una fila del display,
+ *          terminado en '\0', en un buffer de al menos
+ *          SOCK_MAX_COLUMNAS + 1 caracteres.
+ *	@retval Estado de ejecución.
+ */
+bool_t port_sockGetLine(uint8_t, char *);
+
+#endif /* API_INC_API_LCD_PORT_SOCK_H_ */
@@ -0,0 +1,61 @@
+/**
+ * @file API_lcd_profile.h
+ * @brief Perfiles de controlador del LCD. El perfil por
+ * 		  defecto es el HD44780 detrás de un PCF8574 en modo
+ *		  4 bits. Los controladores con I2C nativo (AIP31068,
+ *		  ST7032) reciben cada comando o dato completo precedido
+ *		  por un byte de control, sin partirlo en nibbles ni
+ *		  generar flancos de E. Como no hay flancos que den
+ *		  tiempo, los bytes seguidos de una transacción deben
+ *		  llegar separados al menos por el tiempo de instrucción:
+ *		  9 bits a 100 kHz son 90 µs, pero a 400 kHz son 22,5 µs,
+ *		  menos de lo que tardan el AIP31068 y el ST7032.
+ */
+
+#ifndef API_INC_API_LCD_PROFILE_H_
+#define API_INC_API_LCD_PROFILE_H_
+
+#include "stm32f4xx.h"
+#include "API_lcd_config.h"
+
+// bytes de control de los controladores con I2C nativo
+#define LCD_CONTROL_COMANDO 0x00 // Co = 0, RS = 0: siguen comandos
+#define LCD_CONTROL_DATO    0x40 // Co = 0, RS = 1: siguen datos
+
+// dirección I2C de 7 bits del AIP31068 y del ST7032
+#define LCD_ADDRESS_NATIVO 0x3E
+
+/**
+ * @brief Paso de la secuencia de inicialización de un
+ *        controlador nativo: comando y espera en ms que
+ *        necesita antes del paso siguiente.
+ */
+typedef struct {
+    uint8_t comando;
+    uint8_t espera;
+} LCD_PasoInicioTypedef;
+
+/**
+ * @brief Perfil de un controlador. Para el PCF8574 la
+ *        inicialización y las esperas son las de API_lcd.c,
+ *        por lo que inicio queda en NULL.
+ */
+typedef struct {
+    const char * nombre;
+    uint8_t direccion;                    // dirección I2C de 7 bits
+    bool_t nativo;                        // byte de control en lugar de nibbles y E
+    const LCD_PasoInicioTypedef * inicio; // secuencia de inicialización
+    uint8_t pasosInicio;                  // cantidad de pasos de inicio
+    uint8_t esperaEncendido;              // espera en ms antes del primer paso
+    uint8_t esperaClear;                  // espera en ms de CLR_LCD y RETURN_HOME
+    uint8_t tiempoInstruccion;            // µs que tarda el resto de los comandos y datos
+} LCD_PerfilTypedef;
+
+/**
+ * @brief Perfiles disponibles.
+ */
+extern const LCD_PerfilTypedef LCD_PERFIL_PCF8574;
+extern const LCD_PerfilTypedef LCD_PERFIL_AIP31068;
+extern const LCD_PerfilTypedef LCD_PERFIL_ST7032;
+
+#endif /* API_INC_API_LCD_PROFILE_H_ */
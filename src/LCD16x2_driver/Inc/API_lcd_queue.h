@@ -0,0 +1,112 @@
+/**
+ * @file API_lcd_queue.h
+ * @brief Cola de pedidos para el LCD. Permite
+ * 		  encolar escrituras desde la aplicación y
+ *		  enviarlas al display más tarde, llamando a
+ *		  LCD_queueProcess desde el lazo principal.
+ *		  Los datos de cada pedido se guardan en el
+ *		  pool estático del módulo API_lcd_pool.
+ */
+
+#ifndef API_INC_API_LCD_QUEUE_H_
+#define API_INC_API_LCD_QUEUE_H_
+
+#include "API_lcd.h"
+
+// cantidad máxima de pedidos pendientes en la cola
+#ifndef LCD_COLA_CAPACIDAD
+#define LCD_COLA_CAPACIDAD 8
+#endif
+
+// espera máxima por defecto de la política LCD_COLA_BLOQUEAR, en ms
+#ifndef LCD_COLA_ESPERA_MAXIMA
+#define LCD_COLA_ESPERA_MAXIMA 100
+#endif
+
+// ms que tarda en enviarse un mensaje al PCF8574: LCD_sendByte espera 1 ms por nibble
+#ifndef LCD_COLA_MS_X_MENSAJE
+#define LCD_COLA_MS_X_MENSAJE 2
+#endif
+
+/**
+ * @brief Comportamiento de la cola cuando un pedido no entra.
+ */
+typedef enum {
+    LCD_COLA_DESCARTAR_NUEVO, // se rechaza el pedido nuevo (por defecto)
+    LCD_COLA_DESCARTAR_VIEJO, // se descartan los pedidos más antiguos hasta hacer lugar
+    LCD_COLA_BLOQUEAR,        // el llamador procesa la cola hasta hacer lugar, con espera acotada
+    LCD_COLA_COALESCER        // un pedido reemplaza al pendiente de la misma región
+} LCD_ColaPoliticaTypedef;
+
+/**
+ *	@brief Vacía la cola e inicializa el pool de
+ *		   memoria de los pedidos.
+ */
+void LCD_queueInit();
+
+/**
+ *	@brief Selecciona la política de la cola. El segundo
+ *		   argumento es la espera máxima en ms de la política
+ *		   LCD_COLA_BLOQUEAR; las demás lo ignoran. Antes de
+ *		   enviar cada pedido se estima su duración con
+ *		   LCD_COLA_MS_X_MENSAJE y, si terminaría después del
+ *		   plazo, se desiste sin enviarlo: la espera sólo supera
+ *		   el plazo en lo que los envíos tarden más que lo
+ *		   estimado, por ejemplo con un HAL_Delay que redondea
+ *		   hacia arriba.
+ */
+void LCD_queueSetPolicy(LCD_ColaPoliticaTypedef, uint32_t);
+
+/**
+ *	@brief Encola un texto para ser escrito con LCD_printText.
+ *		   El texto se copia, por lo que el buffer del
+ *		   llamador puede reutilizarse al retornar.
+ *	@retval LCD_ERROR si la cola o el pool están llenos.
+ */
+LCD_StatusTypedef LCD_queuePrintText(const char *);
+
+/**
+ *	@brief Encola un texto para ser escrito con LCD_printAt
+ *		   en la región (fila, posición, largo del texto).
+ *	@retval LCD_ERROR si la cola o el pool están llenos.
+ */
+LCD_StatusTypedef LCD_queuePrintAt(uint8_t, uint8_t, const char *);
+
+/**
+ *	@brief Encola un caracter para ser escrito con LCD_printChar.
+ *	@retval LCD_ERROR si la cola o el pool están llenos.
+ */
+LCD_StatusTypedef LCD_queuePrintChar(char);
+
+/**
+ *	@brief Encola un movimiento de cursor (fila, posición).
+ *	@retval LCD_ERROR si la cola o el pool están llenos.
+ */
+LCD_StatusTypedef LCD_queueSetCursor(uint8_t, uint8_t);
+
+/**
+ *	@brief Encola la carga de un caracter en la CGRAM
+ *		   (posición, patrón de LCD_ALTO_CARACTER filas).
+ *	@retval LCD_ERROR si la cola o el pool están llenos.
+ */
+LCD_StatusTypedef LCD_queueCreateChar(uint8_t, const uint8_t *);
+
+/**
+ *	@brief Envía al LCD el pedido más antiguo de la cola
+ *		   y libera su memoria.
+ *	@retval Estado de ejecución del pedido. LCD_OK si
+ *			la cola estaba vacía.
+ */
+LCD_StatusTypedef LCD_queueProcess();
+
+/**
+ *	@brief Cantidad de pedidos pendientes de envío.
+ */
+uint8_t LCD_queuePending();
+
+/**
+ *	@brief Copia las estadísticas de la cola.
+ */
+void LCD_queueGetStats(LCD_ColaStatsTypedef *);
+
+#endif /* API_INC_API_LCD_QUEUE_H_ */
@@ -0,0 +1,132 @@
+/**
+ * @file API_lcd_record.h
+ * @brief Grabación de las llamadas a la API del LCD en un
+ * 		  registro binario compacto, para reproducir en el
+ *		  host la carga real de una aplicación con distintas
+ *		  configuraciones del driver. Cada llamada se guarda
+ *		  con un byte de tipo, los ticks desde la anterior
+ *		  (de 7 bits por byte) y sus argumentos; los textos
+ *		  con su largo. Las llamadas que hace el driver
+ *		  dentro de otra, como los LCD_printChar de
+ *		  LCD_printText, no se graban.
+ *
+ *		  El módulo se compila definiendo LCD_RECORDER; sin
+ *		  esa definición la API del LCD no tiene ningún costo
+ *		  agregado. LCD_process y las consultas no se graban.
+ */
+
+#ifndef API_INC_API_LCD_RECORD_H_
+#define API_INC_API_LCD_RECORD_H_
+
+#include "API_lcd.h"
+
+// bytes de texto que se guardan como máximo en cada llamada
+#ifndef LCD_GRABACION_MAX_TEXTO
+#define LCD_GRABACION_MAX_TEXTO 64
+#endif
+
+// encabezado del registro: "LR" y la versión del formato
+#define LCD_GRABACION_ENCABEZADO 3
+#define LCD_GRABACION_VERSION    1
+
+// bytes de argumentos de la llamada más larga (LCD_createChar)
+#define LCD_GRABACION_MAX_ARGUMENTOS (1 + LCD_ALTO_CARACTER)
+
+/**
+ * @brief Funciones de la API que se graban.
+ */
+typedef enum {
+    LCD_LLAMADA_INIT,
+    LCD_LLAMADA_REATTACH,
+    LCD_LLAMADA_INIT_LAZY,        // modo
+    LCD_LLAMADA_CLEAR,
+    LCD_LLAMADA_PRINT_CHAR,       // caracter
+    LCD_LLAMADA_PRINT_TEXT,       // texto
+    LCD_LLAMADA_PRINT_AT,         // fila, posición y texto
+    LCD_LLAMADA_SET_CURSOR,       // fila, posición
+    LCD_LLAMADA_CURSOR_ON,
+    LCD_LLAMADA_CURSOR_OFF,
+    LCD_LLAMADA_CREATE_CHAR,      // posición y patrón
+    LCD_LLAMADA_SET_POWER_MODE,   // modo
+    LCD_LLAMADA_SET_IDLE_TIMEOUT, // espera de 32 bits y modo
+    LCD_LLAMADA_NOTIFY_ACTIVITY,
+    LCD_LLAMADA_SET_ENTRY_MODE,   // modo
+    LCD_LLAMADAS
+} LCD_LlamadaTypedef;
+
+/**
+ * @brief Una llamada leída del registro.
+ */
+typedef struct {
+    LCD_LlamadaTypedef llamada;
+    uint32_t tick; // ms desde el inicio de la grabación
+    uint8_t argumentos[LCD_GRABACION_MAX_ARGUMENTOS];
+    char texto[LCD_GRABACION_MAX_TEXTO + 1];
+} LCD_RegistroTypedef;
+
+/**
+ * @brief Posición de lectura en un registro.
+ */
+typedef struct {
+    const uint8_t * datos;
+    uint32_t largo;
+    uint32_t posicion;
+    uint32_t tick;
+} LCD_LectorTypedef;
+
+/**
+ *	@brief Hook de la API del LCD. Sin LCD_RECORDER no genera código.
+ */
+#ifdef LCD_RECORDER
+#define LCD_GRABAR(llamada, argumentos, texto) LCD_recordCall((llamada), (argumentos), (texto))
+#else
+#define LCD_GRABAR(llamada, argumentos, texto)
+#endif
+
+/**
+ *	@brief Empieza a grabar en el buffer indicado (buffer,
+ *		   tamaño), que debe durar hasta LCD_recordStop.
+ *	@retval LCD_ERROR si el buffer no alcanza para el encabezado.
+ */
+LCD_StatusTypedef LCD_recordStart(uint8_t *, uint32_t);
+
+/**
+ *	@brief Deja de grabar.
+ *	@retval Largo del registro en bytes.
+ */
+uint32_t LCD_recordStop();
+
+/**
+ *	@brief Cantidad de llamadas que no entraron en el buffer.
+ *		   Al llenarse se deja de agregar, para que el registro
+ *		   siga siendo válido.
+ */
+uint32_t LCD_recordLost();
+
+/**
+ *	@brief Agrega una llamada al registro (tipo, argumentos,
+ *		   texto o NULL) si hay una grabación en curso. Las
+ *		   llamadas que llevan texto y lo reciben en NULL no
+ *		   se graban, porque no llegan al LCD.
+ */
+void LCD_recordCall(LCD_LlamadaTypedef, const uint8_t *, const char *);
+
+/**
+ *	@brief Prepara la lectura de un registro (lector, datos, largo).
+ *	@retval LCD_ERROR si el encabezado no es válido.
+ */
+LCD_StatusTypedef LCD_recordOpen(LCD_LectorTypedef *, const uint8_t *, uint32_t);
+
+/**
+ *	@brief Lee la próxima llamada del registro.
+ *	@retval false al final del registro o si está truncado.
+ */
+bool_t LCD_recordNext(LCD_LectorTypedef *, LCD_RegistroTypedef *);
+
+/**
+ *	@brief Vuelve a hacer una llamada leída del registro.
+ *	@retval Estado de ejecución de la llamada.
+ */
+LCD_StatusTypedef LCD_recordReplay(const LCD_RegistroTypedef *);
+
+#endif /* API_INC_API_LCD_RECORD_H_ */
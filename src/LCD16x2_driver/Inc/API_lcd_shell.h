@@ -0,0 +1,94 @@
+/**
+ * @file API_lcd_shell.h
+ * @brief Consola de comandos para diagnosticar el driver en un
+ * 		  equipo instalado sin grabar una versión de depuración:
+ *		  muestra las estadísticas y el buffer de sombra, corre la
+ *		  medición del port, cambia la velocidad del bus o el
+ *		  período de refresco de la aplicación y graba una traza
+ *		  de las llamadas a la API.
+ *
+ *		  La consola no depende del medio: la aplicación le pasa
+ *		  cada caracter recibido con LCD_shellInput, que se puede
+ *		  llamar desde la interrupción de recepción de una UART
+ *		  (o desde el lazo que lee una pty en el host), y recibe
+ *		  las respuestas, de a una línea terminada en "\r\n", en
+ *		  el callback de salida. Los comandos se ejecutan en
+ *		  LCD_shellProcess, desde el lazo principal:
+ *
+ *		      ayuda
+ *		      stats
+ *		      sombra
+ *		      bench [tramas]
+ *		      bus [hz]
+ *		      refresco [ms]
+ *		      traza on|off
+ *
+ *		  El módulo se compila definiendo LCD_SHELL; la traza
+ *		  necesita además LCD_RECORDER.
+ */
+
+#ifndef API_INC_API_LCD_SHELL_H_
+#define API_INC_API_LCD_SHELL_H_
+
+#include "API_lcd.h"
+
+// caracteres de una línea de comando como máximo
+#ifndef LCD_SHELL_MAX_LINEA
+#define LCD_SHELL_MAX_LINEA 32
+#endif
+
+// caracteres de una línea de respuesta como máximo
+#ifndef LCD_SHELL_MAX_SALIDA
+#define LCD_SHELL_MAX_SALIDA 96
+#endif
+
+// bytes del registro en que se graba la traza
+#ifndef LCD_SHELL_MAX_TRAZA
+#define LCD_SHELL_MAX_TRAZA 512
+#endif
+
+// tramas de la medición del port si no se indican
+#define LCD_SHELL_TRAMAS_BENCH 16
+
+/**
+ * @brief Callback que envía una línea de respuesta.
+ */
+typedef void (*LCD_ShellSalidaTypedef)(const char *);
+
+/**
+ * @brief Callback que aplica un nuevo período de refresco de la
+ *        aplicación, en ms.
+ * @retval false si la aplicación no acepta el período.
+ */
+typedef bool_t (*LCD_ShellRefrescoTypedef)(uint32_t);
+
+/**
+ *	@brief Inicializa la consola con el callback de salida y el
+ *		   de refresco, que puede ser NULL si la aplicación no
+ *		   permite cambiar el período.
+ */
+void LCD_shellInit(LCD_ShellSalidaTypedef, LCD_ShellRefrescoTypedef);
+
+/**
+ *	@brief Recibe un caracter de la línea de comando. Con '\r'
+ *		   o '\n' la línea queda lista para LCD_shellProcess y,
+ *		   hasta que se ejecute, los caracteres que llegan se
+ *		   descartan. '\b' y DEL borran el último caracter.
+ *		   Se puede llamar desde una interrupción.
+ */
+void LCD_shellInput(char);
+
+/**
+ *	@brief Ejecuta la línea recibida, si hay una. Se llama
+ *		   periódicamente desde el lazo principal.
+ *	@retval LCD_ERROR si el comando no existe o falló.
+ */
+LCD_StatusTypedef LCD_shellProcess();
+
+/**
+ *	@brief Ejecuta una línea de comando.
+ *	@retval LCD_ERROR si el comando no existe o falló.
+ */
+LCD_StatusTypedef LCD_shellExecute(const char *);
+
+#endif /* API_INC_API_LCD_SHELL_H_ */
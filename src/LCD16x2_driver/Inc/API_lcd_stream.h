@@ -0,0 +1,58 @@
+/**
+ * @file API_lcd_stream.h
+ * @brief Envío por interrupciones de un buffer de sombra.
+ * 		  La ISR del I2C pide las tramas de a una y este
+ *		  módulo las codifica en el momento a partir del mapa
+ *		  de celdas sucias, por lo que el flujo de 4 tramas por
+ *		  caracter nunca se arma completo en memoria: alcanza
+ *		  con las 4 tramas del mensaje actual.
+ *
+ *		  Mientras hay un envío en curso no se debe modificar
+ *		  el buffer ni usar las funciones bloqueantes del LCD.
+ *		  Al terminar, el cursor del LCD queda después de la
+ *		  última celda enviada, por lo que antes de volver a
+ *		  usar LCD_printChar hay que posicionarlo con LCD_setCursor.
+ */
+
+#ifndef API_INC_API_LCD_STREAM_H_
+#define API_INC_API_LCD_STREAM_H_
+
+#include "API_lcd.h"
+#include "API_lcd_buffer.h"
+
+/**
+ *	@brief Inicia el envío de las celdas sucias del buffer y
+ *		   retorna sin esperar. Cada celda queda limpia en el
+ *		   momento en que se codifica. Si no hay celdas sucias
+ *		   no accede al bus.
+ *	@retval LCD_ERROR si hay otro envío en curso, el perfil es
+ *	        nativo, el modo de entrada desplaza la pantalla o
+ *	        el port no lo pudo iniciar.
+ */
+LCD_StatusTypedef LCD_streamFlush(LCD_BufferTypedef *);
+
+/**
+ *	@brief Igual que LCD_streamFlush pero por DMA circular
+ *		   sobre un buffer de tramas de tamaño par: mientras el
+ *		   DMA transmite una mitad, la ISR de media transferencia
+ *		   o de transferencia completa codifica la otra. La
+ *		   última mitad se completa repitiendo la última trama,
+ *		   que con E en bajo no tiene efecto en el LCD.
+ *	@retval LCD_ERROR si hay otro envío en curso, el buffer no
+ *	        es válido o el port no lo pudo iniciar.
+ */
+LCD_StatusTypedef LCD_streamFlushDma(LCD_BufferTypedef *, uint8_t *, uint16_t);
+
+/**
+ *	@brief Indica si hay un envío en curso.
+ */
+bool_t LCD_streamBusy();
+
+/**
+ *	@brief Resultado del último envío terminado. Si falló,
+ *		   todo el buffer queda sucio para volver a enviarlo.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_streamResult();
+
+#endif /* API_INC_API_LCD_STREAM_H_ */
@@ -0,0 +1,69 @@
+/**
+ * @file API_lcd_transition.h
+ * @brief Transiciones de pantalla deslizando con el
+ * 		  desplazamiento del display del HD44780. Cada línea de
+ *		  la DDRAM tiene 40 columnas y sólo se ven 16: la
+ *		  pantalla nueva se carga en columnas fuera de la vista
+ *		  y se revela con un comando de desplazamiento por paso,
+ *		  en lugar de redibujar las 32 celdas en cada cuadro de
+ *		  la animación.
+ *
+ *		  Al terminar, la pantalla nueva se copia a las columnas
+ *		  0 a 15 mientras no se ven y RETURN_HOME vuelve la vista
+ *		  a su lugar, así el resto del driver sigue trabajando
+ *		  sin desplazamiento. Mientras la transición está en
+ *		  curso no se debe dibujar con el resto de la API. Sólo
+ *		  vale para el perfil LCD_PERFIL_PCF8574.
+ */
+
+#ifndef API_INC_API_LCD_TRANSITION_H_
+#define API_INC_API_LCD_TRANSITION_H_
+
+#include "API_lcd.h"
+
+/**
+ * @brief Sentido en que se mueve el contenido: con
+ *        LCD_TRANSICION_IZQUIERDA la pantalla nueva entra
+ *        por la derecha.
+ */
+typedef enum { LCD_TRANSICION_IZQUIERDA, LCD_TRANSICION_DERECHA } LCD_TransicionSentidoTypedef;
+
+/**
+ * @brief Transición en curso.
+ */
+typedef struct {
+    char pantalla[LCD_CANTIDAD_FILAS][LCD_CANTIDAD_COLUMNAS + 1];
+    LCD_TransicionSentidoTypedef sentido;
+    uint8_t pasos;    // desplazamientos enviados
+    uint16_t periodo; // ms entre desplazamientos
+    uint32_t tickPaso;
+    bool_t enCurso;
+} LCD_TransicionTypedef;
+
+/**
+ *	@brief Carga la pantalla nueva, una línea de texto por
+ *		   fila, en las columnas que quedan fuera de la vista
+ *		   del lado por donde entra, y deja agendado el primer
+ *		   desplazamiento para dentro de un período. La
+ *		   estructura debe empezar en cero.
+ *	@retval LCD_ERROR si el LCD no está listo, el perfil no es
+ *			el del PCF8574, el modo de entrada no es
+ *			LCD_ENTRADA_INCREMENTO o ya hay una transición en curso.
+ */
+LCD_StatusTypedef LCD_transitionStart(LCD_TransicionTypedef *, LCD_TransicionSentidoTypedef,
+                                      const char *, const char *, uint16_t);
+
+/**
+ *	@brief Envía el desplazamiento agendado si ya se cumplió
+ *		   el período, sin bloquear. Luego del último deja la
+ *		   pantalla nueva en las columnas 0 a 15.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_transitionProcess(LCD_TransicionTypedef *);
+
+/**
+ *	@brief Indica si la transición sigue en curso.
+ */
+bool_t LCD_transitionBusy(const LCD_TransicionTypedef *);
+
+#endif /* API_INC_API_LCD_TRANSITION_H_ */
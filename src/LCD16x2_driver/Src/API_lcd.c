@@ -4,30 +4,72 @@
  * 		   módulo lcd.
  */
 
+#include <string.h>
+
 #include "API_lcd.h"
+#include "API_lcd_buffer.h"
+#include "API_lcd_cmd.h"
+#include "API_lcd_queue.h"
+#include "API_lcd_record.h"
 #include "API_types.h"
 
-// constantes utilizadas para controlar el LCD
-#define _4BIT_MODE      0x28
-#define DISPLAY_CONTROL (1 << 3)
-#define RETURN_HOME     (1 << 1)
-#define ENTRY_MODE      (1 << 2)
-#define AUTOINCREMENT   (1 << 1)
-#define DISPLAY_ON      (1 << 2)
-#define CLR_LCD         1
-#define COMMAND         0
-#define DATA            1
-#define ENABLE          (1 << 2)
-#define POS_BACKLIGHT   (3)
-#define SET_CURSOR      (1 << 7)
-#define CURSOR_ON       1 << 1
-#define CURSOR_BLINK    1
-
-#define NULL_CHAR       '\0' // caracter nulo
+#define NULL_CHAR '\0' // caracter nulo
+
+// largo de una línea de la DDRAM del controlador
+#define LARGO_LINEA_DDRAM 40
+
+// sin LCD_NATIVE sólo está el perfil del PCF8574
+#ifdef LCD_NATIVE
+#define PERFIL_NATIVO (perfil->nativo)
+#else
+#define PERFIL_NATIVO false
+#endif
+
+// bits que ocupa en el bus cada byte de una transacción (dato + ack)
+#define BITS_X_BYTE 9
+
+/**
+ *	@brief Perfil del controlador conectado.
+ */
+static const LCD_PerfilTypedef * perfil = &LCD_PERFIL_PCF8574;
 
 static uint8_t back_light = 1; // variable global privada para guardar el estado
                                // del backlight. 1 = encendido, 0 = apagado
 
+/**
+ *	@brief Buffer de sombra con el contenido de la pantalla
+ *		   y posición del cursor en la DDRAM (fila 0 o 1,
+ *		   columna 0 a 39), seguida a medida que se escribe.
+ */
+static LCD_BufferTypedef sombra;
+static uint8_t cursorFila = 0;
+static uint8_t cursorColumna = 0;
+static bool_t cursorVisible = false;
+static LCD_EntradaTypedef modoEntrada = LCD_ENTRADA_INCREMENTO;
+
+/**
+ *	@brief Estado de la inicialización diferida. Mientras
+ *		   inicioDiferido es true los dibujos sólo se guardan
+ *		   en el buffer de sombra.
+ */
+static bool_t inicioDiferido = false;
+#ifdef LCD_LAZY_INIT
+static LCD_InicioTypedef modoInicio = LCD_INICIO_EN_SEGUNDO_PLANO;
+static uint8_t pasoInicio = 0;
+static uint32_t tickPaso = 0;
+#endif
+
+/**
+ *	@brief Modo de energía y apagado por inactividad.
+ *		   esperaInactividad en 0 lo deshabilita.
+ */
+static LCD_EnergiaTypedef modoEnergia = LCD_ENERGIA_NORMAL;
+#ifdef LCD_POWER
+static uint32_t esperaInactividad = 0;
+static LCD_EnergiaTypedef modoInactividad = LCD_ENERGIA_BAJO_CONSUMO;
+static uint32_t ultimaActividad = 0;
+#endif
+
 /**
  *	@brief Funciones privadas para
  *		   enviar datos al LCD.
@@ -35,6 +77,48 @@ static uint8_t back_light = 1; // variable global privada para guardar el estado
 static LCD_StatusTypedef LCD_sendMsg(uint8_t, uint8_t);
 static LCD_StatusTypedef LCD_sendByte(uint8_t);
 static LCD_StatusTypedef LCD_sendNibble(uint8_t, uint8_t);
+#ifdef LCD_REATTACH
+static LCD_StatusTypedef LCD_readMsg(uint8_t, uint8_t *);
+static LCD_StatusTypedef LCD_readNibble(uint8_t, uint8_t *);
+#endif
+static LCD_StatusTypedef LCD_sendNative(uint8_t, const uint8_t *, uint8_t);
+
+/**
+ *	@brief Funciones privadas para la inicialización
+ *		   y el buffer de sombra.
+ */
+static LCD_StatusTypedef LCD_runInit();
+static uint8_t LCD_initSteps();
+static uint8_t LCD_initDelay(uint8_t);
+static LCD_StatusTypedef LCD_initStep(uint8_t);
+#ifdef LCD_LAZY_INIT
+static LCD_StatusTypedef LCD_completeInit();
+static LCD_StatusTypedef LCD_finishInit();
+static LCD_StatusTypedef LCD_flushShadow();
+#endif
+static bool_t LCD_deferDraw();
+static void LCD_resetShadow();
+static void LCD_shadowPutChar(char, bool_t);
+#ifdef LCD_REATTACH
+static LCD_StatusTypedef LCD_checkMarker();
+static LCD_StatusTypedef LCD_readShadow(uint8_t);
+#endif
+static bool_t LCD_displayIsOn();
+static void LCD_resetPower();
+
+/**
+ *	@brief Cuerpo de las funciones de la API que el driver
+ *		   también usa dentro de otras, para que sólo se
+ *		   grabe la llamada de la aplicación.
+ */
+static LCD_StatusTypedef LCD_clearDisplay();
+static LCD_StatusTypedef LCD_moveCursor(uint8_t, uint8_t);
+static LCD_StatusTypedef LCD_putChar(char);
+static LCD_StatusTypedef LCD_showCursor();
+#ifdef LCD_POWER
+static LCD_StatusTypedef LCD_applyPowerMode(LCD_EnergiaTypedef);
+#endif
+static LCD_StatusTypedef LCD_loadChar(uint8_t, const uint8_t *);
 
 /**
  *	@brief Secuencia de comandos para
@@ -49,45 +133,223 @@ static const uint8_t LCD_INIT_CMD[] = {
     CLR_LCD                       // limpia la pantalla
 };
 
+/**
+ *	@brief Nibbles que despiertan al controlador y lo pasan
+ *		   a modo 4 bits, con la espera previa a cada uno en ms.
+ */
+static const uint8_t LCD_INIT_NIBBLES[] = {0x03, 0x03, 0x02};
+static const uint8_t LCD_INIT_ESPERAS[] = {20, 10, 1};
+
+// espera en ms antes de cada comando de LCD_INIT_CMD
+#define ESPERA_INIT_CMD 1
+
+// cantidad total de pasos de la inicialización
+#define PASOS_INIT (sizeof(LCD_INIT_NIBBLES) + sizeof(LCD_INIT_CMD))
+
+#ifdef LCD_REATTACH
+/**
+ *	@brief Patrón que LCD_reattach deja en el slot
+ *		   LCD_SLOT_MARCADOR para reconocer un LCD ya
+ *		   configurado por el driver. Es poco probable
+ *		   encontrarlo en una CGRAM recién encendida.
+ */
+static const uint8_t LCD_MARCADOR[LCD_ALTO_CARACTER] = {0x15, 0x0A, 0x15, 0x0A,
+                                                       0x11, 0x0E, 0x04, 0x1B};
+
+// máscara del contador de direcciones en la lectura de estado
+#define MASCARA_DIRECCION 0x7F
+#endif
+
 /**
  *	@brief Realiza la secuencia de inicialización
  *		   del LCD.
  *	@retval Estado de ejecución.
  */
 LCD_StatusTypedef LCD_init() {
+    LCD_GRABAR(LCD_LLAMADA_INIT, NULL, NULL);
+
     bool_t estadoI2C = port_init(); // inicializa el periférico I2C
     if (estadoI2C == false)
         return LCD_ERROR;
 
-    port_delay(20);
-    if (LCD_sendNibble(0x03, COMMAND) == LCD_ERROR)
+    return LCD_runInit();
+}
+
+#ifdef LCD_REATTACH
+/**
+ *	@brief Arranque en caliente. Lee el estado del controlador
+ *		   y la marca de la CGRAM; si coinciden, sincroniza el
+ *		   buffer de sombra con la DDRAM y devuelve el cursor a
+ *		   donde estaba. Si el LCD no responde como configurado,
+ *		   realiza la inicialización completa y deja la marca.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_reattach() {
+    LCD_GRABAR(LCD_LLAMADA_REATTACH, NULL, NULL);
+
+    if (port_init() == false)
         return LCD_ERROR;
 
-    port_delay(10);
+    inicioDiferido = false;
+    LCD_resetPower(); // las tramas de la lectura encienden el backlight
+
+    if (PERFIL_NATIVO)
+        return LCD_runInit(); // los controladores nativos no se pueden leer
+
+    uint8_t estado = BUSY_FLAG;
+    if (LCD_readMsg(COMMAND, &estado) == LCD_OK && (estado & BUSY_FLAG)) {
+        port_delay(LCD_ESPERA_CLEAR); // puede estar terminando un clear previo al reset
+        LCD_readMsg(COMMAND, &estado);
+    }
+
+    // la lectura avanza según el modo de entrada, que pudo quedar cambiado
+    if (!(estado & BUSY_FLAG) &&
+        LCD_sendMsg(ENTRY_MODE | LCD_ENTRADA_INCREMENTO, COMMAND) == LCD_OK &&
+        LCD_checkMarker() == LCD_OK &&
+        LCD_readShadow(estado & MASCARA_DIRECCION) == LCD_OK)
+        return LCD_OK;
 
-    if (LCD_sendNibble(0x03, COMMAND) == LCD_ERROR)
+    if (LCD_runInit() == LCD_ERROR)
         return LCD_ERROR;
 
-    port_delay(1);
+    return LCD_loadChar(LCD_SLOT_MARCADOR, LCD_MARCADOR);
+}
+#endif /* LCD_REATTACH */
+
+#ifdef LCD_LAZY_INIT
+/**
+ *	@brief Inicializa el periférico I2C y deja pendiente
+ *		   la secuencia de inicialización del LCD, que avanza
+ *		   con LCD_process sin esperas bloqueantes. Mientras
+ *		   tanto los dibujos se guardan en el buffer de sombra
+ *		   y se envían al terminar la inicialización.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_initLazy(LCD_InicioTypedef modo) {
+    LCD_GRABAR(LCD_LLAMADA_INIT_LAZY, ((const uint8_t[]){modo}), NULL);
 
-    if (LCD_sendNibble(0x02, COMMAND) == LCD_ERROR)
+    if (port_init() == false)
         return LCD_ERROR;
 
-    for (uint8_t indice = 0; indice < sizeof(LCD_INIT_CMD); indice++) {
-        port_delay(1);
-        if (LCD_sendMsg(LCD_INIT_CMD[indice], COMMAND) == LCD_ERROR)
-            return LCD_ERROR;
+    LCD_resetShadow();
+    LCD_resetPower();
+    inicioDiferido = true;
+    modoInicio = modo;
+    pasoInicio = 0;
+    tickPaso = port_getTick();
+    return LCD_OK;
+}
+#endif /* LCD_LAZY_INIT */
+
+/**
+ *	@brief Avanza la inicialización diferida: ejecuta los
+ *		   pasos cuya espera ya se cumplió y, al terminar,
+ *		   envía el contenido del buffer de sombra.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_process() {
+    if (!inicioDiferido) {
+#ifdef LCD_POWER
+        if (esperaInactividad > 0 && modoEnergia == LCD_ENERGIA_NORMAL &&
+            port_getTick() - ultimaActividad >= esperaInactividad)
+            return LCD_applyPowerMode(modoInactividad);
+#endif
+        return LCD_OK;
     }
+
+#ifdef LCD_LAZY_INIT
+    while (pasoInicio < LCD_initSteps()) {
+        if (port_getTick() - tickPaso < LCD_initDelay(pasoInicio))
+            return LCD_OK;
+
+        if (LCD_initStep(pasoInicio) == LCD_ERROR)
+            return LCD_ERROR; // se reintenta el mismo paso en la próxima llamada
+
+        pasoInicio++;
+        tickPaso = port_getTick();
+    }
+
+    if (port_getTick() - tickPaso < LCD_ESPERA_CLEAR)
+        return LCD_OK;
+
+    return LCD_finishInit();
+#else
+    return LCD_OK;
+#endif
+}
+
+/**
+ *	@brief Indica si el LCD terminó de inicializarse.
+ */
+bool_t LCD_isReady() {
+    return !inicioDiferido;
+}
+
+/**
+ *	@brief Devuelve el buffer de sombra del driver.
+ */
+const LCD_BufferTypedef * LCD_getBuffer() {
+    return &sombra;
+}
+
+/**
+ *	@brief Selecciona el perfil del controlador y le pasa
+ *		   al port su dirección I2C.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_setProfile(const LCD_PerfilTypedef * nuevoPerfil) {
+    if (nuevoPerfil == NULL || (nuevoPerfil->nativo && nuevoPerfil->inicio == NULL))
+        return LCD_ERROR;
+
+#ifndef LCD_NATIVE
+    if (nuevoPerfil->nativo)
+        return LCD_ERROR; // sin LCD_NATIVE sólo se maneja el PCF8574
+#endif
+
+    perfil = nuevoPerfil;
+    port_setAddress(perfil->direccion);
     return LCD_OK;
 }
 
+/**
+ *	@brief Devuelve el perfil del controlador.
+ */
+const LCD_PerfilTypedef * LCD_getProfile() {
+    return perfil;
+}
+
 /**
  *	@brief Limpia la pantalla del LCD.
- *		   Para esto envía el comando CLR_LCD.
  *	@retval Estado de ejecución.
  */
 LCD_StatusTypedef LCD_clear() {
-    return LCD_sendMsg(CLR_LCD, COMMAND);
+    LCD_GRABAR(LCD_LLAMADA_CLEAR, NULL, NULL);
+    return LCD_clearDisplay();
+}
+
+/**
+ *	@brief Limpia la pantalla del LCD.
+ *		   Para esto envía el comando CLR_LCD. Con el
+ *		   PCF8574 las esperas de los flancos de E cubren
+ *		   el tiempo del comando; con un controlador nativo
+ *		   se espera lo que indica el perfil.
+ *	@retval Estado de ejecución.
+ */
+static LCD_StatusTypedef LCD_clearDisplay() {
+    bool_t diferido = LCD_deferDraw();
+    if (!diferido && LCD_sendMsg(CLR_LCD, COMMAND) == LCD_ERROR)
+        return LCD_ERROR;
+
+    if (!diferido && PERFIL_NATIVO)
+        port_delay(perfil->esperaClear);
+
+    // durante la inicialización diferida la sombra en blanco ya
+    // coincide con el display, que termina borrado
+    LCD_bufferClear(&sombra);
+    cursorFila = 0;
+    cursorColumna = 0;
+    modoEntrada |= AUTOINCREMENT; // el clear vuelve a incrementar y conserva S
+    return LCD_OK;
 }
 
 /**
@@ -95,10 +357,28 @@ LCD_StatusTypedef LCD_clear() {
  *	@retval Estado de ejecución.
  */
 LCD_StatusTypedef LCD_setCursor(uint8_t fila, uint8_t posicion) {
+    LCD_GRABAR(LCD_LLAMADA_SET_CURSOR, ((const uint8_t[]){fila, posicion}), NULL);
+    return LCD_moveCursor(fila, posicion);
+}
+
+/**
+ *	@brief Valida la posición, la envía y la registra
+ *		   como posición del cursor.
+ *	@retval Estado de ejecución.
+ */
+static LCD_StatusTypedef LCD_moveCursor(uint8_t fila, uint8_t posicion) {
     if (fila != LCD_FILA_1 && fila != LCD_FILA_2)
         return LCD_ERROR;
 
-    return LCD_sendMsg(SET_CURSOR | fila, COMMAND);
+    if (posicion >= LCD_CANTIDAD_COLUMNAS)
+        return LCD_ERROR;
+
+    if (!LCD_deferDraw() && LCD_sendMsg(SET_CURSOR | (fila + posicion), COMMAND) == LCD_ERROR)
+        return LCD_ERROR;
+
+    cursorFila = (fila == LCD_FILA_1) ? 0 : 1;
+    cursorColumna = posicion;
+    return LCD_OK;
 }
 
 /**
@@ -106,7 +386,22 @@ LCD_StatusTypedef LCD_setCursor(uint8_t fila, uint8_t posicion) {
  *	@retval Estado de ejecución.
  */
 LCD_StatusTypedef LCD_printChar(char dato) {
-    return LCD_sendMsg(dato, DATA);
+    LCD_GRABAR(LCD_LLAMADA_PRINT_CHAR, ((const uint8_t[]){dato}), NULL);
+    return LCD_putChar(dato);
+}
+
+/**
+ *	@brief Envía un caracter y lo registra en el buffer
+ *		   de sombra, o sólo lo guarda si el LCD no está listo.
+ *	@retval Estado de ejecución.
+ */
+static LCD_StatusTypedef LCD_putChar(char dato) {
+    bool_t diferido = LCD_deferDraw();
+    if (!diferido && LCD_sendMsg(dato, DATA) == LCD_ERROR)
+        return LCD_ERROR;
+
+    LCD_shadowPutChar(dato, diferido);
+    return LCD_OK;
 }
 
 /**
@@ -117,27 +412,29 @@ LCD_StatusTypedef LCD_printChar(char dato) {
  *	@retval Estado de ejecución.
  */
 LCD_StatusTypedef LCD_printText(char * ptrTexto) {
+    LCD_GRABAR(LCD_LLAMADA_PRINT_TEXT, NULL, ptrTexto);
+
     if (ptrTexto == NULL)
         return LCD_ERROR;
 
-    LCD_clear();
+    LCD_clearDisplay();
 
     uint8_t contadorPosicion = 0;
-    LCD_setCursor(LCD_FILA_1, 0);
+    LCD_moveCursor(LCD_FILA_1, 0);
     while ((*ptrTexto) != NULL_CHAR) {
         char caracter = *ptrTexto++;
         if (caracter == '\n') {
-            LCD_setCursor(LCD_FILA_2, 0);
+            LCD_moveCursor(LCD_FILA_2, 0);
             contadorPosicion = 0;
             continue;
         }
 
-        if (LCD_printChar(caracter) == LCD_ERROR)
+        if (LCD_putChar(caracter) == LCD_ERROR)
             return LCD_ERROR;
 
         contadorPosicion++;
         if (contadorPosicion == LCD_CANTIDAD_COLUMNAS)
-            LCD_setCursor(LCD_FILA_2, 0);
+            LCD_moveCursor(LCD_FILA_2, 0);
         else if (contadorPosicion == (LCD_CANTIDAD_COLUMNAS * LCD_CANTIDAD_FILAS))
             break; // CORTA EL TEXTO PERO NO DEVUELVE ERROR
     }
@@ -145,13 +442,109 @@ LCD_StatusTypedef LCD_printText(char * ptrTexto) {
     return LCD_OK;
 }
 
+/**
+ *	@brief Escribe un texto a partir de (fila, posición).
+ *		   A diferencia de LCD_printText no limpia la
+ *		   pantalla ni pasa a la fila siguiente. Con un
+ *		   controlador nativo el texto sale en una única
+ *		   transacción, con un solo byte de control, salvo
+ *		   que el bus sea demasiado rápido para el controlador.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_printAt(uint8_t fila, uint8_t posicion, const char * ptrTexto) {
+    LCD_GRABAR(LCD_LLAMADA_PRINT_AT, ((const uint8_t[]){fila, posicion}), ptrTexto);
+
+    if (ptrTexto == NULL)
+        return LCD_ERROR;
+
+    uint8_t largo = 0;
+    while (ptrTexto[largo] != NULL_CHAR && posicion + largo < LCD_CANTIDAD_COLUMNAS)
+        largo++;
+
+    // si el cursor retrocede, el texto se envía desde el último caracter
+    bool_t invertido = !(modoEntrada & AUTOINCREMENT);
+    uint8_t inicio = (invertido && largo > 0) ? posicion + largo - 1 : posicion;
+
+    if (LCD_moveCursor(fila, inicio) == LCD_ERROR)
+        return LCD_ERROR;
+
+    if (PERFIL_NATIVO && !LCD_deferDraw()) {
+        const char * bytes = ptrTexto;
+        char invertidos[LCD_CANTIDAD_COLUMNAS];
+        if (invertido) {
+            for (uint8_t indice = 0; indice < largo; indice++)
+                invertidos[indice] = ptrTexto[largo - 1 - indice];
+            bytes = invertidos;
+        }
+
+        if (largo > 0 &&
+            LCD_sendNative(LCD_CONTROL_DATO, (const uint8_t *)bytes, largo) == LCD_ERROR)
+            return LCD_ERROR;
+
+        for (uint8_t indice = 0; indice < largo; indice++)
+            LCD_shadowPutChar(bytes[indice], false);
+        return LCD_OK;
+    }
+
+    for (uint8_t indice = 0; indice < largo; indice++) {
+        if (LCD_putChar(ptrTexto[invertido ? largo - 1 - indice : indice]) == LCD_ERROR)
+            return LCD_ERROR;
+    }
+
+    return LCD_OK;
+}
+
+/**
+ *	@brief Cambia el modo de entrada. Sólo envía el
+ *		   comando si el modo cambia; durante la inicialización
+ *		   diferida se aplica al terminarla.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_setEntryMode(LCD_EntradaTypedef modo) {
+    LCD_GRABAR(LCD_LLAMADA_SET_ENTRY_MODE, ((const uint8_t[]){modo}), NULL);
+
+    if (modo > LCD_ENTRADA_INCREMENTO_DESPLAZA)
+        return LCD_ERROR;
+
+    if (modo == modoEntrada)
+        return LCD_OK;
+
+    if (!LCD_deferDraw() && LCD_sendMsg(ENTRY_MODE | modo, COMMAND) == LCD_ERROR)
+        return LCD_ERROR;
+
+    modoEntrada = modo;
+    return LCD_OK;
+}
+
+/**
+ *	@brief Devuelve el modo de entrada actual.
+ */
+LCD_EntradaTypedef LCD_getEntryMode() {
+    return modoEntrada;
+}
+
 /**
  *	@brief Muestra un cursor que parpadea en
  *		   la pantalla del LCD.
  *	@retval Estado de ejecución.
  */
 LCD_StatusTypedef LCD_cursorOn() {
-    return LCD_sendMsg(DISPLAY_CONTROL | DISPLAY_ON | CURSOR_ON | CURSOR_BLINK, COMMAND);
+    LCD_GRABAR(LCD_LLAMADA_CURSOR_ON, NULL, NULL);
+    return LCD_showCursor();
+}
+
+/**
+ *	@brief Envía el cursor visible si la pantalla está
+ *		   encendida y lo registra.
+ *	@retval Estado de ejecución.
+ */
+static LCD_StatusTypedef LCD_showCursor() {
+    if (!LCD_deferDraw() && LCD_displayIsOn() &&
+        LCD_sendMsg(DISPLAY_CONTROL | DISPLAY_ON | CURSOR_ON | CURSOR_BLINK, COMMAND) == LCD_ERROR)
+        return LCD_ERROR;
+
+    cursorVisible = true;
+    return LCD_OK;
 }
 
 /**
@@ -159,9 +552,469 @@ LCD_StatusTypedef LCD_cursorOn() {
  *	@retval Estado de ejecución.
  */
 LCD_StatusTypedef LCD_cursorOff() {
-    return LCD_sendMsg(DISPLAY_CONTROL | DISPLAY_ON, COMMAND);
+    LCD_GRABAR(LCD_LLAMADA_CURSOR_OFF, NULL, NULL);
+
+    if (!LCD_deferDraw() && LCD_displayIsOn() &&
+        LCD_sendMsg(DISPLAY_CONTROL | DISPLAY_ON, COMMAND) == LCD_ERROR)
+        return LCD_ERROR;
+
+    cursorVisible = false;
+    return LCD_OK;
+}
+
+#ifdef LCD_POWER
+/**
+ *	@brief Cambia el modo de energía.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_setPowerMode(LCD_EnergiaTypedef modo) {
+    LCD_GRABAR(LCD_LLAMADA_SET_POWER_MODE, ((const uint8_t[]){modo}), NULL);
+    return LCD_applyPowerMode(modo);
+}
+
+/**
+ *	@brief Cambia el modo de energía enviando sólo lo que
+ *		   cambia. Al encender la pantalla se restituye
+ *		   también el estado del cursor, y al volver al modo
+ *		   normal se reinicia el tiempo de inactividad.
+ *	@retval Estado de ejecución.
+ */
+static LCD_StatusTypedef LCD_applyPowerMode(LCD_EnergiaTypedef modo) {
+    if (inicioDiferido || modo > LCD_ENERGIA_BAJO_CONSUMO)
+        return LCD_ERROR;
+
+    bool_t pantallaAntes = LCD_displayIsOn();
+    bool_t pantalla = (modo == LCD_ENERGIA_NORMAL || modo == LCD_ENERGIA_BACKLIGHT_APAGADO);
+    uint8_t luz = (modo == LCD_ENERGIA_NORMAL || modo == LCD_ENERGIA_PANTALLA_APAGADA) ? 1 : 0;
+
+    if (pantalla != pantallaAntes) {
+        uint8_t control = DISPLAY_CONTROL;
+        if (pantalla)
+            control |= DISPLAY_ON | (cursorVisible ? (CURSOR_ON | CURSOR_BLINK) : 0);
+
+        if (LCD_sendMsg(control, COMMAND) == LCD_ERROR)
+            return LCD_ERROR;
+    }
+
+    if (luz != back_light) {
+        back_light = luz;
+        // sin E, sólo cambia el backlight; los controladores nativos no lo manejan
+        if (!PERFIL_NATIVO && !port_i2cWriteByte(back_light << POS_BACKLIGHT))
+            return LCD_ERROR;
+    }
+
+    // al volver al modo normal se empieza a contar de nuevo la inactividad
+    if (modo == LCD_ENERGIA_NORMAL && modoEnergia != LCD_ENERGIA_NORMAL && esperaInactividad > 0)
+        ultimaActividad = port_getTick();
+
+    modoEnergia = modo;
+    return LCD_OK;
+}
+
+/**
+ *	@brief Devuelve el modo de energía actual.
+ */
+LCD_EnergiaTypedef LCD_getPowerMode() {
+    return modoEnergia;
+}
+
+/**
+ *	@brief Configura el apagado por inactividad.
+ */
+void LCD_setIdleTimeout(uint32_t espera, LCD_EnergiaTypedef modo) {
+    LCD_GRABAR(LCD_LLAMADA_SET_IDLE_TIMEOUT,
+               ((const uint8_t[]){espera, espera >> 8, espera >> 16, espera >> 24, modo}), NULL);
+
+    esperaInactividad = espera;
+    modoInactividad = modo;
+    if (espera > 0)
+        ultimaActividad = port_getTick();
 }
 
+/**
+ *	@brief Reinicia el tiempo de inactividad y despierta
+ *		   la pantalla si estaba en bajo consumo.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_notifyActivity() {
+    LCD_GRABAR(LCD_LLAMADA_NOTIFY_ACTIVITY, NULL, NULL);
+
+    if (esperaInactividad > 0)
+        ultimaActividad = port_getTick();
+
+    if (modoEnergia == LCD_ENERGIA_NORMAL)
+        return LCD_OK;
+
+    return LCD_applyPowerMode(LCD_ENERGIA_NORMAL);
+}
+#endif /* LCD_POWER */
+
+/**
+ *	@brief Carga un caracter en la CGRAM.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_createChar(uint8_t posicion, const uint8_t * patron) {
+#ifdef LCD_RECORDER
+    uint8_t argumentos[LCD_GRABACION_MAX_ARGUMENTOS] = {posicion};
+    if (patron != NULL)
+        memcpy(&argumentos[1], patron, LCD_ALTO_CARACTER);
+    LCD_GRABAR(LCD_LLAMADA_CREATE_CHAR, argumentos, NULL);
+#endif
+
+    return LCD_loadChar(posicion, patron);
+}
+
+/**
+ *	@brief Carga un caracter en la CGRAM. Luego de
+ *		   escribir el patrón vuelve a direccionar la
+ *		   DDRAM, dejando el cursor en FILA 1 y posición 0,
+ *		   para que los siguientes datos se muestren en pantalla.
+ *		   Si el cursor retrocede, el patrón se escribe desde
+ *		   la última fila. Si la inicialización diferida no
+ *		   terminó, se completa antes de cargar el caracter.
+ *	@retval Estado de ejecución.
+ */
+static LCD_StatusTypedef LCD_loadChar(uint8_t posicion, const uint8_t * patron) {
+    if (patron == NULL || posicion >= LCD_CANTIDAD_CARACTERES_CGRAM)
+        return LCD_ERROR;
+
+#ifdef LCD_LAZY_INIT
+    if (inicioDiferido && LCD_completeInit() == LCD_ERROR)
+        return LCD_ERROR;
+#endif
+
+    // la dirección de la CGRAM también avanza según el modo de entrada
+    uint8_t ultima = (modoEntrada & AUTOINCREMENT) ? 0 : LCD_ALTO_CARACTER - 1;
+    if (LCD_sendMsg(SET_CGRAM | (posicion << 3) | ultima, COMMAND) == LCD_ERROR)
+        return LCD_ERROR;
+
+    for (uint8_t fila = 0; fila < LCD_ALTO_CARACTER; fila++) {
+        if (LCD_sendMsg(patron[fila ^ ultima] & 0x1F, DATA) == LCD_ERROR)
+            return LCD_ERROR;
+    }
+
+    if (LCD_sendMsg(SET_CURSOR | LCD_FILA_1, COMMAND) == LCD_ERROR)
+        return LCD_ERROR;
+
+    cursorFila = 0;
+    cursorColumna = 0;
+    return LCD_OK;
+}
+
+/**
+ *	@brief Reúne las estadísticas de la cola
+ *		   y del pool de memoria.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_getStats(LCD_StatsTypedef * stats) {
+    if (stats == NULL)
+        return LCD_ERROR;
+
+#ifdef LCD_QUEUE
+    LCD_poolGetStats(&stats->pool);
+    LCD_queueGetStats(&stats->cola);
+#else
+    memset(stats, 0, sizeof(*stats)); // sin cola ni pool no hay nada que contar
+#endif
+    return LCD_OK;
+}
+
+/**
+ *	@brief Codifica un mensaje en las tramas que
+ *		   LCD_sendMsg escribe en el PCF8574: nibble alto
+ *		   con ENABLE, nibble alto sin ENABLE y lo mismo
+ *		   para el nibble bajo.
+ */
+void LCD_encodeMsg(uint8_t dato, uint8_t rs, uint8_t * tramas) {
+    uint8_t alto = rs | (back_light << POS_BACKLIGHT) | (dato & 0xF0);
+    uint8_t bajo = rs | (back_light << POS_BACKLIGHT) | (dato & 0x0F) << 4;
+
+    tramas[0] = alto | ENABLE;
+    tramas[1] = alto;
+    tramas[2] = bajo | ENABLE;
+    tramas[3] = bajo;
+}
+
+/**
+ *	@brief Registra en el buffer de sombra y en el cursor un
+ *		   mensaje que se transmitió por fuera del driver. Los
+ *		   datos se escriben como ya enviados; de los comandos
+ *		   sólo se siguen el borrado y el posicionamiento del
+ *		   cursor, que son los que cambian la DDRAM o la dirección.
+ */
+void LCD_trackMsg(uint8_t dato, uint8_t rs) {
+    if (rs == DATA) {
+        LCD_shadowPutChar(dato, false);
+    } else if (dato == CLR_LCD) {
+        LCD_bufferClear(&sombra);
+        cursorFila = 0;
+        cursorColumna = 0;
+        modoEntrada |= AUTOINCREMENT;
+    } else if (dato & SET_CURSOR) {
+        cursorFila = (dato & LCD_FILA_2) ? 1 : 0;
+        cursorColumna = dato & ~(SET_CURSOR | LCD_FILA_2);
+    }
+}
+
+/**
+ *	@brief Ejecuta de forma bloqueante todos los pasos de
+ *		   la inicialización, con el I2C ya inicializado.
+ *	@retval Estado de ejecución.
+ */
+static LCD_StatusTypedef LCD_runInit() {
+    inicioDiferido = false;
+    LCD_resetPower();
+    for (uint8_t paso = 0; paso < LCD_initSteps(); paso++) {
+        if (LCD_initDelay(paso) > 0)
+            port_delay(LCD_initDelay(paso));
+        if (LCD_initStep(paso) == LCD_ERROR)
+            return LCD_ERROR;
+    }
+
+    LCD_resetShadow();
+    return LCD_OK;
+}
+
+/**
+ *	@brief Cantidad de pasos de la inicialización según el perfil.
+ */
+static uint8_t LCD_initSteps() {
+    if (PERFIL_NATIVO)
+        return perfil->pasosInicio;
+
+    return PASOS_INIT;
+}
+
+/**
+ *	@brief Espera en ms previa a un paso de la inicialización.
+ *		   En un perfil nativo es la que pide el paso anterior.
+ */
+static uint8_t LCD_initDelay(uint8_t paso) {
+    if (PERFIL_NATIVO)
+        return (paso == 0) ? perfil->esperaEncendido : perfil->inicio[paso - 1].espera;
+
+    if (paso < sizeof(LCD_INIT_NIBBLES))
+        return LCD_INIT_ESPERAS[paso];
+
+    return ESPERA_INIT_CMD;
+}
+
+/**
+ *	@brief Envía un paso de la inicialización: primero los
+ *		   nibbles sueltos y luego los comandos de LCD_INIT_CMD,
+ *		   o el comando del paso en un perfil nativo.
+ *	@retval Estado de ejecución.
+ */
+static LCD_StatusTypedef LCD_initStep(uint8_t paso) {
+    if (PERFIL_NATIVO)
+        return LCD_sendMsg(perfil->inicio[paso].comando, COMMAND);
+
+    if (paso < sizeof(LCD_INIT_NIBBLES))
+        return LCD_sendNibble(LCD_INIT_NIBBLES[paso], COMMAND);
+
+    return LCD_sendMsg(LCD_INIT_CMD[paso - sizeof(LCD_INIT_NIBBLES)], COMMAND);
+}
+
+#ifdef LCD_LAZY_INIT
+/**
+ *	@brief Completa de forma bloqueante los pasos de la
+ *		   inicialización diferida que faltan.
+ *	@retval Estado de ejecución.
+ */
+static LCD_StatusTypedef LCD_completeInit() {
+    for (; pasoInicio < LCD_initSteps(); pasoInicio++) {
+        if (LCD_initDelay(pasoInicio) > 0)
+            port_delay(LCD_initDelay(pasoInicio));
+        if (LCD_initStep(pasoInicio) == LCD_ERROR)
+            return LCD_ERROR;
+    }
+
+    port_delay(LCD_ESPERA_CLEAR);
+    return LCD_finishInit();
+}
+
+/**
+ *	@brief Termina la inicialización diferida enviando lo
+ *		   que se dibujó mientras tanto y el estado del cursor.
+ *	@retval Estado de ejecución.
+ */
+static LCD_StatusTypedef LCD_finishInit() {
+    inicioDiferido = false;
+
+    if (LCD_flushShadow() == LCD_ERROR)
+        return LCD_ERROR;
+
+    // la secuencia deja el cursor avanzando; el modo elegido se aplica al final
+    if (modoEntrada != LCD_ENTRADA_INCREMENTO &&
+        LCD_sendMsg(ENTRY_MODE | modoEntrada, COMMAND) == LCD_ERROR)
+        return LCD_ERROR;
+
+    if (cursorVisible)
+        return LCD_showCursor();
+
+    return LCD_OK;
+}
+#endif /* LCD_LAZY_INIT */
+
+/**
+ *	@brief Decide si un dibujo sólo debe guardarse en el
+ *		   buffer de sombra. En el modo LCD_INICIO_EN_PRIMER_DIBUJO
+ *		   completa la inicialización y el dibujo se envía.
+ *	@retval true si el LCD todavía no está listo.
+ */
+static bool_t LCD_deferDraw() {
+#ifdef LCD_LAZY_INIT
+    if (!inicioDiferido)
+        return false;
+
+    if (modoInicio == LCD_INICIO_EN_PRIMER_DIBUJO) {
+        LCD_completeInit();
+        return inicioDiferido;
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ *	@brief Indica si la pantalla está encendida según
+ *		   el modo de energía.
+ */
+static bool_t LCD_displayIsOn() {
+    return modoEnergia == LCD_ENERGIA_NORMAL || modoEnergia == LCD_ENERGIA_BACKLIGHT_APAGADO;
+}
+
+/**
+ *	@brief Vuelve al modo de energía en que queda el LCD
+ *		   luego de inicializarlo.
+ */
+static void LCD_resetPower() {
+    modoEnergia = LCD_ENERGIA_NORMAL;
+    back_light = 1;
+}
+
+/**
+ *	@brief Deja el buffer de sombra y el cursor como
+ *		   quedan luego de inicializar el LCD.
+ */
+static void LCD_resetShadow() {
+    LCD_bufferInit(&sombra, LCD_CANTIDAD_FILAS, LCD_CANTIDAD_COLUMNAS);
+    cursorFila = 0;
+    cursorColumna = 0;
+    cursorVisible = false;
+    modoEntrada = LCD_ENTRADA_INCREMENTO;
+}
+
+/**
+ *	@brief Registra un caracter en la posición del cursor
+ *		   y lo mueve como lo hace el controlador según el
+ *		   modo de entrada: al pasar un extremo de una línea
+ *		   de la DDRAM sigue en el extremo opuesto de la otra.
+ *		   El desplazamiento de la pantalla no cambia las
+ *		   direcciones, así que no afecta a la sombra.
+ */
+static void LCD_shadowPutChar(char dato, bool_t diferido) {
+    if (diferido)
+        LCD_bufferWrite(&sombra, cursorFila, cursorColumna, dato);
+    else
+        LCD_bufferSync(&sombra, cursorFila, cursorColumna, dato);
+
+    if (modoEntrada & AUTOINCREMENT) {
+        if (++cursorColumna < LARGO_LINEA_DDRAM)
+            return;
+        cursorColumna = 0;
+    } else {
+        if (cursorColumna-- > 0)
+            return;
+        cursorColumna = LARGO_LINEA_DDRAM - 1;
+    }
+
+    cursorFila = (cursorFila + 1) % LCD_CANTIDAD_FILAS;
+}
+
+#ifdef LCD_LAZY_INIT
+/**
+ *	@brief Envía los tramos de celdas sucias del buffer de
+ *		   sombra y vuelve a dejar el cursor donde estaba.
+ *	@retval Estado de ejecución.
+ */
+static LCD_StatusTypedef LCD_flushShadow() {
+    static const uint8_t inicioFila[] = {LCD_FILA_1, LCD_FILA_2};
+    bool_t huboEnvios = false;
+
+    for (uint8_t fila = 0; fila < LCD_CANTIDAD_FILAS; fila++) {
+        uint8_t inicio = 0;
+        uint8_t largo = 0;
+
+        while (LCD_bufferNextDirtyRun(&sombra, fila, inicio + largo, &inicio, &largo)) {
+            if (LCD_sendMsg(SET_CURSOR | (inicioFila[fila] + inicio), COMMAND) == LCD_ERROR)
+                return LCD_ERROR;
+
+            for (uint8_t columna = inicio; columna < inicio + largo; columna++) {
+                if (LCD_sendMsg(LCD_bufferGet(&sombra, fila, columna), DATA) == LCD_ERROR)
+                    return LCD_ERROR;
+            }
+            LCD_bufferMarkClean(&sombra, fila, inicio, largo);
+            huboEnvios = true;
+        }
+    }
+
+    if (!huboEnvios && cursorFila == 0 && cursorColumna == 0)
+        return LCD_OK;
+
+    return LCD_sendMsg(SET_CURSOR | (inicioFila[cursorFila] + cursorColumna), COMMAND);
+}
+#endif /* LCD_LAZY_INIT */
+
+#ifdef LCD_REATTACH
+/**
+ *	@brief Compara el slot LCD_SLOT_MARCADOR de la CGRAM
+ *		   con el patrón de LCD_MARCADOR.
+ *	@retval LCD_OK si la marca está presente.
+ */
+static LCD_StatusTypedef LCD_checkMarker() {
+    if (LCD_sendMsg(SET_CGRAM | (LCD_SLOT_MARCADOR << 3), COMMAND) == LCD_ERROR)
+        return LCD_ERROR;
+
+    for (uint8_t fila = 0; fila < LCD_ALTO_CARACTER; fila++) {
+        uint8_t valor;
+        if (LCD_readMsg(DATA, &valor) == LCD_ERROR || (valor & 0x1F) != LCD_MARCADOR[fila])
+            return LCD_ERROR;
+    }
+
+    return LCD_OK;
+}
+
+/**
+ *	@brief Carga el buffer de sombra con el contenido visible
+ *		   de la DDRAM y vuelve a poner el cursor en la
+ *		   dirección leída antes de la sincronización.
+ *	@retval Estado de ejecución.
+ */
+static LCD_StatusTypedef LCD_readShadow(uint8_t direccion) {
+    static const uint8_t inicioFila[] = {LCD_FILA_1, LCD_FILA_2};
+
+    LCD_resetShadow();
+    for (uint8_t fila = 0; fila < LCD_CANTIDAD_FILAS; fila++) {
+        if (LCD_sendMsg(SET_CURSOR | inicioFila[fila], COMMAND) == LCD_ERROR)
+            return LCD_ERROR;
+
+        for (uint8_t columna = 0; columna < LCD_CANTIDAD_COLUMNAS; columna++) {
+            uint8_t caracter;
+            if (LCD_readMsg(DATA, &caracter) == LCD_ERROR)
+                return LCD_ERROR;
+            LCD_bufferSync(&sombra, fila, columna, caracter);
+        }
+    }
+
+    cursorFila = (direccion >= LCD_FILA_2) ? 1 : 0;
+    cursorColumna = (direccion - inicioFila[cursorFila]) % LARGO_LINEA_DDRAM;
+    return LCD_sendMsg(SET_CURSOR | (inicioFila[cursorFila] + cursorColumna), COMMAND);
+}
+#endif /* LCD_REATTACH */
+
 /**
  *	@brief Envía un mensaje al LCD, que puede
  *		   ser un comando (rs=0) o un dato (rs=1).
@@ -173,6 +1026,9 @@ LCD_StatusTypedef LCD_cursorOff() {
  *	@retval Estado de ejecución.
  */
 static LCD_StatusTypedef LCD_sendMsg(uint8_t dato, uint8_t rs) {
+    if (PERFIL_NATIVO)
+        return LCD_sendNative((rs == DATA) ? LCD_CONTROL_DATO : LCD_CONTROL_COMANDO, &dato, 1);
+
     if (LCD_sendByte(rs | (back_light << POS_BACKLIGHT) | (dato & 0xF0)) == LCD_ERROR)
         return LCD_ERROR;
 
@@ -182,6 +1038,37 @@ static LCD_StatusTypedef LCD_sendMsg(uint8_t dato, uint8_t rs) {
     return LCD_OK;
 }
 
+/**
+ *	@brief Envía a un controlador nativo una transacción con
+ *		   el byte de control seguido por los bytes completos,
+ *		   como mucho una fila. Si a la velocidad del bus un
+ *		   byte dura menos que una instrucción, cada byte sale
+ *		   en su propia transacción: el inicio, la dirección y
+ *		   el control dan al controlador el tiempo que le falta.
+ *	@retval Estado de ejecución.
+ */
+static LCD_StatusTypedef LCD_sendNative(uint8_t control, const uint8_t * bytes, uint8_t cantidad) {
+    if (cantidad > 1 &&
+        BITS_X_BYTE * 1000000UL / port_getClockSpeed() < perfil->tiempoInstruccion) {
+        for (uint8_t indice = 0; indice < cantidad; indice++) {
+            if (LCD_sendNative(control, &bytes[indice], 1) == LCD_ERROR)
+                return LCD_ERROR;
+        }
+        return LCD_OK;
+    }
+
+    uint8_t transaccion[1 + LCD_CANTIDAD_COLUMNAS];
+
+    transaccion[0] = control;
+    for (uint8_t indice = 0; indice < cantidad; indice++)
+        transaccion[1 + indice] = bytes[indice];
+
+    if (!port_i2cWrite(transaccion, 1 + cantidad))
+        return LCD_ERROR;
+
+    return LCD_OK;
+}
+
 /**
  * @brief Envía los 4 bits menos significativos de dato,
  * 		  junto con los bits de rs, backlight.
@@ -191,6 +1078,49 @@ static LCD_StatusTypedef LCD_sendNibble(uint8_t dato, uint8_t rs) {
     return LCD_sendByte(rs | (back_light << POS_BACKLIGHT) | (dato & 0x0F) << 4);
 }
 
+#ifdef LCD_REATTACH
+/**
+ *	@brief Lee un byte del LCD en dos nibbles, primero el
+ *		   alto. Con rs en COMMAND se obtiene el busy flag
+ *		   y el contador de direcciones; con DATA, el dato de
+ *		   la dirección actual, que luego se incrementa.
+ *	@retval Estado de ejecución.
+ */
+static LCD_StatusTypedef LCD_readMsg(uint8_t rs, uint8_t * dato) {
+    uint8_t alto;
+    uint8_t bajo;
+
+    if (LCD_readNibble(rs, &alto) == LCD_ERROR || LCD_readNibble(rs, &bajo) == LCD_ERROR)
+        return LCD_ERROR;
+
+    *dato = (alto & 0xF0) | (bajo >> 4);
+    return LCD_OK;
+}
+
+/**
+ *	@brief Lee un nibble: deja D4-D7 en 1 para que el LCD
+ *		   pueda manejarlos, sube E con RW en alto, lee los
+ *		   pines del expansor y baja E. No hacen falta esperas
+ *		   porque cada byte I2C dura más que el tiempo de
+ *		   acceso del controlador.
+ *	@retval Estado de ejecución.
+ */
+static LCD_StatusTypedef LCD_readNibble(uint8_t rs, uint8_t * pines) {
+    uint8_t _byte = rs | READ | (back_light << POS_BACKLIGHT) | 0xF0;
+
+    if (!port_i2cWriteByte(_byte | ENABLE))
+        return LCD_ERROR;
+
+    if (!port_i2cReadByte(pines))
+        return LCD_ERROR;
+
+    if (!port_i2cWriteByte(_byte))
+        return LCD_ERROR;
+
+    return LCD_OK;
+}
+#endif /* LCD_REATTACH */
+
 /**
  *	@brief Envía un byte al LCD.
  *		   El envío consiste en envíar
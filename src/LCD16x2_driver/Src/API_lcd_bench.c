@@ -0,0 +1,171 @@
+/**
+ * @file API_lcd_bench.c
+ * @brief Implementación de la medición del port en ciclos.
+ */
+
+#include "API_lcd_bench.h"
+#include "API_lcd_cmd.h"
+#include "API_types.h"
+
+// bits de una transacción I2C de escritura
+#define BITS_INICIO 10 // start + dirección + ack
+#define BITS_BYTE   9  // dato + ack
+#define BITS_FIN    1  // stop
+
+static uint8_t lote[LCD_BENCH_MAX_TRAMAS];
+
+static void LCD_benchCycleCounter();
+static uint32_t LCD_benchBusCycles(uint32_t);
+
+#ifdef LCD_STREAM // el diff sólo se compila con los envíos por cuadros
+// celdas que cambian en cada fila entre un cuadro y el siguiente
+#define CAMBIOS_X_FILA 4
+
+static LCD_BufferTypedef sombras[LCD_BENCH_MAX_PANTALLAS];
+static LCD_BufferTypedef cuadros[LCD_BENCH_MAX_PANTALLAS];
+static LCD_TramoTypedef tramos[LCD_BENCH_MAX_PANTALLAS * LCD_BUFFER_MAX_FILAS * CAMBIOS_X_FILA];
+
+static uint32_t LCD_benchCellsPerUs(uint32_t, uint32_t);
+static void LCD_benchNextFrame(uint8_t, char);
+#endif
+
+/**
+ *	@brief Habilita el contador de ciclos y mide los dos
+ *		   caminos de escritura del port.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_benchPort(uint16_t cantidad, LCD_BenchTypedef * resultado) {
+    if (resultado == NULL || cantidad == 0 || cantidad > LCD_BENCH_MAX_TRAMAS)
+        return LCD_ERROR;
+
+    LCD_benchCycleCounter();
+
+    // la segunda trama de un comando nulo no tiene flanco de E y sólo
+    // lleva el estado actual del backlight, así que no lo cambia
+    uint8_t tramas[LCD_TRAMAS_X_MENSAJE];
+    LCD_encodeMsg(0, COMMAND, tramas);
+    uint8_t inocua = tramas[1];
+
+    resultado->errores = 0;
+
+    uint32_t inicio = DWT->CYCCNT;
+    for (uint16_t indice = 0; indice < cantidad; indice++) {
+        if (!port_i2cWriteByte(inocua))
+            resultado->errores++;
+    }
+    resultado->ciclosPorTrama = (DWT->CYCCNT - inicio) / cantidad;
+
+    for (uint16_t indice = 0; indice < cantidad; indice++)
+        lote[indice] = inocua;
+
+    inicio = DWT->CYCCNT;
+    if (!port_i2cWrite(lote, cantidad))
+        resultado->errores++;
+    resultado->ciclosPorTramaLote = (DWT->CYCCNT - inicio) / cantidad;
+
+    resultado->ciclosBusPorTrama = LCD_benchBusCycles(BITS_INICIO + BITS_BYTE + BITS_FIN);
+    resultado->ciclosBusPorTramaLote =
+        LCD_benchBusCycles(BITS_INICIO + BITS_BYTE * cantidad + BITS_FIN) / cantidad;
+
+    return (resultado->errores == 0) ? LCD_OK : LCD_ERROR;
+}
+
+/**
+ *	@brief Mide dos cuadros distintos: el primero con el diff
+ *		   por palabras y la lista de tramos, el segundo
+ *		   escribiendo cada celda en la sombra y recorriendo
+ *		   los tramos fila por fila.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_benchDiff(uint8_t pantallas, LCD_BenchDiffTypedef * resultado) {
+#ifndef LCD_STREAM
+    return LCD_ERROR;
+#else
+    if (resultado == NULL || pantallas == 0 || pantallas > LCD_BENCH_MAX_PANTALLAS)
+        return LCD_ERROR;
+
+    for (uint8_t pantalla = 0; pantalla < pantallas; pantalla++) {
+        LCD_bufferInit(&sombras[pantalla], LCD_BUFFER_MAX_FILAS, LCD_BUFFER_MAX_COLUMNAS);
+        LCD_bufferInit(&cuadros[pantalla], LCD_BUFFER_MAX_FILAS, LCD_BUFFER_MAX_COLUMNAS);
+    }
+
+    LCD_benchCycleCounter();
+
+    resultado->celdas = (uint32_t)pantallas * LCD_BUFFER_MAX_FILAS * LCD_BUFFER_MAX_COLUMNAS;
+    resultado->tramos = 0;
+
+    LCD_benchNextFrame(pantallas, 'a');
+    uint32_t inicio = DWT->CYCCNT;
+    for (uint8_t pantalla = 0; pantalla < pantallas; pantalla++) {
+        LCD_bufferDiff(&sombras[pantalla], &cuadros[pantalla]);
+        resultado->tramos += LCD_bufferDirtyRuns(&sombras[pantalla], &tramos[resultado->tramos],
+                                                 LCD_BUFFER_MAX_FILAS * CAMBIOS_X_FILA);
+    }
+    resultado->ciclosDiff = DWT->CYCCNT - inicio;
+
+    LCD_benchNextFrame(pantallas, 'b');
+    inicio = DWT->CYCCNT;
+    for (uint8_t pantalla = 0; pantalla < pantallas; pantalla++) {
+        for (uint8_t fila = 0; fila < LCD_BUFFER_MAX_FILAS; fila++) {
+            for (uint8_t columna = 0; columna < LCD_BUFFER_MAX_COLUMNAS; columna++)
+                LCD_bufferWrite(&sombras[pantalla], fila, columna,
+                                LCD_bufferGet(&cuadros[pantalla], fila, columna));
+
+            uint8_t desde = 0;
+            uint8_t largo = 0;
+            while (LCD_bufferNextDirtyRun(&sombras[pantalla], fila, desde, &desde, &largo))
+                desde += largo;
+        }
+    }
+    resultado->ciclosPorCelda = DWT->CYCCNT - inicio;
+
+    resultado->celdasPorUsDiff = LCD_benchCellsPerUs(resultado->celdas, resultado->ciclosDiff);
+    resultado->celdasPorUsPorCelda =
+        LCD_benchCellsPerUs(resultado->celdas, resultado->ciclosPorCelda);
+
+    return LCD_OK;
+#endif
+}
+
+/**
+ *	@brief Habilita el contador de ciclos del DWT y lo pone en cero.
+ */
+static void LCD_benchCycleCounter() {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+#ifdef LCD_STREAM
+/**
+ *	@brief Prepara el próximo cuadro de cada display: cambia
+ *		   CAMBIOS_X_FILA celdas seguidas de cada fila, en una
+ *		   columna distinta para cada display y cada fila.
+ */
+static void LCD_benchNextFrame(uint8_t pantallas, char caracter) {
+    for (uint8_t pantalla = 0; pantalla < pantallas; pantalla++) {
+        for (uint8_t fila = 0; fila < LCD_BUFFER_MAX_FILAS; fila++) {
+            uint8_t desde = (pantalla + fila * 3) % (LCD_BUFFER_MAX_COLUMNAS - CAMBIOS_X_FILA);
+            for (uint8_t cambio = 0; cambio < CAMBIOS_X_FILA; cambio++)
+                cuadros[pantalla].celdas[fila][desde + cambio] = caracter;
+        }
+    }
+}
+
+/**
+ *	@brief Celdas por microsegundo a la frecuencia del núcleo.
+ */
+static uint32_t LCD_benchCellsPerUs(uint32_t celdas, uint32_t ciclos) {
+    if (ciclos == 0)
+        return 0;
+    return (uint32_t)(((uint64_t)celdas * (SystemCoreClock / 1000000)) / ciclos);
+}
+#endif /* LCD_STREAM */
+
+/**
+ *	@brief Convierte una cantidad de bits del bus en
+ *		   ciclos de CPU.
+ */
+static uint32_t LCD_benchBusCycles(uint32_t bits) {
+    return (uint32_t)(((uint64_t)bits * SystemCoreClock) / port_getClockSpeed());
+}
@@ -0,0 +1,265 @@
+/**
+ * @file API_lcd_buffer.c
+ * @brief Implementación del buffer de sombra del LCD.
+ */
+
+#include <string.h>
+
+#include "API_lcd_buffer.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define CARACTER_BLANCO ' '
+
+/**
+ *	@brief Palabra del diff: la del procesador. JUNTAR_BITS
+ *		   lleva el bit 0 de cada byte a bits consecutivos a
+ *		   partir de DESPLAZAR_BITS al multiplicar, sin que
+ *		   los productos cruzados se superpongan.
+ */
+#if UINTPTR_MAX > 0xFFFFFFFFu
+typedef uint64_t LCD_PalabraTypedef;
+#define JUNTAR_BITS     0x0002040810204081ULL
+#define DESPLAZAR_BITS  49
+#else
+typedef uint32_t LCD_PalabraTypedef;
+#define JUNTAR_BITS     0x00204081UL
+#define DESPLAZAR_BITS  21
+#endif
+
+#define BYTES_PALABRA   sizeof(LCD_PalabraTypedef)
+#define BYTES_REPETIDOS(byte) ((LCD_PalabraTypedef)-1 / 0xFF * (byte))
+
+// largo de los bloques de la comparación con SSE2
+#define BYTES_SSE2 16
+
+#ifdef LCD_STREAM
+static uint8_t LCD_bufferChangedBytes(LCD_PalabraTypedef, LCD_PalabraTypedef);
+static uint64_t LCD_bufferDiffRow(const char *, const char *, uint8_t);
+#endif
+static uint8_t LCD_bufferRunLength(uint64_t);
+
+/**
+ *	@brief Máscara con un bit en 1 por cada columna de la fila.
+ */
+static uint64_t LCD_bufferRowMask(const LCD_BufferTypedef * buffer) {
+    return (buffer->columnas >= 64) ? UINT64_MAX : ((1ULL << buffer->columnas) - 1);
+}
+
+/**
+ *	@brief Inicializa el buffer en blanco y limpio.
+ */
+void LCD_bufferInit(LCD_BufferTypedef * buffer, uint8_t filas, uint8_t columnas) {
+    buffer->filas = (filas > LCD_BUFFER_MAX_FILAS) ? LCD_BUFFER_MAX_FILAS : filas;
+    buffer->columnas = (columnas > LCD_BUFFER_MAX_COLUMNAS) ? LCD_BUFFER_MAX_COLUMNAS : columnas;
+    LCD_bufferClear(buffer);
+}
+
+/**
+ *	@brief Deja el buffer en blanco y limpio.
+ */
+void LCD_bufferClear(LCD_BufferTypedef * buffer) {
+    memset(buffer->celdas, CARACTER_BLANCO, sizeof(buffer->celdas));
+    memset(buffer->sucias, 0, sizeof(buffer->sucias));
+}
+
+/**
+ *	@brief Escribe un caracter y, si cambió, marca la celda sucia.
+ *		   Las posiciones fuera de la geometría se ignoran.
+ */
+void LCD_bufferWrite(LCD_BufferTypedef * buffer, uint8_t fila, uint8_t columna, char caracter) {
+    if (fila >= buffer->filas || columna >= buffer->columnas)
+        return;
+
+    if (buffer->celdas[fila][columna] != caracter) {
+        buffer->celdas[fila][columna] = caracter;
+        buffer->sucias[fila] |= 1ULL << columna;
+    }
+}
+
+/**
+ *	@brief Registra un caracter ya enviado y limpia la celda.
+ */
+void LCD_bufferSync(LCD_BufferTypedef * buffer, uint8_t fila, uint8_t columna, char caracter) {
+    if (fila >= buffer->filas || columna >= buffer->columnas)
+        return;
+
+    buffer->celdas[fila][columna] = caracter;
+    buffer->sucias[fila] &= ~(1ULL << columna);
+}
+
+/**
+ *	@brief Devuelve el caracter de una celda, o un blanco
+ *		   si la posición está fuera de la geometría.
+ */
+char LCD_bufferGet(const LCD_BufferTypedef * buffer, uint8_t fila, uint8_t columna) {
+    if (fila >= buffer->filas || columna >= buffer->columnas)
+        return CARACTER_BLANCO;
+
+    return buffer->celdas[fila][columna];
+}
+
+/**
+ *	@brief Marca como limpio un tramo de celdas de una fila.
+ */
+void LCD_bufferMarkClean(LCD_BufferTypedef * buffer, uint8_t fila, uint8_t columna,
+                         uint8_t largo) {
+    if (fila >= buffer->filas || columna >= buffer->columnas)
+        return;
+
+    uint64_t mascara = (largo >= 64) ? UINT64_MAX : ((1ULL << largo) - 1);
+    buffer->sucias[fila] &= ~(mascara << columna);
+}
+
+/**
+ *	@brief Marca como sucias todas las celdas.
+ */
+void LCD_bufferMarkAllDirty(LCD_BufferTypedef * buffer) {
+    for (uint8_t fila = 0; fila < buffer->filas; fila++)
+        buffer->sucias[fila] = LCD_bufferRowMask(buffer);
+}
+
+/**
+ *	@brief Busca en el mapa de la fila, desde la columna
+ *		   indicada, el primer bit en 1 y el largo del tramo,
+ *		   contando ceros finales en lugar de recorrer bit a bit.
+ *	@retval true si se encontró un tramo.
+ */
+bool LCD_bufferNextDirtyRun(const LCD_BufferTypedef * buffer, uint8_t fila, uint8_t desde,
+                            uint8_t * inicio, uint8_t * largo) {
+    if (fila >= buffer->filas || desde >= buffer->columnas)
+        return false;
+
+    uint64_t resto = buffer->sucias[fila] >> desde;
+    if (resto == 0)
+        return false;
+
+    *inicio = desde + __builtin_ctzll(resto);
+    *largo = LCD_bufferRunLength(buffer->sucias[fila] >> *inicio);
+    return true;
+}
+
+/**
+ *	@brief Indica si hay alguna celda sucia.
+ */
+bool LCD_bufferIsDirty(const LCD_BufferTypedef * buffer) {
+    for (uint8_t fila = 0; fila < buffer->filas; fila++) {
+        if (buffer->sucias[fila] != 0)
+            return true;
+    }
+    return false;
+}
+
+#ifdef LCD_STREAM // el diff sólo lo usan los envíos por cuadros
+/**
+ *	@brief Compara fila por fila y, en las que cambiaron,
+ *		   copia la fila completa y suma sus celdas sucias.
+ *	@retval Cantidad de celdas que cambiaron.
+ */
+uint16_t LCD_bufferDiff(LCD_BufferTypedef * buffer, const LCD_BufferTypedef * cuadro) {
+    uint16_t cambios = 0;
+
+    if (buffer->filas != cuadro->filas || buffer->columnas != cuadro->columnas)
+        return 0;
+
+    for (uint8_t fila = 0; fila < buffer->filas; fila++) {
+        uint64_t distintas =
+            LCD_bufferDiffRow(buffer->celdas[fila], cuadro->celdas[fila], buffer->columnas);
+        if (distintas == 0)
+            continue;
+
+        memcpy(buffer->celdas[fila], cuadro->celdas[fila], buffer->columnas);
+        buffer->sucias[fila] |= distintas;
+        cambios += __builtin_popcountll(distintas);
+    }
+
+    return cambios;
+}
+
+/**
+ *	@brief Recorre el mapa de cada fila sacando los tramos
+ *		   de a uno, sin consultar celda por celda.
+ *	@retval Cantidad de tramos cargados.
+ */
+uint16_t LCD_bufferDirtyRuns(const LCD_BufferTypedef * buffer, LCD_TramoTypedef * tramos,
+                             uint16_t maximo) {
+    uint16_t cantidad = 0;
+
+    for (uint8_t fila = 0; fila < buffer->filas; fila++) {
+        uint64_t sucias = buffer->sucias[fila];
+
+        while (sucias != 0 && cantidad < maximo) {
+            uint8_t inicio = __builtin_ctzll(sucias);
+            uint8_t largo = LCD_bufferRunLength(sucias >> inicio);
+
+            tramos[cantidad].fila = fila;
+            tramos[cantidad].inicio = inicio;
+            tramos[cantidad].largo = largo;
+            cantidad++;
+
+            sucias &= (largo + inicio >= 64) ? 0 : (UINT64_MAX << (inicio + largo));
+        }
+    }
+
+    return cantidad;
+}
+
+/**
+ *	@brief Mapa de las columnas distintas de dos filas. Compara
+ *		   de a 16 bytes con SSE2, luego por palabras y las
+ *		   últimas columnas de a una.
+ */
+static uint64_t LCD_bufferDiffRow(const char * actual, const char * nueva, uint8_t columnas) {
+    uint64_t distintas = 0;
+    uint8_t columna = 0;
+
+#if defined(__SSE2__)
+    for (; columna + BYTES_SSE2 <= columnas; columna += BYTES_SSE2) {
+        __m128i a = _mm_loadu_si128((const __m128i *)&actual[columna]);
+        __m128i b = _mm_loadu_si128((const __m128i *)&nueva[columna]);
+        uint32_t iguales = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(a, b));
+        distintas |= (uint64_t)(~iguales & 0xFFFF) << columna;
+    }
+#endif
+
+    for (; columna + BYTES_PALABRA <= columnas; columna += BYTES_PALABRA) {
+        LCD_PalabraTypedef a;
+        LCD_PalabraTypedef b;
+
+        memcpy(&a, &actual[columna], BYTES_PALABRA); // las filas no están alineadas
+        memcpy(&b, &nueva[columna], BYTES_PALABRA);
+        distintas |= (uint64_t)LCD_bufferChangedBytes(a, b) << columna;
+    }
+
+    for (; columna < columnas; columna++) {
+        if (actual[columna] != nueva[columna])
+            distintas |= 1ULL << columna;
+    }
+
+    return distintas;
+}
+
+/**
+ *	@brief Un bit por byte distinto entre dos palabras, en el
+ *		   orden de las columnas (little endian): se deja el bit
+ *		   alto de cada byte en 1 si el byte del XOR no es cero
+ *		   y se juntan esos bits con una multiplicación.
+ */
+static uint8_t LCD_bufferChangedBytes(LCD_PalabraTypedef a, LCD_PalabraTypedef b) {
+    LCD_PalabraTypedef diferencia = a ^ b;
+    LCD_PalabraTypedef bajos = BYTES_REPETIDOS(0x7F);
+
+    diferencia = (((diferencia & bajos) + bajos) | diferencia) & ~bajos;
+    return (uint8_t)((((diferencia >> 7) * JUNTAR_BITS) >> DESPLAZAR_BITS) &
+                     ((1u << BYTES_PALABRA) - 1));
+}
+#endif /* LCD_STREAM */
+
+/**
+ *	@brief Largo del tramo de bits en 1 que empieza en el bit 0.
+ */
+static uint8_t LCD_bufferRunLength(uint64_t bits) {
+    return (~bits == 0) ? 64 : __builtin_ctzll(~bits);
+}
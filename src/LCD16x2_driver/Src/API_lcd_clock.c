@@ -0,0 +1,186 @@
+/**
+ * @file API_lcd_clock.c
+ * @brief Implementación del reloj HH:MM:SS.
+ */
+
+#include "API_lcd_clock.h"
+#include "API_types.h"
+
+#ifdef LCD_WIDGETS
+
+#define SEPARADOR ':'
+
+// segundos en que vuelve a cero cada modo
+#define SEGUNDOS_DIA        86400UL
+#define SEGUNDOS_CRONOMETRO 360000UL
+
+// segundos atrasados desde los que conviene recalcular todo el texto
+#define MAX_SEGUNDOS_A_CONTAR 60
+
+/**
+ *	@brief Último valor de cada cifra antes de volver a cero.
+ *		   Las horas del día vuelven a cero en 24, aparte.
+ */
+static const char ULTIMA_CIFRA[LCD_RELOJ_ANCHO] = {'9', '9', SEPARADOR, '5',
+                                                   '9', SEPARADOR, '5', '9'};
+
+static uint8_t LCD_clockTick(LCD_RelojTypedef *);
+static LCD_StatusTypedef LCD_clockWrite(const LCD_RelojTypedef *, uint8_t);
+
+/**
+ *	@brief Valida la ubicación y dibuja el reloj en cero.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_clockInit(LCD_RelojTypedef * reloj, uint8_t fila, uint8_t posicion,
+                                LCD_RelojModoTypedef modo) {
+    if (reloj == NULL || (fila != LCD_FILA_1 && fila != LCD_FILA_2))
+        return LCD_ERROR;
+
+    if (posicion + LCD_RELOJ_ANCHO > LCD_CANTIDAD_COLUMNAS || modo > LCD_RELOJ_CRONOMETRO)
+        return LCD_ERROR;
+
+    reloj->fila = fila;
+    reloj->posicion = posicion;
+    reloj->modo = modo;
+    reloj->enMarcha = false;
+    reloj->proximoTick = 0;
+    for (uint8_t indice = 0; indice < LCD_RELOJ_ANCHO; indice++)
+        reloj->texto[indice] = (ULTIMA_CIFRA[indice] == SEPARADOR) ? SEPARADOR : '0';
+    reloj->texto[LCD_RELOJ_ANCHO] = '\0';
+
+    return LCD_clockRedraw(reloj);
+}
+
+/**
+ *	@brief Arma el texto de la hora nueva desde los segundos
+ *		   y reescribe desde la primera cifra distinta.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_clockSet(LCD_RelojTypedef * reloj, uint32_t segundos) {
+    uint8_t primera = LCD_RELOJ_ANCHO;
+
+    segundos %= (reloj->modo == LCD_RELOJ_HORA) ? SEGUNDOS_DIA : SEGUNDOS_CRONOMETRO;
+    uint32_t campos[] = {segundos / 3600, segundos / 60 % 60, segundos % 60};
+
+    for (uint8_t campo = 0; campo < 3; campo++) {
+        char cifras[] = {'0' + campos[campo] / 10, '0' + campos[campo] % 10};
+        uint8_t indice = campo * 3; // cada campo ocupa sus dos cifras y el separador
+
+        for (uint8_t cifra = 0; cifra < 2; cifra++, indice++) {
+            if (reloj->texto[indice] == cifras[cifra])
+                continue;
+            reloj->texto[indice] = cifras[cifra];
+            if (primera == LCD_RELOJ_ANCHO)
+                primera = indice;
+        }
+    }
+
+    if (primera == LCD_RELOJ_ANCHO)
+        return LCD_OK;
+
+    return LCD_clockWrite(reloj, primera);
+}
+
+/**
+ *	@brief Agenda el primer segundo.
+ */
+void LCD_clockStart(LCD_RelojTypedef * reloj) {
+    reloj->proximoTick = port_getTick() + LCD_RELOJ_TICKS_X_SEGUNDO;
+    reloj->enMarcha = true;
+}
+
+/**
+ *	@brief Deja de avanzar el reloj.
+ */
+void LCD_clockStop(LCD_RelojTypedef * reloj) {
+    reloj->enMarcha = false;
+}
+
+/**
+ *	@brief Cuenta los segundos cumplidos desde el borde
+ *		   agendado. Unos pocos se suman de a uno en el texto;
+ *		   si son muchos se recalcula la hora.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_clockProcess(LCD_RelojTypedef * reloj) {
+    uint32_t atraso = port_getTick() - reloj->proximoTick;
+
+    // la resta sin signo da un atraso enorme mientras el borde no llega
+    if (!reloj->enMarcha || atraso >= UINT32_MAX / 2)
+        return LCD_OK;
+
+    uint32_t cumplidos = atraso / LCD_RELOJ_TICKS_X_SEGUNDO + 1;
+    reloj->proximoTick += cumplidos * LCD_RELOJ_TICKS_X_SEGUNDO;
+
+    if (cumplidos > MAX_SEGUNDOS_A_CONTAR)
+        return LCD_clockSet(reloj, LCD_clockGet(reloj) + cumplidos);
+
+    uint8_t primera = LCD_RELOJ_ANCHO;
+    while (cumplidos-- > 0) {
+        uint8_t cambio = LCD_clockTick(reloj);
+        if (cambio < primera)
+            primera = cambio;
+    }
+
+    return LCD_clockWrite(reloj, primera);
+}
+
+/**
+ *	@brief Dibuja el reloj completo.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_clockRedraw(const LCD_RelojTypedef * reloj) {
+    return LCD_clockWrite(reloj, 0);
+}
+
+/**
+ *	@brief Convierte el texto en segundos.
+ */
+uint32_t LCD_clockGet(const LCD_RelojTypedef * reloj) {
+    uint32_t campos[3];
+
+    for (uint8_t campo = 0; campo < 3; campo++)
+        campos[campo] = (reloj->texto[campo * 3] - '0') * 10 + (reloj->texto[campo * 3 + 1] - '0');
+
+    return campos[0] * 3600 + campos[1] * 60 + campos[2];
+}
+
+/**
+ *	@brief Suma un segundo: las cifras que llegaron a su
+ *		   último valor pasan a cero hasta encontrar una que
+ *		   se pueda incrementar, salteando los separadores.
+ *	@retval Primera cifra que cambió.
+ */
+static uint8_t LCD_clockTick(LCD_RelojTypedef * reloj) {
+    int8_t indice = LCD_RELOJ_ANCHO - 1;
+
+    for (; indice >= 0; indice--) {
+        if (ULTIMA_CIFRA[indice] == SEPARADOR)
+            continue;
+        if (reloj->texto[indice] != ULTIMA_CIFRA[indice])
+            break;
+        reloj->texto[indice] = '0';
+    }
+
+    if (indice < 0)
+        return 0; // el cronómetro pasó de 99:59:59
+
+    reloj->texto[indice]++;
+    if (reloj->modo == LCD_RELOJ_HORA && reloj->texto[0] == '2' && reloj->texto[1] == '4') {
+        reloj->texto[0] = '0';
+        reloj->texto[1] = '0';
+        return 0;
+    }
+
+    return indice;
+}
+
+/**
+ *	@brief Escribe el texto desde la cifra indicada.
+ *	@retval Estado de ejecución.
+ */
+static LCD_StatusTypedef LCD_clockWrite(const LCD_RelojTypedef * reloj, uint8_t desde) {
+    return LCD_printAt(reloj->fila, reloj->posicion + desde, &reloj->texto[desde]);
+}
+
+#endif /* LCD_WIDGETS */
@@ -0,0 +1,172 @@
+/**
+ * @file API_lcd_counter.c
+ * @brief Implementación del contador tipo odómetro.
+ */
+
+#include "API_lcd_counter.h"
+#include "API_types.h"
+
+#ifdef LCD_WIDGETS
+
+#define CARACTER_BLANCO ' '
+
+static LCD_StatusTypedef LCD_counterWrite(const LCD_ContadorTypedef *, uint8_t);
+static uint8_t LCD_counterWrap(LCD_ContadorTypedef *);
+
+/**
+ *	@brief Valida la ubicación, deja el contador en cero
+ *		   y lo dibuja completo.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_counterInit(LCD_ContadorTypedef * contador, uint8_t fila, uint8_t posicion,
+                                  uint8_t cifras, bool_t ceros) {
+    if (contador == NULL || (fila != LCD_FILA_1 && fila != LCD_FILA_2))
+        return LCD_ERROR;
+
+    if (cifras == 0 || cifras > LCD_CONTADOR_MAX_CIFRAS ||
+        posicion + cifras > LCD_CANTIDAD_COLUMNAS)
+        return LCD_ERROR;
+
+    contador->fila = fila;
+    contador->posicion = posicion;
+    contador->cifras = cifras;
+    contador->ceros = ceros;
+    for (uint8_t indice = 0; indice < cifras; indice++)
+        contador->texto[indice] = ceros ? '0' : CARACTER_BLANCO;
+    contador->texto[cifras - 1] = '0';
+    contador->texto[cifras] = '\0';
+
+    return LCD_counterRedraw(contador);
+}
+
+/**
+ *	@brief Las cifras en 9 pasan a 0 hasta encontrar una que
+ *		   se pueda incrementar; un blanco pasa a 1.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_counterIncrement(LCD_ContadorTypedef * contador) {
+    int8_t indice = contador->cifras - 1;
+
+    while (indice >= 0 && contador->texto[indice] == '9')
+        contador->texto[indice--] = '0';
+
+    if (indice < 0)
+        return LCD_counterWrite(contador, LCD_counterWrap(contador));
+
+    if (contador->texto[indice] == CARACTER_BLANCO)
+        contador->texto[indice] = '1';
+    else
+        contador->texto[indice]++;
+
+    return LCD_counterWrite(contador, indice);
+}
+
+/**
+ *	@brief Suma como a mano: a cada cifra le corresponde una
+ *		   cifra del valor y el acarreo de la anterior. Termina
+ *		   cuando no queda nada por sumar.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_counterAdd(LCD_ContadorTypedef * contador, uint32_t valor) {
+    int8_t indice = contador->cifras - 1;
+    uint8_t primera = contador->cifras;
+
+    for (; indice >= 0 && valor > 0; indice--) {
+        char * caracter = &contador->texto[indice];
+        uint8_t suma = ((*caracter == CARACTER_BLANCO) ? 0 : *caracter - '0') + valor % 10;
+
+        valor /= 10;
+        if (suma >= 10) {
+            suma -= 10;
+            valor++; // acarreo a la cifra siguiente
+        }
+
+        if (*caracter != '0' + suma) {
+            *caracter = '0' + suma;
+            primera = indice;
+        }
+    }
+
+    // un cero que queda a la izquierda sólo aparece si se pasó del máximo
+    if (valor > 0)
+        primera = LCD_counterWrap(contador);
+
+    if (primera == contador->cifras)
+        return LCD_OK;
+
+    return LCD_counterWrite(contador, primera);
+}
+
+/**
+ *	@brief Arma las cifras del valor nuevo desde la menos
+ *		   significativa y reescribe desde la primera distinta.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_counterSet(LCD_ContadorTypedef * contador, uint32_t valor) {
+    uint8_t primera = contador->cifras;
+
+    for (int8_t indice = contador->cifras - 1; indice >= 0; indice--) {
+        char caracter = '0' + valor % 10;
+        if (valor == 0 && indice < contador->cifras - 1 && !contador->ceros)
+            caracter = CARACTER_BLANCO;
+        valor /= 10;
+
+        if (contador->texto[indice] != caracter) {
+            contador->texto[indice] = caracter;
+            primera = indice;
+        }
+    }
+
+    if (primera == contador->cifras)
+        return LCD_OK;
+
+    return LCD_counterWrite(contador, primera);
+}
+
+/**
+ *	@brief Dibuja todas las cifras.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_counterRedraw(const LCD_ContadorTypedef * contador) {
+    return LCD_counterWrite(contador, 0);
+}
+
+/**
+ *	@brief Convierte las cifras en un valor.
+ */
+uint32_t LCD_counterGet(const LCD_ContadorTypedef * contador) {
+    uint32_t valor = 0;
+
+    for (uint8_t indice = 0; indice < contador->cifras; indice++) {
+        if (contador->texto[indice] != CARACTER_BLANCO)
+            valor = valor * 10 + (contador->texto[indice] - '0');
+    }
+
+    return valor;
+}
+
+/**
+ *	@brief Escribe las cifras desde la indicada hasta la
+ *		   menos significativa, que son las que cambiaron.
+ *	@retval Estado de ejecución.
+ */
+static LCD_StatusTypedef LCD_counterWrite(const LCD_ContadorTypedef * contador, uint8_t desde) {
+    return LCD_printAt(contador->fila, contador->posicion + desde, &contador->texto[desde]);
+}
+
+/**
+ *	@brief Luego de pasar del máximo pueden quedar ceros a
+ *		   la izquierda; sin ceros, vuelven a ser blancos.
+ *	@retval Primera cifra a reescribir.
+ */
+static uint8_t LCD_counterWrap(LCD_ContadorTypedef * contador) {
+    for (uint8_t indice = 0; indice < contador->cifras - 1 && !contador->ceros; indice++) {
+        if (contador->texto[indice] != '0')
+            break;
+        contador->texto[indice] = CARACTER_BLANCO;
+    }
+
+    return 0;
+}
+
+#endif /* LCD_WIDGETS */
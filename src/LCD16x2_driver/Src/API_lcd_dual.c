@@ -0,0 +1,211 @@
+/**
+ * @file API_lcd_dual.c
+ * @brief Implementación de los paneles de dos controladores.
+ */
+
+#ifdef LCD_PANEL_DUAL // sin LCD_PANEL_DUAL el buffer no alcanza para el panel
+
+#include "API_lcd_dual.h"
+#include "API_lcd_cmd.h"
+#include "API_types.h"
+
+// luz de fondo encendida en todas las tramas del panel
+#define LUZ (1 << POS_BACKLIGHT)
+
+// enable de los dos controladores a la vez
+#define AMBOS (LCD_DUAL_E1 | LCD_DUAL_E2)
+
+/**
+ *	@brief Nibbles que despiertan a los controladores y los
+ *		   pasan a modo 4 bits, con la espera previa en ms, y
+ *		   comandos de configuración. Las tramas I2C son más
+ *		   lentas que los comandos, que no necesitan esperas.
+ */
+static const uint8_t INICIO_NIBBLES[] = {0x03, 0x03, 0x02};
+static const uint8_t INICIO_ESPERAS[] = {20, 10, 1};
+static const uint8_t INICIO_CMD[] = {
+    _4BIT_MODE,
+    DISPLAY_CONTROL,
+    ENTRY_MODE | AUTOINCREMENT,
+    DISPLAY_CONTROL | DISPLAY_ON,
+};
+
+static void LCD_dualEncode(uint8_t, uint8_t, uint8_t, uint8_t *);
+static LCD_StatusTypedef LCD_dualSend(uint8_t, uint8_t, uint8_t);
+static bool_t LCD_dualNextMsg(LCD_DualTypedef *, uint8_t, uint8_t *, uint8_t *);
+
+/**
+ *	@brief Inicializa el I2C y los dos controladores a la vez.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_dualInit(LCD_DualTypedef * panel) {
+    if (panel == NULL || port_init() == false)
+        return LCD_ERROR;
+
+    LCD_bufferInit(&panel->buffer, LCD_DUAL_FILAS, LCD_DUAL_COLUMNAS);
+    panel->controladores[0].enable = LCD_DUAL_E1;
+    panel->controladores[1].enable = LCD_DUAL_E2;
+
+    for (uint8_t paso = 0; paso < sizeof(INICIO_NIBBLES); paso++) {
+        uint8_t nibble[] = {LUZ | (INICIO_NIBBLES[paso] << 4) | AMBOS,
+                            LUZ | (INICIO_NIBBLES[paso] << 4)};
+
+        port_delay(INICIO_ESPERAS[paso]);
+        if (!port_i2cWrite(nibble, sizeof(nibble)))
+            return LCD_ERROR;
+    }
+
+    for (uint8_t paso = 0; paso < sizeof(INICIO_CMD); paso++) {
+        if (LCD_dualSend(INICIO_CMD[paso], COMMAND, AMBOS) == LCD_ERROR)
+            return LCD_ERROR;
+    }
+
+    return LCD_dualClear(panel);
+}
+
+/**
+ *	@brief Borra los dos controladores con un único comando.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_dualClear(LCD_DualTypedef * panel) {
+    if (panel == NULL || LCD_dualSend(CLR_LCD, COMMAND, AMBOS) == LCD_ERROR)
+        return LCD_ERROR;
+
+    port_delay(LCD_ESPERA_CLEAR);
+    LCD_bufferClear(&panel->buffer);
+    return LCD_OK;
+}
+
+/**
+ *	@brief Escribe un texto en el buffer del panel.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_dualPrintAt(LCD_DualTypedef * panel, uint8_t fila, uint8_t columna,
+                                  const char * texto) {
+    if (panel == NULL || texto == NULL || fila >= LCD_DUAL_FILAS || columna >= LCD_DUAL_COLUMNAS)
+        return LCD_ERROR;
+
+    while (*texto != '\0' && columna < LCD_DUAL_COLUMNAS)
+        LCD_bufferWrite(&panel->buffer, fila, columna++, *texto++);
+
+    return LCD_OK;
+}
+
+/**
+ *	@brief Envía las celdas sucias intercalando los mensajes
+ *		   de los dos controladores en bloques de tramas.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_dualFlush(LCD_DualTypedef * panel) {
+    uint8_t bloque[LCD_DUAL_TRAMAS_X_BLOQUE];
+    uint16_t largo = 0;
+    bool_t quedan = true;
+
+    if (panel == NULL)
+        return LCD_ERROR;
+
+    for (uint8_t indice = 0; indice < LCD_DUAL_CONTROLADORES; indice++) {
+        panel->controladores[indice].fila = 0;
+        panel->controladores[indice].columna = 0;
+        panel->controladores[indice].enTramo = false;
+    }
+
+    while (quedan) {
+        quedan = false;
+        for (uint8_t indice = 0; indice < LCD_DUAL_CONTROLADORES; indice++) {
+            uint8_t dato;
+            uint8_t rs;
+
+            if (!LCD_dualNextMsg(panel, indice, &dato, &rs))
+                continue;
+
+            if (largo + LCD_TRAMAS_X_MENSAJE > LCD_DUAL_TRAMAS_X_BLOQUE) {
+                if (!port_i2cWrite(bloque, largo)) {
+                    LCD_bufferMarkAllDirty(&panel->buffer);
+                    return LCD_ERROR;
+                }
+                largo = 0;
+            }
+
+            LCD_dualEncode(dato, rs, panel->controladores[indice].enable, &bloque[largo]);
+            largo += LCD_TRAMAS_X_MENSAJE;
+            quedan = true;
+        }
+    }
+
+    if (largo > 0 && !port_i2cWrite(bloque, largo)) {
+        LCD_bufferMarkAllDirty(&panel->buffer);
+        return LCD_ERROR;
+    }
+
+    return LCD_OK;
+}
+
+/**
+ *	@brief Codifica un mensaje en 4 tramas con el enable indicado.
+ */
+static void LCD_dualEncode(uint8_t dato, uint8_t rs, uint8_t enable, uint8_t * tramas) {
+    uint8_t alto = rs | LUZ | (dato & 0xF0);
+    uint8_t bajo = rs | LUZ | (dato & 0x0F) << 4;
+
+    tramas[0] = alto | enable;
+    tramas[1] = alto;
+    tramas[2] = bajo | enable;
+    tramas[3] = bajo;
+}
+
+/**
+ *	@brief Envía un mensaje en una transacción.
+ *	@retval Estado de ejecución.
+ */
+static LCD_StatusTypedef LCD_dualSend(uint8_t dato, uint8_t rs, uint8_t enable) {
+    uint8_t tramas[LCD_TRAMAS_X_MENSAJE];
+
+    LCD_dualEncode(dato, rs, enable, tramas);
+    return port_i2cWrite(tramas, sizeof(tramas)) ? LCD_OK : LCD_ERROR;
+}
+
+/**
+ *	@brief Próximo mensaje de un controlador: el caracter
+ *		   siguiente del tramo sucio actual o el posicionamiento
+ *		   al comienzo del próximo tramo de sus dos filas. Cada
+ *		   celda queda limpia al codificarse.
+ *	@retval false si el controlador no tiene celdas sucias.
+ */
+static bool_t LCD_dualNextMsg(LCD_DualTypedef * panel, uint8_t indice, uint8_t * dato,
+                              uint8_t * rs) {
+    static const uint8_t inicioFila[] = {LCD_FILA_1, LCD_FILA_2};
+    LCD_DualControladorTypedef * controlador = &panel->controladores[indice];
+    uint8_t inicio;
+    uint8_t largo;
+
+    while (controlador->fila < LCD_DUAL_FILAS_X_CONTROLADOR) {
+        uint8_t fila = indice * LCD_DUAL_FILAS_X_CONTROLADOR + controlador->fila;
+        bool_t hayTramo = LCD_bufferNextDirtyRun(&panel->buffer, fila, controlador->columna,
+                                                 &inicio, &largo);
+
+        if (controlador->enTramo && hayTramo && inicio == controlador->columna) {
+            *dato = LCD_bufferGet(&panel->buffer, fila, inicio);
+            *rs = DATA;
+            LCD_bufferMarkClean(&panel->buffer, fila, inicio, 1);
+            controlador->columna++;
+            return true;
+        }
+
+        if (hayTramo) {
+            *dato = SET_CURSOR | (inicioFila[controlador->fila] + inicio);
+            *rs = COMMAND;
+            controlador->columna = inicio;
+            controlador->enTramo = true;
+            return true;
+        }
+
+        controlador->fila++;
+        controlador->columna = 0;
+        controlador->enTramo = false;
+    }
+
+    return false;
+}
+
+#endif /* LCD_PANEL_DUAL */
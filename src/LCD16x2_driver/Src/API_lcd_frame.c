@@ -0,0 +1,102 @@
+/**
+ * @file API_lcd_frame.c
+ * @brief Implementación del doble cuadro con seqlock.
+ */
+
+#include <string.h>
+
+#include "API_lcd_frame.h"
+
+#ifdef LCD_STREAM
+
+/**
+ *	@brief Accesos atómicos a la secuencia y al índice. En
+ *		   Cortex-M4 son lecturas y escrituras de una palabra
+ *		   con barreras DMB; en el host, las de la arquitectura.
+ */
+#define LEER(variable)           __atomic_load_n(&(variable), __ATOMIC_ACQUIRE)
+#define ESCRIBIR(variable, dato) __atomic_store_n(&(variable), (dato), __ATOMIC_RELEASE)
+
+/**
+ *	@brief Inicializa los cuadros y la secuencia.
+ */
+void LCD_frameInit(LCD_CuadroDobleTypedef * cuadro, uint8_t filas, uint8_t columnas) {
+    LCD_bufferInit(&cuadro->cuadros[0], filas, columnas);
+    LCD_bufferInit(&cuadro->cuadros[1], filas, columnas);
+    cuadro->secuencia = 0;
+    cuadro->frente = 0;
+    cuadro->secuenciaLeida = 0;
+}
+
+/**
+ *	@brief Cuadro que no es el del frente.
+ */
+LCD_BufferTypedef * LCD_frameBack(LCD_CuadroDobleTypedef * cuadro) {
+    return &cuadro->cuadros[1 - cuadro->frente];
+}
+
+/**
+ *	@brief Marca la secuencia impar, intercambia los índices,
+ *		   copia el cuadro publicado en el de atrás y marca la
+ *		   secuencia par. La barrera después de la primera
+ *		   escritura asegura que un lector que vea cualquier
+ *		   escritura posterior en el cuadro viejo, incluso las
+ *		   del próximo dibujo, vea también la secuencia cambiada.
+ */
+void LCD_frameCommit(LCD_CuadroDobleTypedef * cuadro) {
+    uint32_t secuencia = cuadro->secuencia;
+    uint8_t atras = 1 - cuadro->frente;
+
+    __atomic_store_n(&cuadro->secuencia, secuencia + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    ESCRIBIR(cuadro->frente, atras);
+    memcpy(cuadro->cuadros[1 - atras].celdas, cuadro->cuadros[atras].celdas,
+           sizeof(cuadro->cuadros[atras].celdas));
+
+    ESCRIBIR(cuadro->secuencia, secuencia + 2);
+}
+
+/**
+ *	@brief Compara la secuencia publicada con la de la última copia.
+ */
+bool_t LCD_framePending(const LCD_CuadroDobleTypedef * cuadro) {
+    return LEER(cuadro->secuencia) != cuadro->secuenciaLeida;
+}
+
+/**
+ *	@brief Lee la secuencia, copia el cuadro del frente y
+ *		   vuelve a leer la secuencia: si no cambió la copia es
+ *		   coherente y recién entonces se compara con la sombra.
+ *		   Con la secuencia impar no se intenta, porque el
+ *		   escritor está publicando.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_frameSnapshot(LCD_CuadroDobleTypedef * cuadro, LCD_BufferTypedef * sombra) {
+    LCD_BufferTypedef copia;
+
+    for (uint8_t intento = 0; intento < LCD_CUADRO_REINTENTOS; intento++) {
+        uint32_t secuencia = LEER(cuadro->secuencia);
+        if (secuencia & 1)
+            continue;
+
+        if (secuencia == cuadro->secuenciaLeida)
+            return LCD_OK;
+
+        uint8_t frente = LEER(cuadro->frente);
+        copia.filas = cuadro->cuadros[frente].filas;
+        copia.columnas = cuadro->cuadros[frente].columnas;
+        memcpy(copia.celdas, cuadro->cuadros[frente].celdas, sizeof(copia.celdas));
+
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&cuadro->secuencia, __ATOMIC_RELAXED) == secuencia) {
+            LCD_bufferDiff(sombra, &copia);
+            cuadro->secuenciaLeida = secuencia;
+            return LCD_OK;
+        }
+    }
+
+    return LCD_ERROR;
+}
+
+#endif /* LCD_STREAM */
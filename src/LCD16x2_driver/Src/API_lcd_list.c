@@ -0,0 +1,233 @@
+/**
+ * @file API_lcd_list.c
+ * @brief Implementación de las listas de visualización.
+ */
+
+#include <string.h>
+
+#include "API_lcd_list.h"
+#include "API_lcd_cmd.h"
+#include "API_types.h"
+
+#ifdef LCD_LIST
+
+static LCD_StatusTypedef LCD_listAppend(LCD_ListaTypedef *, uint8_t, uint8_t);
+static void LCD_listTrack(const uint8_t *, uint16_t);
+static bool_t LCD_listSend(const uint8_t *, uint16_t);
+
+/**
+ *	@brief Prepara una lista vacía.
+ */
+void LCD_listInit(LCD_ListaTypedef * lista, uint8_t * buffer, uint16_t capacidad) {
+    memset(lista, 0, sizeof(*lista));
+    lista->tramas = buffer;
+    lista->capacidad = capacidad;
+}
+
+/**
+ *	@brief Graba el comando CLR_LCD y una pausa, porque
+ *		   el controlador tarda más de 1,5 ms en ejecutarlo.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_listClear(LCD_ListaTypedef * lista) {
+    if (lista->cantidadPausas == LCD_LISTA_MAX_PAUSAS) {
+        lista->desbordada = true;
+        return LCD_ERROR;
+    }
+
+    if (LCD_listAppend(lista, CLR_LCD, COMMAND) == LCD_ERROR)
+        return LCD_ERROR;
+
+    lista->pausas[lista->cantidadPausas++] = lista->largo;
+    return LCD_OK;
+}
+
+/**
+ *	@brief Graba un posicionamiento del cursor.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_listSetCursor(LCD_ListaTypedef * lista, uint8_t fila, uint8_t posicion) {
+    if (fila != LCD_FILA_1 && fila != LCD_FILA_2)
+        return LCD_ERROR;
+
+    if (posicion >= LCD_CANTIDAD_COLUMNAS)
+        return LCD_ERROR;
+
+    return LCD_listAppend(lista, SET_CURSOR | (fila + posicion), COMMAND);
+}
+
+/**
+ *	@brief Graba la escritura de un caracter.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_listPrintChar(LCD_ListaTypedef * lista, char caracter) {
+    return LCD_listAppend(lista, caracter, DATA);
+}
+
+/**
+ *	@brief Graba un texto en (fila, posición), cortado
+ *		   al final de la fila.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_listPrintAt(LCD_ListaTypedef * lista, uint8_t fila, uint8_t posicion,
+                                  const char * ptrTexto) {
+    if (ptrTexto == NULL)
+        return LCD_ERROR;
+
+    if (LCD_listSetCursor(lista, fila, posicion) == LCD_ERROR)
+        return LCD_ERROR;
+
+    while ((*ptrTexto) != '\0' && posicion < LCD_CANTIDAD_COLUMNAS) {
+        if (LCD_listPrintChar(lista, *ptrTexto++) == LCD_ERROR)
+            return LCD_ERROR;
+        posicion++;
+    }
+
+    return LCD_OK;
+}
+
+/**
+ *	@brief Graba un campo en blanco y guarda dónde empiezan
+ *		   sus tramas para poder reemplazarlas después.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_listSlot(LCD_ListaTypedef * lista, uint8_t fila, uint8_t posicion,
+                               uint8_t ancho, uint8_t * slot) {
+    if (slot == NULL || ancho == 0 || posicion + ancho > LCD_CANTIDAD_COLUMNAS)
+        return LCD_ERROR;
+
+    if (lista->cantidadSlots == LCD_LISTA_MAX_SLOTS) {
+        lista->desbordada = true;
+        return LCD_ERROR;
+    }
+
+    if (LCD_listSetCursor(lista, fila, posicion) == LCD_ERROR)
+        return LCD_ERROR;
+
+    uint16_t inicio = lista->largo;
+    for (uint8_t indice = 0; indice < ancho; indice++) {
+        if (LCD_listPrintChar(lista, ' ') == LCD_ERROR)
+            return LCD_ERROR;
+    }
+
+    *slot = lista->cantidadSlots++;
+    lista->slots[*slot].inicio = inicio;
+    lista->slots[*slot].ancho = ancho;
+    return LCD_OK;
+}
+
+/**
+ *	@brief Recodifica en el lugar las tramas de un slot.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_listPatch(LCD_ListaTypedef * lista, uint8_t slot, const char * ptrTexto) {
+    if (ptrTexto == NULL || slot >= lista->cantidadSlots)
+        return LCD_ERROR;
+
+    uint8_t * tramas = &lista->tramas[lista->slots[slot].inicio];
+    for (uint8_t indice = 0; indice < lista->slots[slot].ancho; indice++) {
+        char caracter = ' ';
+        if ((*ptrTexto) != '\0')
+            caracter = *ptrTexto++;
+        LCD_encodeMsg(caracter, DATA, tramas);
+        tramas += LCD_TRAMAS_X_MENSAJE;
+    }
+
+    return LCD_OK;
+}
+
+/**
+ *	@brief Transmite la lista en tramos separados por las
+ *		   pausas de los comandos lentos. No se transmite mientras
+ *		   la inicialización diferida no haya terminado, ni
+ *		   a un controlador nativo, que no usa tramas del PCF8574.
+ *		   Los textos se grabaron para un cursor que avanza, así
+ *		   que tampoco con otro modo de entrada. Cada tramo
+ *		   transmitido se registra en el buffer de sombra y en
+ *		   el cursor del driver.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_listReplay(const LCD_ListaTypedef * lista) {
+    if (lista->desbordada || !LCD_isReady() || LCD_getProfile()->nativo ||
+        LCD_getEntryMode() != LCD_ENTRADA_INCREMENTO)
+        return LCD_ERROR;
+
+    uint16_t desde = 0;
+    for (uint8_t pausa = 0; pausa <= lista->cantidadPausas; pausa++) {
+        uint16_t hasta = (pausa < lista->cantidadPausas) ? lista->pausas[pausa] : lista->largo;
+
+        if (hasta > desde && !LCD_listSend(&lista->tramas[desde], hasta - desde))
+            return LCD_ERROR;
+        LCD_listTrack(&lista->tramas[desde], hasta - desde);
+
+        if (pausa < lista->cantidadPausas)
+            port_delay(LCD_ESPERA_CLEAR);
+
+        desde = hasta;
+    }
+
+    return LCD_OK;
+}
+
+/**
+ *	@brief Agrega al final de la lista las tramas de un mensaje.
+ *	@retval LCD_ERROR si no hay lugar en el buffer.
+ */
+static LCD_StatusTypedef LCD_listAppend(LCD_ListaTypedef * lista, uint8_t dato, uint8_t rs) {
+    if (lista->largo + LCD_TRAMAS_X_MENSAJE > lista->capacidad) {
+        lista->desbordada = true;
+        return LCD_ERROR;
+    }
+
+    LCD_encodeMsg(dato, rs, &lista->tramas[lista->largo]);
+    lista->largo += LCD_TRAMAS_X_MENSAJE;
+    return LCD_OK;
+}
+
+/**
+ *	@brief Decodifica los mensajes de un tramo ya transmitido
+ *		   y los registra en la sombra: el nibble alto y RS
+ *		   vienen en la primera trama y el bajo en la tercera.
+ */
+static void LCD_listTrack(const uint8_t * tramas, uint16_t cantidad) {
+    for (uint16_t indice = 0; indice < cantidad; indice += LCD_TRAMAS_X_MENSAJE) {
+        const uint8_t * mensaje = &tramas[indice];
+        LCD_trackMsg((mensaje[0] & 0xF0) | (mensaje[2] >> 4), mensaje[0] & DATA);
+    }
+}
+
+/**
+ *	@brief Transmite un tramo con el estado actual del
+ *		   backlight. Si las tramas ya lo llevan salen en una
+ *		   única transacción; si se grabaron con otro, se copian
+ *		   de a LCD_LISTA_TRAMAS_X_BLOQUE con el bit corregido,
+ *		   porque la lista puede estar en memoria de sólo lectura.
+ *	@retval false si falló alguna transacción.
+ */
+static bool_t LCD_listSend(const uint8_t * tramas, uint16_t cantidad) {
+    uint8_t actual[LCD_TRAMAS_X_MENSAJE];
+    LCD_encodeMsg(0, COMMAND, actual);
+    uint8_t luz = actual[1] & (1 << POS_BACKLIGHT);
+
+    uint16_t iguales = 0;
+    while (iguales < cantidad && (tramas[iguales] & (1 << POS_BACKLIGHT)) == luz)
+        iguales++;
+    if (iguales == cantidad)
+        return port_i2cWrite(tramas, cantidad);
+
+    uint8_t bloque[LCD_LISTA_TRAMAS_X_BLOQUE];
+    for (uint16_t desde = 0; desde < cantidad; desde += LCD_LISTA_TRAMAS_X_BLOQUE) {
+        uint16_t largo = cantidad - desde;
+        if (largo > LCD_LISTA_TRAMAS_X_BLOQUE)
+            largo = LCD_LISTA_TRAMAS_X_BLOQUE;
+
+        for (uint16_t indice = 0; indice < largo; indice++)
+            bloque[indice] = (tramas[desde + indice] & ~(1 << POS_BACKLIGHT)) | luz;
+
+        if (!port_i2cWrite(bloque, largo))
+            return false;
+    }
+    return true;
+}
+
+#endif /* LCD_LIST */
@@ -0,0 +1,194 @@
+/**
+ * @file API_lcd_log.c
+ * @brief Implementación del registro de líneas.
+ */
+
+#include <string.h>
+
+#include "API_lcd_log.h"
+#include "API_types.h"
+
+#ifdef LCD_WIDGETS
+
+#define CARACTER_BLANCO ' '
+
+static uint16_t LCD_logAvailable(const LCD_LogTypedef *, uint32_t);
+static uint16_t LCD_logMaxOffset(const LCD_LogTypedef *, uint32_t);
+static void LCD_logRebase(LCD_LogTypedef *, uint32_t);
+static LCD_StatusTypedef LCD_logDrawRow(uint8_t, char *);
+
+/**
+ *	@brief Deja el registro vacío, siguiendo a las líneas nuevas.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_logInit(LCD_LogTypedef * log, char * buffer, uint16_t lineas) {
+    if (log == NULL || buffer == NULL || lineas < LCD_CANTIDAD_FILAS)
+        return LCD_ERROR;
+
+    log->lineas = buffer;
+    log->capacidad = lineas;
+    log->reservadas = 0;
+    log->escritas = 0;
+    log->dibujadas = 0;
+    log->referencia = 0;
+    log->desplazamiento = 0;
+    log->vistaCambiada = true;
+    return LCD_OK;
+}
+
+/**
+ *	@brief Reserva el lugar con un incremento atómico, copia la
+ *		   línea y recién entonces la publica.
+ */
+void LCD_logAppend(LCD_LogTypedef * log, const char * texto) {
+    uint32_t numero = __atomic_fetch_add(&log->reservadas, 1, __ATOMIC_RELAXED);
+    char * linea = &log->lineas[(numero % log->capacidad) * LCD_CANTIDAD_COLUMNAS];
+    uint8_t columna = 0;
+
+    for (; texto != NULL && texto[columna] != '\0' && columna < LCD_CANTIDAD_COLUMNAS; columna++)
+        linea[columna] = texto[columna];
+    memset(&linea[columna], CARACTER_BLANCO, LCD_CANTIDAD_COLUMNAS - columna);
+
+    __atomic_fetch_add(&log->escritas, 1, __ATOMIC_RELEASE);
+}
+
+/**
+ *	@brief Mueve la vista dentro de las líneas disponibles.
+ */
+void LCD_logScroll(LCD_LogTypedef * log, int16_t lineas) {
+    uint32_t escritas = __atomic_load_n(&log->escritas, __ATOMIC_ACQUIRE);
+
+    LCD_logRebase(log, escritas);
+
+    int32_t desplazamiento = (int32_t)log->desplazamiento + lineas;
+    uint16_t maximo = LCD_logMaxOffset(log, escritas);
+
+    if (desplazamiento < 0)
+        desplazamiento = 0;
+    else if (desplazamiento > maximo)
+        desplazamiento = maximo;
+
+    if (desplazamiento != log->desplazamiento) {
+        log->desplazamiento = desplazamiento;
+        log->vistaCambiada = true;
+    }
+}
+
+/**
+ *	@brief Una página es una pantalla de líneas.
+ */
+void LCD_logPage(LCD_LogTypedef * log, int8_t paginas) {
+    LCD_logScroll(log, paginas * LCD_CANTIDAD_FILAS);
+}
+
+/**
+ *	@brief Lleva la vista a las líneas más nuevas.
+ */
+void LCD_logFollow(LCD_LogTypedef * log) {
+    LCD_logScroll(log, -(int16_t)log->desplazamiento);
+}
+
+/**
+ *	@brief Busca la línea en el buffer circular.
+ *	@retval false si no está.
+ */
+bool_t LCD_logGetLine(const LCD_LogTypedef * log, uint16_t atras, char * texto) {
+    uint32_t escritas = __atomic_load_n(&log->escritas, __ATOMIC_ACQUIRE);
+
+    if (atras >= LCD_logAvailable(log, escritas))
+        return false;
+
+    uint32_t numero = escritas - 1 - atras;
+    memcpy(texto, &log->lineas[(numero % log->capacidad) * LCD_CANTIDAD_COLUMNAS],
+           LCD_CANTIDAD_COLUMNAS);
+    texto[LCD_CANTIDAD_COLUMNAS] = '\0';
+    return true;
+}
+
+/**
+ *	@brief Dibuja las filas de arriba hacia abajo.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_logProcess(LCD_LogTypedef * log) {
+    static const uint8_t inicioFila[] = {LCD_FILA_1, LCD_FILA_2};
+    uint32_t escritas = __atomic_load_n(&log->escritas, __ATOMIC_ACQUIRE);
+    char texto[LCD_CANTIDAD_COLUMNAS + 1];
+
+    if (escritas == log->dibujadas && !log->vistaCambiada)
+        return LCD_OK;
+
+    LCD_logRebase(log, escritas);
+
+    for (uint8_t fila = 0; fila < LCD_CANTIDAD_FILAS; fila++) {
+        uint16_t atras = log->desplazamiento + (LCD_CANTIDAD_FILAS - 1 - fila);
+
+        if (!LCD_logGetLine(log, atras, texto)) {
+            memset(texto, CARACTER_BLANCO, LCD_CANTIDAD_COLUMNAS);
+            texto[LCD_CANTIDAD_COLUMNAS] = '\0';
+        }
+
+        if (LCD_logDrawRow(inicioFila[fila], texto) == LCD_ERROR)
+            return LCD_ERROR; // se vuelve a intentar en la próxima llamada
+    }
+
+    log->dibujadas = escritas;
+    log->vistaCambiada = false;
+    return LCD_OK;
+}
+
+/**
+ *	@brief Líneas que siguen en el buffer.
+ */
+static uint16_t LCD_logAvailable(const LCD_LogTypedef * log, uint32_t escritas) {
+    return (escritas < log->capacidad) ? escritas : log->capacidad;
+}
+
+/**
+ *	@brief Desplazamiento que deja la línea más vieja en la
+ *		   primera fila.
+ */
+static uint16_t LCD_logMaxOffset(const LCD_LogTypedef * log, uint32_t escritas) {
+    uint16_t disponibles = LCD_logAvailable(log, escritas);
+
+    return (disponibles > LCD_CANTIDAD_FILAS) ? disponibles - LCD_CANTIDAD_FILAS : 0;
+}
+
+/**
+ *	@brief Con la vista atrás, la corre tantas líneas como
+ *		   llegaron desde la referencia para que siga mostrando
+ *		   las mismas.
+ */
+static void LCD_logRebase(LCD_LogTypedef * log, uint32_t escritas) {
+    if (log->desplazamiento > 0) {
+        uint32_t desplazamiento = log->desplazamiento + (escritas - log->referencia);
+        uint16_t maximo = LCD_logMaxOffset(log, escritas);
+        log->desplazamiento = (desplazamiento > maximo) ? maximo : desplazamiento;
+    }
+
+    log->referencia = escritas;
+}
+
+/**
+ *	@brief Compara la fila con el buffer de sombra y escribe
+ *		   desde la primera hasta la última celda distinta.
+ *	@retval Estado de ejecución.
+ */
+static LCD_StatusTypedef LCD_logDrawRow(uint8_t fila, char * texto) {
+    const LCD_BufferTypedef * sombra = LCD_getBuffer();
+    uint8_t filaSombra = (fila == LCD_FILA_1) ? 0 : 1;
+    int8_t primera = 0;
+    int8_t ultima = LCD_CANTIDAD_COLUMNAS - 1;
+
+    while (primera <= ultima && LCD_bufferGet(sombra, filaSombra, primera) == texto[primera])
+        primera++;
+    while (ultima >= primera && LCD_bufferGet(sombra, filaSombra, ultima) == texto[ultima])
+        ultima--;
+
+    if (primera > ultima)
+        return LCD_OK;
+
+    texto[ultima + 1] = '\0';
+    return LCD_printAt(fila, primera, &texto[primera]);
+}
+
+#endif /* LCD_WIDGETS */
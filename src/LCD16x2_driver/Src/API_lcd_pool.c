@@ -0,0 +1,125 @@
+/**
+ * @file API_lcd_pool.c
+ * @brief Implementación del pool de memoria
+ * 		  estático con clases de tamaño.
+ */
+
+#include "API_lcd_pool.h"
+
+#ifdef LCD_QUEUE // el pool sólo lo usa la cola
+
+/**
+ *	@brief Descriptor de una clase de tamaño. Cada bit
+ *		   de libres en 1 indica un bloque disponible.
+ */
+typedef struct {
+    uint8_t * memoria;
+    uint8_t tamanio;
+    uint8_t cantidad;
+    uint32_t libres;
+} LCD_PoolClaseTypedef;
+
+/**
+ *	@brief Memoria reservada para cada clase.
+ */
+static uint8_t memoriaClase0[LCD_POOL_TAM_CLASE_0 * LCD_POOL_BLOQUES_CLASE_0];
+static uint8_t memoriaClase1[LCD_POOL_TAM_CLASE_1 * LCD_POOL_BLOQUES_CLASE_1];
+static uint8_t memoriaClase2[LCD_POOL_TAM_CLASE_2 * LCD_POOL_BLOQUES_CLASE_2];
+
+/**
+ *	@brief Clases ordenadas de menor a mayor tamaño.
+ */
+static LCD_PoolClaseTypedef clases[LCD_POOL_CANTIDAD_CLASES] = {
+    {memoriaClase0, LCD_POOL_TAM_CLASE_0, LCD_POOL_BLOQUES_CLASE_0, 0},
+    {memoriaClase1, LCD_POOL_TAM_CLASE_1, LCD_POOL_BLOQUES_CLASE_1, 0},
+    {memoriaClase2, LCD_POOL_TAM_CLASE_2, LCD_POOL_BLOQUES_CLASE_2, 0},
+};
+
+static LCD_PoolStatsTypedef estadisticas;
+
+/**
+ *	@brief Marca todos los bloques como libres
+ *		   y pone en cero las estadísticas.
+ */
+void LCD_poolInit() {
+    for (uint8_t indice = 0; indice < LCD_POOL_CANTIDAD_CLASES; indice++) {
+        uint8_t cantidad = clases[indice].cantidad;
+        clases[indice].libres = (cantidad == 32) ? 0xFFFFFFFF : ((1UL << cantidad) - 1);
+        estadisticas.enUso[indice] = 0;
+        estadisticas.maximoUso[indice] = 0;
+    }
+    estadisticas.fallos = 0;
+}
+
+/**
+ *	@brief Busca la clase más chica que tenga un bloque
+ *		   libre del tamaño pedido. Al agotarse el pool
+ *		   se cuenta el fallo y se devuelve NULL de inmediato,
+ *		   sin esperar a que se liberen bloques.
+ *	@retval Puntero al bloque o NULL si no hay lugar.
+ */
+void * LCD_poolAlloc(uint8_t tamanio) {
+    if (tamanio == 0)
+        return NULL;
+
+    for (uint8_t indice = 0; indice < LCD_POOL_CANTIDAD_CLASES; indice++) {
+        LCD_PoolClaseTypedef * clase = &clases[indice];
+        if (clase->tamanio < tamanio || clase->libres == 0)
+            continue;
+
+        uint8_t bloque = 0;
+        while ((clase->libres & (1UL << bloque)) == 0)
+            bloque++;
+        clase->libres &= ~(1UL << bloque);
+
+        estadisticas.enUso[indice]++;
+        if (estadisticas.enUso[indice] > estadisticas.maximoUso[indice])
+            estadisticas.maximoUso[indice] = estadisticas.enUso[indice];
+
+        return &clase->memoria[bloque * clase->tamanio];
+    }
+
+    estadisticas.fallos++;
+    return NULL;
+}
+
+/**
+ *	@brief Ubica la clase a la que pertenece el bloque
+ *		   por su dirección y lo marca como libre.
+ */
+void LCD_poolFree(void * ptrBloque) {
+    uint8_t * direccion = ptrBloque;
+    if (direccion == NULL)
+        return;
+
+    for (uint8_t indice = 0; indice < LCD_POOL_CANTIDAD_CLASES; indice++) {
+        LCD_PoolClaseTypedef * clase = &clases[indice];
+        uint8_t * fin = clase->memoria + clase->tamanio * clase->cantidad;
+        if (direccion < clase->memoria || direccion >= fin)
+            continue;
+
+        uint16_t desplazamiento = direccion - clase->memoria;
+        if (desplazamiento % clase->tamanio != 0)
+            return; // no apunta al inicio de un bloque
+
+        uint32_t mascara = 1UL << (desplazamiento / clase->tamanio);
+        if (clase->libres & mascara)
+            return; // el bloque ya estaba libre
+
+        clase->libres |= mascara;
+        estadisticas.enUso[indice]--;
+        return;
+    }
+}
+
+/**
+ *	@brief Copia las estadísticas de uso del pool.
+ */
+void LCD_poolGetStats(LCD_PoolStatsTypedef * stats) {
+    if (stats == NULL)
+        return;
+
+    *stats = estadisticas;
+}
+
+#endif /* LCD_QUEUE */
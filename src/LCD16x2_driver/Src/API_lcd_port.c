@@ -7,17 +7,54 @@
 
 #include "API_lcd_port.h"
 
+#ifndef LCD_PORT_SOCKET // con LCD_PORT_SOCKET el port es el de API_lcd_port_sock.c
+
 /**
  *	@brief Variable global privada para controlar el periferico I2C.
  */
 static I2C_HandleTypeDef I2C_HANDLE;
 
+/**
+ *	@brief Dirección I2C de 7 bits del LCD.
+ */
+static uint8_t direccionI2C = LCD_ADDRESS;
+
+/**
+ *	@brief Velocidad del bus I2C en Hz.
+ */
+static uint32_t velocidadI2C = I2C_CLOCK_SPEED;
+
+/**
+ *	@brief Modos de la transmisión en segundo plano.
+ */
+typedef enum { MODO_INACTIVO, MODO_INTERRUPCION, MODO_DMA } port_ModoTypedef;
+
+/**
+ *	@brief Estado de la transmisión en segundo plano en curso.
+ */
+static volatile port_ModoTypedef modo = MODO_INACTIVO;
+static volatile port_TramaCallbackTypedef tramaSiguiente = NULL;
+static volatile port_MitadCallbackTypedef mitadLista = NULL;
+static volatile port_FinCallbackTypedef finTransmision = NULL;
+
 /**
  *	@brief Función privada para inicializar el I2C.
  *	@retval Estado de ejecución.
  */
 static bool_t port_i2cInit();
 
+/**
+ *	@brief Función privada para terminar la transmisión por
+ *		   interrupciones e informar el resultado.
+ */
+static void port_i2cStreamEnd(bool_t);
+
+/**
+ *	@brief Función privada para detener el DMA y esperar
+ *		   el último byte antes de generar el stop.
+ */
+static void port_dmaStop();
+
 /**
  *   @brief Inicializa el periférico I2C.
  *	@retval Estado de ejecución.
@@ -26,6 +63,48 @@ bool_t port_init() {
     return port_i2cInit();
 }
 
+/**
+ *   @brief Cambia la dirección I2C de 7 bits del LCD.
+ */
+void port_setAddress(uint8_t direccion) {
+    direccionI2C = direccion;
+}
+
+/**
+ *   @brief Devuelve la dirección I2C de 7 bits del LCD.
+ */
+uint8_t port_getAddress() {
+    return direccionI2C;
+}
+
+/**
+ *   @brief Cambia la velocidad del bus I2C y vuelve a
+ *		   configurar el periférico. Si la HAL rechaza la
+ *		   nueva velocidad se restituye la anterior.
+ *	@retval Estado de ejecución.
+ */
+bool_t port_setClockSpeed(uint32_t velocidad) {
+    if (velocidad < I2C_CLOCK_MIN || velocidad > I2C_CLOCK_MAX || modo != MODO_INACTIVO)
+        return false;
+
+    uint32_t anterior = velocidadI2C;
+
+    velocidadI2C = velocidad;
+    if (port_i2cInit())
+        return true;
+
+    velocidadI2C = anterior;
+    port_i2cInit();
+    return false;
+}
+
+/**
+ *   @brief Devuelve la velocidad del bus I2C, en Hz.
+ */
+uint32_t port_getClockSpeed() {
+    return velocidadI2C;
+}
+
 /**
  *	@brief Función para inicializar el I2C.
  *		   Utiliza la HAL de STM32 para la configuración.
@@ -33,7 +112,7 @@ bool_t port_init() {
  */
 static bool_t port_i2cInit() {
     I2C_HANDLE.Instance = I2C_INSTANCE;
-    I2C_HANDLE.Init.ClockSpeed = I2C_CLOCK_SPEED;
+    I2C_HANDLE.Init.ClockSpeed = velocidadI2C;
     I2C_HANDLE.Init.DutyCycle = I2C_DUTYCYCLE_2;
     I2C_HANDLE.Init.OwnAddress1 = 0;
     I2C_HANDLE.Init.AddressingMode = I2C_ADDRESSINGMODE_7BIT;
@@ -51,6 +130,7 @@ static bool_t port_i2cInit() {
     return estado;
 }
 
+#ifndef LCD_PORT_LL // con LCD_PORT_LL estas funciones están en API_lcd_port_ll.c
 /**
  *   @brief Escribe un byte por I2C.
  *		   Utiliza la función bloqueante para
@@ -58,16 +138,248 @@ static bool_t port_i2cInit() {
  *	@retval Estado de ejecución.
  */
 bool_t port_i2cWriteByte(uint8_t _byte) {
-    if (HAL_I2C_Master_Transmit(&I2C_HANDLE, LCD_ADDRESS << 1, &_byte, 1, I2C_TIMEOUT) == HAL_OK)
+    if (HAL_I2C_Master_Transmit(&I2C_HANDLE, direccionI2C << 1, &_byte, 1, I2C_TIMEOUT) == HAL_OK)
+        return true;
+    else
+        return false;
+}
+
+/**
+ *   @brief Escribe varios bytes por I2C en una única
+ *		   transacción bloqueante. El timeout se extiende
+ *		   un milisegundo por byte, que alcanza con holgura
+ *		   a 100 kHz.
+ *	@retval Estado de ejecución.
+ */
+bool_t port_i2cWrite(const uint8_t * bytes, uint16_t cantidad) {
+    if (HAL_I2C_Master_Transmit(&I2C_HANDLE, direccionI2C << 1, (uint8_t *)bytes, cantidad,
+                                I2C_TIMEOUT + cantidad) == HAL_OK)
+        return true;
+    else
+        return false;
+}
+
+/**
+ *   @brief Lee un byte por I2C.
+ *		   Utiliza la función bloqueante para
+ *		   recibir.
+ *	@retval Estado de ejecución.
+ */
+bool_t port_i2cReadByte(uint8_t * _byte) {
+    if (HAL_I2C_Master_Receive(&I2C_HANDLE, direccionI2C << 1, _byte, 1, I2C_TIMEOUT) == HAL_OK)
         return true;
     else
         return false;
 }
+#endif /* LCD_PORT_LL */
+
+/**
+ *   @brief Inicia una transmisión por interrupciones. Se
+ *		   accede directamente a los registros del I2C: la ISR
+ *		   carga en DR cada trama que entrega el callback, sin
+ *		   pasar por la máquina de estados de la HAL.
+ *	@retval Estado de ejecución.
+ */
+bool_t port_i2cStreamStart(port_TramaCallbackTypedef trama, port_FinCallbackTypedef fin) {
+    I2C_TypeDef * i2c = I2C_HANDLE.Instance;
+
+    if (trama == NULL || modo != MODO_INACTIVO || (i2c->SR2 & I2C_SR2_BUSY))
+        return false;
+
+    modo = MODO_INTERRUPCION;
+    tramaSiguiente = trama;
+    finTransmision = fin;
+
+    HAL_NVIC_EnableIRQ(I2C_EV_IRQN);
+    HAL_NVIC_EnableIRQ(I2C_ER_IRQN);
+    i2c->CR2 |= I2C_CR2_ITEVTEN | I2C_CR2_ITBUFEN | I2C_CR2_ITERREN;
+    i2c->CR1 |= I2C_CR1_START;
+    return true;
+}
+
+/**
+ *   @brief Inicia una transmisión circular por DMA sobre un
+ *		   buffer dividido en dos mitades. El DMA1 Stream6
+ *		   (canal 1, I2C1_TX) se configura por registros en
+ *		   modo circular con interrupciones de media
+ *		   transferencia y de transferencia completa.
+ *	@retval Estado de ejecución.
+ */
+bool_t port_i2cDmaStart(const uint8_t * buffer, uint16_t largo, port_MitadCallbackTypedef mitad,
+                        port_FinCallbackTypedef fin) {
+    I2C_TypeDef * i2c = I2C_HANDLE.Instance;
+
+    if (buffer == NULL || mitad == NULL || largo < 2 || (largo % 2) != 0)
+        return false;
+
+    if (modo != MODO_INACTIVO || (i2c->SR2 & I2C_SR2_BUSY))
+        return false;
+
+    modo = MODO_DMA;
+    mitadLista = mitad;
+    finTransmision = fin;
+
+    __HAL_RCC_DMA1_CLK_ENABLE();
+    DMA_STREAM->CR = 0;
+    DMA1->HIFCR = DMA_HIFCR_CTCIF6 | DMA_HIFCR_CHTIF6 | DMA_HIFCR_CTEIF6;
+    DMA_STREAM->PAR = (uint32_t)(uintptr_t)&i2c->DR;
+    DMA_STREAM->M0AR = (uint32_t)(uintptr_t)buffer;
+    DMA_STREAM->NDTR = largo;
+    DMA_STREAM->CR = (DMA_CANAL << DMA_SxCR_CHSEL_Pos) | DMA_SxCR_MINC | DMA_SxCR_CIRC |
+                     DMA_SxCR_DIR_0 | DMA_SxCR_HTIE | DMA_SxCR_TCIE | DMA_SxCR_TEIE;
+
+    HAL_NVIC_EnableIRQ(DMA_IRQN);
+    HAL_NVIC_EnableIRQ(I2C_EV_IRQN);
+    HAL_NVIC_EnableIRQ(I2C_ER_IRQN);
+    DMA_STREAM->CR |= DMA_SxCR_EN;
+    i2c->CR2 |= I2C_CR2_DMAEN | I2C_CR2_ITEVTEN | I2C_CR2_ITERREN;
+    i2c->CR1 |= I2C_CR1_START;
+    return true;
+}
+
+/**
+ *   @brief Atención de la interrupción del DMA: avisa qué
+ *		   mitad terminó de transmitirse para que se vuelva a
+ *		   llenar, o detiene la transmisión si no hay más datos.
+ */
+void port_dmaIRQHandler() {
+    uint32_t estado = DMA1->HISR;
+
+    if (modo != MODO_DMA)
+        return;
+
+    if (estado & DMA_HISR_TEIF6) {
+        DMA1->HIFCR = DMA_HIFCR_CTEIF6;
+        DMA_STREAM->CR &= ~DMA_SxCR_EN;
+        port_i2cStreamEnd(false);
+        return;
+    }
+
+    if (estado & DMA_HISR_HTIF6) {
+        DMA1->HIFCR = DMA_HIFCR_CHTIF6;
+        if (!mitadLista(0))
+            port_dmaStop();
+    }
+
+    if (estado & DMA_HISR_TCIF6) {
+        DMA1->HIFCR = DMA_HIFCR_CTCIF6;
+        if (!mitadLista(1))
+            port_dmaStop();
+    }
+}
+
+/**
+ *   @brief Atención de la interrupción de eventos del I2C:
+ *		   envía la dirección luego del start. Por interrupción
+ *		   pide una trama por cada TXE; por DMA los datos los
+ *		   carga el DMA. Al terminar espera BTF para generar
+ *		   el stop.
+ */
+void port_i2cEvIRQHandler() {
+    I2C_TypeDef * i2c = I2C_HANDLE.Instance;
+    uint32_t estado = i2c->SR1;
+
+    if (modo == MODO_INACTIVO)
+        return;
+
+    if (estado & I2C_SR1_SB) {
+        i2c->DR = direccionI2C << 1;
+        return;
+    }
+
+    if (estado & I2C_SR1_ADDR) {
+        (void)i2c->SR2; // la lectura de SR1 y SR2 limpia ADDR
+        estado = i2c->SR1;
+    }
+
+    if (modo == MODO_DMA) {
+        if (!(i2c->CR2 & I2C_CR2_DMAEN) && (estado & I2C_SR1_BTF))
+            port_i2cStreamEnd(true);
+        return;
+    }
+
+    if (!(estado & I2C_SR1_TXE))
+        return;
+
+    uint8_t trama;
+    if (tramaSiguiente(&trama)) {
+        i2c->DR = trama;
+        return;
+    }
+
+    i2c->CR2 &= ~I2C_CR2_ITBUFEN; // sólo queda esperar BTF
+    if (estado & I2C_SR1_BTF)
+        port_i2cStreamEnd(true);
+}
+
+/**
+ *   @brief Atención de la interrupción de errores del I2C:
+ *		   limpia las banderas y termina la transmisión.
+ */
+void port_i2cErIRQHandler() {
+    I2C_HANDLE.Instance->SR1 &= ~(I2C_SR1_AF | I2C_SR1_BERR | I2C_SR1_ARLO | I2C_SR1_OVR);
+
+    if (modo == MODO_DMA)
+        DMA_STREAM->CR &= ~DMA_SxCR_EN;
+
+    if (modo != MODO_INACTIVO)
+        port_i2cStreamEnd(false);
+}
+
+/**
+ *	@brief Deshabilita el DMA. El byte que ya está en el
+ *		   registro de desplazamiento termina de salir y su
+ *		   BTF genera el stop en port_i2cEvIRQHandler.
+ */
+static void port_dmaStop() {
+    DMA_STREAM->CR &= ~DMA_SxCR_EN;
+    I2C_HANDLE.Instance->CR2 &= ~I2C_CR2_DMAEN;
+}
+
+/**
+ *	@brief Genera el stop, deshabilita las interrupciones
+ *		   y llama al callback de fin.
+ */
+static void port_i2cStreamEnd(bool_t resultado) {
+    I2C_TypeDef * i2c = I2C_HANDLE.Instance;
+    port_FinCallbackTypedef fin = finTransmision;
+
+    i2c->CR1 |= I2C_CR1_STOP;
+    i2c->CR2 &= ~(I2C_CR2_ITEVTEN | I2C_CR2_ITBUFEN | I2C_CR2_ITERREN | I2C_CR2_DMAEN);
+    modo = MODO_INACTIVO;
+    tramaSiguiente = NULL;
+    mitadLista = NULL;
+    finTransmision = NULL;
+
+    if (fin != NULL)
+        fin(resultado);
+}
 
 /**
  *   @brief Implementa un delay bloqueante
- *		   utilizando HAL_Delay.
+ *		   utilizando HAL_Delay. Con PORT_DELAY_WFI el
+ *		   núcleo duerme con __WFI entre las interrupciones
+ *		   del SysTick, que lo despiertan cada milisegundo,
+ *		   en lugar de consultar el tick continuamente.
  */
 void port_delay(uint32_t delay) {
+#ifdef PORT_DELAY_WFI
+    uint32_t inicio = HAL_GetTick();
+
+    // igual que HAL_Delay, espera al menos delay milisegundos completos
+    while ((HAL_GetTick() - inicio) <= delay)
+        __WFI();
+#else
     HAL_Delay(delay);
+#endif
 }
+
+/**
+ *   @brief Devuelve el tiempo transcurrido desde
+ *		   el arranque utilizando HAL_GetTick.
+ */
+uint32_t port_getTick() {
+    return HAL_GetTick();
+}
+
+#endif /* LCD_PORT_SOCKET */
@@ -0,0 +1,146 @@
+/**
+ * @file API_lcd_port_ll.c
+ * @brief Implementación de las escrituras y lecturas
+ *        bloqueantes del port accediendo directamente a
+ *        los registros del I2C, sin la HAL. Se compila en
+ *        lugar de las de API_lcd_port.c definiendo
+ *        LCD_PORT_LL. La configuración del periférico sigue
+ *        a cargo de port_init.
+ *
+ *        Cada espera se acota por cantidad de consultas al
+ *        registro de estado en lugar de por HAL_GetTick. Ante
+ *        un NACK o una espera vencida se genera el stop, se
+ *        limpian las banderas y se devuelve false.
+ */
+
+#include "API_lcd_port.h"
+
+#ifdef LCD_PORT_LL
+
+// cantidad máxima de consultas a SR1 esperando una bandera
+#ifndef PORT_LL_ESPERA_MAXIMA
+#define PORT_LL_ESPERA_MAXIMA 100000UL
+#endif
+
+// errores que cortan una transferencia
+#define PORT_LL_ERRORES (I2C_SR1_AF | I2C_SR1_BERR | I2C_SR1_ARLO)
+
+/**
+ *	@brief Funciones privadas para esperar banderas
+ *		   y para salir de una transferencia con error.
+ */
+static bool_t port_llWaitFlag(uint32_t);
+static bool_t port_llStart(uint8_t);
+static bool_t port_llAbort();
+
+/**
+ *   @brief Escribe un byte por I2C.
+ *	@retval Estado de ejecución.
+ */
+bool_t port_i2cWriteByte(uint8_t _byte) {
+    return port_i2cWrite(&_byte, 1);
+}
+
+/**
+ *   @brief Escribe varios bytes por I2C en una única
+ *		   transacción: start, dirección, un byte por cada
+ *		   TXE y stop luego de BTF.
+ *	@retval Estado de ejecución.
+ */
+bool_t port_i2cWrite(const uint8_t * bytes, uint16_t cantidad) {
+    if (!port_llStart(port_getAddress() << 1))
+        return false;
+
+    for (uint16_t indice = 0; indice < cantidad; indice++) {
+        if (!port_llWaitFlag(I2C_SR1_TXE))
+            return port_llAbort();
+        I2C_INSTANCE->DR = bytes[indice];
+    }
+
+    if (!port_llWaitFlag(I2C_SR1_BTF))
+        return port_llAbort();
+
+    I2C_INSTANCE->CR1 |= I2C_CR1_STOP;
+    return true;
+}
+
+/**
+ *   @brief Lee un byte por I2C con la secuencia de
+ *		   recepción de un solo byte del RM0090: se quita el
+ *		   ACK antes de limpiar ADDR y se pide el stop apenas
+ *		   se limpió, mientras se recibe el byte.
+ *	@retval Estado de ejecución.
+ */
+bool_t port_i2cReadByte(uint8_t * _byte) {
+    I2C_INSTANCE->CR1 &= ~I2C_CR1_ACK;
+
+    if (!port_llStart((port_getAddress() << 1) | 1))
+        return false;
+
+    I2C_INSTANCE->CR1 |= I2C_CR1_STOP;
+
+    if (!port_llWaitFlag(I2C_SR1_RXNE))
+        return port_llAbort();
+
+    *_byte = I2C_INSTANCE->DR;
+    I2C_INSTANCE->CR1 |= I2C_CR1_ACK;
+    return true;
+}
+
+/**
+ *	@brief Genera el start, envía la dirección y limpia
+ *		   ADDR leyendo SR1 y SR2.
+ *	@retval Estado de ejecución.
+ */
+static bool_t port_llStart(uint8_t direccion) {
+    uint32_t consultas = 0;
+
+    while (I2C_INSTANCE->SR2 & I2C_SR2_BUSY) {
+        if (++consultas >= PORT_LL_ESPERA_MAXIMA)
+            return false;
+    }
+
+    I2C_INSTANCE->CR1 |= I2C_CR1_START;
+    if (!port_llWaitFlag(I2C_SR1_SB))
+        return port_llAbort();
+
+    I2C_INSTANCE->DR = direccion;
+    if (!port_llWaitFlag(I2C_SR1_ADDR))
+        return port_llAbort();
+
+    (void)I2C_INSTANCE->SR2;
+    return true;
+}
+
+/**
+ *	@brief Espera una bandera de SR1.
+ *	@retval false si llega un error o se agotan las consultas.
+ */
+static bool_t port_llWaitFlag(uint32_t bandera) {
+    for (uint32_t consultas = 0; consultas < PORT_LL_ESPERA_MAXIMA; consultas++) {
+        uint32_t estado = I2C_INSTANCE->SR1;
+
+        if (estado & PORT_LL_ERRORES)
+            return false;
+
+        if (estado & bandera)
+            return true;
+    }
+
+    return false;
+}
+
+/**
+ *	@brief Termina una transferencia fallida: genera el
+ *		   stop, limpia las banderas de error y restablece
+ *		   el ACK.
+ *	@retval false, para usarlo directamente como retorno.
+ */
+static bool_t port_llAbort() {
+    I2C_INSTANCE->CR1 |= I2C_CR1_STOP;
+    I2C_INSTANCE->SR1 &= ~PORT_LL_ERRORES;
+    I2C_INSTANCE->CR1 |= I2C_CR1_ACK;
+    return false;
+}
+
+#endif /* LCD_PORT_LL */
@@ -0,0 +1,386 @@
+/**
+ * @file API_lcd_port_sock.c
+ * @brief Implementación del port sobre el socket Unix del
+ *        servicio de displays simulados. Se compila en lugar
+ *        de API_lcd_port.c definiendo LCD_PORT_SOCKET.
+ *
+ *        Cada función del port es un pedido y espera su
+ *        respuesta, así que el tiempo simulado del display lo
+ *        lleva el servicio: port_getTick devuelve el de ese
+ *        display. Las transmisiones en segundo plano se hacen
+ *        dentro de la llamada que las inicia, pidiendo las
+ *        tramas a los callbacks como lo haría la ISR, y el
+ *        callback de fin se llama antes de volver. No es
+ *        reentrante: la aplicación del host usa el port desde
+ *        un único hilo, como en el target.
+ */
+
+#define _POSIX_C_SOURCE 200809L // sockets y getenv en el host
+
+#include "API_lcd_port_sock.h"
+
+#ifdef LCD_PORT_SOCKET
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// bytes de una escritura: el primero del contenido es la dirección
+#define SOCK_MAX_BYTES (SOCK_MAX_DATOS - 1)
+
+/**
+ *	@brief Conexión con el servicio y display elegido.
+ */
+static int conexion = -1;
+static char ruta[SOCK_MAX_RUTA];
+static uint8_t pantalla = 0;
+static bool_t configurado = false;
+
+/**
+ *	@brief Dirección I2C de 7 bits del LCD.
+ */
+static uint8_t direccionI2C = LCD_ADDRESS;
+
+/**
+ *	@brief Mensaje que se arma para cada pedido y tramas de
+ *		   una transmisión en segundo plano.
+ */
+static uint8_t mensaje[sizeof(SOCK_EncabezadoTypedef) + SOCK_MAX_DATOS];
+static uint8_t * const contenido = &mensaje[sizeof(SOCK_EncabezadoTypedef)];
+static uint8_t flujo[SOCK_MAX_BYTES];
+static bool_t enCurso = false;
+
+/**
+ *	@brief Funciones privadas para la configuración por
+ *		   defecto y el intercambio de mensajes.
+ */
+static void port_sockDefaults();
+static SOCK_RespuestaTypedef port_sockRequest(uint8_t, uint16_t, void *, uint16_t);
+static bool_t port_sockSend(const uint8_t *, size_t);
+static bool_t port_sockReceive(uint8_t *, size_t);
+
+/**
+ *   @brief Elige el socket y el display del servicio. Si
+ *		   había una conexión abierta la cierra.
+ */
+void port_sockConfig(const char * nuevaRuta, uint8_t nuevaPantalla) {
+    port_sockClose();
+
+    strncpy(ruta, (nuevaRuta != NULL) ? nuevaRuta : SOCK_RUTA_DEFECTO, sizeof(ruta) - 1);
+    ruta[sizeof(ruta) - 1] = '\0';
+    pantalla = nuevaPantalla;
+    configurado = true;
+}
+
+/**
+ *   @brief Cierra la conexión con el servicio.
+ */
+void port_sockClose() {
+    if (conexion >= 0)
+        close(conexion);
+    conexion = -1;
+}
+
+/**
+ *   @brief Se conecta al servicio si no lo estaba. Como en el
+ *		   target, volver a llamarla no cambia nada.
+ *	@retval Estado de ejecución.
+ **/
+bool_t port_init() {
+    if (conexion >= 0)
+        return true;
+
+    if (!configurado)
+        port_sockDefaults();
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0)
+        return false;
+
+    struct sockaddr_un direccion;
+    memset(&direccion, 0, sizeof(direccion));
+    direccion.sun_family = AF_UNIX;
+    strncpy(direccion.sun_path, ruta, sizeof(direccion.sun_path) - 1);
+
+    if (connect(fd, (struct sockaddr *)&direccion, sizeof(direccion)) != 0) {
+        close(fd);
+        return false;
+    }
+
+    conexion = fd;
+    return true;
+}
+
+/**
+ *   @brief Cambia la dirección I2C de 7 bits del LCD.
+ */
+void port_setAddress(uint8_t direccion) {
+    direccionI2C = direccion;
+}
+
+/**
+ *   @brief Devuelve la dirección I2C de 7 bits del LCD.
+ */
+uint8_t port_getAddress() {
+    return direccionI2C;
+}
+
+/**
+ *   @brief La velocidad del bus la fija la configuración del
+ *          display en el servicio, así que no se puede cambiar.
+ *	@retval false.
+ */
+bool_t port_setClockSpeed(uint32_t velocidad) {
+    return false;
+}
+
+/**
+ *   @brief Devuelve la velocidad nominal del bus, en Hz.
+ */
+uint32_t port_getClockSpeed() {
+    return I2C_CLOCK_SPEED;
+}
+
+/**
+ *   @brief Escribe un byte por I2C.
+ *	@retval Estado de ejecución.
+ */
+bool_t port_i2cWriteByte(uint8_t _byte) {
+    return port_i2cWrite(&_byte, 1);
+}
+
+/**
+ *   @brief Envía una transacción de escritura al display.
+ *	@retval false si no hubo respuesta de la dirección o
+ *	        la transacción no entra en un mensaje.
+ */
+bool_t port_i2cWrite(const uint8_t * bytes, uint16_t cantidad) {
+    if (bytes == NULL || cantidad > SOCK_MAX_BYTES)
+        return false;
+
+    contenido[0] = direccionI2C;
+    memcpy(&contenido[1], bytes, cantidad);
+    return port_sockRequest(SOCK_OP_ESCRIBIR, cantidad + 1, NULL, 0) == SOCK_RESPUESTA_OK;
+}
+
+/**
+ *   @brief Lee un byte por I2C del display.
+ *	@retval Estado de ejecución.
+ */
+bool_t port_i2cReadByte(uint8_t * _byte) {
+    if (_byte == NULL)
+        return false;
+
+    contenido[0] = direccionI2C;
+    return port_sockRequest(SOCK_OP_LEER, 1, _byte, 1) == SOCK_RESPUESTA_OK;
+}
+
+/**
+ *   @brief Pide todas las tramas al callback y las envía en
+ *		   transacciones de hasta SOCK_MAX_BYTES.
+ *	@retval false si hay otra transmisión en curso.
+ */
+bool_t port_i2cStreamStart(port_TramaCallbackTypedef trama, port_FinCallbackTypedef fin) {
+    if (trama == NULL || enCurso)
+        return false;
+
+    enCurso = true;
+    bool_t resultado = true;
+    bool_t quedan = true;
+
+    while (quedan && resultado) {
+        uint16_t cantidad = 0;
+        while (cantidad < SOCK_MAX_BYTES && (quedan = trama(&flujo[cantidad])))
+            cantidad++;
+        if (cantidad > 0)
+            resultado = port_i2cWrite(flujo, cantidad);
+    }
+
+    enCurso = false;
+    if (fin != NULL)
+        fin(resultado);
+    return true;
+}
+
+/**
+ *   @brief Recorre el buffer circular por mitades como el
+ *		   DMA: copia una mitad, avisa que se puede volver a
+ *		   llenar y sigue con la otra. Cuando el callback
+ *		   devuelve false sale un byte más, el que el DMA ya
+ *		   había cargado, y se envía todo en una transacción
+ *		   (o en varias si no entra en un mensaje).
+ *	@retval false si el buffer es inválido o hay otra transmisión en curso.
+ */
+bool_t port_i2cDmaStart(const uint8_t * buffer, uint16_t largo, port_MitadCallbackTypedef mitad,
+                        port_FinCallbackTypedef fin) {
+    uint16_t largoMitad = largo / 2;
+
+    if (buffer == NULL || mitad == NULL || largo < 2 || (largo % 2) != 0)
+        return false;
+
+    if (largoMitad + 1 > SOCK_MAX_BYTES || enCurso)
+        return false;
+
+    enCurso = true;
+    bool_t resultado = true;
+    uint16_t cantidad = 0;
+    uint8_t actual = 0;
+
+    for (;;) {
+        if (cantidad + largoMitad + 1 > SOCK_MAX_BYTES) {
+            resultado = port_i2cWrite(flujo, cantidad) && resultado;
+            cantidad = 0;
+        }
+
+        memcpy(&flujo[cantidad], &buffer[actual * largoMitad], largoMitad);
+        cantidad += largoMitad;
+        actual = 1 - actual;
+
+        if (!mitad(1 - actual)) {
+            flujo[cantidad++] = buffer[actual * largoMitad];
+            break;
+        }
+    }
+    resultado = port_i2cWrite(flujo, cantidad) && resultado;
+
+    enCurso = false;
+    if (fin != NULL)
+        fin(resultado);
+    return true;
+}
+
+/**
+ *   @brief En el host no hay interrupciones: las
+ *		   transmisiones terminan dentro de la llamada que
+ *		   las inicia.
+ */
+void port_dmaIRQHandler() {
+}
+
+void port_i2cEvIRQHandler() {
+}
+
+void port_i2cErIRQHandler() {
+}
+
+/**
+ *   @brief Avanza el tiempo simulado del display. El
+ *		   servicio puede además esperar en tiempo real.
+ */
+void port_delay(uint32_t delay) {
+    memcpy(contenido, &delay, sizeof(delay));
+    port_sockRequest(SOCK_OP_ESPERAR, sizeof(delay), NULL, 0);
+}
+
+/**
+ *   @brief Devuelve el tiempo simulado del display, en
+ *		   milisegundos, o 0 si no hay servicio.
+ */
+uint32_t port_getTick() {
+    uint32_t tick = 0;
+
+    if (port_sockRequest(SOCK_OP_TICK, 0, &tick, sizeof(tick)) != SOCK_RESPUESTA_OK)
+        return 0;
+    return tick;
+}
+
+/**
+ *   @brief Pide las estadísticas del display.
+ *	@retval Estado de ejecución.
+ */
+bool_t port_sockGetStats(SOCK_EstadisticasTypedef * estadisticas) {
+    if (estadisticas == NULL)
+        return false;
+
+    return port_sockRequest(SOCK_OP_ESTADISTICAS, 0, estadisticas, sizeof(*estadisticas)) ==
+           SOCK_RESPUESTA_OK;
+}
+
+/**
+ *   @brief Pide el texto visible de una fila. El servicio
+ *		   lo envía con el '\0' final.
+ *	@retval Estado de ejecución.
+ */
+bool_t port_sockGetLine(uint8_t fila, char * texto) {
+    if (texto == NULL)
+        return false;
+
+    texto[0] = '\0';
+    contenido[0] = fila;
+    return port_sockRequest(SOCK_OP_LINEA, 1, texto, SOCK_MAX_COLUMNAS + 1) == SOCK_RESPUESTA_OK;
+}
+
+/**
+ *	@brief Toma el socket y el display de las variables de
+ *		   entorno, o los valores por defecto.
+ */
+static void port_sockDefaults() {
+    const char * variableRuta = getenv(SOCK_VARIABLE_RUTA);
+    const char * variablePantalla = getenv(SOCK_VARIABLE_PANTALLA);
+
+    port_sockConfig(variableRuta, (variablePantalla != NULL) ? atoi(variablePantalla) : 0);
+}
+
+/**
+ *	@brief Envía el pedido armado en contenido y recibe la
+ *		   respuesta, copiando hasta largoRespuesta bytes de
+ *		   su contenido. Se conecta si no lo estaba; si falla
+ *		   la comunicación cierra la conexión.
+ *	@retval Resultado del pedido.
+ */
+static SOCK_RespuestaTypedef port_sockRequest(uint8_t operacion, uint16_t largo, void * respuesta,
+                                              uint16_t largoRespuesta) {
+    if (conexion < 0 && !port_init())
+        return SOCK_RESPUESTA_ERROR;
+
+    SOCK_EncabezadoTypedef encabezado = {operacion, pantalla, largo};
+    memcpy(mensaje, &encabezado, sizeof(encabezado));
+
+    if (!port_sockSend(mensaje, sizeof(encabezado) + largo) ||
+        !port_sockReceive((uint8_t *)&encabezado, sizeof(encabezado)) ||
+        encabezado.largo > SOCK_MAX_DATOS || !port_sockReceive(contenido, encabezado.largo)) {
+        port_sockClose();
+        return SOCK_RESPUESTA_ERROR;
+    }
+
+    if (respuesta != NULL)
+        memcpy(respuesta, contenido,
+               (encabezado.largo < largoRespuesta) ? encabezado.largo : largoRespuesta);
+
+    return encabezado.operacion;
+}
+
+/**
+ *	@brief Envía todos los bytes. Con MSG_NOSIGNAL un
+ *		   servicio caído no termina la aplicación.
+ *	@retval Estado de ejecución.
+ */
+static bool_t port_sockSend(const uint8_t * datos, size_t largo) {
+    while (largo > 0) {
+        ssize_t enviados = send(conexion, datos, largo, MSG_NOSIGNAL);
+        if (enviados <= 0)
+            return false;
+        datos += enviados;
+        largo -= enviados;
+    }
+    return true;
+}
+
+/**
+ *	@brief Recibe exactamente la cantidad de bytes pedida.
+ *	@retval false si se cerró la conexión.
+ */
+static bool_t port_sockReceive(uint8_t * datos, size_t largo) {
+    while (largo > 0) {
+        ssize_t recibidos = recv(conexion, datos, largo, 0);
+        if (recibidos <= 0)
+            return false;
+        datos += recibidos;
+        largo -= recibidos;
+    }
+    return true;
+}
+
+#endif /* LCD_PORT_SOCKET */
@@ -0,0 +1,90 @@
+/**
+ * @file API_lcd_profile.c
+ * @brief Tablas de inicialización y tiempos de los
+ * 		  perfiles de controlador.
+ */
+
+#include "API_lcd_profile.h"
+#include "API_lcd_cmd.h"
+#include "API_lcd_port.h"
+
+#ifdef LCD_NATIVE
+// function set de 8 bits y 2 líneas, con y sin la tabla extendida del ST7032
+#define FUNCION_8BITS     0x38
+#define FUNCION_EXTENDIDA 0x39
+
+// comandos de la tabla extendida del ST7032 (IS = 1)
+#define ST7032_OSCILADOR 0x14 // bias 1/5, oscilador interno de 183 Hz
+#define ST7032_CONTRASTE 0x78 // bits C3-C0 del contraste
+#define ST7032_POTENCIA  0x56 // booster encendido, bits C5-C4 del contraste
+#define ST7032_SEGUIDOR  0x6C // seguidor de tensión encendido, Rab = 4
+
+// espera en ms que necesita el seguidor de tensión para estabilizarse
+#define ST7032_ESPERA_SEGUIDOR 200
+
+/**
+ *	@brief Inicialización del AIP31068. Cada paso es una
+ *		   transacción propia y los comandos que no son CLR_LCD
+ *		   tardan menos que ella, por lo que no necesitan espera.
+ */
+static const LCD_PasoInicioTypedef INICIO_AIP31068[] = {
+    {FUNCION_8BITS, 0},
+    {DISPLAY_CONTROL | DISPLAY_ON, 0},
+    {CLR_LCD, LCD_ESPERA_CLEAR},
+    {ENTRY_MODE | AUTOINCREMENT, 0},
+};
+
+/**
+ *	@brief Inicialización del ST7032, según la hoja de
+ *		   datos para 3,3 V: configura el oscilador y el
+ *		   contraste desde la tabla extendida y vuelve a la
+ *		   tabla normal antes de encender la pantalla.
+ */
+static const LCD_PasoInicioTypedef INICIO_ST7032[] = {
+    {FUNCION_8BITS, 0},
+    {FUNCION_EXTENDIDA, 0},
+    {ST7032_OSCILADOR, 0},
+    {ST7032_CONTRASTE, 0},
+    {ST7032_POTENCIA, 0},
+    {ST7032_SEGUIDOR, ST7032_ESPERA_SEGUIDOR},
+    {FUNCION_8BITS, 0},
+    {DISPLAY_CONTROL | DISPLAY_ON, 0},
+    {CLR_LCD, LCD_ESPERA_CLEAR},
+    {ENTRY_MODE | AUTOINCREMENT, 0},
+};
+#endif /* LCD_NATIVE */
+
+const LCD_PerfilTypedef LCD_PERFIL_PCF8574 = {
+    .nombre = "PCF8574",
+    .direccion = LCD_ADDRESS,
+    .nativo = false,
+    .inicio = NULL,
+    .pasosInicio = 0,
+    .esperaEncendido = 0,
+    .esperaClear = LCD_ESPERA_CLEAR,
+    .tiempoInstruccion = 37, // lo cubren las esperas de los flancos de E
+};
+
+#ifdef LCD_NATIVE
+const LCD_PerfilTypedef LCD_PERFIL_AIP31068 = {
+    .nombre = "AIP31068",
+    .direccion = LCD_ADDRESS_NATIVO,
+    .nativo = true,
+    .inicio = INICIO_AIP31068,
+    .pasosInicio = sizeof(INICIO_AIP31068) / sizeof(INICIO_AIP31068[0]),
+    .esperaEncendido = 20,
+    .esperaClear = LCD_ESPERA_CLEAR,
+    .tiempoInstruccion = 37,
+};
+
+const LCD_PerfilTypedef LCD_PERFIL_ST7032 = {
+    .nombre = "ST7032",
+    .direccion = LCD_ADDRESS_NATIVO,
+    .nativo = true,
+    .inicio = INICIO_ST7032,
+    .pasosInicio = sizeof(INICIO_ST7032) / sizeof(INICIO_ST7032[0]),
+    .esperaEncendido = 40,
+    .esperaClear = LCD_ESPERA_CLEAR,
+    .tiempoInstruccion = 27, // 26,3 µs con el oscilador de 380 kHz
+};
+#endif /* LCD_NATIVE */
@@ -0,0 +1,410 @@
+/**
+ * @file API_lcd_queue.c
+ * @brief Implementación de la cola de pedidos del LCD.
+ */
+
+#include <string.h>
+
+#include "API_lcd_queue.h"
+#include "API_lcd_pool.h"
+#include "API_types.h"
+
+#ifdef LCD_QUEUE
+
+/**
+ *	@brief Tipos de pedido que admite la cola.
+ */
+typedef enum {
+    LCD_PEDIDO_TEXTO,
+    LCD_PEDIDO_REGION,
+    LCD_PEDIDO_CARACTER,
+    LCD_PEDIDO_CURSOR,
+    LCD_PEDIDO_CGRAM
+} LCD_PedidoTipoTypedef;
+
+/**
+ *	@brief Pedido encolado. Los datos apuntan a un
+ *		   bloque del pool de al menos capacidad bytes.
+ *		   En los pedidos de región los dos primeros bytes
+ *		   son la fila y la posición; en los de CGRAM, el
+ *		   primero es la posición del caracter.
+ */
+typedef struct {
+    LCD_PedidoTipoTypedef tipo;
+    uint8_t capacidad;
+    uint8_t * datos;
+} LCD_PedidoTypedef;
+
+/**
+ *	@brief Buffer circular de pedidos.
+ */
+static LCD_PedidoTypedef cola[LCD_COLA_CAPACIDAD];
+static uint8_t inicio = 0;
+static uint8_t cantidad = 0;
+
+static LCD_ColaPoliticaTypedef politica = LCD_COLA_DESCARTAR_NUEVO;
+static uint32_t esperaPermitida = LCD_COLA_ESPERA_MAXIMA;
+
+static LCD_ColaStatsTypedef estadisticas;
+
+static LCD_StatusTypedef LCD_queuePush(LCD_PedidoTipoTypedef, const uint8_t *, uint8_t);
+static bool_t LCD_queueCoalesce(LCD_PedidoTipoTypedef, const uint8_t *, uint8_t);
+static bool_t LCD_queueSameRegion(const LCD_PedidoTypedef *, LCD_PedidoTipoTypedef,
+                                  const uint8_t *, uint8_t);
+static bool_t LCD_queueOverlaps(const LCD_PedidoTypedef *, LCD_PedidoTipoTypedef,
+                                const uint8_t *, uint8_t);
+static void LCD_queueDropOldest();
+static uint32_t LCD_queueCost(const LCD_PedidoTypedef *);
+
+/**
+ *	@brief Vacía la cola e inicializa el pool.
+ *		   La política seleccionada se conserva.
+ */
+void LCD_queueInit() {
+    inicio = 0;
+    cantidad = 0;
+    memset(&estadisticas, 0, sizeof(estadisticas));
+    LCD_poolInit();
+}
+
+/**
+ *	@brief Selecciona la política de la cola.
+ */
+void LCD_queueSetPolicy(LCD_ColaPoliticaTypedef nuevaPolitica, uint32_t espera) {
+    politica = nuevaPolitica;
+    esperaPermitida = espera;
+}
+
+/**
+ *	@brief Encola un texto. Se copia como máximo lo que
+ *		   entra en el bloque más grande del pool, que alcanza
+ *		   para una pantalla completa con su salto de línea.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_queuePrintText(const char * ptrTexto) {
+    if (ptrTexto == NULL)
+        return LCD_ERROR;
+
+    size_t largo = strlen(ptrTexto);
+    if (largo > LCD_POOL_TAM_CLASE_2 - 1)
+        largo = LCD_POOL_TAM_CLASE_2 - 1;
+
+    uint8_t datos[LCD_POOL_TAM_CLASE_2];
+    memcpy(datos, ptrTexto, largo);
+    datos[largo] = '\0';
+
+    return LCD_queuePush(LCD_PEDIDO_TEXTO, datos, largo + 1);
+}
+
+/**
+ *	@brief Encola un texto en una región de una fila.
+ *		   El texto se corta al final de la fila.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_queuePrintAt(uint8_t fila, uint8_t posicion, const char * ptrTexto) {
+    if (ptrTexto == NULL || posicion >= LCD_CANTIDAD_COLUMNAS)
+        return LCD_ERROR;
+
+    size_t largo = strlen(ptrTexto);
+    if (largo > (size_t)(LCD_CANTIDAD_COLUMNAS - posicion))
+        largo = LCD_CANTIDAD_COLUMNAS - posicion;
+
+    uint8_t datos[2 + LCD_CANTIDAD_COLUMNAS + 1];
+    datos[0] = fila;
+    datos[1] = posicion;
+    memcpy(&datos[2], ptrTexto, largo);
+    datos[2 + largo] = '\0';
+
+    return LCD_queuePush(LCD_PEDIDO_REGION, datos, 2 + largo + 1);
+}
+
+/**
+ *	@brief Encola un caracter.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_queuePrintChar(char caracter) {
+    uint8_t datos = caracter;
+    return LCD_queuePush(LCD_PEDIDO_CARACTER, &datos, 1);
+}
+
+/**
+ *	@brief Encola un movimiento de cursor.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_queueSetCursor(uint8_t fila, uint8_t posicion) {
+    uint8_t datos[] = {fila, posicion};
+    return LCD_queuePush(LCD_PEDIDO_CURSOR, datos, sizeof(datos));
+}
+
+/**
+ *	@brief Encola la carga de un caracter en la CGRAM.
+ *		   El primer byte del bloque guarda la posición.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_queueCreateChar(uint8_t posicion, const uint8_t * patron) {
+    if (patron == NULL || posicion >= LCD_CANTIDAD_CARACTERES_CGRAM)
+        return LCD_ERROR;
+
+    uint8_t datos[1 + LCD_ALTO_CARACTER];
+    datos[0] = posicion;
+    memcpy(&datos[1], patron, LCD_ALTO_CARACTER);
+    return LCD_queuePush(LCD_PEDIDO_CGRAM, datos, sizeof(datos));
+}
+
+/**
+ *	@brief Toma el pedido más antiguo, lo envía con la
+ *		   función bloqueante que corresponde y libera
+ *		   su bloque del pool.
+ *	@retval Estado de ejecución del pedido.
+ */
+LCD_StatusTypedef LCD_queueProcess() {
+    if (cantidad == 0)
+        return LCD_OK;
+
+    LCD_PedidoTypedef pedido = cola[inicio];
+    inicio = (inicio + 1) % LCD_COLA_CAPACIDAD;
+    cantidad--;
+
+    LCD_StatusTypedef estado = LCD_ERROR;
+    switch (pedido.tipo) {
+    case LCD_PEDIDO_TEXTO:
+        estado = LCD_printText((char *)pedido.datos);
+        break;
+    case LCD_PEDIDO_REGION:
+        estado = LCD_printAt(pedido.datos[0], pedido.datos[1], (char *)&pedido.datos[2]);
+        break;
+    case LCD_PEDIDO_CARACTER:
+        estado = LCD_printChar(pedido.datos[0]);
+        break;
+    case LCD_PEDIDO_CURSOR:
+        estado = LCD_setCursor(pedido.datos[0], pedido.datos[1]);
+        break;
+    case LCD_PEDIDO_CGRAM:
+        estado = LCD_createChar(pedido.datos[0], &pedido.datos[1]);
+        break;
+    }
+
+    LCD_poolFree(pedido.datos);
+    estadisticas.procesados++;
+    return estado;
+}
+
+/**
+ *	@brief Cantidad de pedidos pendientes de envío.
+ */
+uint8_t LCD_queuePending() {
+    return cantidad;
+}
+
+/**
+ *	@brief Copia las estadísticas de la cola.
+ */
+void LCD_queueGetStats(LCD_ColaStatsTypedef * stats) {
+    if (stats == NULL)
+        return;
+
+    *stats = estadisticas;
+    stats->pendientes = cantidad;
+}
+
+/**
+ *	@brief Copia los datos del pedido a un bloque del pool
+ *		   y lo agrega al final de la cola. Si no hay lugar
+ *		   actúa según la política seleccionada.
+ *	@retval Estado de ejecución.
+ */
+static LCD_StatusTypedef LCD_queuePush(LCD_PedidoTipoTypedef tipo, const uint8_t * datos,
+                                       uint8_t largo) {
+    if (politica == LCD_COLA_COALESCER && LCD_queueCoalesce(tipo, datos, largo)) {
+        estadisticas.coalescidos++;
+        return LCD_OK;
+    }
+
+    uint8_t * bloque = NULL;
+    bool_t esperando = false;
+    uint32_t inicioEspera = 0;
+
+    while (true) {
+        if (cantidad < LCD_COLA_CAPACIDAD) {
+            bloque = LCD_poolAlloc(largo);
+            if (bloque != NULL)
+                break;
+        }
+
+        if (politica == LCD_COLA_DESCARTAR_VIEJO && cantidad > 0) {
+            LCD_queueDropOldest();
+            continue;
+        }
+
+        if (politica == LCD_COLA_BLOQUEAR && cantidad > 0) {
+            uint32_t ahora = port_getTick();
+            if (!esperando) {
+                esperando = true;
+                inicioEspera = ahora;
+                estadisticas.bloqueos++;
+            }
+            // no se empieza un envío que terminaría después del plazo
+            if (ahora - inicioEspera + LCD_queueCost(&cola[inicio]) > esperaPermitida) {
+                estadisticas.bloqueosVencidos++;
+                estadisticas.descartados++;
+                return LCD_ERROR;
+            }
+            LCD_queueProcess();
+            continue;
+        }
+
+        estadisticas.descartados++;
+        return LCD_ERROR;
+    }
+
+    if (esperando) {
+        uint32_t espera = port_getTick() - inicioEspera;
+        if (espera > estadisticas.esperaMaxima)
+            estadisticas.esperaMaxima = espera;
+    }
+
+    memcpy(bloque, datos, largo);
+
+    LCD_PedidoTypedef * pedido = &cola[(inicio + cantidad) % LCD_COLA_CAPACIDAD];
+    pedido->tipo = tipo;
+    pedido->capacidad = largo;
+    pedido->datos = bloque;
+    cantidad++;
+
+    estadisticas.encolados++;
+    if (cantidad > estadisticas.maximoPendientes)
+        estadisticas.maximoPendientes = cantidad;
+
+    return LCD_OK;
+}
+
+/**
+ *	@brief Busca, del más nuevo al más viejo, un pedido
+ *		   pendiente de la misma región y le reemplaza el
+ *		   contenido. La búsqueda se corta en el primer pedido
+ *		   que escribe celdas de la región o mueve el cursor,
+ *		   porque reemplazar uno anterior cambiaría el resultado
+ *		   en pantalla o la posición final del cursor.
+ *	@retval true si el pedido nuevo se combinó con uno pendiente.
+ */
+static bool_t LCD_queueCoalesce(LCD_PedidoTipoTypedef tipo, const uint8_t * datos,
+                                uint8_t largo) {
+    if (tipo == LCD_PEDIDO_CARACTER || tipo == LCD_PEDIDO_CURSOR)
+        return false; // dependen de la posición del cursor
+
+    for (uint8_t indice = cantidad; indice > 0; indice--) {
+        LCD_PedidoTypedef * pedido = &cola[(inicio + indice - 1) % LCD_COLA_CAPACIDAD];
+
+        if (LCD_queueSameRegion(pedido, tipo, datos, largo)) {
+            if (largo > pedido->capacidad) {
+                uint8_t * bloque = LCD_poolAlloc(largo);
+                if (bloque == NULL)
+                    return false;
+                LCD_poolFree(pedido->datos);
+                pedido->datos = bloque;
+                pedido->capacidad = largo;
+            }
+            memcpy(pedido->datos, datos, largo);
+            return true;
+        }
+
+        if (LCD_queueOverlaps(pedido, tipo, datos, largo))
+            return false;
+    }
+
+    return false;
+}
+
+/**
+ *	@brief Indica si un pedido pendiente cubre exactamente
+ *		   las mismas celdas que el pedido nuevo.
+ */
+static bool_t LCD_queueSameRegion(const LCD_PedidoTypedef * pedido, LCD_PedidoTipoTypedef tipo,
+                                  const uint8_t * datos, uint8_t largo) {
+    if (pedido->tipo != tipo)
+        return false;
+
+    switch (tipo) {
+    case LCD_PEDIDO_TEXTO:
+        return true; // ocupa la pantalla completa
+    case LCD_PEDIDO_REGION:
+        return pedido->datos[0] == datos[0] && pedido->datos[1] == datos[1] &&
+               strlen((char *)&pedido->datos[2]) == (size_t)(largo - 3);
+    case LCD_PEDIDO_CGRAM:
+        return pedido->datos[0] == datos[0];
+    default:
+        return false;
+    }
+}
+
+/**
+ *	@brief Indica si un pedido pendiente escribe alguna
+ *		   celda del pedido nuevo. Los caracteres sueltos, los
+ *		   movimientos del cursor y las cargas de la CGRAM, que
+ *		   terminan con el cursor en (0, 0), se consideran
+ *		   superpuestos: adelantar un pedido por delante de ellos,
+ *		   o una carga por delante de otro pedido, cambia la
+ *		   posición en que queda el cursor.
+ */
+static bool_t LCD_queueOverlaps(const LCD_PedidoTypedef * pedido, LCD_PedidoTipoTypedef tipo,
+                                const uint8_t * datos, uint8_t largo) {
+    if (tipo == LCD_PEDIDO_CGRAM)
+        return true;
+
+    switch (pedido->tipo) {
+    case LCD_PEDIDO_TEXTO:
+    case LCD_PEDIDO_CARACTER:
+    case LCD_PEDIDO_CURSOR:
+    case LCD_PEDIDO_CGRAM:
+        return true;
+    case LCD_PEDIDO_REGION: {
+        if (tipo == LCD_PEDIDO_TEXTO)
+            return true;
+        if (pedido->datos[0] != datos[0])
+            return false;
+        uint8_t desde = pedido->datos[1];
+        uint8_t hasta = desde + strlen((char *)&pedido->datos[2]);
+        return datos[1] < hasta && desde < datos[1] + (largo - 3);
+    }
+    default:
+        return false;
+    }
+}
+
+/**
+ *	@brief Estima en ms lo que tarda en enviarse un pedido,
+ *		   contando sus mensajes. Con un controlador nativo
+ *		   no hay esperas por nibble y el envío tarda menos
+ *		   de un tick.
+ */
+static uint32_t LCD_queueCost(const LCD_PedidoTypedef * pedido) {
+    uint32_t mensajes = 1;
+
+    switch (pedido->tipo) {
+    case LCD_PEDIDO_TEXTO:
+        mensajes = strlen((char *)pedido->datos) + 3; // clear y dos posicionamientos
+        break;
+    case LCD_PEDIDO_REGION:
+        mensajes = strlen((char *)&pedido->datos[2]) + 1;
+        break;
+    case LCD_PEDIDO_CGRAM:
+        mensajes = LCD_ALTO_CARACTER + 2; // dirección de la CGRAM y vuelta a la DDRAM
+        break;
+    default:
+        break;
+    }
+
+    return LCD_getProfile()->nativo ? 0 : mensajes * LCD_COLA_MS_X_MENSAJE;
+}
+
+/**
+ *	@brief Descarta el pedido más antiguo sin enviarlo.
+ */
+static void LCD_queueDropOldest() {
+    LCD_poolFree(cola[inicio].datos);
+    inicio = (inicio + 1) % LCD_COLA_CAPACIDAD;
+    cantidad--;
+    estadisticas.descartadosViejos++;
+}
+
+#endif /* LCD_QUEUE */
@@ -0,0 +1,271 @@
+/**
+ * @file API_lcd_record.c
+ * @brief Implementación de la grabación y la lectura
+ *        del registro de llamadas.
+ */
+
+#include <string.h>
+
+#include "API_lcd_record.h"
+#include "API_types.h"
+
+#ifdef LCD_RECORDER
+
+// bits de datos de cada byte de los ticks; el bit alto indica que sigue otro
+#define BITS_X_BYTE 7
+#define SIGUE       0x80
+
+// bytes de los ticks de una llamada como máximo (32 bits de a 7)
+#define MAX_BYTES_TICKS 5
+
+/**
+ *	@brief Formato de una llamada: bytes de argumentos y
+ *		   si lleva texto.
+ */
+typedef struct {
+    uint8_t largo;
+    bool_t texto;
+} LCD_FormatoTypedef;
+
+static const LCD_FormatoTypedef FORMATOS[] = {
+    [LCD_LLAMADA_INIT] = {0, false},
+    [LCD_LLAMADA_REATTACH] = {0, false},
+    [LCD_LLAMADA_INIT_LAZY] = {1, false},
+    [LCD_LLAMADA_CLEAR] = {0, false},
+    [LCD_LLAMADA_PRINT_CHAR] = {1, false},
+    [LCD_LLAMADA_PRINT_TEXT] = {0, true},
+    [LCD_LLAMADA_PRINT_AT] = {2, true},
+    [LCD_LLAMADA_SET_CURSOR] = {2, false},
+    [LCD_LLAMADA_CURSOR_ON] = {0, false},
+    [LCD_LLAMADA_CURSOR_OFF] = {0, false},
+    [LCD_LLAMADA_CREATE_CHAR] = {LCD_GRABACION_MAX_ARGUMENTOS, false},
+    [LCD_LLAMADA_SET_POWER_MODE] = {1, false},
+    [LCD_LLAMADA_SET_IDLE_TIMEOUT] = {5, false},
+    [LCD_LLAMADA_NOTIFY_ACTIVITY] = {0, false},
+    [LCD_LLAMADA_SET_ENTRY_MODE] = {1, false},
+};
+
+_Static_assert(sizeof(FORMATOS) / sizeof(FORMATOS[0]) == LCD_LLAMADAS,
+               "FORMATOS debe tener una entrada por cada LCD_LlamadaTypedef");
+
+/**
+ *	@brief Estado de la grabación. registro en NULL indica
+ *		   que no hay una grabación en curso.
+ */
+static uint8_t * registro = NULL;
+static uint32_t tamanioRegistro;
+static uint32_t largoRegistro;
+static uint32_t tickAnterior;
+static uint32_t perdidas;
+
+static uint8_t LCD_recordTextLength(const char *);
+
+/**
+ *	@brief Escribe el encabezado y toma el tick de inicio.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_recordStart(uint8_t * buffer, uint32_t tamanio) {
+    if (buffer == NULL || tamanio < LCD_GRABACION_ENCABEZADO)
+        return LCD_ERROR;
+
+    buffer[0] = 'L';
+    buffer[1] = 'R';
+    buffer[2] = LCD_GRABACION_VERSION;
+    tamanioRegistro = tamanio;
+    largoRegistro = LCD_GRABACION_ENCABEZADO;
+    tickAnterior = port_getTick();
+    perdidas = 0;
+    registro = buffer;
+    return LCD_OK;
+}
+
+/**
+ *	@brief Termina la grabación en curso.
+ *	@retval Largo del registro.
+ */
+uint32_t LCD_recordStop() {
+    registro = NULL;
+    return largoRegistro;
+}
+
+/**
+ *	@brief Llamadas descartadas por falta de lugar.
+ */
+uint32_t LCD_recordLost() {
+    return perdidas;
+}
+
+/**
+ *	@brief Codifica la llamada en un buffer local y la agrega
+ *		   sólo si entra completa. Un texto NULL no se graba:
+ *		   la API lo rechaza sin tocar el LCD.
+ */
+void LCD_recordCall(LCD_LlamadaTypedef llamada, const uint8_t * argumentos, const char * texto) {
+    uint8_t codificada[1 + MAX_BYTES_TICKS + LCD_GRABACION_MAX_ARGUMENTOS + 1];
+    uint8_t largo = 0;
+
+    if (registro == NULL || llamada >= LCD_LLAMADAS)
+        return;
+
+    if (FORMATOS[llamada].texto && texto == NULL)
+        return;
+
+    uint32_t tick = port_getTick();
+    uint32_t ticks = tick - tickAnterior;
+
+    codificada[largo++] = llamada;
+    do {
+        codificada[largo] = ticks & ~SIGUE;
+        ticks >>= BITS_X_BYTE;
+        if (ticks != 0)
+            codificada[largo] |= SIGUE;
+        largo++;
+    } while (ticks != 0);
+
+    if (FORMATOS[llamada].largo > 0) {
+        memcpy(&codificada[largo], argumentos, FORMATOS[llamada].largo);
+        largo += FORMATOS[llamada].largo;
+    }
+
+    uint8_t largoTexto = FORMATOS[llamada].texto ? LCD_recordTextLength(texto) : 0;
+    if (FORMATOS[llamada].texto)
+        codificada[largo++] = largoTexto;
+
+    if (largoRegistro + largo + largoTexto > tamanioRegistro) {
+        perdidas++;
+        return;
+    }
+
+    memcpy(&registro[largoRegistro], codificada, largo);
+    if (largoTexto > 0)
+        memcpy(&registro[largoRegistro + largo], texto, largoTexto);
+    largoRegistro += largo + largoTexto;
+    tickAnterior = tick;
+}
+
+/**
+ *	@brief Verifica el encabezado y deja el lector al
+ *		   comienzo de la primera llamada.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_recordOpen(LCD_LectorTypedef * lector, const uint8_t * datos,
+                                 uint32_t largo) {
+    if (lector == NULL || datos == NULL || largo < LCD_GRABACION_ENCABEZADO)
+        return LCD_ERROR;
+
+    if (datos[0] != 'L' || datos[1] != 'R' || datos[2] != LCD_GRABACION_VERSION)
+        return LCD_ERROR;
+
+    lector->datos = datos;
+    lector->largo = largo;
+    lector->posicion = LCD_GRABACION_ENCABEZADO;
+    lector->tick = 0;
+    return LCD_OK;
+}
+
+/**
+ *	@brief Decodifica una llamada y acumula los ticks.
+ *	@retval false al final del registro o si está truncado.
+ */
+bool_t LCD_recordNext(LCD_LectorTypedef * lector, LCD_RegistroTypedef * llamada) {
+    const uint8_t * datos = lector->datos;
+    uint32_t posicion = lector->posicion;
+    uint32_t ticks = 0;
+    uint8_t desplazamiento = 0;
+
+    if (posicion >= lector->largo || datos[posicion] >= LCD_LLAMADAS)
+        return false;
+    llamada->llamada = datos[posicion++];
+
+    do {
+        if (posicion >= lector->largo || desplazamiento >= BITS_X_BYTE * MAX_BYTES_TICKS)
+            return false;
+        ticks |= (uint32_t)(datos[posicion] & ~SIGUE) << desplazamiento;
+        desplazamiento += BITS_X_BYTE;
+    } while (datos[posicion++] & SIGUE);
+
+    uint8_t largoArgumentos = FORMATOS[llamada->llamada].largo;
+    if (posicion + largoArgumentos > lector->largo)
+        return false;
+    memcpy(llamada->argumentos, &datos[posicion], largoArgumentos);
+    posicion += largoArgumentos;
+
+    uint8_t largoTexto = 0;
+    if (FORMATOS[llamada->llamada].texto) {
+        if (posicion >= lector->largo)
+            return false;
+        largoTexto = datos[posicion++];
+        if (largoTexto > LCD_GRABACION_MAX_TEXTO || posicion + largoTexto > lector->largo)
+            return false;
+        memcpy(llamada->texto, &datos[posicion], largoTexto);
+        posicion += largoTexto;
+    }
+    llamada->texto[largoTexto] = '\0';
+
+    lector->tick += ticks;
+    llamada->tick = lector->tick;
+    lector->posicion = posicion;
+    return true;
+}
+
+/**
+ *	@brief Llama a la función de la API con los argumentos
+ *		   grabados.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_recordReplay(const LCD_RegistroTypedef * llamada) {
+    const uint8_t * argumentos = llamada->argumentos;
+
+    switch (llamada->llamada) {
+    case LCD_LLAMADA_INIT:
+        return LCD_init();
+    case LCD_LLAMADA_REATTACH:
+        return LCD_reattach();
+    case LCD_LLAMADA_INIT_LAZY:
+        return LCD_initLazy(argumentos[0]);
+    case LCD_LLAMADA_CLEAR:
+        return LCD_clear();
+    case LCD_LLAMADA_PRINT_CHAR:
+        return LCD_printChar(argumentos[0]);
+    case LCD_LLAMADA_PRINT_TEXT:
+        return LCD_printText((char *)llamada->texto);
+    case LCD_LLAMADA_PRINT_AT:
+        return LCD_printAt(argumentos[0], argumentos[1], llamada->texto);
+    case LCD_LLAMADA_SET_CURSOR:
+        return LCD_setCursor(argumentos[0], argumentos[1]);
+    case LCD_LLAMADA_CURSOR_ON:
+        return LCD_cursorOn();
+    case LCD_LLAMADA_CURSOR_OFF:
+        return LCD_cursorOff();
+    case LCD_LLAMADA_CREATE_CHAR:
+        return LCD_createChar(argumentos[0], &argumentos[1]);
+    case LCD_LLAMADA_SET_POWER_MODE:
+        return LCD_setPowerMode(argumentos[0]);
+    case LCD_LLAMADA_SET_IDLE_TIMEOUT:
+        LCD_setIdleTimeout(argumentos[0] | argumentos[1] << 8 | argumentos[2] << 16 |
+                               (uint32_t)argumentos[3] << 24,
+                           argumentos[4]);
+        return LCD_OK;
+    case LCD_LLAMADA_NOTIFY_ACTIVITY:
+        return LCD_notifyActivity();
+    case LCD_LLAMADA_SET_ENTRY_MODE:
+        return LCD_setEntryMode(argumentos[0]);
+    default:
+        return LCD_ERROR;
+    }
+}
+
+/**
+ *	@brief Largo del texto que se graba, limitado a
+ *		   LCD_GRABACION_MAX_TEXTO.
+ */
+static uint8_t LCD_recordTextLength(const char * texto) {
+    uint8_t largo = 0;
+
+    while (largo < LCD_GRABACION_MAX_TEXTO && texto[largo] != '\0')
+        largo++;
+
+    return largo;
+}
+
+#endif /* LCD_RECORDER */
@@ -0,0 +1,460 @@
+/**
+ * @file API_lcd_shell.c
+ * @brief Implementación de la consola de comandos.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "API_lcd_shell.h"
+#include "API_lcd_bench.h"
+#include "API_lcd_buffer.h"
+#include "API_lcd_record.h"
+#include "API_types.h"
+
+#ifdef LCD_SHELL
+
+#define CARACTER_BORRAR     '\b'
+#define CARACTER_DEL        0x7F
+#define CARACTER_NO_VISIBLE '?'
+#define FIN_DE_LINEA        "\r\n"
+
+/**
+ *	@brief Un comando de la consola. ejecutar recibe el
+ *		   argumento que sigue al nombre, o NULL.
+ */
+typedef struct {
+    const char * nombre;
+    LCD_StatusTypedef (*ejecutar)(const char *);
+} LCD_ComandoTypedef;
+
+/**
+ *	@brief Línea de comando que llena LCD_shellInput, en
+ *		   interrupción, y vacía LCD_shellProcess.
+ */
+static char linea[LCD_SHELL_MAX_LINEA];
+static volatile uint8_t largoLinea = 0;
+static volatile bool_t lineaLista = false;
+
+/**
+ *	@brief Línea de respuesta en armado.
+ */
+static char salida[LCD_SHELL_MAX_SALIDA];
+static uint8_t largoSalida = 0;
+
+static LCD_ShellSalidaTypedef escribir = NULL;
+static LCD_ShellRefrescoTypedef cambiarRefresco = NULL;
+static uint32_t periodoRefresco = 0; // 0 hasta que se cambia desde la consola
+
+#ifdef LCD_RECORDER
+/**
+ *	@brief Registro de la traza y nombre de cada llamada, con la
+ *		   cantidad de argumentos que se muestran, en el orden de
+ *		   LCD_LlamadaTypedef.
+ */
+static uint8_t traza[LCD_SHELL_MAX_TRAZA];
+static bool_t trazando = false;
+
+static const char * const NOMBRE_LLAMADA[LCD_LLAMADAS] = {
+    "init",       "reattach",     "initLazy",       "clear",          "printChar",
+    "printText",  "printAt",      "setCursor",      "cursorOn",       "cursorOff",
+    "createChar", "setPowerMode", "setIdleTimeout", "notifyActivity", "setEntryMode"};
+static const uint8_t ARGUMENTOS_MOSTRADOS[LCD_LLAMADAS] = {0, 0, 1, 0, 1, 0, 2, 2,
+                                                           0, 0, 1, 1, 0, 0, 1};
+#endif
+
+static LCD_StatusTypedef LCD_shellHelp(const char *);
+static LCD_StatusTypedef LCD_shellStats(const char *);
+static LCD_StatusTypedef LCD_shellShadow(const char *);
+static LCD_StatusTypedef LCD_shellBench(const char *);
+static LCD_StatusTypedef LCD_shellBus(const char *);
+static LCD_StatusTypedef LCD_shellRefresh(const char *);
+static LCD_StatusTypedef LCD_shellTrace(const char *);
+static bool_t LCD_shellNumber(const char *, uint32_t *);
+static void LCD_shellText(const char *);
+static void LCD_shellDecimal(uint32_t);
+static void LCD_shellField(const char *, uint32_t);
+static void LCD_shellEndLine();
+
+static const LCD_ComandoTypedef COMANDOS[] = {
+    {"ayuda", LCD_shellHelp},   {"stats", LCD_shellStats},       {"sombra", LCD_shellShadow},
+    {"bench", LCD_shellBench},  {"bus", LCD_shellBus},           {"refresco", LCD_shellRefresh},
+    {"traza", LCD_shellTrace},
+};
+
+/**
+ *	@brief Inicializa la consola con la línea vacía.
+ */
+void LCD_shellInit(LCD_ShellSalidaTypedef salidaLinea, LCD_ShellRefrescoTypedef refresco) {
+    escribir = salidaLinea;
+    cambiarRefresco = refresco;
+    periodoRefresco = 0;
+    largoLinea = 0;
+    lineaLista = false;
+    largoSalida = 0;
+}
+
+/**
+ *	@brief Agrega el caracter a la línea. Sólo escribe en la
+ *		   línea mientras no está lista, y LCD_shellProcess sólo
+ *		   la lee cuando lo está, así que no hace falta otra
+ *		   sincronización.
+ */
+void LCD_shellInput(char caracter) {
+    if (lineaLista)
+        return;
+
+    if (caracter == '\r' || caracter == '\n') {
+        if (largoLinea > 0)
+            lineaLista = true;
+    } else if (caracter == CARACTER_BORRAR || caracter == CARACTER_DEL) {
+        if (largoLinea > 0)
+            largoLinea--;
+    } else if (largoLinea < LCD_SHELL_MAX_LINEA - 1) {
+        linea[largoLinea++] = caracter;
+    }
+}
+
+/**
+ *	@brief Ejecuta la línea lista y deja lugar para la próxima.
+ *	@retval LCD_ERROR si el comando no existe o falló.
+ */
+LCD_StatusTypedef LCD_shellProcess() {
+    if (!lineaLista)
+        return LCD_OK;
+
+    linea[largoLinea] = '\0';
+    LCD_StatusTypedef estado = LCD_shellExecute(linea);
+
+    largoLinea = 0;
+    lineaLista = false;
+    return estado;
+}
+
+/**
+ *	@brief Separa el nombre del comando de su argumento y lo
+ *		   busca en la tabla de comandos.
+ *	@retval LCD_ERROR si el comando no existe o falló.
+ */
+LCD_StatusTypedef LCD_shellExecute(const char * comando) {
+    char nombre[LCD_SHELL_MAX_LINEA];
+    uint8_t largo = 0;
+
+    if (comando == NULL)
+        return LCD_ERROR;
+
+    while (*comando == ' ')
+        comando++;
+    while (comando[largo] != '\0' && comando[largo] != ' ' && largo < sizeof(nombre) - 1) {
+        nombre[largo] = comando[largo];
+        largo++;
+    }
+    nombre[largo] = '\0';
+
+    const char * argumento = &comando[largo];
+    while (*argumento == ' ')
+        argumento++;
+    if (*argumento == '\0')
+        argumento = NULL;
+
+    for (uint8_t indice = 0; indice < sizeof(COMANDOS) / sizeof(COMANDOS[0]); indice++) {
+        if (strcmp(nombre, COMANDOS[indice].nombre) == 0)
+            return COMANDOS[indice].ejecutar(argumento);
+    }
+
+    if (largo == 0)
+        return LCD_OK;
+
+    LCD_shellText("comando desconocido: ");
+    LCD_shellText(nombre);
+    LCD_shellEndLine();
+    return LCD_ERROR;
+}
+
+/**
+ *	@brief Lista los comandos.
+ */
+static LCD_StatusTypedef LCD_shellHelp(const char * argumento) {
+    LCD_shellText("stats | sombra | bench [tramas] | bus [hz] | refresco [ms] | traza on|off");
+    LCD_shellEndLine();
+    return LCD_OK;
+}
+
+/**
+ *	@brief Muestra las estadísticas de la cola y del pool.
+ */
+static LCD_StatusTypedef LCD_shellStats(const char * argumento) {
+    LCD_StatsTypedef stats;
+
+    if (LCD_getStats(&stats) == LCD_ERROR)
+        return LCD_ERROR;
+
+    LCD_shellText("cola:");
+    LCD_shellField("encolados", stats.cola.encolados);
+    LCD_shellField("procesados", stats.cola.procesados);
+    LCD_shellField("descartados", stats.cola.descartados);
+    LCD_shellField("viejos", stats.cola.descartadosViejos);
+    LCD_shellField("coalescidos", stats.cola.coalescidos);
+    LCD_shellEndLine();
+
+    LCD_shellText("cola:");
+    LCD_shellField("bloqueos", stats.cola.bloqueos);
+    LCD_shellField("vencidos", stats.cola.bloqueosVencidos);
+    LCD_shellField("espera", stats.cola.esperaMaxima);
+    LCD_shellField("pendientes", stats.cola.pendientes);
+    LCD_shellField("maximo", stats.cola.maximoPendientes);
+    LCD_shellEndLine();
+
+    LCD_shellText("pool: uso");
+    for (uint8_t clase = 0; clase < LCD_POOL_CANTIDAD_CLASES; clase++) {
+        LCD_shellText(clase == 0 ? "=" : "/");
+        LCD_shellDecimal(stats.pool.enUso[clase]);
+    }
+    LCD_shellText(" maximo");
+    for (uint8_t clase = 0; clase < LCD_POOL_CANTIDAD_CLASES; clase++) {
+        LCD_shellText(clase == 0 ? "=" : "/");
+        LCD_shellDecimal(stats.pool.maximoUso[clase]);
+    }
+    LCD_shellField("fallos", stats.pool.fallos);
+    LCD_shellEndLine();
+    return LCD_OK;
+}
+
+/**
+ *	@brief Muestra el estado del driver y cada fila del buffer
+ *		   de sombra seguida de sus celdas sucias, marcadas con
+ *		   '*'. Los caracteres no imprimibles se muestran como '?'.
+ */
+static LCD_StatusTypedef LCD_shellShadow(const char * argumento) {
+    const LCD_BufferTypedef * sombra = LCD_getBuffer();
+    char celdas[LCD_BUFFER_MAX_COLUMNAS + 1];
+
+    LCD_shellText("estado:");
+    LCD_shellField("listo", LCD_isReady());
+    LCD_shellField("entrada", LCD_getEntryMode());
+#ifdef LCD_POWER
+    LCD_shellField("energia", LCD_getPowerMode());
+#endif
+    LCD_shellEndLine();
+
+    for (uint8_t fila = 0; fila < sombra->filas; fila++) {
+        for (uint8_t columna = 0; columna < sombra->columnas; columna++) {
+            char caracter = LCD_bufferGet(sombra, fila, columna);
+            celdas[columna] = (caracter >= ' ' && caracter < CARACTER_DEL) ? caracter
+                                                                          : CARACTER_NO_VISIBLE;
+        }
+        celdas[sombra->columnas] = '\0';
+        LCD_shellDecimal(fila);
+        LCD_shellText(" |");
+        LCD_shellText(celdas);
+        LCD_shellText("| ");
+
+        for (uint8_t columna = 0; columna < sombra->columnas; columna++)
+            celdas[columna] = ((sombra->sucias[fila] >> columna) & 1) ? '*' : '.';
+        LCD_shellText(celdas);
+        LCD_shellEndLine();
+    }
+    return LCD_OK;
+}
+
+/**
+ *	@brief Corre la medición del port con la cantidad de tramas
+ *		   indicada o LCD_SHELL_TRAMAS_BENCH.
+ */
+static LCD_StatusTypedef LCD_shellBench(const char * argumento) {
+    LCD_BenchTypedef resultado = {0};
+    uint32_t tramas = LCD_SHELL_TRAMAS_BENCH;
+
+    if (argumento != NULL && !LCD_shellNumber(argumento, &tramas))
+        tramas = 0;
+
+    LCD_StatusTypedef estado = LCD_benchPort(tramas > UINT16_MAX ? 0 : tramas, &resultado);
+
+    LCD_shellText("bench:");
+    LCD_shellField("tramas", tramas);
+    LCD_shellField("ciclos", resultado.ciclosPorTrama);
+    LCD_shellField("bus", resultado.ciclosBusPorTrama);
+    LCD_shellField("lote", resultado.ciclosPorTramaLote);
+    LCD_shellField("bus", resultado.ciclosBusPorTramaLote);
+    LCD_shellField("errores", resultado.errores);
+    if (estado == LCD_ERROR)
+        LCD_shellText(" error");
+    LCD_shellEndLine();
+    return estado;
+}
+
+/**
+ *	@brief Muestra o cambia la velocidad del bus.
+ */
+static LCD_StatusTypedef LCD_shellBus(const char * argumento) {
+    uint32_t velocidad;
+    LCD_StatusTypedef estado = LCD_OK;
+
+    if (argumento != NULL &&
+        (!LCD_shellNumber(argumento, &velocidad) || !port_setClockSpeed(velocidad)))
+        estado = LCD_ERROR;
+
+    LCD_shellText("bus: ");
+    LCD_shellDecimal(port_getClockSpeed());
+    LCD_shellText(" Hz");
+    if (estado == LCD_ERROR)
+        LCD_shellText(" (error)");
+    LCD_shellEndLine();
+    return estado;
+}
+
+/**
+ *	@brief Muestra o cambia el período de refresco de la
+ *		   aplicación.
+ */
+static LCD_StatusTypedef LCD_shellRefresh(const char * argumento) {
+    uint32_t periodo;
+    LCD_StatusTypedef estado = LCD_OK;
+
+    if (cambiarRefresco == NULL) {
+        LCD_shellText("refresco: no disponible");
+        LCD_shellEndLine();
+        return LCD_ERROR;
+    }
+
+    if (argumento != NULL) {
+        if (LCD_shellNumber(argumento, &periodo) && cambiarRefresco(periodo))
+            periodoRefresco = periodo;
+        else
+            estado = LCD_ERROR;
+    }
+
+    LCD_shellText("refresco: ");
+    if (periodoRefresco == 0) {
+        LCD_shellText("sin cambios");
+    } else {
+        LCD_shellDecimal(periodoRefresco);
+        LCD_shellText(" ms");
+    }
+    if (estado == LCD_ERROR)
+        LCD_shellText(" (error)");
+    LCD_shellEndLine();
+    return estado;
+}
+
+/**
+ *	@brief Con "on" empieza a grabar las llamadas a la API; con
+ *		   "off" deja de grabar y muestra una línea por llamada,
+ *		   con los ms desde el inicio, sus argumentos y su texto.
+ */
+static LCD_StatusTypedef LCD_shellTrace(const char * argumento) {
+#ifdef LCD_RECORDER
+    if (argumento != NULL && strcmp(argumento, "on") == 0) {
+        LCD_StatusTypedef estado = LCD_ERROR;
+
+        if (!trazando && LCD_recordStart(traza, sizeof(traza)) == LCD_OK) {
+            trazando = true;
+            estado = LCD_OK;
+        }
+        LCD_shellText(estado == LCD_OK ? "traza: on" : "traza: error");
+        LCD_shellEndLine();
+        return estado;
+    }
+
+    if (argumento == NULL || strcmp(argumento, "off") != 0 || !trazando) {
+        LCD_shellText("traza: error");
+        LCD_shellEndLine();
+        return LCD_ERROR;
+    }
+
+    LCD_LectorTypedef lector;
+    LCD_RegistroTypedef llamada;
+    uint32_t largo = LCD_recordStop();
+    uint32_t perdidas = LCD_recordLost();
+
+    trazando = false;
+    if (LCD_recordOpen(&lector, traza, largo) == LCD_ERROR)
+        return LCD_ERROR;
+
+    while (LCD_recordNext(&lector, &llamada)) {
+        LCD_shellDecimal(llamada.tick);
+        LCD_shellText(" ");
+        LCD_shellText(NOMBRE_LLAMADA[llamada.llamada]);
+        for (uint8_t indice = 0; indice < ARGUMENTOS_MOSTRADOS[llamada.llamada]; indice++) {
+            LCD_shellText(" ");
+            LCD_shellDecimal(llamada.argumentos[indice]);
+        }
+        if (llamada.texto[0] != '\0') {
+            LCD_shellText(" \"");
+            LCD_shellText(llamada.texto);
+            LCD_shellText("\"");
+        }
+        LCD_shellEndLine();
+    }
+
+    LCD_shellText("traza: off");
+    LCD_shellField("perdidas", perdidas);
+    LCD_shellEndLine();
+    return LCD_OK;
+#else
+    LCD_shellText("traza: no disponible");
+    LCD_shellEndLine();
+    return LCD_ERROR;
+#endif
+}
+
+/**
+ *	@brief Convierte un argumento decimal.
+ *	@retval false si no es un número.
+ */
+static bool_t LCD_shellNumber(const char * texto, uint32_t * numero) {
+    char * fin;
+
+    if (*texto < '0' || *texto > '9')
+        return false;
+
+    *numero = strtoul(texto, &fin, 10);
+    return *fin == '\0';
+}
+
+/**
+ *	@brief Agrega texto a la línea de respuesta; lo que no
+ *		   entra se descarta.
+ */
+static void LCD_shellText(const char * texto) {
+    while (*texto != '\0' && largoSalida < sizeof(salida) - sizeof(FIN_DE_LINEA))
+        salida[largoSalida++] = *texto++;
+}
+
+/**
+ *	@brief Agrega un número en decimal a la línea de respuesta.
+ */
+static void LCD_shellDecimal(uint32_t numero) {
+    char digitos[11];
+    uint8_t posicion = sizeof(digitos) - 1;
+
+    digitos[posicion] = '\0';
+    do {
+        digitos[--posicion] = '0' + numero % 10;
+        numero /= 10;
+    } while (numero > 0);
+
+    LCD_shellText(&digitos[posicion]);
+}
+
+/**
+ *	@brief Agrega un campo " nombre=valor" a la línea de respuesta.
+ */
+static void LCD_shellField(const char * nombre, uint32_t valor) {
+    LCD_shellText(" ");
+    LCD_shellText(nombre);
+    LCD_shellText("=");
+    LCD_shellDecimal(valor);
+}
+
+/**
+ *	@brief Termina la línea de respuesta y la envía.
+ */
+static void LCD_shellEndLine() {
+    memcpy(&salida[largoSalida], FIN_DE_LINEA, sizeof(FIN_DE_LINEA));
+    largoSalida = 0;
+    if (escribir != NULL)
+        escribir(salida);
+}
+
+#endif /* LCD_SHELL */
@@ -0,0 +1,259 @@
+/**
+ * @file API_lcd_stream.c
+ * @brief Implementación del envío por interrupciones
+ *        de un buffer de sombra.
+ */
+
+#include "API_lcd_stream.h"
+#include "API_lcd_cmd.h"
+#include "API_types.h"
+
+#ifdef LCD_STREAM
+
+/**
+ *	@brief Estado del codificador. Sólo hay un envío a la
+ *		   vez porque el bus es uno solo.
+ */
+static LCD_BufferTypedef * volatile buffer = NULL;
+static uint8_t fila;
+static uint8_t columna;                      // donde se busca el próximo tramo
+static uint8_t celda;                        // próxima celda del tramo en curso
+static uint8_t pendientes;                   // celdas del tramo que faltan enviar
+static bool_t decremento;                    // el cursor del LCD retrocede
+static uint8_t tramas[LCD_TRAMAS_X_MENSAJE]; // tramas del mensaje actual
+static uint8_t indiceTrama;
+static LCD_StatusTypedef resultado = LCD_OK;
+
+/**
+ *	@brief Estado del envío por DMA: buffer de dos mitades,
+ *		   última trama codificada para completar la mitad
+ *		   final, y mitad que contiene el último dato real.
+ */
+static uint8_t * bufferDma;
+static uint16_t tamanioMitad;
+static uint8_t ultimaTrama;
+static bool_t agotado;
+static uint8_t mitadFinal;
+
+// valor de mitadFinal mientras quedan datos por codificar
+#define SIN_MITAD_FINAL 0xFF
+
+static bool_t LCD_streamNextFrame(uint8_t *);
+static void LCD_streamEnd(bool_t);
+static bool_t LCD_streamNextMsg();
+static uint8_t LCD_streamRowAddress(uint8_t);
+static void LCD_streamStart(LCD_BufferTypedef *);
+static bool_t LCD_streamShifts();
+static bool_t LCD_streamHalfDone(uint8_t);
+static void LCD_streamFillHalf(uint8_t);
+
+/**
+ *	@brief Prepara el codificador y le pasa al port los
+ *		   callbacks que va a llamar la ISR.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_streamFlush(LCD_BufferTypedef * sombra) {
+    if (sombra == NULL || buffer != NULL || LCD_getProfile()->nativo || LCD_streamShifts())
+        return LCD_ERROR;
+
+    if (!LCD_bufferIsDirty(sombra))
+        return LCD_OK;
+
+    LCD_streamStart(sombra);
+    if (!port_i2cStreamStart(LCD_streamNextFrame, LCD_streamEnd)) {
+        buffer = NULL;
+        return LCD_ERROR;
+    }
+
+    return LCD_OK;
+}
+
+/**
+ *	@brief Llena las dos mitades del buffer de tramas y
+ *		   le pasa al port el buffer y los callbacks que va
+ *		   a llamar la ISR del DMA.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_streamFlushDma(LCD_BufferTypedef * sombra, uint8_t * tramasDma,
+                                     uint16_t tamanio) {
+    if (sombra == NULL || tramasDma == NULL || tamanio < 2 || (tamanio % 2) != 0)
+        return LCD_ERROR;
+
+    if (buffer != NULL || LCD_getProfile()->nativo || LCD_streamShifts())
+        return LCD_ERROR;
+
+    if (!LCD_bufferIsDirty(sombra))
+        return LCD_OK;
+
+    LCD_streamStart(sombra);
+    bufferDma = tramasDma;
+    tamanioMitad = tamanio / 2;
+    agotado = false;
+    mitadFinal = SIN_MITAD_FINAL;
+    LCD_streamFillHalf(0);
+    LCD_streamFillHalf(1);
+
+    if (!port_i2cDmaStart(tramasDma, tamanio, LCD_streamHalfDone, LCD_streamEnd)) {
+        LCD_bufferMarkAllDirty(sombra);
+        buffer = NULL;
+        return LCD_ERROR;
+    }
+
+    return LCD_OK;
+}
+
+/**
+ *	@brief Indica si hay un envío en curso.
+ */
+bool_t LCD_streamBusy() {
+    return buffer != NULL;
+}
+
+/**
+ *	@brief Resultado del último envío terminado.
+ */
+LCD_StatusTypedef LCD_streamResult() {
+    return resultado;
+}
+
+/**
+ *	@brief Indica si el modo de entrada desplaza la pantalla,
+ *		   lo que movería el contenido con cada celda enviada.
+ */
+static bool_t LCD_streamShifts() {
+    LCD_EntradaTypedef modo = LCD_getEntryMode();
+    return modo == LCD_ENTRADA_INCREMENTO_DESPLAZA || modo == LCD_ENTRADA_DECREMENTO_DESPLAZA;
+}
+
+/**
+ *	@brief Deja el codificador al comienzo del buffer.
+ */
+static void LCD_streamStart(LCD_BufferTypedef * sombra) {
+    fila = 0;
+    columna = 0;
+    pendientes = 0;
+    decremento = (LCD_getEntryMode() == LCD_ENTRADA_DECREMENTO);
+    indiceTrama = LCD_TRAMAS_X_MENSAJE;
+    buffer = sombra;
+}
+
+/**
+ *	@brief Callback de mitad: si la mitad transmitida tenía
+ *		   el último dato, la otra sólo tiene relleno y se
+ *		   termina; si no, se vuelve a llenar.
+ *	@retval false para terminar la transmisión.
+ */
+static bool_t LCD_streamHalfDone(uint8_t mitad) {
+    if (mitad == mitadFinal)
+        return false;
+
+    LCD_streamFillHalf(mitad);
+    return true;
+}
+
+/**
+ *	@brief Codifica tramas en una mitad del buffer. Cuando
+ *		   no quedan datos la completa con la última trama y
+ *		   registra en qué mitad quedó el último dato real.
+ */
+static void LCD_streamFillHalf(uint8_t mitad) {
+    uint8_t * destino = &bufferDma[mitad * tamanioMitad];
+
+    for (uint16_t indice = 0; indice < tamanioMitad; indice++) {
+        if (!agotado && LCD_streamNextFrame(&ultimaTrama)) {
+            destino[indice] = ultimaTrama;
+            continue;
+        }
+
+        if (!agotado) {
+            agotado = true;
+            mitadFinal = (indice > 0) ? mitad : (1 - mitad);
+        }
+        destino[indice] = ultimaTrama;
+    }
+}
+
+/**
+ *	@brief Callback de trama: entrega la próxima trama del
+ *		   mensaje actual y codifica el siguiente al agotarlo.
+ *	@retval false cuando no quedan celdas sucias.
+ */
+static bool_t LCD_streamNextFrame(uint8_t * trama) {
+    if (buffer == NULL)
+        return false;
+
+    if (indiceTrama == LCD_TRAMAS_X_MENSAJE) {
+        if (!LCD_streamNextMsg())
+            return false;
+        indiceTrama = 0;
+    }
+
+    *trama = tramas[indiceTrama++];
+    return true;
+}
+
+/**
+ *	@brief Callback de fin: si el envío falló se marca todo
+ *		   el buffer sucio, porque no se sabe qué celdas llegaron.
+ */
+static void LCD_streamEnd(bool_t exito) {
+    if (buffer == NULL)
+        return;
+
+    if (!exito)
+        LCD_bufferMarkAllDirty(buffer);
+
+    resultado = exito ? LCD_OK : LCD_ERROR;
+    buffer = NULL;
+}
+
+/**
+ *	@brief Codifica el próximo mensaje: el caracter siguiente
+ *		   del tramo actual o el posicionamiento del cursor al
+ *		   comienzo del próximo tramo sucio. Si el cursor del
+ *		   LCD retrocede, cada tramo se envía desde su última
+ *		   celda, con el mismo costo y sin cambiar el modo.
+ *	@retval false si no quedan celdas sucias.
+ */
+static bool_t LCD_streamNextMsg() {
+    uint8_t inicio;
+    uint8_t largo;
+
+    while (fila < buffer->filas) {
+        if (pendientes > 0) {
+            LCD_encodeMsg(LCD_bufferGet(buffer, fila, celda), DATA, tramas);
+            LCD_bufferMarkClean(buffer, fila, celda, 1);
+            celda = decremento ? celda - 1 : celda + 1;
+            pendientes--;
+            return true;
+        }
+
+        if (LCD_bufferNextDirtyRun(buffer, fila, columna, &inicio, &largo)) {
+            celda = decremento ? inicio + largo - 1 : inicio;
+            pendientes = largo;
+            columna = inicio + largo;
+            LCD_encodeMsg(SET_CURSOR | (LCD_streamRowAddress(fila) + celda), COMMAND, tramas);
+            return true;
+        }
+
+        fila++;
+        columna = 0;
+    }
+
+    return false;
+}
+
+/**
+ *	@brief Dirección de la DDRAM donde empieza una fila. Las
+ *		   filas 3 y 4 continúan a las 1 y 2 en la misma línea.
+ */
+static uint8_t LCD_streamRowAddress(uint8_t numeroFila) {
+    uint8_t direccion = (numeroFila & 1) ? LCD_FILA_2 : LCD_FILA_1;
+
+    if (numeroFila >= 2)
+        direccion += buffer->columnas;
+
+    return direccion;
+}
+
+#endif /* LCD_STREAM */
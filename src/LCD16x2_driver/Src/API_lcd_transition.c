@@ -0,0 +1,160 @@
+/**
+ * @file API_lcd_transition.c
+ * @brief Implementación de las transiciones con el
+ * 		  desplazamiento del display.
+ */
+
+#include "API_lcd_transition.h"
+#include "API_lcd_cmd.h"
+#include "API_types.h"
+
+#ifdef LCD_TRANSITIONS
+
+#define CARACTER_BLANCO ' '
+
+// largo de una línea de la DDRAM del controlador
+#define LARGO_LINEA_DDRAM 40
+
+// mensajes de la carga de una fila: posición y caracteres
+#define MENSAJES_CARGA (1 + LCD_CANTIDAD_COLUMNAS)
+
+static LCD_StatusTypedef LCD_transitionLoad(const LCD_TransicionTypedef *);
+static LCD_StatusTypedef LCD_transitionSend(uint8_t);
+static LCD_StatusTypedef LCD_transitionFinish(LCD_TransicionTypedef *);
+
+/**
+ *	@brief Copia las filas completándolas con blancos y las
+ *		   carga fuera de la vista.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_transitionStart(LCD_TransicionTypedef * transicion,
+                                      LCD_TransicionSentidoTypedef sentido, const char * fila1,
+                                      const char * fila2, uint16_t periodo) {
+    const char * filas[] = {fila1, fila2};
+
+    if (transicion->enCurso || sentido > LCD_TRANSICION_DERECHA)
+        return LCD_ERROR;
+
+    // la precarga escribe las columnas ocultas de izquierda a derecha
+    if (!LCD_isReady() || LCD_getProfile()->nativo ||
+        LCD_getEntryMode() != LCD_ENTRADA_INCREMENTO)
+        return LCD_ERROR;
+
+    for (uint8_t fila = 0; fila < LCD_CANTIDAD_FILAS; fila++) {
+        const char * texto = (filas[fila] != NULL) ? filas[fila] : "";
+        uint8_t columna = 0;
+
+        for (; texto[columna] != '\0' && columna < LCD_CANTIDAD_COLUMNAS; columna++)
+            transicion->pantalla[fila][columna] = texto[columna];
+        for (; columna < LCD_CANTIDAD_COLUMNAS; columna++)
+            transicion->pantalla[fila][columna] = CARACTER_BLANCO;
+        transicion->pantalla[fila][LCD_CANTIDAD_COLUMNAS] = '\0';
+    }
+
+    transicion->sentido = sentido;
+    transicion->pasos = 0;
+    transicion->periodo = periodo;
+
+    if (LCD_transitionLoad(transicion) == LCD_ERROR)
+        return LCD_ERROR;
+
+    transicion->tickPaso = port_getTick();
+    transicion->enCurso = true;
+    return LCD_OK;
+}
+
+/**
+ *	@brief Un paso es un único comando de desplazamiento. Si
+ *		   falla, el mismo paso o la copia final se reintentan
+ *		   en la próxima llamada.
+ *	@retval Estado de ejecución.
+ */
+LCD_StatusTypedef LCD_transitionProcess(LCD_TransicionTypedef * transicion) {
+    if (!transicion->enCurso || port_getTick() - transicion->tickPaso < transicion->periodo)
+        return LCD_OK;
+
+    if (transicion->pasos < LCD_CANTIDAD_COLUMNAS) {
+        uint8_t comando = CURSOR_SHIFT | SHIFT_DISPLAY;
+        if (transicion->sentido == LCD_TRANSICION_DERECHA)
+            comando |= SHIFT_RIGHT;
+
+        if (LCD_transitionSend(comando) == LCD_ERROR)
+            return LCD_ERROR;
+
+        transicion->tickPaso = port_getTick();
+        if (++transicion->pasos < LCD_CANTIDAD_COLUMNAS)
+            return LCD_OK;
+    }
+
+    return LCD_transitionFinish(transicion);
+}
+
+/**
+ *	@brief Indica si falta algún desplazamiento o la copia final.
+ */
+bool_t LCD_transitionBusy(const LCD_TransicionTypedef * transicion) {
+    return transicion->enCurso;
+}
+
+/**
+ *	@brief Escribe cada fila en una transacción: hacia la
+ *		   izquierda entra por las columnas 16 a 31 y hacia
+ *		   la derecha por las 24 a 39, que quedan antes de la
+ *		   columna 0 porque la línea es circular.
+ *	@retval Estado de ejecución.
+ */
+static LCD_StatusTypedef LCD_transitionLoad(const LCD_TransicionTypedef * transicion) {
+    static const uint8_t inicioFila[] = {LCD_FILA_1, LCD_FILA_2};
+    uint8_t tramas[MENSAJES_CARGA * LCD_TRAMAS_X_MENSAJE];
+    uint8_t columna = (transicion->sentido == LCD_TRANSICION_IZQUIERDA)
+                          ? LCD_CANTIDAD_COLUMNAS
+                          : LARGO_LINEA_DDRAM - LCD_CANTIDAD_COLUMNAS;
+
+    for (uint8_t fila = 0; fila < LCD_CANTIDAD_FILAS; fila++) {
+        LCD_encodeMsg(SET_CURSOR | (inicioFila[fila] + columna), LCD_COMANDO, tramas);
+        for (uint8_t indice = 0; indice < LCD_CANTIDAD_COLUMNAS; indice++)
+            LCD_encodeMsg(transicion->pantalla[fila][indice], LCD_DATO,
+                          &tramas[(1 + indice) * LCD_TRAMAS_X_MENSAJE]);
+
+        if (!port_i2cWrite(tramas, sizeof(tramas)))
+            return LCD_ERROR;
+    }
+
+    return LCD_OK;
+}
+
+/**
+ *	@brief Envía un comando codificado para el PCF8574.
+ *	@retval Estado de ejecución.
+ */
+static LCD_StatusTypedef LCD_transitionSend(uint8_t comando) {
+    uint8_t tramas[LCD_TRAMAS_X_MENSAJE];
+
+    LCD_encodeMsg(comando, LCD_COMANDO, tramas);
+    if (!port_i2cWrite(tramas, sizeof(tramas)))
+        return LCD_ERROR;
+
+    return LCD_OK;
+}
+
+/**
+ *	@brief Copia la pantalla nueva a las columnas 0 a 15 con
+ *		   el driver, que así actualiza su buffer de sombra,
+ *		   vuelve la vista con RETURN_HOME y deja el cursor
+ *		   del driver donde lo dejó el comando.
+ *	@retval Estado de ejecución.
+ */
+static LCD_StatusTypedef LCD_transitionFinish(LCD_TransicionTypedef * transicion) {
+    if (LCD_printAt(LCD_FILA_1, 0, transicion->pantalla[0]) == LCD_ERROR ||
+        LCD_printAt(LCD_FILA_2, 0, transicion->pantalla[1]) == LCD_ERROR)
+        return LCD_ERROR;
+
+    if (LCD_transitionSend(RETURN_HOME) == LCD_ERROR)
+        return LCD_ERROR;
+    port_delay(LCD_ESPERA_CLEAR);
+
+    transicion->enCurso = false;
+    return LCD_setCursor(LCD_FILA_1, 0);
+}
+
+#endif /* LCD_TRANSITIONS */
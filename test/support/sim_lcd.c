@@ -0,0 +1,515 @@
+/**
+ * @file sim_lcd.c
+ * @brief Implementación del simulador de LCD HD44780 + PCF8574
+ *        y de los controladores con I2C nativo.
+ */
+
+#include <string.h>
+
+#include "sim_lcd.h"
+
+// pines del PCF8574
+#define PIN_RS        (1 << 0)
+#define PIN_RW        (1 << 1)
+#define PIN_E         (1 << 2)
+#define PIN_BACKLIGHT (1 << 3)
+
+// bits de los comandos del HD44780
+#define CMD_CLEAR         0x01
+#define CMD_HOME          0x02
+#define CMD_ENTRY_MODE    0x04
+#define CMD_DISPLAY       0x08
+#define CMD_SHIFT         0x10
+#define CMD_FUNCTION_SET  0x20
+#define CMD_SET_CGRAM     0x40
+#define CMD_SET_DDRAM     0x80
+#define ENTRY_INCREMENTO  (1 << 1)
+#define ENTRY_SHIFT       (1 << 0)
+#define SHIFT_PANTALLA    (1 << 3)
+#define SHIFT_DERECHA     (1 << 2)
+#define FUNCTION_8BITS    (1 << 4)
+#define FUNCTION_IS       (1 << 0)
+#define BUSY_FLAG         (1 << 7)
+
+// bits del byte de control de la interfaz nativa
+#define CONTROL_CO (1 << 7)
+#define CONTROL_RS (1 << 6)
+
+// comandos de la tabla extendida del ST7032 (IS = 1)
+#define ST7032_OSCILADOR 0x10
+#define ST7032_POTENCIA  0x50
+#define ST7032_SEGUIDOR  0x60
+#define ST7032_CONTRASTE 0x70
+#define ST7032_FON       (1 << 3)
+
+// bits que ocupa cada parte de una transacción I2C
+#define BITS_INICIO 10 // start + dirección + ack
+#define BITS_BYTE   9  // dato + ack
+#define BITS_FIN    1  // stop
+
+SIM_LcdTypedef sim_lcd;
+SIM_LcdTypedef sim_lcdE2;
+
+/**
+ * @brief Convierte una cantidad de bits en microsegundos
+ *        según la velocidad del bus.
+ */
+static uint32_t sim_bitsToUs(SIM_LcdTypedef * lcd, uint32_t bits) {
+    return (bits * 1000000UL + lcd->clockI2C - 1) / lcd->clockI2C;
+}
+
+/**
+ * @brief Marca al controlador ocupado y cuenta una violación
+ *        si llega una operación antes de que termine la anterior.
+ */
+static void sim_ocupar(SIM_LcdTypedef * lcd, uint32_t duracionUs) {
+    if (lcd->tiempoUs < lcd->ocupadoHastaUs)
+        lcd->violaciones++;
+    lcd->ocupadoHastaUs = lcd->tiempoUs + duracionUs;
+}
+
+/**
+ * @brief Avanza o retrocede el contador de direcciones respetando
+ *        la organización de la DDRAM en dos líneas de 40 posiciones.
+ */
+static void sim_moverDireccion(SIM_LcdTypedef * lcd, bool_t incrementar) {
+    if (lcd->enCgram) {
+        lcd->direccion = (lcd->direccion + (incrementar ? 1 : SIM_TAM_CGRAM - 1)) % SIM_TAM_CGRAM;
+        return;
+    }
+
+    if (incrementar) {
+        if (lcd->direccion == 0x27)
+            lcd->direccion = 0x40;
+        else if (lcd->direccion == 0x67)
+            lcd->direccion = 0x00;
+        else
+            lcd->direccion++;
+    } else {
+        if (lcd->direccion == 0x00)
+            lcd->direccion = 0x67;
+        else if (lcd->direccion == 0x40)
+            lcd->direccion = 0x27;
+        else
+            lcd->direccion--;
+    }
+}
+
+/**
+ * @brief Desplaza la pantalla una posición a izquierda o derecha.
+ */
+static void sim_desplazar(SIM_LcdTypedef * lcd, bool_t derecha) {
+    lcd->desplazamiento = (lcd->desplazamiento + (derecha ? SIM_LARGO_LINEA - 1 : 1)) %
+                          SIM_LARGO_LINEA;
+}
+
+/**
+ * @brief Ejecuta una instrucción del HD44780.
+ */
+static void sim_instruccion(SIM_LcdTypedef * lcd, uint8_t comando) {
+    lcd->instrucciones++;
+
+    if (comando & CMD_SET_DDRAM) {
+        sim_ocupar(lcd, lcd->tiempoInstruccionUs);
+        lcd->direccion = comando & 0x7F;
+        lcd->enCgram = false;
+    } else if (comando & CMD_SET_CGRAM) {
+        sim_ocupar(lcd, lcd->tiempoInstruccionUs);
+        lcd->direccion = comando & 0x3F;
+        lcd->enCgram = true;
+    } else if (comando & CMD_FUNCTION_SET) {
+        sim_ocupar(lcd, lcd->tiempoInstruccionUs);
+        lcd->funcion = comando;
+        if (lcd->interfaz == SIM_INTERFAZ_ST7032)
+            lcd->tablaExtendida = comando & FUNCTION_IS;
+        if (!(comando & FUNCTION_8BITS) && !lcd->modo4Bits) {
+            lcd->modo4Bits = true;
+            lcd->nibblePendiente = false;
+        }
+    } else if (comando & CMD_SHIFT) {
+        sim_ocupar(lcd, lcd->tiempoInstruccionUs);
+        if (comando & SHIFT_PANTALLA)
+            sim_desplazar(lcd, comando & SHIFT_DERECHA);
+        else
+            sim_moverDireccion(lcd, comando & SHIFT_DERECHA);
+    } else if (comando & CMD_DISPLAY) {
+        sim_ocupar(lcd, lcd->tiempoInstruccionUs);
+        lcd->control = comando & 0x07;
+    } else if (comando & CMD_ENTRY_MODE) {
+        sim_ocupar(lcd, lcd->tiempoInstruccionUs);
+        lcd->modoEntrada = comando & 0x03;
+    } else if (comando & CMD_HOME) {
+        sim_ocupar(lcd, lcd->tiempoClearUs);
+        lcd->direccion = 0;
+        lcd->enCgram = false;
+        lcd->desplazamiento = 0;
+    } else if (comando & CMD_CLEAR) {
+        sim_ocupar(lcd, lcd->tiempoClearUs);
+        memset(lcd->ddram, ' ', sizeof(lcd->ddram));
+        lcd->direccion = 0;
+        lcd->enCgram = false;
+        lcd->desplazamiento = 0;
+        lcd->modoEntrada |= ENTRY_INCREMENTO;
+    }
+}
+
+/**
+ * @brief Ejecuta una instrucción de la tabla extendida del ST7032:
+ *        oscilador, contraste y seguidor de tensión. El seguidor
+ *        necesita estabilizarse antes de la instrucción siguiente.
+ */
+static void sim_instruccionExtendida(SIM_LcdTypedef * lcd, uint8_t comando) {
+    lcd->instrucciones++;
+
+    switch (comando & 0xF0) {
+    case ST7032_POTENCIA:
+        sim_ocupar(lcd, lcd->tiempoInstruccionUs);
+        lcd->contraste = (lcd->contraste & 0x0F) | ((comando & 0x03) << 4);
+        break;
+    case ST7032_SEGUIDOR:
+        lcd->seguidor = comando & ST7032_FON;
+        sim_ocupar(lcd, lcd->seguidor ? SIM_ST7032_SEGUIDOR : lcd->tiempoInstruccionUs);
+        break;
+    case ST7032_CONTRASTE:
+        sim_ocupar(lcd, lcd->tiempoInstruccionUs);
+        lcd->contraste = (lcd->contraste & 0x30) | (comando & 0x0F);
+        break;
+    default: // ST7032_OSCILADOR o dirección de íconos
+        sim_ocupar(lcd, lcd->tiempoInstruccionUs);
+        break;
+    }
+}
+
+/**
+ * @brief Escribe un dato en la DDRAM o en la CGRAM y
+ *        actualiza la dirección según el modo de entrada.
+ */
+static void sim_dato(SIM_LcdTypedef * lcd, uint8_t dato) {
+    lcd->datos++;
+    sim_ocupar(lcd, lcd->tiempoInstruccionUs);
+
+    if (lcd->enCgram)
+        lcd->cgram[lcd->direccion] = dato & 0x1F;
+    else
+        lcd->ddram[lcd->direccion] = dato;
+
+    bool_t incrementar = lcd->modoEntrada & ENTRY_INCREMENTO;
+    sim_moverDireccion(lcd, incrementar);
+    if (!lcd->enCgram && (lcd->modoEntrada & ENTRY_SHIFT))
+        sim_desplazar(lcd, !incrementar);
+}
+
+/**
+ * @brief Recibe un byte de la interfaz nativa: un byte de control,
+ *        o un comando o dato completo según el último control.
+ */
+static void sim_byteNativo(SIM_LcdTypedef * lcd, uint8_t valor) {
+    if (lcd->esperaControl) {
+        lcd->esperaControl = false;
+        lcd->controlFinal = !(valor & CONTROL_CO);
+        lcd->rsNativo = valor & CONTROL_RS;
+        return;
+    }
+
+    if (lcd->rsNativo)
+        sim_dato(lcd, valor);
+    else if (lcd->tablaExtendida && valor >= CMD_SHIFT && valor < CMD_SET_DDRAM &&
+             (valor & 0xE0) != CMD_FUNCTION_SET)
+        sim_instruccionExtendida(lcd, valor);
+    else
+        sim_instruccion(lcd, valor);
+
+    lcd->esperaControl = !lcd->controlFinal;
+}
+
+/**
+ * @brief Procesa un flanco descendente de E: en modo 8 bits cada
+ *        nibble es una instrucción, en modo 4 bits se arma el byte
+ *        con dos nibbles, primero el alto.
+ */
+static void sim_strobe(SIM_LcdTypedef * lcd, uint8_t pines) {
+    uint8_t nibble = pines >> 4;
+    bool_t esDato = pines & PIN_RS;
+
+    if (!lcd->modo4Bits) {
+        if (!esDato)
+            sim_instruccion(lcd, nibble << 4);
+        return;
+    }
+
+    if (!lcd->nibblePendiente) {
+        lcd->nibbleAlto = nibble;
+        lcd->nibblePendiente = true;
+        return;
+    }
+
+    lcd->nibblePendiente = false;
+    uint8_t valor = (lcd->nibbleAlto << 4) | nibble;
+    if (esDato)
+        sim_dato(lcd, valor);
+    else
+        sim_instruccion(lcd, valor);
+}
+
+/**
+ * @brief Valor que devuelve una lectura: el busy flag y el
+ *        contador de direcciones, o el dato de la dirección actual.
+ */
+static uint8_t sim_valorLectura(SIM_LcdTypedef * lcd, bool_t esDato) {
+    if (!esDato)
+        return ((lcd->tiempoUs < lcd->ocupadoHastaUs) ? BUSY_FLAG : 0) | lcd->direccion;
+
+    return lcd->enCgram ? lcd->cgram[lcd->direccion] : lcd->ddram[lcd->direccion];
+}
+
+/**
+ * @brief Nibble que el controlador maneja en D4-D7 mientras E está
+ *        en alto con RW en alto.
+ */
+static uint8_t sim_nibbleLectura(SIM_LcdTypedef * lcd, bool_t esDato) {
+    if (lcd->modo4Bits && lcd->nibblePendiente)
+        return lcd->lectura & 0x0F;
+
+    return sim_valorLectura(lcd, esDato) >> 4;
+}
+
+/**
+ * @brief Procesa el flanco descendente de E de una lectura. La
+ *        lectura de un dato termina con el nibble bajo en modo 4 bits
+ *        y mueve el contador de direcciones como una escritura.
+ */
+static void sim_strobeLectura(SIM_LcdTypedef * lcd, uint8_t pines) {
+    bool_t esDato = pines & PIN_RS;
+
+    if (lcd->modo4Bits && !lcd->nibblePendiente) {
+        lcd->lectura = sim_valorLectura(lcd, esDato);
+        lcd->nibblePendiente = true;
+        return;
+    }
+
+    lcd->nibblePendiente = false;
+    if (esDato) {
+        sim_ocupar(lcd, lcd->tiempoInstruccionUs);
+        sim_moverDireccion(lcd, lcd->modoEntrada & ENTRY_INCREMENTO);
+    }
+}
+
+void sim_init(SIM_LcdTypedef * lcd) {
+    memset(lcd, 0, sizeof(*lcd));
+    memset(lcd->ddram, ' ', sizeof(lcd->ddram));
+    lcd->modoEntrada = ENTRY_INCREMENTO;
+    lcd->columnas = 16;
+    lcd->filas = 2;
+    lcd->clockI2C = I2C_CLOCK_SPEED;
+    lcd->interfaz = SIM_INTERFAZ_PCF8574;
+    lcd->direccionBus = LCD_ADDRESS;
+    lcd->direccionPort = LCD_ADDRESS;
+    lcd->tiempoInstruccionUs = SIM_TIEMPO_INSTRUCCION;
+    lcd->tiempoClearUs = SIM_TIEMPO_CLEAR_HOME;
+    lcd->pinE = PIN_E;
+    lcd->pinRw = PIN_RW;
+}
+
+void sim_initDual(SIM_LcdTypedef * e1, SIM_LcdTypedef * e2, uint8_t pinE1, uint8_t pinE2) {
+    sim_init(e1);
+    sim_init(e2);
+    e1->columnas = e2->columnas = SIM_LARGO_LINEA;
+    e1->pinE = pinE1;
+    e2->pinE = pinE2;
+    e1->pinRw = e2->pinRw = 0;
+    e1->siguiente = e2;
+}
+
+void sim_initNative(SIM_LcdTypedef * lcd, SIM_InterfazTypedef interfaz) {
+    sim_init(lcd);
+    lcd->interfaz = interfaz;
+    lcd->direccionBus = SIM_DIRECCION_NATIVO;
+
+    if (interfaz == SIM_INTERFAZ_ST7032) {
+        lcd->tiempoInstruccionUs = SIM_ST7032_INSTRUCCION;
+        lcd->tiempoClearUs = SIM_ST7032_CLEAR_HOME;
+    }
+}
+
+/**
+ * @brief Recibe el byte número indice de una transacción que empezó
+ *        en inicio: avanza el tiempo y actualiza los pines del PCF8574.
+ */
+static void sim_recibirByte(SIM_LcdTypedef * lcd, uint32_t inicio, uint32_t indice,
+                            uint8_t dato) {
+    lcd->tiempoUs = inicio + sim_bitsToUs(lcd, BITS_INICIO + BITS_BYTE * (indice + 1));
+    lcd->bytesI2C++;
+
+    if (lcd->interfaz != SIM_INTERFAZ_PCF8574) {
+        sim_byteNativo(lcd, dato);
+        return;
+    }
+
+    uint8_t anterior = lcd->pines;
+    lcd->pines = dato;
+
+    bool_t flancoBajada = (anterior & lcd->pinE) && !(lcd->pines & lcd->pinE);
+    if (flancoBajada && !(anterior & lcd->pinRw))
+        sim_strobe(lcd, anterior);
+    else if (flancoBajada)
+        sim_strobeLectura(lcd, anterior);
+}
+
+/**
+ * @brief Cierra una transacción de una cantidad de bytes.
+ */
+static void sim_terminarTransaccion(SIM_LcdTypedef * lcd, uint32_t inicio, uint32_t cantidad) {
+    uint32_t duracion = sim_bitsToUs(lcd, BITS_INICIO + BITS_BYTE * cantidad + BITS_FIN);
+    lcd->tiempoUs = inicio + duracion;
+    lcd->tiempoBusUs += duracion;
+}
+
+bool_t sim_i2cWrite(SIM_LcdTypedef * lcd, const uint8_t * bytes, uint16_t cantidad) {
+    uint32_t inicio = lcd->tiempoUs;
+
+    if (lcd->siguiente != NULL)
+        sim_i2cWrite(lcd->siguiente, bytes, cantidad);
+
+    lcd->transacciones++;
+    if (lcd->direccionPort != lcd->direccionBus) {
+        lcd->nacks++; // nadie responde a la dirección: sólo sale el byte de dirección
+        sim_terminarTransaccion(lcd, inicio, 0);
+        return false;
+    }
+
+    lcd->esperaControl = true;
+    for (uint16_t indice = 0; indice < cantidad; indice++)
+        sim_recibirByte(lcd, inicio, indice, bytes[indice]);
+
+    sim_terminarTransaccion(lcd, inicio, cantidad);
+    return true;
+}
+
+uint32_t sim_i2cWriteCircular(SIM_LcdTypedef * lcd, const uint8_t * buffer, uint16_t largo,
+                              port_MitadCallbackTypedef mitadLista) {
+    uint32_t inicio = lcd->tiempoUs;
+    uint16_t largoMitad = largo / 2;
+    uint32_t enviados = 0;
+    uint8_t mitad = 0;
+
+    lcd->transacciones++;
+    while (enviados < SIM_MAX_BYTES_DMA) {
+        for (uint16_t indice = 0; indice < largoMitad; indice++)
+            sim_recibirByte(lcd, inicio, enviados++, buffer[mitad * largoMitad + indice]);
+
+        mitad = 1 - mitad;
+        if (!mitadLista(1 - mitad)) {
+            // el DMA ya cargó el primer byte de la otra mitad antes del stop
+            sim_recibirByte(lcd, inicio, enviados++, buffer[mitad * largoMitad]);
+            break;
+        }
+    }
+
+    sim_terminarTransaccion(lcd, inicio, enviados);
+    return enviados;
+}
+
+void sim_i2cRead(SIM_LcdTypedef * lcd, uint8_t * dato) {
+    uint32_t duracion = sim_bitsToUs(lcd, BITS_INICIO + BITS_BYTE + BITS_FIN);
+
+    *dato = lcd->pines;
+    if ((lcd->pines & PIN_RW) && (lcd->pines & PIN_E)) {
+        uint8_t nibble = sim_nibbleLectura(lcd, lcd->pines & PIN_RS);
+        *dato = (lcd->pines & 0x0F) | (lcd->pines & (nibble << 4));
+    }
+
+    lcd->transacciones++;
+    lcd->bytesI2C++;
+    lcd->tiempoUs += duracion;
+    lcd->tiempoBusUs += duracion;
+}
+
+void sim_delay(SIM_LcdTypedef * lcd, uint32_t milisegundos) {
+    if (lcd->siguiente != NULL)
+        sim_delay(lcd->siguiente, milisegundos);
+
+    lcd->tiempoUs += milisegundos * 1000;
+    lcd->tiempoEsperaUs += milisegundos * 1000;
+}
+
+void sim_resetStats(SIM_LcdTypedef * lcd) {
+    lcd->tiempoBusUs = 0;
+    lcd->tiempoEsperaUs = 0;
+    lcd->bytesI2C = 0;
+    lcd->transacciones = 0;
+    lcd->instrucciones = 0;
+    lcd->datos = 0;
+    lcd->violaciones = 0;
+    lcd->nacks = 0;
+}
+
+void sim_getEnergy(SIM_LcdTypedef * lcd, SIM_EnergiaTypedef * energia) {
+    energia->busUs = lcd->tiempoBusUs;
+    energia->esperaUs = lcd->tiempoEsperaUs;
+    energia->despiertoUs = lcd->tiempoBusUs;
+    energia->dormidoUs = 0;
+
+    if (lcd->esperaDormido) {
+        uint32_t despertares = (lcd->tiempoEsperaUs / 1000) * SIM_DESPERTAR_US;
+        energia->despiertoUs += despertares;
+        energia->dormidoUs = lcd->tiempoEsperaUs - despertares;
+    } else {
+        energia->despiertoUs += lcd->tiempoEsperaUs;
+    }
+
+    uint64_t activa = (uint64_t)energia->despiertoUs * SIM_CORRIENTE_ACTIVA_UA;
+    uint64_t sleep = (uint64_t)energia->dormidoUs * SIM_CORRIENTE_SLEEP_UA;
+    energia->energiaUj = (uint32_t)(((activa + sleep) * SIM_TENSION_MV) / 1000000000ULL);
+}
+
+void sim_getLine(SIM_LcdTypedef * lcd, uint8_t fila, char * texto) {
+    uint8_t base = (fila & 1) ? 0x40 : 0x00;
+    uint8_t inicio = (fila >= 2) ? lcd->columnas : 0;
+
+    for (uint8_t columna = 0; columna < lcd->columnas; columna++) {
+        uint8_t posicion = (inicio + columna + lcd->desplazamiento) % SIM_LARGO_LINEA;
+        texto[columna] = lcd->ddram[base + posicion];
+    }
+    texto[lcd->columnas] = '\0';
+}
+
+bool_t sim_port_init(int llamadas) {
+    return true;
+}
+
+void sim_port_setAddress(uint8_t direccion, int llamadas) {
+    sim_lcd.direccionPort = direccion;
+}
+
+bool_t sim_port_setClockSpeed(uint32_t velocidad, int llamadas) {
+    if (velocidad < I2C_CLOCK_MIN || velocidad > I2C_CLOCK_MAX)
+        return false;
+
+    sim_lcd.clockI2C = velocidad;
+    return true;
+}
+
+uint32_t sim_port_getClockSpeed(int llamadas) {
+    return sim_lcd.clockI2C;
+}
+
+bool_t sim_port_i2cWriteByte(uint8_t dato, int llamadas) {
+    return sim_i2cWrite(&sim_lcd, &dato, 1);
+}
+
+bool_t sim_port_i2cWrite(const uint8_t * bytes, uint16_t cantidad, int llamadas) {
+    return sim_i2cWrite(&sim_lcd, bytes, cantidad);
+}
+
+bool_t sim_port_i2cReadByte(uint8_t * dato, int llamadas) {
+    sim_i2cRead(&sim_lcd, dato);
+    return true;
+}
+
+void sim_port_delay(uint32_t milisegundos, int llamadas) {
+    sim_delay(&sim_lcd, milisegundos);
+}
+
+uint32_t sim_port_getTick(int llamadas) {
+    return sim_lcd.tiempoUs / 1000;
+}
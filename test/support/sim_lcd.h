@@ -0,0 +1,229 @@
+/**
+ * @file sim_lcd.h
+ * @brief Simulador de un LCD HD44780 conectado por I2C
+ *        a través de un expansor PCF8574, o de un AIP31068 o
+ *        ST7032 con I2C nativo. Decodifica los
+ *        bytes que escribe el driver, mantiene la DDRAM y
+ *        la CGRAM, y lleva la cuenta del tiempo de bus y de
+ *        espera para medir el costo de cada operación.
+ *
+ *        Las funciones sim_port_* tienen la firma de los
+ *        callbacks de CMock, para reemplazar al port con
+ *        port_xxx_StubWithCallback(sim_port_xxx).
+ */
+
+#ifndef TEST_SUPPORT_SIM_LCD_H_
+#define TEST_SUPPORT_SIM_LCD_H_
+
+#include <stdint.h>
+
+#include "API_lcd_port.h"
+
+// tamaño de la DDRAM de un controlador (dos líneas de 40 posiciones)
+#define SIM_TAM_DDRAM    0x68
+#define SIM_TAM_CGRAM    64
+#define SIM_LARGO_LINEA  40
+#define SIM_MAX_COLUMNAS 40
+
+// tiempos de ejecución de las instrucciones en microsegundos
+#define SIM_TIEMPO_INSTRUCCION 37
+#define SIM_TIEMPO_CLEAR_HOME  1520
+
+// tiempos del ST7032, y del seguidor de tensión hasta estabilizarse
+#define SIM_ST7032_INSTRUCCION 27
+#define SIM_ST7032_CLEAR_HOME  1080
+#define SIM_ST7032_SEGUIDOR    200000
+
+// dirección I2C de 7 bits de los controladores nativos
+#define SIM_DIRECCION_NATIVO 0x3E
+
+// modelo de consumo del MCU (STM32F401 a 84 MHz) durante las operaciones
+#define SIM_CORRIENTE_ACTIVA_UA 12000
+#define SIM_CORRIENTE_SLEEP_UA  4000
+#define SIM_TENSION_MV          3300
+#define SIM_DESPERTAR_US        2 // atención del SysTick en cada tick de espera con WFI
+
+// límite de una transmisión circular, para cortar si nunca termina
+#define SIM_MAX_BYTES_DMA 100000
+
+/**
+ * @brief Interfaz del display simulado.
+ */
+typedef enum {
+    SIM_INTERFAZ_PCF8574,  // HD44780 en 4 bits detrás del expansor
+    SIM_INTERFAZ_AIP31068, // I2C nativo con byte de control
+    SIM_INTERFAZ_ST7032    // I2C nativo, con tabla de instrucciones extendida
+} SIM_InterfazTypedef;
+
+/**
+ * @brief Estado de un display simulado.
+ */
+typedef struct SIM_Lcd {
+    // interfaz y direcciones I2C del display y a la que escribe el port
+    SIM_InterfazTypedef interfaz;
+    uint8_t direccionBus;
+    uint8_t direccionPort;
+
+    // salidas del PCF8574 y pines que usa este controlador como E y RW
+    uint8_t pines;
+    uint8_t pinE;
+    uint8_t pinRw; // 0 si RW está a masa
+
+    // decodificación de los bytes de control de la interfaz nativa
+    bool_t esperaControl; // el próximo byte es de control
+    bool_t controlFinal;  // el último control tenía Co = 0: el resto son datos o comandos
+    bool_t rsNativo;      // RS del último byte de control
+
+    // tabla extendida del ST7032
+    bool_t tablaExtendida; // IS del último FUNCTION SET
+    uint8_t contraste;     // 6 bits de contraste
+    bool_t seguidor;       // seguidor de tensión encendido
+
+    // estado del controlador HD44780
+    uint8_t ddram[SIM_TAM_DDRAM];
+    uint8_t cgram[SIM_TAM_CGRAM];
+    uint8_t direccion;      // contador de direcciones (AC)
+    bool_t enCgram;         // el AC apunta a la CGRAM
+    bool_t modo4Bits;       // interfaz de 4 bits configurada
+    bool_t nibblePendiente; // se recibió el nibble alto y falta el bajo
+    uint8_t nibbleAlto;
+    uint8_t lectura;        // byte que se está leyendo de a nibbles
+    uint8_t modoEntrada;    // bits I/D y S del comando ENTRY MODE
+    uint8_t control;        // bits D, C y B del comando DISPLAY CONTROL
+    uint8_t funcion;        // último FUNCTION SET
+    uint8_t desplazamiento; // desplazamiento de pantalla, 0 a 39
+    uint8_t columnas;       // geometría visible
+    uint8_t filas;
+    uint32_t tiempoInstruccionUs;
+    uint32_t tiempoClearUs;
+
+    // tiempo simulado en microsegundos
+    uint32_t clockI2C;
+    uint32_t tiempoUs;
+    uint32_t ocupadoHastaUs;
+    uint32_t tiempoBusUs;
+    uint32_t tiempoEsperaUs;
+    bool_t esperaDormido; // port_delay duerme con WFI (PORT_DELAY_WFI)
+
+    // estadísticas
+    uint32_t bytesI2C;
+    uint32_t transacciones;
+    uint32_t instrucciones;
+    uint32_t datos;
+    uint32_t violaciones; // instrucciones recibidas con el controlador ocupado
+    uint32_t nacks;       // transacciones a una dirección que no es la del display
+
+    // otro controlador conectado al mismo expansor, que recibe los mismos bytes
+    struct SIM_Lcd * siguiente;
+} SIM_LcdTypedef;
+
+/**
+ * @brief Reporte de consumo de la CPU. Durante las transacciones
+ *        bloqueantes la CPU está despierta esperando al bus; durante
+ *        las esperas lo está o no según esperaDormido.
+ */
+typedef struct {
+    uint32_t busUs;       // tiempo de transacciones I2C
+    uint32_t esperaUs;    // tiempo en port_delay
+    uint32_t despiertoUs; // CPU activa
+    uint32_t dormidoUs;   // CPU en Sleep
+    uint32_t energiaUj;   // energía del MCU en el período
+} SIM_EnergiaTypedef;
+
+/**
+ * @brief Display simulado que usan los callbacks sim_port_*.
+ */
+extern SIM_LcdTypedef sim_lcd;
+
+/**
+ * @brief Segundo controlador (E2) de un panel de 40x4 simulado.
+ */
+extern SIM_LcdTypedef sim_lcdE2;
+
+/**
+ * @brief Deja el display en el estado de encendido: interfaz de 8 bits,
+ *        pantalla apagada y DDRAM en blanco. Geometría de 16x2 a 100 kHz.
+ */
+void sim_init(SIM_LcdTypedef *);
+
+/**
+ * @brief Deja el display como sim_init pero con un controlador de
+ *        I2C nativo, en su dirección y con sus tiempos.
+ */
+void sim_initNative(SIM_LcdTypedef *, SIM_InterfazTypedef);
+
+/**
+ * @brief Deja dos displays como los controladores de un panel de 40x4
+ *        detrás de un mismo PCF8574: dos filas de 40 columnas cada uno,
+ *        con E en los pines indicados y RW a masa. Lo que se escribe en
+ *        el primero llega también al segundo.
+ */
+void sim_initDual(SIM_LcdTypedef *, SIM_LcdTypedef *, uint8_t, uint8_t);
+
+/**
+ * @brief Simula una transacción de escritura I2C con uno o más bytes.
+ *        Con el PCF8574 cada byte actualiza sus salidas y un flanco
+ *        descendente de E hace que el controlador lea el nibble. Con
+ *        una interfaz nativa cada byte de control indica si sigue un
+ *        comando o un dato (RS) y si después viene otro control (Co).
+ * @return false si la dirección del port no es la del display.
+ */
+bool_t sim_i2cWrite(SIM_LcdTypedef *, const uint8_t *, uint16_t);
+
+/**
+ * @brief Avanza el tiempo simulado en milisegundos de espera.
+ */
+void sim_delay(SIM_LcdTypedef *, uint32_t);
+
+/**
+ * @brief Modela una transmisión por DMA circular en una única
+ *        transacción: envía una mitad del buffer y llama al
+ *        callback de mitad, como la ISR de media transferencia o
+ *        de transferencia completa, mientras sigue con la otra.
+ *        Cuando el callback devuelve false llega a salir un byte
+ *        más, el que el DMA ya había cargado en el I2C.
+ * @return cantidad de bytes transmitidos
+ */
+uint32_t sim_i2cWriteCircular(SIM_LcdTypedef *, const uint8_t *, uint16_t,
+                              port_MitadCallbackTypedef);
+
+/**
+ * @brief Pone en cero los tiempos y contadores acumulados, sin cambiar
+ *        el estado del display, para medir una operación aislada.
+ */
+void sim_resetStats(SIM_LcdTypedef *);
+
+/**
+ * @brief Calcula el tiempo despierto, dormido y la energía del MCU
+ *        desde el último sim_init o sim_resetStats.
+ */
+void sim_getEnergy(SIM_LcdTypedef *, SIM_EnergiaTypedef *);
+
+/**
+ * @brief Lee los pines del PCF8574 en una transacción I2C. Con RW
+ *        y E en alto el controlador maneja D4-D7 con el nibble que
+ *        corresponde; los pines que el driver dejó en 0 leen 0.
+ */
+void sim_i2cRead(SIM_LcdTypedef *, uint8_t *);
+
+/**
+ * @brief Copia el texto visible de una fila, terminado en '\0'.
+ *        Tiene en cuenta el desplazamiento de pantalla.
+ */
+void sim_getLine(SIM_LcdTypedef *, uint8_t, char *);
+
+/**
+ * @brief Callbacks con la firma de CMock para reemplazar
+ *        las funciones de API_lcd_port con el display sim_lcd.
+ */
+bool_t sim_port_init(int);
+void sim_port_setAddress(uint8_t, int);
+bool_t sim_port_setClockSpeed(uint32_t, int);
+uint32_t sim_port_getClockSpeed(int);
+bool_t sim_port_i2cWriteByte(uint8_t, int);
+bool_t sim_port_i2cWrite(const uint8_t *, uint16_t, int);
+bool_t sim_port_i2cReadByte(uint8_t *, int);
+void sim_port_delay(uint32_t, int);
+uint32_t sim_port_getTick(int);
+
+#endif /* TEST_SUPPORT_SIM_LCD_H_ */
@@ -0,0 +1,266 @@
+/**
+ * @file sim_replay.c
+ * @brief Implementación del banco de reproducción de registros
+ *        de llamadas.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "sim_replay.h"
+
+#ifdef SIM_REPLAY
+
+#include "API_lcd.h"
+#include "API_lcd_buffer.h"
+#include "API_lcd_queue.h"
+#include "API_lcd_record.h"
+#include "API_lcd_stream.h"
+#include "sim_lcd.h"
+
+#if !(defined(LCD_RECORDER) && defined(LCD_QUEUE) && defined(LCD_STREAM))
+#error "SIM_REPLAY usa el registro, la cola y el envío por interrupciones del driver"
+#endif
+
+/**
+ * @brief Estado de la reproducción: lienzo de la aplicación, sombra
+ *        del envío, cursor del lienzo y llegada de las llamadas
+ *        pendientes de verse.
+ */
+static LCD_BufferTypedef lienzo;
+static LCD_BufferTypedef sombraEnvio;
+static uint8_t filaLienzo;
+static uint8_t columnaLienzo;
+static uint32_t llegadas[SIM_REPLAY_MAX_LLAMADAS];
+static uint32_t latencias[SIM_REPLAY_MAX_LLAMADAS];
+static uint32_t cantidadPendientes;
+static uint32_t cantidadLatencias;
+
+/**
+ * @brief Avanza el tiempo simulado hasta el instante indicado, si no pasó.
+ */
+static void sim_replayWait(uint32_t instanteUs) {
+    if (sim_lcd.tiempoUs < instanteUs)
+        sim_lcd.tiempoUs = instanteUs;
+}
+
+/**
+ * @brief Registra como vistas en el display todas las llamadas pendientes.
+ */
+static void sim_replayDeliver() {
+    for (uint32_t indice = 0; indice < cantidadPendientes; indice++)
+        latencias[cantidadLatencias++] = sim_lcd.tiempoUs - llegadas[indice];
+    cantidadPendientes = 0;
+}
+
+/**
+ * @brief Indica si la llamada sólo cambia celdas y el cursor.
+ */
+static bool_t sim_replayIsDraw(LCD_LlamadaTypedef llamada) {
+    return llamada == LCD_LLAMADA_CLEAR || llamada == LCD_LLAMADA_PRINT_CHAR ||
+           llamada == LCD_LLAMADA_PRINT_TEXT || llamada == LCD_LLAMADA_PRINT_AT ||
+           llamada == LCD_LLAMADA_SET_CURSOR;
+}
+
+/**
+ * @brief Escribe un caracter en el lienzo y avanza el cursor.
+ */
+static void sim_replayDrawChar(char caracter) {
+    LCD_bufferWrite(&lienzo, filaLienzo, columnaLienzo, caracter);
+    columnaLienzo++;
+}
+
+/**
+ * @brief Hace una llamada de dibujo sobre el lienzo, con el mismo
+ *        resultado en pantalla que la API del LCD.
+ */
+static void sim_replayDraw(const LCD_RegistroTypedef * llamada) {
+    const char * texto = llamada->texto;
+    uint8_t contador = 0;
+
+    switch (llamada->llamada) {
+    case LCD_LLAMADA_PRINT_TEXT:
+        LCD_bufferClear(&lienzo);
+        filaLienzo = 0;
+        columnaLienzo = 0;
+        while (*texto != '\0' && contador < LCD_CANTIDAD_COLUMNAS * LCD_CANTIDAD_FILAS) {
+            if (*texto == '\n') {
+                filaLienzo = 1;
+                columnaLienzo = 0;
+                contador = 0;
+                texto++;
+                continue;
+            }
+            sim_replayDrawChar(*texto++);
+            if (++contador == LCD_CANTIDAD_COLUMNAS) {
+                filaLienzo = 1;
+                columnaLienzo = 0;
+            }
+        }
+        break;
+    case LCD_LLAMADA_PRINT_AT:
+    case LCD_LLAMADA_SET_CURSOR:
+        filaLienzo = (llamada->argumentos[0] == LCD_FILA_1) ? 0 : 1;
+        columnaLienzo = llamada->argumentos[1];
+        while (llamada->llamada == LCD_LLAMADA_PRINT_AT && *texto != '\0' &&
+               columnaLienzo < LCD_CANTIDAD_COLUMNAS)
+            sim_replayDrawChar(*texto++);
+        break;
+    case LCD_LLAMADA_PRINT_CHAR:
+        sim_replayDrawChar(llamada->argumentos[0]);
+        break;
+    default:
+        LCD_bufferClear(&lienzo);
+        filaLienzo = 0;
+        columnaLienzo = 0;
+        break;
+    }
+}
+
+/**
+ * @brief Encola una llamada de dibujo en la cola del driver.
+ * @retval false si la cola la rechazó.
+ */
+static bool_t sim_replayEnqueue(const LCD_RegistroTypedef * llamada) {
+    const uint8_t * argumentos = llamada->argumentos;
+
+    switch (llamada->llamada) {
+    case LCD_LLAMADA_PRINT_TEXT:
+        return LCD_queuePrintText(llamada->texto) == LCD_OK;
+    case LCD_LLAMADA_PRINT_AT:
+        return LCD_queuePrintAt(argumentos[0], argumentos[1], llamada->texto) == LCD_OK;
+    case LCD_LLAMADA_PRINT_CHAR:
+        return LCD_queuePrintChar(argumentos[0]) == LCD_OK;
+    case LCD_LLAMADA_SET_CURSOR:
+        return LCD_queueSetCursor(argumentos[0], argumentos[1]) == LCD_OK;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Envía lo pendiente al terminar un cuadro, según el modo.
+ */
+static void sim_replayCloseFrame(const SIM_ReproduccionTypedef * config, uint32_t instanteUs,
+                                 SIM_ReporteTypedef * reporte) {
+    if (config->modo == SIM_MODO_ASINCRONO && sim_lcd.tiempoUs > instanteUs) {
+        reporte->cuadrosPerdidos++; // el envío del cuadro anterior sigue en el bus
+        return;
+    }
+
+    sim_replayWait(instanteUs);
+    uint32_t inicio = sim_lcd.tiempoUs;
+
+    if (config->modo == SIM_MODO_LOTES) {
+        while (LCD_queuePending() > 0)
+            LCD_queueProcess();
+    } else {
+        LCD_bufferDiff(&sombraEnvio, &lienzo);
+        if (LCD_bufferIsDirty(&sombraEnvio) && LCD_streamFlush(&sombraEnvio) == LCD_OK)
+            config->atender();
+    }
+
+    if (config->modo != SIM_MODO_ASINCRONO)
+        reporte->tiempoBloqueadoUs += sim_lcd.tiempoUs - inicio;
+    reporte->cuadros++;
+    sim_replayDeliver();
+}
+
+/**
+ * @brief Compara dos latencias para ordenarlas.
+ */
+static int sim_replayCompare(const void * primera, const void * segunda) {
+    uint32_t a = *(const uint32_t *)primera;
+    uint32_t b = *(const uint32_t *)segunda;
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief Hace las llamadas del registro en sus tiempos; los dibujos se
+ *        envían al hacerse o al cerrar cada cuadro, según el modo.
+ */
+bool_t sim_replay(const uint8_t * datos, uint32_t largo, const SIM_ReproduccionTypedef * config,
+                  SIM_ReporteTypedef * reporte) {
+    LCD_LectorTypedef lector;
+    LCD_RegistroTypedef llamada;
+    uint32_t periodoUs = config->periodoMs * 1000;
+    uint32_t proximoCuadroUs = periodoUs;
+
+    if (LCD_recordOpen(&lector, datos, largo) != LCD_OK || config->modo >= SIM_MODOS ||
+        periodoUs == 0)
+        return false;
+
+    // el port conserva la velocidad cuando el registro llama a LCD_init
+    sim_init(&sim_lcd);
+    if (!port_setClockSpeed(config->clockI2C))
+        return false;
+
+    memset(reporte, 0, sizeof(*reporte));
+    LCD_queueInit();
+    LCD_queueSetPolicy(LCD_COLA_DESCARTAR_NUEVO, 0);
+    LCD_bufferInit(&lienzo, LCD_CANTIDAD_FILAS, LCD_CANTIDAD_COLUMNAS);
+    LCD_bufferInit(&sombraEnvio, LCD_CANTIDAD_FILAS, LCD_CANTIDAD_COLUMNAS);
+    filaLienzo = 0;
+    columnaLienzo = 0;
+    cantidadPendientes = 0;
+    cantidadLatencias = 0;
+
+    while (LCD_recordNext(&lector, &llamada)) {
+        uint32_t llegadaUs = llamada.tick * 1000;
+
+        if (reporte->llamadas == SIM_REPLAY_MAX_LLAMADAS)
+            return false;
+
+        // en los cuadros sin dibujos pendientes no hay nada que enviar
+        while (config->modo != SIM_MODO_BLOQUEANTE && proximoCuadroUs <= llegadaUs) {
+            if (cantidadPendientes > 0)
+                sim_replayCloseFrame(config, proximoCuadroUs, reporte);
+            proximoCuadroUs += periodoUs;
+        }
+
+        sim_replayWait(llegadaUs);
+        reporte->llamadas++;
+
+        if (config->modo != SIM_MODO_BLOQUEANTE && sim_replayIsDraw(llamada.llamada)) {
+            if (config->modo == SIM_MODO_LOTES && !sim_replayEnqueue(&llamada)) {
+                reporte->cuadrosPerdidos++;
+                continue;
+            }
+            if (config->modo != SIM_MODO_LOTES)
+                sim_replayDraw(&llamada);
+            llegadas[cantidadPendientes++] = llegadaUs;
+            continue;
+        }
+
+        // las llamadas que no son dibujos se hacen en orden con lo ya encolado
+        if (config->modo == SIM_MODO_LOTES) {
+            while (LCD_queuePending() > 0)
+                LCD_queueProcess();
+            sim_replayDeliver();
+        }
+
+        uint32_t inicio = sim_lcd.tiempoUs;
+        LCD_recordReplay(&llamada);
+        reporte->tiempoBloqueadoUs += sim_lcd.tiempoUs - inicio;
+        latencias[cantidadLatencias++] = sim_lcd.tiempoUs - llegadaUs;
+    }
+
+    while (cantidadPendientes > 0) {
+        sim_replayCloseFrame(config, proximoCuadroUs, reporte);
+        proximoCuadroUs += periodoUs;
+    }
+
+    if (cantidadLatencias == 0)
+        return false;
+
+    qsort(latencias, cantidadLatencias, sizeof(latencias[0]), sim_replayCompare);
+    reporte->latenciaP50Us = latencias[(cantidadLatencias - 1) * 50 / 100];
+    reporte->latenciaP95Us = latencias[(cantidadLatencias - 1) * 95 / 100];
+    reporte->latenciaP99Us = latencias[(cantidadLatencias - 1) * 99 / 100];
+    reporte->latenciaMaximaUs = latencias[cantidadLatencias - 1];
+    reporte->tiempoBusUs = sim_lcd.tiempoBusUs;
+    reporte->bytesI2C = sim_lcd.bytesI2C;
+    return true;
+}
+
+#endif /* SIM_REPLAY */
@@ -0,0 +1,75 @@
+/**
+ * @file sim_replay.h
+ * @brief Banco de reproducción de registros de llamadas (API_lcd_record)
+ *        contra el display simulado sim_lcd: hace las llamadas del
+ *        registro en sus tiempos con una configuración del driver y
+ *        mide el tiempo de bus, la latencia desde cada llamada hasta
+ *        que se ve en el display y los cuadros perdidos.
+ *
+ *        Lo usan el test del registro y la herramienta host/lcd_replay.
+ *        Se compila definiendo SIM_REPLAY, con LCD_RECORDER y la
+ *        configuración LCD_BUILD_FULL del driver.
+ */
+
+#ifndef TEST_SUPPORT_SIM_REPLAY_H_
+#define TEST_SUPPORT_SIM_REPLAY_H_
+
+#include <stdint.h>
+
+#include "API_lcd_port.h"
+
+// llamadas de un registro que puede seguir el banco
+#ifndef SIM_REPLAY_MAX_LLAMADAS
+#define SIM_REPLAY_MAX_LLAMADAS 4096
+#endif
+
+/**
+ * @brief Configuraciones del driver con que se reproduce un registro.
+ */
+typedef enum {
+    SIM_MODO_BLOQUEANTE, // cada llamada se envía al hacerse
+    SIM_MODO_LOTES,      // los dibujos se encolan y la cola se procesa en cada cuadro
+    SIM_MODO_DIFF,       // se dibuja en un lienzo y en cada cuadro se envía el diff, bloqueando
+    SIM_MODO_ASINCRONO,  // igual, sin bloquear; si el bus sigue ocupado se pierde el cuadro
+    SIM_MODOS
+} SIM_ModoTypedef;
+
+/**
+ * @brief Configuración de una reproducción. atender hace el trabajo de
+ *        la ISR del I2C: completa el envío por interrupciones que
+ *        arrancó el port con port_i2cStreamStart.
+ */
+typedef struct {
+    SIM_ModoTypedef modo;
+    uint32_t clockI2C;
+    uint32_t periodoMs; // período de los cuadros
+    void (*atender)();
+} SIM_ReproduccionTypedef;
+
+/**
+ * @brief Resultado de una reproducción.
+ */
+typedef struct {
+    uint32_t llamadas;
+    uint32_t tiempoBusUs;
+    uint32_t tiempoBloqueadoUs; // tiempo de la aplicación dentro del driver
+    uint32_t bytesI2C;
+    uint32_t latenciaP50Us;     // desde la llamada hasta que se ve en el display
+    uint32_t latenciaP95Us;
+    uint32_t latenciaP99Us;
+    uint32_t latenciaMaximaUs;
+    uint32_t cuadros;
+    uint32_t cuadrosPerdidos;   // cuadros con el bus ocupado o pedidos rechazados por la cola
+} SIM_ReporteTypedef;
+
+/**
+ * @brief Reproduce el registro (datos, largo) desde un display recién
+ *        encendido con la configuración indicada y completa el reporte.
+ *        Deja en sim_lcd la pantalla del final de la reproducción.
+ * @retval false si el registro es inválido, no tiene llamadas o tiene
+ *         más de SIM_REPLAY_MAX_LLAMADAS.
+ */
+bool_t sim_replay(const uint8_t *, uint32_t, const SIM_ReproduccionTypedef *,
+                  SIM_ReporteTypedef *);
+
+#endif /* TEST_SUPPORT_SIM_REPLAY_H_ */
@@ -0,0 +1,351 @@
+/**
+ * @file sim_server.c
+ * @brief Implementación del servicio de displays simulados.
+ */
+
+#define _POSIX_C_SOURCE 200809L // sockets, poll y nanosleep
+
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "sim_server.h"
+
+// período en el que el hilo de escucha revisa si tiene que terminar
+#define SIM_ESPERA_ESCUCHA_MS 50
+
+/**
+ * @brief Espera en tiempo real una cantidad de microsegundos.
+ */
+static void sim_dormir(uint64_t microsegundos) {
+    struct timespec espera = {(time_t)(microsegundos / 1000000),
+                              (long)(microsegundos % 1000000) * 1000};
+
+    if (microsegundos > 0)
+        while (nanosleep(&espera, &espera) != 0)
+            ;
+}
+
+/**
+ * @brief Recibe exactamente la cantidad de bytes pedida.
+ * @return false si se cerró la conexión.
+ */
+static bool_t sim_recibir(int fd, uint8_t * datos, size_t largo) {
+    while (largo > 0) {
+        ssize_t recibidos = recv(fd, datos, largo, 0);
+        if (recibidos <= 0)
+            return false;
+        datos += recibidos;
+        largo -= recibidos;
+    }
+    return true;
+}
+
+/**
+ * @brief Envía el encabezado de la respuesta y su contenido.
+ */
+static bool_t sim_responder(int fd, uint8_t respuesta, const void * datos, uint16_t largo) {
+    uint8_t mensaje[sizeof(SOCK_EncabezadoTypedef) + SOCK_MAX_COLUMNAS + 1 +
+                    sizeof(SOCK_EstadisticasTypedef)];
+    SOCK_EncabezadoTypedef encabezado = {respuesta, 0, largo};
+
+    memcpy(mensaje, &encabezado, sizeof(encabezado));
+    if (largo > 0)
+        memcpy(&mensaje[sizeof(encabezado)], datos, largo);
+
+    size_t total = sizeof(encabezado) + largo;
+    const uint8_t * pendiente = mensaje;
+    while (total > 0) {
+        ssize_t enviados = send(fd, pendiente, total, MSG_NOSIGNAL);
+        if (enviados <= 0)
+            return false;
+        pendiente += enviados;
+        total -= enviados;
+    }
+    return true;
+}
+
+/**
+ * @brief Copia las estadísticas de un display, con su mutex tomado.
+ */
+static void sim_copiarEstadisticas(SIM_PantallaTypedef * pantalla, uint8_t * destino) {
+    SOCK_EstadisticasTypedef estadisticas;
+
+    estadisticas.pedidos = pantalla->pedidos;
+    estadisticas.transacciones = pantalla->lcd.transacciones;
+    estadisticas.bytesI2C = pantalla->lcd.bytesI2C;
+    estadisticas.nacks = pantalla->lcd.nacks;
+    estadisticas.violaciones = pantalla->lcd.violaciones;
+    estadisticas.tiempoBusUs = pantalla->lcd.tiempoBusUs;
+    estadisticas.tiempoEsperaUs = pantalla->lcd.tiempoEsperaUs;
+    estadisticas.clientes = pantalla->clientes;
+    memcpy(destino, &estadisticas, sizeof(estadisticas));
+}
+
+/**
+ * @brief Ejecuta un pedido sobre el display con su mutex tomado y
+ *        arma la respuesta.
+ * @return resultado del pedido; en largo queda el largo de la respuesta.
+ */
+static uint8_t sim_atender(SIM_PantallaTypedef * pantalla, const SOCK_EncabezadoTypedef * pedido,
+                           const uint8_t * datos, uint8_t * respuesta, uint16_t * largo) {
+    SIM_LcdTypedef * lcd = &pantalla->lcd;
+    uint32_t milisegundos;
+
+    *largo = 0;
+    switch (pedido->operacion) {
+    case SOCK_OP_ESCRIBIR:
+        if (pedido->largo < 1)
+            return SOCK_RESPUESTA_ERROR;
+        lcd->direccionPort = datos[0];
+        return sim_i2cWrite(lcd, &datos[1], pedido->largo - 1) ? SOCK_RESPUESTA_OK
+                                                               : SOCK_RESPUESTA_NACK;
+    case SOCK_OP_LEER:
+        if (pedido->largo < 1)
+            return SOCK_RESPUESTA_ERROR;
+        lcd->direccionPort = datos[0];
+        if (lcd->direccionPort != lcd->direccionBus) {
+            lcd->nacks++;
+            return SOCK_RESPUESTA_NACK;
+        }
+        sim_i2cRead(lcd, respuesta);
+        *largo = 1;
+        return SOCK_RESPUESTA_OK;
+    case SOCK_OP_ESPERAR:
+        if (pedido->largo != sizeof(milisegundos))
+            return SOCK_RESPUESTA_ERROR;
+        memcpy(&milisegundos, datos, sizeof(milisegundos));
+        sim_delay(lcd, milisegundos);
+        return SOCK_RESPUESTA_OK;
+    case SOCK_OP_TICK:
+        milisegundos = lcd->tiempoUs / 1000;
+        memcpy(respuesta, &milisegundos, sizeof(milisegundos));
+        *largo = sizeof(milisegundos);
+        return SOCK_RESPUESTA_OK;
+    case SOCK_OP_ESTADISTICAS:
+        sim_copiarEstadisticas(pantalla, respuesta);
+        *largo = sizeof(SOCK_EstadisticasTypedef);
+        return SOCK_RESPUESTA_OK;
+    case SOCK_OP_LINEA:
+        if (pedido->largo < 1 || datos[0] >= lcd->filas)
+            return SOCK_RESPUESTA_ERROR;
+        sim_getLine(lcd, datos[0], (char *)respuesta);
+        *largo = lcd->columnas + 1;
+        return SOCK_RESPUESTA_OK;
+    default:
+        return SOCK_RESPUESTA_ERROR;
+    }
+}
+
+/**
+ * @brief Hilo de un cliente: lee pedidos hasta que se cierra la
+ *        conexión. La latencia se espera después de soltar el mutex.
+ */
+static void * sim_hiloCliente(void * argumento) {
+    SIM_ClienteTypedef * cliente = argumento;
+    SIM_ServidorTypedef * servidor = cliente->servidor;
+    uint8_t datos[SOCK_MAX_DATOS];
+    uint8_t respuesta[SOCK_MAX_COLUMNAS + 1 + sizeof(SOCK_EstadisticasTypedef)];
+    SOCK_EncabezadoTypedef pedido;
+
+    while (sim_recibir(cliente->fd, (uint8_t *)&pedido, sizeof(pedido))) {
+        if (pedido.largo > SOCK_MAX_DATOS || !sim_recibir(cliente->fd, datos, pedido.largo))
+            break;
+
+        if (pedido.pantalla >= servidor->config.pantallas) {
+            if (!sim_responder(cliente->fd, SOCK_RESPUESTA_ERROR, NULL, 0))
+                break;
+            continue;
+        }
+
+        SIM_PantallaTypedef * pantalla = &servidor->pantallas[pedido.pantalla];
+        uint16_t largo;
+
+        pthread_mutex_lock(&pantalla->mutex);
+        uint32_t antes = pantalla->lcd.tiempoUs;
+        pantalla->pedidos++;
+        if (!cliente->pantallasUsadas[pedido.pantalla]) {
+            cliente->pantallasUsadas[pedido.pantalla] = true;
+            pantalla->clientes++;
+        }
+        uint8_t resultado = sim_atender(pantalla, &pedido, datos, respuesta, &largo);
+        uint32_t simulado = pantalla->lcd.tiempoUs - antes;
+        pthread_mutex_unlock(&pantalla->mutex);
+
+        sim_dormir(servidor->config.latenciaUs +
+                   (uint64_t)simulado * servidor->config.escalaTiempo / 100);
+
+        if (!sim_responder(cliente->fd, resultado, respuesta, largo))
+            break;
+    }
+
+    pthread_mutex_lock(&servidor->mutexClientes);
+    close(cliente->fd);
+    cliente->terminado = true;
+    pthread_mutex_unlock(&servidor->mutexClientes);
+    return NULL;
+}
+
+/**
+ * @brief Espera a los hilos de los clientes que terminaron y libera
+ *        su lugar. Con todos en true espera a todos; en ese caso se
+ *        llama sin el mutex de clientes, que los hilos toman al salir.
+ */
+static void sim_liberarClientes(SIM_ServidorTypedef * servidor, bool_t todos) {
+    for (uint8_t indice = 0; indice < SIM_MAX_CLIENTES; indice++) {
+        SIM_ClienteTypedef * cliente = &servidor->clientes[indice];
+        if (cliente->usado && (todos || cliente->terminado)) {
+            pthread_join(cliente->hilo, NULL);
+            cliente->usado = false;
+        }
+    }
+}
+
+/**
+ * @brief Hilo de escucha: acepta clientes mientras el servicio está
+ *        activo. Si no hay lugar para otro cliente lo desconecta.
+ */
+static void * sim_hiloEscucha(void * argumento) {
+    SIM_ServidorTypedef * servidor = argumento;
+    struct pollfd escucha = {servidor->fd, POLLIN, 0};
+
+    while (servidor->activo) {
+        if (poll(&escucha, 1, SIM_ESPERA_ESCUCHA_MS) <= 0)
+            continue;
+
+        int fd = accept(servidor->fd, NULL, NULL);
+        if (fd < 0)
+            continue;
+
+        pthread_mutex_lock(&servidor->mutexClientes);
+        sim_liberarClientes(servidor, false);
+
+        SIM_ClienteTypedef * cliente = NULL;
+        for (uint8_t indice = 0; indice < SIM_MAX_CLIENTES && cliente == NULL; indice++)
+            if (!servidor->clientes[indice].usado)
+                cliente = &servidor->clientes[indice];
+
+        if (cliente != NULL) {
+            memset(cliente, 0, sizeof(*cliente));
+            cliente->servidor = servidor;
+            cliente->fd = fd;
+            cliente->usado = true;
+            if (pthread_create(&cliente->hilo, NULL, sim_hiloCliente, cliente) != 0) {
+                cliente->usado = false;
+                close(fd);
+            }
+        } else {
+            close(fd);
+        }
+        pthread_mutex_unlock(&servidor->mutexClientes);
+    }
+
+    return NULL;
+}
+
+void sim_serverDefaults(SIM_ServidorConfigTypedef * config) {
+    config->ruta = SOCK_RUTA_DEFECTO;
+    config->pantallas = 1;
+    config->columnas = 16;
+    config->filas = 2;
+    config->clockI2C = I2C_CLOCK_SPEED;
+    config->latenciaUs = 0;
+    config->escalaTiempo = 0;
+}
+
+bool_t sim_serverStart(SIM_ServidorTypedef * servidor, const SIM_ServidorConfigTypedef * config) {
+    if (config->pantallas == 0 || config->pantallas > SIM_MAX_PANTALLAS ||
+        config->columnas == 0 || config->columnas > SIM_MAX_COLUMNAS || config->filas == 0 ||
+        config->filas > 4 || config->clockI2C == 0 || strlen(config->ruta) >= SOCK_MAX_RUTA)
+        return false;
+
+    memset(servidor, 0, sizeof(*servidor));
+    servidor->config = *config;
+    strcpy(servidor->ruta, config->ruta);
+    servidor->config.ruta = servidor->ruta;
+
+    for (uint8_t indice = 0; indice < config->pantallas; indice++) {
+        SIM_PantallaTypedef * pantalla = &servidor->pantallas[indice];
+        sim_init(&pantalla->lcd);
+        pantalla->lcd.columnas = config->columnas;
+        pantalla->lcd.filas = config->filas;
+        pantalla->lcd.clockI2C = config->clockI2C;
+        pthread_mutex_init(&pantalla->mutex, NULL);
+    }
+    pthread_mutex_init(&servidor->mutexClientes, NULL);
+
+    struct sockaddr_un direccion;
+    memset(&direccion, 0, sizeof(direccion));
+    direccion.sun_family = AF_UNIX;
+    strcpy(direccion.sun_path, servidor->ruta);
+
+    unlink(servidor->ruta);
+    servidor->fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (servidor->fd < 0)
+        return false;
+
+    if (bind(servidor->fd, (struct sockaddr *)&direccion, sizeof(direccion)) != 0 ||
+        listen(servidor->fd, SIM_MAX_CLIENTES) != 0) {
+        close(servidor->fd);
+        return false;
+    }
+
+    servidor->activo = true;
+    if (pthread_create(&servidor->hiloEscucha, NULL, sim_hiloEscucha, servidor) != 0) {
+        servidor->activo = false;
+        close(servidor->fd);
+        unlink(servidor->ruta);
+        return false;
+    }
+
+    return true;
+}
+
+void sim_serverStop(SIM_ServidorTypedef * servidor) {
+    if (!servidor->activo)
+        return;
+
+    servidor->activo = false;
+    pthread_join(servidor->hiloEscucha, NULL);
+    close(servidor->fd);
+    unlink(servidor->ruta);
+
+    // despierta a los hilos bloqueados en recv; cada uno cierra su conexión
+    pthread_mutex_lock(&servidor->mutexClientes);
+    for (uint8_t indice = 0; indice < SIM_MAX_CLIENTES; indice++)
+        if (servidor->clientes[indice].usado && !servidor->clientes[indice].terminado)
+            shutdown(servidor->clientes[indice].fd, SHUT_RDWR);
+    pthread_mutex_unlock(&servidor->mutexClientes);
+    sim_liberarClientes(servidor, true);
+
+    for (uint8_t indice = 0; indice < servidor->config.pantallas; indice++)
+        pthread_mutex_destroy(&servidor->pantallas[indice].mutex);
+    pthread_mutex_destroy(&servidor->mutexClientes);
+}
+
+bool_t sim_serverGetStats(SIM_ServidorTypedef * servidor, uint8_t indice,
+                          SOCK_EstadisticasTypedef * estadisticas) {
+    if (indice >= servidor->config.pantallas)
+        return false;
+
+    SIM_PantallaTypedef * pantalla = &servidor->pantallas[indice];
+    pthread_mutex_lock(&pantalla->mutex);
+    sim_copiarEstadisticas(pantalla, (uint8_t *)estadisticas);
+    pthread_mutex_unlock(&pantalla->mutex);
+    return true;
+}
+
+bool_t sim_serverGetLine(SIM_ServidorTypedef * servidor, uint8_t indice, uint8_t fila,
+                         char * texto) {
+    if (indice >= servidor->config.pantallas)
+        return false;
+
+    SIM_PantallaTypedef * pantalla = &servidor->pantallas[indice];
+    pthread_mutex_lock(&pantalla->mutex);
+    sim_getLine(&pantalla->lcd, fila, texto);
+    pthread_mutex_unlock(&pantalla->mutex);
+    return true;
+}
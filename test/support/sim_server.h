@@ -0,0 +1,111 @@
+/**
+ * @file sim_server.h
+ * @brief Servicio de displays simulados sobre un socket Unix.
+ *        Atiende el protocolo de API_lcd_port_sock.h con varios
+ *        displays sim_lcd, cada uno con su tiempo simulado y sus
+ *        estadísticas. Cada cliente se atiende en su propio hilo
+ *        y cada display tiene su mutex, así que clientes de
+ *        displays distintos avanzan en paralelo.
+ *
+ *        La latencia se puede inyectar de dos formas: una demora
+ *        fija por pedido, y un porcentaje del tiempo simulado de
+ *        bus y de espera de cada pedido que también se espera en
+ *        tiempo real (100 para imitar la velocidad del bus real).
+ *        La espera se hace fuera del mutex del display.
+ *
+ *        Lo usan los tests de API_lcd_port_sock y el programa
+ *        tools/sim_lcdd.c.
+ */
+
+#ifndef TEST_SUPPORT_SIM_SERVER_H_
+#define TEST_SUPPORT_SIM_SERVER_H_
+
+#include <pthread.h>
+
+#include "API_lcd_port_sock.h"
+#include "sim_lcd.h"
+
+#define SIM_MAX_PANTALLAS 8
+#define SIM_MAX_CLIENTES  16
+
+/**
+ * @brief Configuración del servicio.
+ */
+typedef struct {
+    const char * ruta; // socket a crear; si existe se reemplaza
+    uint8_t pantallas;
+    uint8_t columnas;
+    uint8_t filas;
+    uint32_t clockI2C;
+    uint32_t latenciaUs;    // demora fija de cada pedido
+    uint16_t escalaTiempo;  // % del tiempo simulado que se espera en tiempo real
+} SIM_ServidorConfigTypedef;
+
+/**
+ * @brief Un display del servicio.
+ */
+typedef struct {
+    SIM_LcdTypedef lcd;
+    pthread_mutex_t mutex;
+    uint32_t pedidos;
+    uint32_t clientes;
+} SIM_PantallaTypedef;
+
+/**
+ * @brief Conexión de un cliente.
+ */
+typedef struct {
+    struct SIM_Servidor * servidor;
+    int fd;
+    pthread_t hilo;
+    bool_t usado;
+    bool_t terminado;
+    uint8_t pantallasUsadas[SIM_MAX_PANTALLAS]; // para contar cada cliente una vez
+} SIM_ClienteTypedef;
+
+/**
+ * @brief Estado del servicio.
+ */
+typedef struct SIM_Servidor {
+    SIM_ServidorConfigTypedef config;
+    char ruta[SOCK_MAX_RUTA];
+    int fd;
+    volatile bool_t activo;
+    pthread_t hiloEscucha;
+    pthread_mutex_t mutexClientes;
+    SIM_PantallaTypedef pantallas[SIM_MAX_PANTALLAS];
+    SIM_ClienteTypedef clientes[SIM_MAX_CLIENTES];
+} SIM_ServidorTypedef;
+
+/**
+ * @brief Deja la configuración por defecto: SOCK_RUTA_DEFECTO, un
+ *        display de 16x2 a I2C_CLOCK_SPEED y sin latencia.
+ */
+void sim_serverDefaults(SIM_ServidorConfigTypedef *);
+
+/**
+ * @brief Crea el socket, inicializa los displays y empieza a
+ *        aceptar clientes en un hilo.
+ * @return false si la configuración es inválida o no se pudo crear el socket.
+ */
+bool_t sim_serverStart(SIM_ServidorTypedef *, const SIM_ServidorConfigTypedef *);
+
+/**
+ * @brief Deja de aceptar clientes, cierra las conexiones, espera
+ *        a los hilos y borra el socket.
+ */
+void sim_serverStop(SIM_ServidorTypedef *);
+
+/**
+ * @brief Copia las estadísticas de un display.
+ * @return false si el display no existe.
+ */
+bool_t sim_serverGetStats(SIM_ServidorTypedef *, uint8_t, SOCK_EstadisticasTypedef *);
+
+/**
+ * @brief Copia el texto visible de una fila de un display, como sim_getLine.
+ * @return false si el display no existe.
+ */
+bool_t sim_serverGetLine(SIM_ServidorTypedef *, uint8_t, uint8_t, char *);
+
+#endif /* TEST_SUPPORT_SIM_SERVER_H_ */
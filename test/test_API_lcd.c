@@ -16,8 +16,32 @@
     5- Se debe poder escribir un texto
     6- Encender cursor
     7- Apagar cursor
+    8- Se debe poder cargar un caracter en la CGRAM
+    9- Se debe poder escribir un texto en una posición sin borrar la pantalla
+    10- La codificación de un mensaje debe coincidir con las tramas que se envían
+    11- La inicialización diferida no debe bloquear y lo dibujado mientras tanto
+        se debe mostrar al terminar
+    12- En el modo de inicio en el primer dibujo, dibujar debe completar la inicialización
+    13- Un arranque en caliente no debe borrar la pantalla y debe sincronizar el buffer
+    14- Un arranque en caliente sobre un LCD sin configurar debe inicializarlo y dejar la marca
+    15- Esperar con WFI debe reducir el tiempo de CPU despierta sin cambiar el tiempo de bus
+    16- Los modos de energía deben apagar pantalla y backlight y restaurarlos sin redibujar
+    17- Sin actividad durante el tiempo configurado se debe pasar al modo de energía indicado,
+        contando desde la última actividad o desde la vuelta al modo normal
+    18- Con un ST7032 se debe inicializar con su secuencia y escribir con bytes de control,
+        enviando el texto de LCD_printAt en una única transacción si el bus deja ejecutar
+        cada byte, y en una transacción por caracter si no
+    19- Con un AIP31068 cada mensaje debe ocupar una transacción de dos bytes, sin tramas
+        de backlight, y el arranque en caliente debe hacer la inicialización completa
+    20- Si el perfil no corresponde al controlador conectado la inicialización debe fallar
+    21- Con el cursor retrocediendo se debe poder escribir un campo desde la última cifra,
+        y el driver debe seguir al cursor, escribir los textos y cargar la CGRAM igual
+    22- Con los modos que desplazan la pantalla el texto debe entrar por un costado, y
+        el clear debe volver a incrementar conservando el desplazamiento
 */
 
+#include <string.h>
+
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -28,11 +52,24 @@
  */
 #include "API_lcd.h"
 
+/**
+ * @brief Includes de los módulos que usa API_lcd para las estadísticas.
+ */
+#include "API_lcd_buffer.h"
+#include "API_lcd_pool.h"
+#include "API_lcd_profile.h"
+#include "API_lcd_queue.h"
+
 /**
  * @brief Include de un mock para las funciones que acceden al hardware.
  */
 #include "mock_API_lcd_port.h"
 
+/**
+ * @brief Include del simulador de LCD para los tests de inicialización.
+ */
+#include "sim_lcd.h"
+
 /**
  * @brief Constantes utilizadas para controlar el LCD. Obtenidas del archivo API_lcd.c
  */
@@ -50,6 +87,7 @@
 #define SET_CURSOR      (1 << 7)
 #define CURSOR_ON       1 << 1
 #define CURSOR_BLINK    1
+#define SET_CGRAM       (1 << 6)
 
 #define NULL_CHAR       '\0' // caracter nulo
 
@@ -130,6 +168,19 @@ void setUp(void) {
     port_delay_Ignore();
 }
 
+/**
+ * @brief Reemplaza las funciones del port por el simulador de LCD,
+ * recién encendido y por lo tanto en modo 8 bits.
+ */
+static void usarSimulador(void) {
+    sim_init(&sim_lcd);
+    port_init_ExpectAndReturn(true);
+    port_i2cWriteByte_StubWithCallback(sim_port_i2cWriteByte);
+    port_i2cReadByte_StubWithCallback(sim_port_i2cReadByte);
+    port_delay_StubWithCallback(sim_port_delay);
+    port_getTick_StubWithCallback(sim_port_getTick);
+}
+
 /**
  * @brief Test para verificar la secuencia de inicio del LCD
  * según el requerimiento 1.
@@ -177,6 +228,11 @@ void test_posicionar_cursor() {
     LCD_sendMsg_ExpectAndReturn(SET_CURSOR | fila, COMMAND, true);
 
     TEST_ASSERT_EQUAL(LCD_setCursor(fila, 0), LCD_OK);
+
+    LCD_sendMsg_ExpectAndReturn(SET_CURSOR | (LCD_FILA_2 + 5), COMMAND, true);
+    TEST_ASSERT_EQUAL(LCD_setCursor(LCD_FILA_2, 5), LCD_OK);
+
+    TEST_ASSERT_EQUAL(LCD_setCursor(LCD_FILA_2, LCD_CANTIDAD_COLUMNAS), LCD_ERROR);
 }
 
 /**
@@ -216,3 +272,450 @@ void test_apagar_cursor() {
     LCD_sendMsg_ExpectAndReturn(DISPLAY_CONTROL | DISPLAY_ON, COMMAND, true);
     TEST_ASSERT_EQUAL(LCD_cursorOff(), LCD_OK);
 }
+
+/**
+ * @brief Test para verificar la carga de un caracter en la CGRAM,
+ * según requerimiento 8.
+ */
+void test_cargar_caracter_cgram() {
+    const uint8_t patron[LCD_ALTO_CARACTER] = {0x00, 0x0A, 0x1F, 0x1F, 0x0E, 0x04, 0x00, 0xFF};
+    uint8_t posicion = 3;
+
+    LCD_sendMsg_ExpectAndReturn(SET_CGRAM | (posicion << 3), COMMAND, true);
+    for (uint8_t fila = 0; fila < LCD_ALTO_CARACTER; fila++) {
+        LCD_sendMsg_ExpectAndReturn(patron[fila] & 0x1F, DATA, true);
+    }
+    LCD_sendMsg_ExpectAndReturn(SET_CURSOR | LCD_FILA_1, COMMAND, true);
+
+    TEST_ASSERT_EQUAL(LCD_createChar(posicion, patron), LCD_OK);
+    TEST_ASSERT_EQUAL(LCD_createChar(LCD_CANTIDAD_CARACTERES_CGRAM, patron), LCD_ERROR);
+}
+
+/**
+ * @brief Test para verificar la escritura de un texto en una posición,
+ * según requerimiento 9.
+ */
+void test_escribir_en_posicion() {
+    LCD_sendMsg_ExpectAndReturn(SET_CURSOR | (LCD_FILA_2 + 13), COMMAND, true);
+    LCD_sendMsg_ExpectAndReturn('a', DATA, true);
+    LCD_sendMsg_ExpectAndReturn('b', DATA, true);
+    LCD_sendMsg_ExpectAndReturn('c', DATA, true);
+
+    TEST_ASSERT_EQUAL(LCD_printAt(LCD_FILA_2, 13, "abcdef"), LCD_OK);
+    TEST_ASSERT_EQUAL(LCD_printAt(LCD_FILA_2, 0, NULL), LCD_ERROR);
+}
+
+/**
+ * @brief Test para verificar que LCD_encodeMsg genera las mismas tramas que
+ * envía LCD_sendMsg, según requerimiento 10.
+ */
+void test_codificar_mensaje() {
+    uint8_t tramas[LCD_TRAMAS_X_MENSAJE];
+    uint8_t alto = DATA | (back_light << POS_BACKLIGHT) | ('K' & 0xF0);
+    uint8_t bajo = DATA | (back_light << POS_BACKLIGHT) | ('K' & 0x0F) << 4;
+    uint8_t esperado[LCD_TRAMAS_X_MENSAJE] = {alto | ENABLE, alto, bajo | ENABLE, bajo};
+
+    LCD_encodeMsg('K', LCD_DATO, tramas);
+
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(esperado, tramas, LCD_TRAMAS_X_MENSAJE);
+}
+
+/**
+ * @brief Test para verificar que la inicialización diferida no bloquea y que
+ * lo dibujado antes de terminar se muestra después, según requerimiento 11.
+ */
+void test_inicializacion_diferida() {
+    char linea[LCD_CANTIDAD_COLUMNAS + 1];
+    uint16_t llamadas = 0;
+
+    usarSimulador();
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_initLazy(LCD_INICIO_EN_SEGUNDO_PLANO));
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_printAt(LCD_FILA_2, 3, "Hola"));
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_cursorOn());
+
+    TEST_ASSERT_FALSE(LCD_isReady());
+    TEST_ASSERT_EQUAL(0, sim_lcd.bytesI2C);
+    TEST_ASSERT_EQUAL('H', LCD_bufferGet(LCD_getBuffer(), 1, 3));
+    TEST_ASSERT_TRUE(LCD_bufferIsDirty(LCD_getBuffer()));
+
+    // el lazo principal llama a LCD_process mientras pasa el tiempo
+    while (!LCD_isReady() && llamadas < 100) {
+        sim_delay(&sim_lcd, 1000);
+        TEST_ASSERT_EQUAL(LCD_OK, LCD_process());
+        llamadas++;
+    }
+
+    TEST_ASSERT_TRUE(LCD_isReady());
+    TEST_ASSERT_GREATER_THAN(1, llamadas);
+    TEST_ASSERT_TRUE(sim_lcd.modo4Bits);
+    TEST_ASSERT_EQUAL(0, sim_lcd.violaciones);
+    TEST_ASSERT_FALSE(LCD_bufferIsDirty(LCD_getBuffer()));
+
+    sim_getLine(&sim_lcd, 1, linea);
+    TEST_ASSERT_EQUAL_STRING("   Hola         ", linea);
+    TEST_ASSERT_EQUAL(LCD_FILA_2 + 7, sim_lcd.direccion);
+    TEST_ASSERT_EQUAL(DISPLAY_ON | CURSOR_ON | CURSOR_BLINK, sim_lcd.control);
+}
+
+/**
+ * @brief Test para verificar que en el modo de inicio en el primer dibujo
+ * dibujar completa la inicialización, según requerimiento 12.
+ */
+void test_inicializacion_en_primer_dibujo() {
+    char linea[LCD_CANTIDAD_COLUMNAS + 1];
+
+    usarSimulador();
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_initLazy(LCD_INICIO_EN_PRIMER_DIBUJO));
+    TEST_ASSERT_EQUAL(0, sim_lcd.bytesI2C);
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_printChar('x'));
+
+    TEST_ASSERT_TRUE(LCD_isReady());
+    TEST_ASSERT_EQUAL(0, sim_lcd.violaciones);
+    sim_getLine(&sim_lcd, 0, linea);
+    TEST_ASSERT_EQUAL_STRING("x               ", linea);
+}
+
+/**
+ * @brief Test para verificar que el arranque en caliente conserva la pantalla
+ * y sincroniza el buffer de sombra y el cursor, según requerimiento 13.
+ */
+void test_arranque_en_caliente() {
+    char linea[LCD_CANTIDAD_COLUMNAS + 1];
+
+    usarSimulador();
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_reattach());
+
+    // contenido que dejó el firmware antes del reset
+    memcpy(&sim_lcd.ddram[LCD_FILA_2 + 3], "Hola", 4);
+    sim_lcd.direccion = LCD_FILA_2 + 7;
+    uint32_t instrucciones = sim_lcd.instrucciones;
+
+    port_init_ExpectAndReturn(true);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_reattach());
+
+    sim_getLine(&sim_lcd, 1, linea);
+    TEST_ASSERT_EQUAL_STRING("   Hola         ", linea);
+    TEST_ASSERT_EQUAL('H', LCD_bufferGet(LCD_getBuffer(), 1, 3));
+    TEST_ASSERT_FALSE(LCD_bufferIsDirty(LCD_getBuffer()));
+    TEST_ASSERT_EQUAL(LCD_FILA_2 + 7, sim_lcd.direccion);
+    TEST_ASSERT_EQUAL(0, sim_lcd.violaciones);
+
+    // sólo se envían el modo de entrada y los posicionamientos, sin secuencia
+    // de inicio ni clear
+    TEST_ASSERT_EQUAL(5, sim_lcd.instrucciones - instrucciones);
+
+    // el cursor del driver continúa donde quedó el del LCD
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_printChar('!'));
+    sim_getLine(&sim_lcd, 1, linea);
+    TEST_ASSERT_EQUAL_STRING("   Hola!        ", linea);
+}
+
+/**
+ * @brief Test para verificar que el arranque en caliente de un LCD recién
+ * encendido realiza la inicialización completa, según requerimiento 14.
+ */
+void test_arranque_en_caliente_sin_marca() {
+    usarSimulador();
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_reattach());
+
+    TEST_ASSERT_TRUE(sim_lcd.modo4Bits);
+    TEST_ASSERT_EQUAL(DISPLAY_ON, sim_lcd.control);
+    TEST_ASSERT_EQUAL(0, sim_lcd.violaciones);
+    TEST_ASSERT_EQUAL(0x15, sim_lcd.cgram[LCD_SLOT_MARCADOR * LCD_ALTO_CARACTER]);
+    TEST_ASSERT_EQUAL(0x1B, sim_lcd.cgram[LCD_SLOT_MARCADOR * LCD_ALTO_CARACTER + 7]);
+}
+
+/**
+ * @brief Test para verificar el reporte de consumo de una escritura con
+ * esperas activas y con WFI, según requerimiento 15.
+ */
+void test_consumo_esperas_con_wfi() {
+    SIM_EnergiaTypedef activa;
+    SIM_EnergiaTypedef dormida;
+
+    usarSimulador();
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_init());
+
+    sim_resetStats(&sim_lcd);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_printAt(LCD_FILA_1, 0, "Hola"));
+    sim_getEnergy(&sim_lcd, &activa);
+
+    sim_lcd.esperaDormido = true;
+    sim_resetStats(&sim_lcd);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_printAt(LCD_FILA_1, 0, "Chau"));
+    sim_getEnergy(&sim_lcd, &dormida);
+
+    TEST_ASSERT_EQUAL(activa.busUs, dormida.busUs);
+    TEST_ASSERT_EQUAL(activa.esperaUs, dormida.esperaUs);
+    TEST_ASSERT_EQUAL(activa.busUs + activa.esperaUs, activa.despiertoUs);
+    TEST_ASSERT_LESS_THAN(activa.despiertoUs / 2, dormida.despiertoUs);
+    TEST_ASSERT_LESS_THAN(activa.energiaUj, dormida.energiaUj);
+}
+
+/**
+ * @brief Test para verificar los modos de energía y la restauración sin
+ * redibujar, según requerimiento 16.
+ */
+void test_modos_de_energia() {
+    char linea[LCD_CANTIDAD_COLUMNAS + 1];
+
+    usarSimulador();
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_init());
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_printAt(LCD_FILA_1, 0, "Hola"));
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_setPowerMode(LCD_ENERGIA_BAJO_CONSUMO));
+    TEST_ASSERT_EQUAL(LCD_ENERGIA_BAJO_CONSUMO, LCD_getPowerMode());
+    TEST_ASSERT_EQUAL(0, sim_lcd.control & DISPLAY_ON);
+    TEST_ASSERT_EQUAL(0, (sim_lcd.pines >> POS_BACKLIGHT) & 1);
+
+    // con la pantalla apagada el cursor no la enciende y lo escrito se conserva
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_cursorOn());
+    TEST_ASSERT_EQUAL(0, sim_lcd.control & DISPLAY_ON);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_printAt(LCD_FILA_2, 0, "Noche"));
+
+    sim_resetStats(&sim_lcd);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_setPowerMode(LCD_ENERGIA_NORMAL));
+    TEST_ASSERT_EQUAL(1, sim_lcd.instrucciones);
+    TEST_ASSERT_EQUAL(0, sim_lcd.datos);
+    TEST_ASSERT_EQUAL(DISPLAY_ON | CURSOR_ON | CURSOR_BLINK, sim_lcd.control);
+    TEST_ASSERT_EQUAL(1, (sim_lcd.pines >> POS_BACKLIGHT) & 1);
+
+    sim_getLine(&sim_lcd, 0, linea);
+    TEST_ASSERT_EQUAL_STRING("Hola            ", linea);
+    sim_getLine(&sim_lcd, 1, linea);
+    TEST_ASSERT_EQUAL_STRING("Noche           ", linea);
+
+    // sólo backlight: no se envían comandos
+    sim_resetStats(&sim_lcd);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_setPowerMode(LCD_ENERGIA_BACKLIGHT_APAGADO));
+    TEST_ASSERT_EQUAL(0, sim_lcd.instrucciones);
+    TEST_ASSERT_EQUAL(1, sim_lcd.bytesI2C);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_setPowerMode(LCD_ENERGIA_NORMAL));
+    TEST_ASSERT_EQUAL(0, sim_lcd.violaciones);
+}
+
+/**
+ * @brief Test para verificar el apagado por inactividad,
+ * según requerimiento 17.
+ */
+void test_apagado_por_inactividad() {
+    usarSimulador();
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_init());
+
+    LCD_setIdleTimeout(1000, LCD_ENERGIA_PANTALLA_APAGADA);
+
+    sim_delay(&sim_lcd, 500);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_process());
+    TEST_ASSERT_EQUAL(LCD_ENERGIA_NORMAL, LCD_getPowerMode());
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_notifyActivity());
+    sim_delay(&sim_lcd, 800);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_process());
+    TEST_ASSERT_EQUAL(LCD_ENERGIA_NORMAL, LCD_getPowerMode());
+
+    sim_delay(&sim_lcd, 300);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_process());
+    TEST_ASSERT_EQUAL(LCD_ENERGIA_PANTALLA_APAGADA, LCD_getPowerMode());
+    TEST_ASSERT_EQUAL(0, sim_lcd.control & DISPLAY_ON);
+    TEST_ASSERT_EQUAL(1, (sim_lcd.pines >> POS_BACKLIGHT) & 1);
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_notifyActivity());
+    TEST_ASSERT_EQUAL(LCD_ENERGIA_NORMAL, LCD_getPowerMode());
+    TEST_ASSERT_EQUAL(DISPLAY_ON, sim_lcd.control);
+
+    // volver al modo normal desde la aplicación también reinicia la espera
+    sim_delay(&sim_lcd, 1200);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_process());
+    TEST_ASSERT_EQUAL(LCD_ENERGIA_PANTALLA_APAGADA, LCD_getPowerMode());
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_setPowerMode(LCD_ENERGIA_NORMAL));
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_process());
+    TEST_ASSERT_EQUAL(LCD_ENERGIA_NORMAL, LCD_getPowerMode());
+    sim_delay(&sim_lcd, 900);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_process());
+    TEST_ASSERT_EQUAL(LCD_ENERGIA_NORMAL, LCD_getPowerMode());
+    sim_delay(&sim_lcd, 200);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_process());
+    TEST_ASSERT_EQUAL(LCD_ENERGIA_PANTALLA_APAGADA, LCD_getPowerMode());
+
+    LCD_setIdleTimeout(0, LCD_ENERGIA_PANTALLA_APAGADA);
+}
+
+/**
+ * @brief Reemplaza además las funciones del port que usan los perfiles
+ * nativos, con un simulador del controlador indicado.
+ */
+static void usarSimuladorNativo(SIM_InterfazTypedef interfaz) {
+    usarSimulador();
+    sim_initNative(&sim_lcd, interfaz);
+    port_setAddress_StubWithCallback(sim_port_setAddress);
+    port_i2cWrite_StubWithCallback(sim_port_i2cWrite);
+    port_getClockSpeed_StubWithCallback(sim_port_getClockSpeed);
+}
+
+/**
+ * @brief Test para verificar la inicialización y escritura de un ST7032,
+ * según requerimiento 18.
+ */
+void test_perfil_st7032() {
+    char linea[LCD_CANTIDAD_COLUMNAS + 1];
+
+    usarSimuladorNativo(SIM_INTERFAZ_ST7032);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_setProfile(&LCD_PERFIL_ST7032));
+    TEST_ASSERT_EQUAL_PTR(&LCD_PERFIL_ST7032, LCD_getProfile());
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_init());
+
+    TEST_ASSERT_EQUAL(0, sim_lcd.violaciones);
+    TEST_ASSERT_EQUAL(0, sim_lcd.nacks);
+    TEST_ASSERT_TRUE(sim_lcd.seguidor);
+    TEST_ASSERT_FALSE(sim_lcd.tablaExtendida);
+    TEST_ASSERT_EQUAL(0x28, sim_lcd.contraste);
+    TEST_ASSERT_EQUAL(DISPLAY_ON, sim_lcd.control);
+
+    // posicionamiento (control + comando) y texto (control + 4 datos)
+    sim_resetStats(&sim_lcd);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_printAt(LCD_FILA_2, 3, "Hola"));
+    TEST_ASSERT_EQUAL(2, sim_lcd.transacciones);
+    TEST_ASSERT_EQUAL(7, sim_lcd.bytesI2C);
+    TEST_ASSERT_EQUAL(0, sim_lcd.violaciones);
+
+    sim_getLine(&sim_lcd, 1, linea);
+    TEST_ASSERT_EQUAL_STRING("   Hola         ", linea);
+    TEST_ASSERT_EQUAL('H', LCD_bufferGet(LCD_getBuffer(), 1, 3));
+
+    // a 400 kHz un byte dura menos que una instrucción: un dato por transacción
+    sim_lcd.clockI2C = 400000;
+    sim_resetStats(&sim_lcd);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_printAt(LCD_FILA_1, 0, "Chau"));
+    TEST_ASSERT_EQUAL(5, sim_lcd.transacciones);
+    TEST_ASSERT_EQUAL(10, sim_lcd.bytesI2C);
+    TEST_ASSERT_EQUAL(0, sim_lcd.violaciones);
+    sim_getLine(&sim_lcd, 0, linea);
+    TEST_ASSERT_EQUAL_STRING("Chau            ", linea);
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_setProfile(&LCD_PERFIL_PCF8574));
+}
+
+/**
+ * @brief Test para verificar los mensajes de dos bytes de un AIP31068,
+ * según requerimiento 19.
+ */
+void test_perfil_aip31068() {
+    char linea[LCD_CANTIDAD_COLUMNAS + 1];
+
+    usarSimuladorNativo(SIM_INTERFAZ_AIP31068);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_setProfile(&LCD_PERFIL_AIP31068));
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_reattach());
+    TEST_ASSERT_EQUAL(DISPLAY_ON, sim_lcd.control);
+
+    sim_resetStats(&sim_lcd);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_clear());
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_printChar('A'));
+    TEST_ASSERT_EQUAL(2, sim_lcd.transacciones);
+    TEST_ASSERT_EQUAL(4, sim_lcd.bytesI2C);
+    TEST_ASSERT_EQUAL(0, sim_lcd.violaciones);
+
+    sim_getLine(&sim_lcd, 0, linea);
+    TEST_ASSERT_EQUAL_STRING("A               ", linea);
+
+    // el backlight no lo maneja el controlador: sólo se envía DISPLAY_CONTROL
+    sim_resetStats(&sim_lcd);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_setPowerMode(LCD_ENERGIA_BAJO_CONSUMO));
+    TEST_ASSERT_EQUAL(1, sim_lcd.transacciones);
+    TEST_ASSERT_EQUAL(0, sim_lcd.control & DISPLAY_ON);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_setPowerMode(LCD_ENERGIA_NORMAL));
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_setProfile(&LCD_PERFIL_PCF8574));
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_setProfile(NULL));
+}
+
+/**
+ * @brief Test para verificar que un perfil equivocado no inicializa el LCD,
+ * según requerimiento 20.
+ */
+void test_perfil_equivocado() {
+    usarSimuladorNativo(SIM_INTERFAZ_ST7032);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_setProfile(&LCD_PERFIL_PCF8574));
+
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_init());
+    TEST_ASSERT_EQUAL(1, sim_lcd.nacks);
+}
+
+/**
+ * @brief Test para verificar la escritura con el cursor retrocediendo,
+ * según requerimiento 21.
+ */
+void test_modo_decremento() {
+    static const uint8_t patron[LCD_ALTO_CARACTER] = {1, 2, 3, 4, 5, 6, 7, 8};
+    char linea[LCD_CANTIDAD_COLUMNAS + 1];
+
+    usarSimulador();
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_init());
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_setEntryMode(LCD_ENTRADA_DECREMENTO));
+    TEST_ASSERT_EQUAL(LCD_ENTRADA_DECREMENTO, LCD_getEntryMode());
+
+    // campo alineado a la derecha, desde la cifra menos significativa
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_setCursor(LCD_FILA_1, LCD_CANTIDAD_COLUMNAS - 1));
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_printChar('3'));
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_printChar('2'));
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_printChar('1'));
+    sim_getLine(&sim_lcd, 0, linea);
+    TEST_ASSERT_EQUAL_STRING("             123", linea);
+
+    // el texto queda en el orden de lectura y el cursor pasa al final de la fila 1
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_printAt(LCD_FILA_2, 0, "Hola"));
+    sim_getLine(&sim_lcd, 1, linea);
+    TEST_ASSERT_EQUAL_STRING("Hola            ", linea);
+    TEST_ASSERT_EQUAL(LCD_FILA_1 + 39, sim_lcd.direccion);
+    TEST_ASSERT_EQUAL('H', LCD_bufferGet(LCD_getBuffer(), 1, 0));
+    TEST_ASSERT_EQUAL('3', LCD_bufferGet(LCD_getBuffer(), 0, 15));
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_createChar(2, patron));
+    TEST_ASSERT_EQUAL_MEMORY(patron, &sim_lcd.cgram[2 * LCD_ALTO_CARACTER], LCD_ALTO_CARACTER);
+
+    // el clear vuelve a incrementar, como el controlador
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_clear());
+    TEST_ASSERT_EQUAL(LCD_ENTRADA_INCREMENTO, LCD_getEntryMode());
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_printAt(LCD_FILA_1, 2, "ab"));
+    sim_getLine(&sim_lcd, 0, linea);
+    TEST_ASSERT_EQUAL_STRING("  ab            ", linea);
+    TEST_ASSERT_EQUAL(0, sim_lcd.violaciones);
+}
+
+/**
+ * @brief Test para verificar los modos que desplazan la pantalla,
+ * según requerimiento 22.
+ */
+void test_modo_desplazamiento() {
+    char linea[LCD_CANTIDAD_COLUMNAS + 1];
+
+    usarSimulador();
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_init());
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_setEntryMode(LCD_ENTRADA_INCREMENTO_DESPLAZA));
+
+    // cada caracter escrito en el borde derecho corre la pantalla a la izquierda
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_setCursor(LCD_FILA_1, LCD_CANTIDAD_COLUMNAS - 1));
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_printChar('a'));
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_printChar('b'));
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_printChar('c'));
+    sim_getLine(&sim_lcd, 0, linea);
+    TEST_ASSERT_EQUAL_STRING("            abc ", linea);
+    TEST_ASSERT_EQUAL(LCD_FILA_1 + 18, sim_lcd.direccion);
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_clear());
+    TEST_ASSERT_EQUAL(LCD_ENTRADA_INCREMENTO_DESPLAZA, LCD_getEntryMode());
+    TEST_ASSERT_EQUAL(0, sim_lcd.desplazamiento);
+
+    // con el cursor retrocediendo el texto entra por la izquierda
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_setEntryMode(LCD_ENTRADA_DECREMENTO_DESPLAZA));
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_printChar('x'));
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_printChar('y'));
+    sim_getLine(&sim_lcd, 0, linea);
+    TEST_ASSERT_EQUAL_STRING("  x             ", linea);
+    sim_getLine(&sim_lcd, 1, linea);
+    TEST_ASSERT_EQUAL_STRING(" y              ", linea);
+    TEST_ASSERT_EQUAL(LCD_FILA_2 + 38, sim_lcd.direccion);
+
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_setEntryMode(LCD_ENTRADA_INCREMENTO_DESPLAZA + 1));
+    TEST_ASSERT_EQUAL(0, sim_lcd.violaciones);
+}
@@ -0,0 +1,199 @@
+/**
+ * @file test_API_lcd_buffer.c
+ * @brief Implementación de funciones de test del buffer de sombra del LCD
+ */
+
+/*
+    Requerimientos a probar:
+    1- Un buffer recién inicializado debe estar en blanco y limpio
+    2- Escribir un caracter distinto debe marcar la celda sucia
+    3- Registrar un caracter enviado debe dejar la celda limpia
+    4- Se deben poder recorrer los tramos de celdas sucias consecutivas
+    5- Las posiciones fuera de la geometría se deben ignorar
+    6- El diff de un cuadro completo debe copiar y marcar sucias exactamente las celdas
+       que cambiaron, incluidas las que no completan una palabra al final de la fila
+    7- Se deben poder obtener los tramos sucios de todas las filas en una lista, hasta
+       un máximo
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "unity.h"
+
+/**
+ * @brief Include del módulo que va a ser probado.
+ */
+#include "API_lcd_buffer.h"
+
+static LCD_BufferTypedef buffer;
+
+/**
+ * @brief Inicializa un buffer de 16x2 antes de cada test.
+ */
+void setUp(void) {
+    LCD_bufferInit(&buffer, 2, 16);
+}
+
+/**
+ * @brief Test para verificar el estado inicial, según el requerimiento 1.
+ */
+void test_buffer_inicial() {
+    TEST_ASSERT_FALSE(LCD_bufferIsDirty(&buffer));
+    TEST_ASSERT_EQUAL(' ', LCD_bufferGet(&buffer, 1, 15));
+}
+
+/**
+ * @brief Test para verificar que sólo los cambios ensucian celdas,
+ * según el requerimiento 2.
+ */
+void test_escribir_marca_sucia() {
+    LCD_bufferWrite(&buffer, 0, 4, ' ');
+    TEST_ASSERT_FALSE(LCD_bufferIsDirty(&buffer));
+
+    LCD_bufferWrite(&buffer, 0, 4, 'a');
+    TEST_ASSERT_TRUE(LCD_bufferIsDirty(&buffer));
+    TEST_ASSERT_EQUAL('a', LCD_bufferGet(&buffer, 0, 4));
+}
+
+/**
+ * @brief Test para verificar que registrar un envío limpia la celda,
+ * según el requerimiento 3.
+ */
+void test_sincronizar_limpia() {
+    LCD_bufferWrite(&buffer, 1, 0, 'a');
+    LCD_bufferSync(&buffer, 1, 0, 'b');
+
+    TEST_ASSERT_FALSE(LCD_bufferIsDirty(&buffer));
+    TEST_ASSERT_EQUAL('b', LCD_bufferGet(&buffer, 1, 0));
+}
+
+/**
+ * @brief Test para verificar el recorrido de tramos sucios,
+ * según el requerimiento 4.
+ */
+void test_tramos_sucios() {
+    uint8_t inicio;
+    uint8_t largo;
+
+    LCD_bufferWrite(&buffer, 0, 2, 'a');
+    LCD_bufferWrite(&buffer, 0, 3, 'b');
+    LCD_bufferWrite(&buffer, 0, 15, 'c');
+
+    TEST_ASSERT_TRUE(LCD_bufferNextDirtyRun(&buffer, 0, 0, &inicio, &largo));
+    TEST_ASSERT_EQUAL(2, inicio);
+    TEST_ASSERT_EQUAL(2, largo);
+
+    TEST_ASSERT_TRUE(LCD_bufferNextDirtyRun(&buffer, 0, inicio + largo, &inicio, &largo));
+    TEST_ASSERT_EQUAL(15, inicio);
+    TEST_ASSERT_EQUAL(1, largo);
+
+    TEST_ASSERT_FALSE(LCD_bufferNextDirtyRun(&buffer, 0, inicio + largo, &inicio, &largo));
+    TEST_ASSERT_FALSE(LCD_bufferNextDirtyRun(&buffer, 1, 0, &inicio, &largo));
+
+    LCD_bufferMarkClean(&buffer, 0, 2, 2);
+    TEST_ASSERT_TRUE(LCD_bufferNextDirtyRun(&buffer, 0, 0, &inicio, &largo));
+    TEST_ASSERT_EQUAL(15, inicio);
+
+    LCD_bufferMarkAllDirty(&buffer);
+    TEST_ASSERT_TRUE(LCD_bufferNextDirtyRun(&buffer, 1, 0, &inicio, &largo));
+    TEST_ASSERT_EQUAL(0, inicio);
+    TEST_ASSERT_EQUAL(16, largo);
+}
+
+/**
+ * @brief Test para verificar que se ignoran posiciones inválidas,
+ * según el requerimiento 5.
+ */
+void test_fuera_de_geometria() {
+    LCD_bufferWrite(&buffer, 2, 0, 'a');
+    LCD_bufferWrite(&buffer, 0, 16, 'a');
+
+    TEST_ASSERT_FALSE(LCD_bufferIsDirty(&buffer));
+    TEST_ASSERT_EQUAL(' ', LCD_bufferGet(&buffer, 0, 16));
+}
+
+/**
+ * @brief Test para verificar el diff contra el chequeo celda por celda en
+ * cuadros pseudoaleatorios de la mayor geometría, según el requerimiento 6.
+ */
+void test_diff_por_palabras() {
+    static LCD_BufferTypedef cuadro;
+    static LCD_BufferTypedef esperado;
+    uint32_t semilla = 12345;
+
+    LCD_bufferInit(&buffer, LCD_BUFFER_MAX_FILAS, LCD_BUFFER_MAX_COLUMNAS);
+    LCD_bufferInit(&esperado, LCD_BUFFER_MAX_FILAS, LCD_BUFFER_MAX_COLUMNAS);
+
+    for (uint8_t pasada = 0; pasada < 50; pasada++) {
+        memcpy(&cuadro, &buffer, sizeof(cuadro));
+        uint8_t cambios = (semilla >> 8) % 20;
+        for (uint8_t cambio = 0; cambio < cambios; cambio++) {
+            semilla = semilla * 1103515245 + 12345;
+            uint8_t fila = (semilla >> 16) % LCD_BUFFER_MAX_FILAS;
+            uint8_t columna = (semilla >> 20) % LCD_BUFFER_MAX_COLUMNAS;
+            cuadro.celdas[fila][columna] = 'a' + (semilla >> 26) % 3;
+        }
+
+        uint16_t distintas = 0;
+        for (uint8_t fila = 0; fila < LCD_BUFFER_MAX_FILAS; fila++) {
+            for (uint8_t columna = 0; columna < LCD_BUFFER_MAX_COLUMNAS; columna++) {
+                if (cuadro.celdas[fila][columna] != buffer.celdas[fila][columna])
+                    distintas++;
+                LCD_bufferWrite(&esperado, fila, columna, cuadro.celdas[fila][columna]);
+            }
+        }
+
+        TEST_ASSERT_EQUAL(distintas, LCD_bufferDiff(&buffer, &cuadro));
+        TEST_ASSERT_EQUAL_MEMORY(esperado.celdas, buffer.celdas, sizeof(buffer.celdas));
+        TEST_ASSERT_EQUAL_MEMORY(esperado.sucias, buffer.sucias, sizeof(buffer.sucias));
+    }
+
+    // un cambio en la última columna, fuera de las palabras completas
+    memcpy(&cuadro, &buffer, sizeof(cuadro));
+    LCD_bufferMarkClean(&buffer, 0, 0, LCD_BUFFER_MAX_COLUMNAS);
+    cuadro.celdas[0][LCD_BUFFER_MAX_COLUMNAS - 1] = 'z';
+    TEST_ASSERT_EQUAL(1, LCD_bufferDiff(&buffer, &cuadro));
+    TEST_ASSERT_EQUAL(1ULL << (LCD_BUFFER_MAX_COLUMNAS - 1), buffer.sucias[0]);
+
+    // con otra geometría no se compara
+    LCD_bufferInit(&cuadro, 1, LCD_BUFFER_MAX_COLUMNAS);
+    TEST_ASSERT_EQUAL(0, LCD_bufferDiff(&buffer, &cuadro));
+}
+
+/**
+ * @brief Test para verificar la lista de tramos sucios,
+ * según el requerimiento 7.
+ */
+void test_lista_de_tramos() {
+    LCD_TramoTypedef tramos[4];
+
+    TEST_ASSERT_EQUAL(0, LCD_bufferDirtyRuns(&buffer, tramos, 4));
+
+    LCD_bufferWrite(&buffer, 0, 0, 'a');
+    LCD_bufferWrite(&buffer, 0, 1, 'b');
+    LCD_bufferWrite(&buffer, 0, 7, 'c');
+    LCD_bufferWrite(&buffer, 1, 12, 'd');
+    LCD_bufferWrite(&buffer, 1, 13, 'e');
+    LCD_bufferWrite(&buffer, 1, 14, 'f');
+    LCD_bufferWrite(&buffer, 1, 15, 'g');
+
+    TEST_ASSERT_EQUAL(3, LCD_bufferDirtyRuns(&buffer, tramos, 4));
+    TEST_ASSERT_EQUAL(0, tramos[0].fila);
+    TEST_ASSERT_EQUAL(0, tramos[0].inicio);
+    TEST_ASSERT_EQUAL(2, tramos[0].largo);
+    TEST_ASSERT_EQUAL(0, tramos[1].fila);
+    TEST_ASSERT_EQUAL(7, tramos[1].inicio);
+    TEST_ASSERT_EQUAL(1, tramos[1].largo);
+    TEST_ASSERT_EQUAL(1, tramos[2].fila);
+    TEST_ASSERT_EQUAL(12, tramos[2].inicio);
+    TEST_ASSERT_EQUAL(4, tramos[2].largo);
+
+    TEST_ASSERT_EQUAL(2, LCD_bufferDirtyRuns(&buffer, tramos, 2));
+    TEST_ASSERT_EQUAL(7, tramos[1].inicio);
+
+    LCD_bufferMarkAllDirty(&buffer);
+    TEST_ASSERT_EQUAL(2, LCD_bufferDirtyRuns(&buffer, tramos, 4));
+    TEST_ASSERT_EQUAL(16, tramos[1].largo);
+}
@@ -0,0 +1,174 @@
+/**
+ * @file test_API_lcd_clock.c
+ * @brief Implementación de funciones de test del reloj HH:MM:SS
+ */
+
+/*
+    Requerimientos a probar:
+    1- Al inicializar se debe dibujar el reloj en 00:00:00 y se deben rechazar los
+       relojes que no entran en la pantalla
+    2- El reloj sólo debe avanzar en el borde de cada segundo y la mayoría de los
+       segundos deben reescribir una sola cifra
+    3- Al volver a cero una cifra sólo se deben reescribir las que cambian, y la hora
+       del día debe volver a cero a las 24 horas
+    4- Si el avance llega tarde se deben contar los segundos cumplidos sin correr los
+       bordes de los siguientes
+    5- Un reloj detenido no debe avanzar
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "unity.h"
+
+/**
+ * @brief Include del módulo que va a ser probado.
+ */
+#include "API_lcd_clock.h"
+
+/**
+ * @brief Includes de los módulos utilizados por el reloj.
+ */
+#include "API_lcd.h"
+#include "API_lcd_buffer.h"
+#include "API_lcd_pool.h"
+#include "API_lcd_profile.h"
+#include "API_lcd_queue.h"
+
+/**
+ * @brief Include de un mock para las funciones que acceden al hardware.
+ */
+#include "mock_API_lcd_port.h"
+
+/**
+ * @brief Include del simulador de LCD.
+ */
+#include "sim_lcd.h"
+
+static LCD_RelojTypedef reloj;
+
+/**
+ * @brief Inicializa el LCD sobre el simulador.
+ */
+void setUp(void) {
+    sim_init(&sim_lcd);
+    port_init_IgnoreAndReturn(true);
+    port_i2cWriteByte_StubWithCallback(sim_port_i2cWriteByte);
+    port_delay_StubWithCallback(sim_port_delay);
+    port_getTick_StubWithCallback(sim_port_getTick);
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_init());
+}
+
+/**
+ * @brief Línea del simulador.
+ */
+static const char * linea(uint8_t fila) {
+    static char texto[SIM_MAX_COLUMNAS + 1];
+
+    sim_getLine(&sim_lcd, fila, texto);
+    return texto;
+}
+
+/**
+ * @brief Avanza el tiempo del simulador y procesa el reloj.
+ */
+static void esperar(uint32_t milisegundos) {
+    sim_delay(&sim_lcd, milisegundos);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_clockProcess(&reloj));
+}
+
+/**
+ * @brief Test para verificar la inicialización,
+ * según el requerimiento 1.
+ */
+void test_inicializar_reloj() {
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_clockInit(&reloj, LCD_FILA_1, 9, LCD_RELOJ_HORA));
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_clockInit(&reloj, 1, 0, LCD_RELOJ_HORA));
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_clockInit(&reloj, LCD_FILA_2, 8, LCD_RELOJ_HORA));
+    TEST_ASSERT_EQUAL_STRING("        00:00:00", linea(1));
+    TEST_ASSERT_EQUAL(0, LCD_clockGet(&reloj));
+}
+
+/**
+ * @brief Test para verificar el avance en cada segundo,
+ * según el requerimiento 2.
+ */
+void test_avance_por_segundo() {
+    LCD_clockInit(&reloj, LCD_FILA_1, 0, LCD_RELOJ_HORA);
+    LCD_clockSet(&reloj, 12 * 3600 + 34 * 60 + 50);
+    LCD_clockStart(&reloj);
+    sim_resetStats(&sim_lcd);
+
+    esperar(999);
+    TEST_ASSERT_EQUAL(0, sim_lcd.datos + sim_lcd.instrucciones);
+
+    esperar(1);
+    TEST_ASSERT_EQUAL(1, sim_lcd.datos);
+    TEST_ASSERT_EQUAL(1, sim_lcd.instrucciones);
+    TEST_ASSERT_EQUAL_STRING("12:34:51        ", linea(0));
+}
+
+/**
+ * @brief Test para verificar la vuelta a cero de las cifras,
+ * según el requerimiento 3.
+ */
+void test_vuelta_a_cero_de_cifras() {
+    LCD_clockInit(&reloj, LCD_FILA_1, 0, LCD_RELOJ_HORA);
+    LCD_clockSet(&reloj, 59);
+    LCD_clockStart(&reloj);
+    sim_resetStats(&sim_lcd);
+
+    esperar(1000);
+    TEST_ASSERT_EQUAL_STRING("00:01:00        ", linea(0));
+    TEST_ASSERT_EQUAL(4, sim_lcd.datos); // "1:00"
+
+    LCD_clockSet(&reloj, 23 * 3600 + 59 * 60 + 59);
+    esperar(1000);
+    TEST_ASSERT_EQUAL_STRING("00:00:00        ", linea(0));
+
+    LCD_clockInit(&reloj, LCD_FILA_2, 0, LCD_RELOJ_CRONOMETRO);
+    LCD_clockSet(&reloj, 23 * 3600 + 59 * 60 + 59);
+    LCD_clockStart(&reloj);
+    esperar(1000);
+    TEST_ASSERT_EQUAL_STRING("24:00:00        ", linea(1));
+    TEST_ASSERT_EQUAL(24 * 3600, LCD_clockGet(&reloj));
+}
+
+/**
+ * @brief Test para verificar el avance atrasado,
+ * según el requerimiento 4.
+ */
+void test_avance_atrasado() {
+    LCD_clockInit(&reloj, LCD_FILA_1, 0, LCD_RELOJ_CRONOMETRO);
+    LCD_clockStart(&reloj);
+    sim_resetStats(&sim_lcd);
+
+    esperar(3500);
+    TEST_ASSERT_EQUAL_STRING("00:00:03        ", linea(0));
+    TEST_ASSERT_EQUAL(1, sim_lcd.datos);
+
+    esperar(500);
+    TEST_ASSERT_EQUAL_STRING("00:00:04        ", linea(0));
+
+    esperar(30 * 60 * 1000); // el tiempo del simulador es de 32 bits en us
+    TEST_ASSERT_EQUAL_STRING("00:30:04        ", linea(0));
+}
+
+/**
+ * @brief Test para verificar que un reloj detenido no avanza,
+ * según el requerimiento 5.
+ */
+void test_reloj_detenido() {
+    LCD_clockInit(&reloj, LCD_FILA_1, 0, LCD_RELOJ_HORA);
+    LCD_clockStart(&reloj);
+    esperar(1000);
+    LCD_clockStop(&reloj);
+    sim_resetStats(&sim_lcd);
+
+    esperar(5000);
+    TEST_ASSERT_EQUAL(0, sim_lcd.datos + sim_lcd.instrucciones);
+    TEST_ASSERT_EQUAL(1, LCD_clockGet(&reloj));
+}
@@ -0,0 +1,164 @@
+/**
+ * @file test_API_lcd_counter.c
+ * @brief Implementación de funciones de test del contador tipo odómetro
+ */
+
+/*
+    Requerimientos a probar:
+    1- Al inicializar se debe dibujar el contador en cero y se deben rechazar los
+       contadores que no entran en la pantalla
+    2- Un incremento sin acarreo debe reescribir una sola cifra
+    3- El acarreo debe reescribir sólo las cifras que cambian
+    4- Sumar o fijar un valor debe reescribir desde la primera cifra que cambia
+    5- Al pasar del máximo el contador debe volver a cero
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "unity.h"
+
+/**
+ * @brief Include del módulo que va a ser probado.
+ */
+#include "API_lcd_counter.h"
+
+/**
+ * @brief Includes de los módulos utilizados por el contador.
+ */
+#include "API_lcd.h"
+#include "API_lcd_buffer.h"
+#include "API_lcd_pool.h"
+#include "API_lcd_profile.h"
+#include "API_lcd_queue.h"
+
+/**
+ * @brief Include de un mock para las funciones que acceden al hardware.
+ */
+#include "mock_API_lcd_port.h"
+
+/**
+ * @brief Include del simulador de LCD.
+ */
+#include "sim_lcd.h"
+
+static LCD_ContadorTypedef contador;
+
+/**
+ * @brief Inicializa el LCD sobre el simulador.
+ */
+void setUp(void) {
+    sim_init(&sim_lcd);
+    port_init_IgnoreAndReturn(true);
+    port_i2cWriteByte_StubWithCallback(sim_port_i2cWriteByte);
+    port_delay_StubWithCallback(sim_port_delay);
+    port_getTick_StubWithCallback(sim_port_getTick);
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_init());
+}
+
+/**
+ * @brief Línea del simulador.
+ */
+static const char * linea(uint8_t fila) {
+    static char texto[SIM_MAX_COLUMNAS + 1];
+
+    sim_getLine(&sim_lcd, fila, texto);
+    return texto;
+}
+
+/**
+ * @brief Test para verificar la inicialización,
+ * según el requerimiento 1.
+ */
+void test_inicializar_contador() {
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_counterInit(&contador, LCD_FILA_1, 10, 7, false));
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_counterInit(&contador, LCD_FILA_1, 0, 11, false));
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_counterInit(&contador, 1, 0, 4, false));
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_counterInit(&contador, LCD_FILA_1, 0, 4, true));
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_counterInit(&contador, LCD_FILA_2, 10, 6, false));
+
+    TEST_ASSERT_EQUAL_STRING("0000            ", linea(0));
+    TEST_ASSERT_EQUAL_STRING("               0", linea(1));
+    TEST_ASSERT_EQUAL(0, LCD_counterGet(&contador));
+}
+
+/**
+ * @brief Test para verificar el incremento sin acarreo,
+ * según el requerimiento 2.
+ */
+void test_incremento_sin_acarreo() {
+    LCD_counterInit(&contador, LCD_FILA_1, 4, 5, false);
+    sim_resetStats(&sim_lcd);
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_counterIncrement(&contador));
+
+    TEST_ASSERT_EQUAL(1, sim_lcd.datos);
+    TEST_ASSERT_EQUAL(1, sim_lcd.instrucciones);
+    TEST_ASSERT_EQUAL_STRING("        1       ", linea(0));
+    TEST_ASSERT_EQUAL(1, LCD_counterGet(&contador));
+}
+
+/**
+ * @brief Test para verificar la propagación del acarreo,
+ * según el requerimiento 3.
+ */
+void test_acarreo() {
+    LCD_counterInit(&contador, LCD_FILA_1, 0, 5, false);
+    LCD_counterSet(&contador, 1999);
+    sim_resetStats(&sim_lcd);
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_counterIncrement(&contador));
+    TEST_ASSERT_EQUAL(4, sim_lcd.datos);
+    TEST_ASSERT_EQUAL_STRING(" 2000           ", linea(0));
+
+    LCD_counterSet(&contador, 9999);
+    sim_resetStats(&sim_lcd);
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_counterIncrement(&contador));
+    TEST_ASSERT_EQUAL(5, sim_lcd.datos);
+    TEST_ASSERT_EQUAL_STRING("10000           ", linea(0));
+    TEST_ASSERT_EQUAL(10000, LCD_counterGet(&contador));
+}
+
+/**
+ * @brief Test para verificar la suma y el cambio de valor,
+ * según el requerimiento 4.
+ */
+void test_sumar_y_fijar() {
+    LCD_counterInit(&contador, LCD_FILA_2, 0, 6, true);
+    LCD_counterSet(&contador, 123456);
+    sim_resetStats(&sim_lcd);
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_counterAdd(&contador, 40));
+    TEST_ASSERT_EQUAL(2, sim_lcd.datos);
+    TEST_ASSERT_EQUAL_STRING("123496          ", linea(1));
+
+    sim_resetStats(&sim_lcd);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_counterAdd(&contador, 0));
+    TEST_ASSERT_EQUAL(0, sim_lcd.datos + sim_lcd.instrucciones);
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_counterSet(&contador, 120000));
+    TEST_ASSERT_EQUAL(4, sim_lcd.datos);
+    TEST_ASSERT_EQUAL_STRING("120000          ", linea(1));
+    TEST_ASSERT_EQUAL(120000, LCD_counterGet(&contador));
+}
+
+/**
+ * @brief Test para verificar la vuelta a cero,
+ * según el requerimiento 5.
+ */
+void test_vuelta_a_cero() {
+    LCD_counterInit(&contador, LCD_FILA_1, 0, 3, false);
+    LCD_counterSet(&contador, 999);
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_counterIncrement(&contador));
+    TEST_ASSERT_EQUAL_STRING("  0             ", linea(0));
+
+    LCD_counterSet(&contador, 950);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_counterAdd(&contador, 100));
+    TEST_ASSERT_EQUAL_STRING(" 50             ", linea(0));
+    TEST_ASSERT_EQUAL(50, LCD_counterGet(&contador));
+}
@@ -0,0 +1,175 @@
+/**
+ * @file test_API_lcd_dual.c
+ * @brief Implementación de funciones de test de los paneles de dos controladores
+ */
+
+/*
+    Requerimientos a probar:
+    1- Se deben inicializar los dos controladores a la vez, con una sola serie de esperas
+    2- Se debe dibujar en las 4 filas de un único buffer y enviar a cada fila su controlador
+    3- El envío debe intercalar los mensajes de los dos controladores en bloques, sin
+       esperas ni violaciones de los tiempos de ejecución a la velocidad máxima del bus, y
+       ocupar menos de la mitad del bus que ocuparía enviando de a una trama
+    4- El borrado debe llegar a los dos controladores con una sola espera
+    5- No se debe escribir fuera del panel
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "unity.h"
+
+/**
+ * @brief Include del módulo que va a ser probado.
+ */
+#include "API_lcd_dual.h"
+
+/**
+ * @brief Includes de los módulos utilizados por el panel.
+ */
+#include "API_lcd.h"
+#include "API_lcd_buffer.h"
+#include "API_lcd_pool.h"
+#include "API_lcd_profile.h"
+#include "API_lcd_queue.h"
+
+/**
+ * @brief Include de un mock para las funciones que acceden al hardware.
+ */
+#include "mock_API_lcd_port.h"
+
+/**
+ * @brief Include del simulador de LCD.
+ */
+#include "sim_lcd.h"
+
+// bit DISPLAY_ON del comando DISPLAY CONTROL
+#define DISPLAY_ON (1 << 2)
+
+// esperas de la secuencia de inicio y del borrado, en ms
+#define ESPERAS_INICIO (20 + 10 + 1 + 2)
+
+static LCD_DualTypedef panel;
+
+/**
+ * @brief Conecta el port a un panel simulado y lo inicializa.
+ */
+void setUp(void) {
+    sim_initDual(&sim_lcd, &sim_lcdE2, LCD_DUAL_E1, LCD_DUAL_E2);
+    port_init_IgnoreAndReturn(true);
+    port_i2cWrite_StubWithCallback(sim_port_i2cWrite);
+    port_delay_StubWithCallback(sim_port_delay);
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_dualInit(&panel));
+}
+
+/**
+ * @brief Test para verificar la inicialización en paralelo,
+ * según el requerimiento 1.
+ */
+void test_inicio_en_paralelo() {
+    TEST_ASSERT_TRUE(sim_lcd.modo4Bits);
+    TEST_ASSERT_TRUE(sim_lcdE2.modo4Bits);
+    TEST_ASSERT_EQUAL(DISPLAY_ON, sim_lcd.control);
+    TEST_ASSERT_EQUAL(DISPLAY_ON, sim_lcdE2.control);
+    TEST_ASSERT_EQUAL(0, sim_lcd.violaciones);
+    TEST_ASSERT_EQUAL(0, sim_lcdE2.violaciones);
+
+    TEST_ASSERT_EQUAL(ESPERAS_INICIO * 1000, sim_lcd.tiempoEsperaUs);
+}
+
+/**
+ * @brief Test para verificar el dibujo en las 4 filas,
+ * según el requerimiento 2.
+ */
+void test_dibujo_en_cuatro_filas() {
+    char linea[LCD_DUAL_COLUMNAS + 1];
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_dualPrintAt(&panel, 0, 0, "fila 1"));
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_dualPrintAt(&panel, 1, 10, "fila 2"));
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_dualPrintAt(&panel, 2, 20, "fila 3"));
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_dualPrintAt(&panel, 3, 34, "fila 4 cortada"));
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_dualFlush(&panel));
+    TEST_ASSERT_FALSE(LCD_bufferIsDirty(&panel.buffer));
+
+    sim_getLine(&sim_lcd, 0, linea);
+    TEST_ASSERT_EQUAL_STRING("fila 1                                  ", linea);
+    sim_getLine(&sim_lcd, 1, linea);
+    TEST_ASSERT_EQUAL_STRING("          fila 2                        ", linea);
+    sim_getLine(&sim_lcdE2, 0, linea);
+    TEST_ASSERT_EQUAL_STRING("                    fila 3              ", linea);
+    sim_getLine(&sim_lcdE2, 1, linea);
+    TEST_ASSERT_EQUAL_STRING("                                  fila 4", linea);
+
+    TEST_ASSERT_EQUAL(0, sim_lcd.violaciones);
+    TEST_ASSERT_EQUAL(0, sim_lcdE2.violaciones);
+}
+
+/**
+ * @brief Test para verificar el envío intercalado en bloques a la velocidad
+ * máxima del port, según el requerimiento 3.
+ */
+void test_envio_intercalado() {
+    char texto[LCD_DUAL_COLUMNAS + 1];
+
+    for (uint8_t columna = 0; columna < LCD_DUAL_COLUMNAS; columna++)
+        texto[columna] = 'a' + (columna % 26);
+    texto[LCD_DUAL_COLUMNAS] = '\0';
+
+    sim_lcd.clockI2C = sim_lcdE2.clockI2C = I2C_CLOCK_MAX;
+    sim_resetStats(&sim_lcd);
+    sim_resetStats(&sim_lcdE2);
+
+    for (uint8_t fila = 0; fila < LCD_DUAL_FILAS; fila++)
+        LCD_dualPrintAt(&panel, fila, 0, texto);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_dualFlush(&panel));
+
+    // 2 posicionamientos y 80 caracteres por controlador
+    uint32_t tramas = 2 * (2 + 2 * LCD_DUAL_COLUMNAS) * LCD_TRAMAS_X_MENSAJE;
+    TEST_ASSERT_EQUAL(tramas, sim_lcd.bytesI2C);
+    TEST_ASSERT_EQUAL((tramas + LCD_DUAL_TRAMAS_X_BLOQUE - 1) / LCD_DUAL_TRAMAS_X_BLOQUE,
+                      sim_lcd.transacciones);
+    TEST_ASSERT_EQUAL(0, sim_lcd.tiempoEsperaUs);
+    TEST_ASSERT_EQUAL(2 + 2 * LCD_DUAL_COLUMNAS, sim_lcd.instrucciones + sim_lcd.datos);
+    TEST_ASSERT_EQUAL(2 + 2 * LCD_DUAL_COLUMNAS, sim_lcdE2.instrucciones + sim_lcdE2.datos);
+    TEST_ASSERT_EQUAL(0, sim_lcd.violaciones);
+    TEST_ASSERT_EQUAL(0, sim_lcdE2.violaciones);
+
+    // en bloques cada trama ocupa 9 bits; de a una, con inicio y fin, ocuparía 20
+    uint32_t deAUnaUs = (uint64_t)tramas * (10 + 9 + 1) * 1000000 / I2C_CLOCK_MAX;
+    TEST_ASSERT_LESS_THAN(deAUnaUs / 2, sim_lcd.tiempoBusUs);
+}
+
+/**
+ * @brief Test para verificar el borrado de los dos controladores,
+ * según el requerimiento 4.
+ */
+void test_borrado_con_una_espera() {
+    char linea[LCD_DUAL_COLUMNAS + 1];
+
+    LCD_dualPrintAt(&panel, 0, 0, "arriba");
+    LCD_dualPrintAt(&panel, 3, 0, "abajo");
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_dualFlush(&panel));
+
+    sim_resetStats(&sim_lcd);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_dualClear(&panel));
+    TEST_ASSERT_EQUAL(1, sim_lcd.transacciones);
+    TEST_ASSERT_EQUAL(2 * 1000, sim_lcd.tiempoEsperaUs);
+    TEST_ASSERT_EQUAL(' ', LCD_bufferGet(&panel.buffer, 0, 0));
+
+    sim_getLine(&sim_lcd, 0, linea);
+    TEST_ASSERT_EQUAL_STRING("                                        ", linea);
+    sim_getLine(&sim_lcdE2, 1, linea);
+    TEST_ASSERT_EQUAL_STRING("                                        ", linea);
+}
+
+/**
+ * @brief Test para verificar los límites del panel,
+ * según el requerimiento 5.
+ */
+void test_fuera_del_panel() {
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_dualPrintAt(&panel, LCD_DUAL_FILAS, 0, "x"));
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_dualPrintAt(&panel, 0, LCD_DUAL_COLUMNAS, "x"));
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_dualPrintAt(&panel, 0, 0, NULL));
+    TEST_ASSERT_FALSE(LCD_bufferIsDirty(&panel.buffer));
+}
@@ -0,0 +1,260 @@
+/**
+ * @file test_API_lcd_frame.c
+ * @brief Implementación de funciones de test del doble cuadro
+ */
+
+/*
+    Requerimientos a probar:
+    1- Un cuadro publicado debe llegar a la sombra sólo con las celdas que cambiaron, y
+       el cuadro de atrás debe continuar desde lo publicado
+    2- Sin publicaciones nuevas la copia no debe modificar la sombra
+    3- Mientras se publica un cuadro la copia debe fallar sin esperar
+    4- Con un hilo que dibuja y publica sin pausa y otro que copia y envía al display,
+       cada copia y cada pantalla enviada debe ser un cuadro completo, también luego
+       de una copia fallida, y el último cuadro publicado debe llegar al display
+*/
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "unity.h"
+
+/**
+ * @brief Include del módulo que va a ser probado.
+ */
+#include "API_lcd_frame.h"
+
+/**
+ * @brief Includes de los módulos utilizados en el envío.
+ */
+#include "API_lcd.h"
+#include "API_lcd_buffer.h"
+#include "API_lcd_pool.h"
+#include "API_lcd_profile.h"
+#include "API_lcd_queue.h"
+#include "API_lcd_stream.h"
+
+/**
+ * @brief Include de un mock para las funciones que acceden al hardware.
+ */
+#include "mock_API_lcd_port.h"
+
+/**
+ * @brief Include del simulador de LCD.
+ */
+#include "sim_lcd.h"
+
+// tamaño máximo del flujo que se junta para pasarlo al simulador
+#define MAX_TRAMAS 512
+
+// cuadros que publica el hilo de dibujo en la prueba de carga
+#define CUADROS_PRUEBA 50000
+
+// copias que se toman por cada envío al display
+#define COPIAS_X_ENVIO 16
+
+static LCD_CuadroDobleTypedef cuadro;
+static LCD_BufferTypedef sombra;
+
+/**
+ * @brief Callbacks que recibió el port en el último envío.
+ */
+static port_TramaCallbackTypedef tramaSiguiente;
+static port_FinCallbackTypedef finTransmision;
+
+// el hilo de dibujo terminó de publicar
+static bool_t terminado;
+
+/**
+ * @brief Reemplaza a port_i2cStreamStart guardando los callbacks.
+ */
+static bool_t capturarEnvio(port_TramaCallbackTypedef trama, port_FinCallbackTypedef fin,
+                            int llamadas) {
+    tramaSiguiente = trama;
+    finTransmision = fin;
+    return true;
+}
+
+/**
+ * @brief Hace el trabajo de la ISR: pide tramas hasta que no quedan y las
+ * pasa al simulador como una única transacción.
+ */
+static void atenderInterrupciones() {
+    static uint8_t flujo[MAX_TRAMAS];
+    uint16_t cantidad = 0;
+
+    while (cantidad < MAX_TRAMAS && tramaSiguiente(&flujo[cantidad]))
+        cantidad++;
+
+    sim_i2cWrite(&sim_lcd, flujo, cantidad);
+    finTransmision(true);
+}
+
+/**
+ * @brief Indica si todas las celdas del buffer tienen el mismo caracter.
+ */
+static bool_t cuadroCompleto(const LCD_BufferTypedef * buffer) {
+    for (uint8_t fila = 0; fila < buffer->filas; fila++) {
+        for (uint8_t columna = 0; columna < buffer->columnas; columna++) {
+            if (LCD_bufferGet(buffer, fila, columna) != LCD_bufferGet(buffer, 0, 0))
+                return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Indica si todas las celdas visibles del display tienen el caracter.
+ */
+static bool_t pantallaCompleta(char caracter) {
+    char linea[SIM_MAX_COLUMNAS + 1];
+
+    for (uint8_t fila = 0; fila < LCD_CANTIDAD_FILAS; fila++) {
+        sim_getLine(&sim_lcd, fila, linea);
+        for (uint8_t columna = 0; columna < LCD_CANTIDAD_COLUMNAS; columna++) {
+            if (linea[columna] != caracter)
+                return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Envía la sombra al display y verifica que muestre un cuadro completo.
+ */
+static void enviar() {
+    if (!LCD_bufferIsDirty(&sombra))
+        return;
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_streamFlush(&sombra));
+    atenderInterrupciones();
+    TEST_ASSERT_TRUE(pantallaCompleta(LCD_bufferGet(&sombra, 0, 0)));
+}
+
+/**
+ * @brief Hilo de dibujo: llena el cuadro de atrás celda por celda con una
+ * letra distinta en cada cuadro y lo publica, sin esperar al envío.
+ */
+static void * dibujar(void * argumento) {
+    for (uint32_t numero = 1; numero <= CUADROS_PRUEBA; numero++) {
+        LCD_BufferTypedef * atras = LCD_frameBack(&cuadro);
+
+        for (uint8_t fila = 0; fila < atras->filas; fila++) {
+            for (uint8_t columna = 0; columna < atras->columnas; columna++)
+                LCD_bufferWrite(atras, fila, columna, 'A' + numero % 26);
+        }
+        LCD_frameCommit(&cuadro);
+    }
+
+    __atomic_store_n(&terminado, true, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+/**
+ * @brief Inicializa los cuadros, la sombra y el simulador antes de cada test.
+ */
+void setUp(void) {
+    LCD_frameInit(&cuadro, LCD_CANTIDAD_FILAS, LCD_CANTIDAD_COLUMNAS);
+    LCD_bufferInit(&sombra, LCD_CANTIDAD_FILAS, LCD_CANTIDAD_COLUMNAS);
+    sim_init(&sim_lcd);
+    sim_lcd.modo4Bits = true;
+    terminado = false;
+}
+
+/**
+ * @brief Test para verificar la publicación de un cuadro,
+ * según el requerimiento 1.
+ */
+void test_publicar_cuadro() {
+    uint8_t inicio;
+    uint8_t largo;
+
+    LCD_bufferWrite(LCD_frameBack(&cuadro), 1, 3, 'x');
+    TEST_ASSERT_FALSE(LCD_framePending(&cuadro));
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_frameSnapshot(&cuadro, &sombra));
+    TEST_ASSERT_FALSE(LCD_bufferIsDirty(&sombra));
+
+    LCD_frameCommit(&cuadro);
+    TEST_ASSERT_TRUE(LCD_framePending(&cuadro));
+    TEST_ASSERT_EQUAL('x', LCD_bufferGet(LCD_frameBack(&cuadro), 1, 3));
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_frameSnapshot(&cuadro, &sombra));
+    TEST_ASSERT_FALSE(LCD_framePending(&cuadro));
+    TEST_ASSERT_EQUAL('x', LCD_bufferGet(&sombra, 1, 3));
+    TEST_ASSERT_TRUE(LCD_bufferNextDirtyRun(&sombra, 1, 0, &inicio, &largo));
+    TEST_ASSERT_EQUAL(3, inicio);
+    TEST_ASSERT_EQUAL(1, largo);
+    TEST_ASSERT_FALSE(LCD_bufferNextDirtyRun(&sombra, 0, 0, &inicio, &largo));
+}
+
+/**
+ * @brief Test para verificar que sin cuadros nuevos la sombra no cambia,
+ * según el requerimiento 2.
+ */
+void test_copia_sin_cambios() {
+    LCD_bufferWrite(LCD_frameBack(&cuadro), 0, 0, 'x');
+    LCD_frameCommit(&cuadro);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_frameSnapshot(&cuadro, &sombra));
+    LCD_bufferMarkClean(&sombra, 0, 0, LCD_CANTIDAD_COLUMNAS);
+
+    // se dibuja sin publicar
+    LCD_bufferWrite(LCD_frameBack(&cuadro), 0, 1, 'y');
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_frameSnapshot(&cuadro, &sombra));
+    TEST_ASSERT_FALSE(LCD_bufferIsDirty(&sombra));
+    TEST_ASSERT_EQUAL(' ', LCD_bufferGet(&sombra, 0, 1));
+}
+
+/**
+ * @brief Test para verificar que la copia no espera a una publicación,
+ * según el requerimiento 3.
+ */
+void test_copia_durante_publicacion() {
+    LCD_bufferWrite(LCD_frameBack(&cuadro), 0, 0, 'x');
+    LCD_frameCommit(&cuadro);
+
+    // el escritor quedó entre las dos escrituras de la secuencia
+    cuadro.secuencia++;
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_frameSnapshot(&cuadro, &sombra));
+    TEST_ASSERT_FALSE(LCD_bufferIsDirty(&sombra));
+
+    cuadro.secuencia++;
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_frameSnapshot(&cuadro, &sombra));
+    TEST_ASSERT_EQUAL('x', LCD_bufferGet(&sombra, 0, 0));
+}
+
+/**
+ * @brief Test de carga con dos hilos contra el simulador: el hilo de dibujo
+ * publica sin pausa mientras este copia y envía por interrupciones, según
+ * el requerimiento 4.
+ */
+void test_carga_con_hilos() {
+    pthread_t hilo;
+    uint32_t copias = 0;
+    bool_t ultimo = false;
+
+    port_i2cStreamStart_StubWithCallback(capturarEnvio);
+    TEST_ASSERT_EQUAL(0, pthread_create(&hilo, NULL, dibujar, NULL));
+
+    while (!ultimo) {
+        ultimo = __atomic_load_n(&terminado, __ATOMIC_ACQUIRE);
+        if (!LCD_framePending(&cuadro))
+            continue;
+
+        // aunque la copia falle, la sombra no debe quedar con una mezcla de cuadros
+        bool_t copiada = (LCD_frameSnapshot(&cuadro, &sombra) == LCD_OK);
+        TEST_ASSERT_TRUE(cuadroCompleto(&sombra));
+        if (!copiada)
+            continue;
+
+        if (++copias % COPIAS_X_ENVIO == 0)
+            enviar();
+    }
+    enviar();
+
+    TEST_ASSERT_EQUAL(0, pthread_join(hilo, NULL));
+    TEST_ASSERT_FALSE(LCD_framePending(&cuadro));
+    TEST_ASSERT_TRUE(pantallaCompleta('A' + CUADROS_PRUEBA % 26));
+    TEST_ASSERT_TRUE(copias > 1);
+    TEST_ASSERT_EQUAL(0, sim_lcd.violaciones);
+}
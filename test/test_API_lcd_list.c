@@ -0,0 +1,236 @@
+/**
+ * @file test_API_lcd_list.c
+ * @brief Implementación de funciones de test de las listas de visualización
+ */
+
+/*
+    Requerimientos a probar:
+    1- Grabar una lista no debe acceder al hardware
+    2- Reproducir una lista debe mostrar lo grabado, en una transacción por tramo
+    3- Se debe esperar a que termine el borrado antes de seguir transmitiendo
+    4- Actualizar un slot sólo debe modificar las tramas del campo
+    5- Una lista que no entra en su buffer no se debe reproducir
+    6- Lo reproducido se debe registrar en el buffer de sombra y en el cursor del driver
+    7- La reproducción debe respetar el estado actual del backlight aunque la lista se
+       haya grabado con otro
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "unity.h"
+
+/**
+ * @brief Include del módulo que va a ser probado.
+ */
+#include "API_lcd_list.h"
+
+/**
+ * @brief Includes de los módulos utilizados por la lista.
+ */
+#include "API_lcd.h"
+#include "API_lcd_buffer.h"
+#include "API_lcd_pool.h"
+#include "API_lcd_profile.h"
+#include "API_lcd_queue.h"
+
+/**
+ * @brief Include de un mock para las funciones que acceden al hardware.
+ */
+#include "mock_API_lcd_port.h"
+
+/**
+ * @brief Include del simulador de LCD.
+ */
+#include "sim_lcd.h"
+
+/**
+ * @brief Bit del backlight en las tramas. Obtenido del archivo API_lcd_cmd.h
+ */
+#define POS_BACKLIGHT 3
+
+static LCD_ListaTypedef lista;
+static uint8_t buffer[LCD_LISTA_TAM_BUFFER(40)];
+static uint8_t slot;
+
+/**
+ * @brief Graba una pantalla de ejemplo con un campo variable.
+ */
+void setUp(void) {
+    sim_init(&sim_lcd);
+    sim_lcd.modo4Bits = true;
+
+    LCD_listInit(&lista, buffer, sizeof(buffer));
+    LCD_listClear(&lista);
+    LCD_listPrintAt(&lista, LCD_FILA_1, 0, "Temp:");
+    LCD_listSlot(&lista, LCD_FILA_1, 6, 4, &slot);
+    LCD_listPrintAt(&lista, LCD_FILA_2, 0, "Estado OK");
+}
+
+/**
+ * @brief Reemplaza las funciones del port por el simulador de LCD.
+ */
+static void usarSimulador(void) {
+    port_i2cWrite_StubWithCallback(sim_port_i2cWrite);
+    port_delay_StubWithCallback(sim_port_delay);
+}
+
+/**
+ * @brief Inicializa el LCD sobre el simulador.
+ */
+static void iniciarLcd(void) {
+    sim_init(&sim_lcd);
+    port_init_IgnoreAndReturn(true);
+    port_i2cWriteByte_StubWithCallback(sim_port_i2cWriteByte);
+    port_getTick_StubWithCallback(sim_port_getTick);
+    usarSimulador();
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_init());
+    sim_delay(&sim_lcd, 2); // la inicialización termina con un borrado
+}
+
+/**
+ * @brief Test para verificar que grabar no accede al hardware,
+ * según el requerimiento 1.
+ */
+void test_grabar_no_envia() {
+    TEST_ASSERT_FALSE(lista.desbordada);
+    TEST_ASSERT_EQUAL(LCD_LISTA_TAM_BUFFER(1 + 6 + 5 + 10), lista.largo);
+}
+
+/**
+ * @brief Test para verificar la reproducción de la lista,
+ * según el requerimiento 2.
+ */
+void test_reproducir_lista() {
+    char linea[SIM_MAX_COLUMNAS + 1];
+
+    usarSimulador();
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_listReplay(&lista));
+
+    sim_getLine(&sim_lcd, 0, linea);
+    TEST_ASSERT_EQUAL_STRING("Temp:           ", linea);
+    sim_getLine(&sim_lcd, 1, linea);
+    TEST_ASSERT_EQUAL_STRING("Estado OK       ", linea);
+
+    TEST_ASSERT_EQUAL(2, sim_lcd.transacciones);
+    TEST_ASSERT_EQUAL(lista.largo, sim_lcd.bytesI2C);
+}
+
+/**
+ * @brief Test para verificar la pausa luego del borrado,
+ * según el requerimiento 3.
+ */
+void test_pausa_luego_de_borrar() {
+    port_i2cWrite_ExpectAndReturn(buffer, LCD_TRAMAS_X_MENSAJE, true);
+    port_delay_Expect(2);
+    port_i2cWrite_ExpectAndReturn(&buffer[LCD_TRAMAS_X_MENSAJE],
+                                  lista.largo - LCD_TRAMAS_X_MENSAJE, true);
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_listReplay(&lista));
+}
+
+/**
+ * @brief Test para verificar la actualización de un slot,
+ * según el requerimiento 4.
+ */
+void test_actualizar_slot() {
+    char linea[SIM_MAX_COLUMNAS + 1];
+    uint8_t copia[sizeof(buffer)];
+    uint16_t inicio = lista.slots[slot].inicio;
+    uint16_t fin = inicio + LCD_LISTA_TAM_BUFFER(4);
+
+    memcpy(copia, buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_listPatch(&lista, slot, "23.5C"));
+
+    TEST_ASSERT_EQUAL_MEMORY(copia, buffer, inicio);
+    TEST_ASSERT_EQUAL_MEMORY(&copia[fin], &buffer[fin], sizeof(buffer) - fin);
+
+    usarSimulador();
+    LCD_listReplay(&lista);
+    sim_getLine(&sim_lcd, 0, linea);
+    TEST_ASSERT_EQUAL_STRING("Temp: 23.5      ", linea);
+
+    LCD_listPatch(&lista, slot, "7");
+    LCD_listReplay(&lista);
+    sim_getLine(&sim_lcd, 0, linea);
+    TEST_ASSERT_EQUAL_STRING("Temp: 7         ", linea);
+    TEST_ASSERT_EQUAL(0, sim_lcd.violaciones);
+
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_listPatch(&lista, slot + 1, "x"));
+}
+
+/**
+ * @brief Test para verificar que una lista desbordada no se reproduce,
+ * según el requerimiento 5.
+ */
+void test_lista_desbordada() {
+    uint8_t chico[LCD_LISTA_TAM_BUFFER(3)];
+
+    LCD_listInit(&lista, chico, sizeof(chico));
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_listPrintAt(&lista, LCD_FILA_1, 0, "Hola"));
+    TEST_ASSERT_TRUE(lista.desbordada);
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_listReplay(&lista));
+}
+
+/**
+ * @brief Test para verificar que la reproducción actualiza la sombra y el cursor,
+ * según el requerimiento 6.
+ */
+void test_reproducir_registra_sombra() {
+    char linea[SIM_MAX_COLUMNAS + 1];
+    uint8_t fila, inicio, largo;
+
+    iniciarLcd();
+    LCD_printAt(LCD_FILA_2, 12, "viejo");
+
+    LCD_listPatch(&lista, slot, "21C");
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_listReplay(&lista));
+
+    const LCD_BufferTypedef * sombra = LCD_getBuffer();
+    TEST_ASSERT_EQUAL('T', LCD_bufferGet(sombra, 0, 0));
+    TEST_ASSERT_EQUAL('C', LCD_bufferGet(sombra, 0, 8));
+    TEST_ASSERT_EQUAL(' ', LCD_bufferGet(sombra, 0, 9));
+    TEST_ASSERT_EQUAL('K', LCD_bufferGet(sombra, 1, 8));
+    TEST_ASSERT_EQUAL(' ', LCD_bufferGet(sombra, 1, 12)); // el clear de la lista la borró
+    for (fila = 0; fila < LCD_CANTIDAD_FILAS; fila++)
+        TEST_ASSERT_FALSE(LCD_bufferNextDirtyRun(sombra, fila, 0, &inicio, &largo));
+
+    // el cursor sigue donde terminó la lista
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_printChar('!'));
+    TEST_ASSERT_EQUAL('!', LCD_bufferGet(sombra, 1, 9));
+    sim_getLine(&sim_lcd, 1, linea);
+    TEST_ASSERT_EQUAL_STRING("Estado OK!      ", linea);
+}
+
+/**
+ * @brief Test para verificar la reproducción luego de un cambio del modo de
+ * energía, según el requerimiento 7.
+ */
+void test_reproducir_respeta_backlight() {
+    char linea[SIM_MAX_COLUMNAS + 1];
+
+    iniciarLcd();
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_setPowerMode(LCD_ENERGIA_BACKLIGHT_APAGADO));
+    sim_resetStats(&sim_lcd);
+
+    // grabada con backlight, se reproduce sin encenderlo
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_listReplay(&lista));
+    TEST_ASSERT_EQUAL(0, (sim_lcd.pines >> POS_BACKLIGHT) & 1);
+    TEST_ASSERT_EQUAL(1 + (lista.largo - LCD_TRAMAS_X_MENSAJE + LCD_LISTA_TRAMAS_X_BLOQUE - 1) /
+                              LCD_LISTA_TRAMAS_X_BLOQUE,
+                      sim_lcd.transacciones);
+    sim_getLine(&sim_lcd, 1, linea);
+    TEST_ASSERT_EQUAL_STRING("Estado OK       ", linea);
+    TEST_ASSERT_EQUAL(0, sim_lcd.violaciones);
+
+    // grabada sin backlight, se reproduce con el backlight encendido
+    LCD_listInit(&lista, buffer, sizeof(buffer));
+    LCD_listPrintAt(&lista, LCD_FILA_1, 0, "Hola");
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_setPowerMode(LCD_ENERGIA_NORMAL));
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_listReplay(&lista));
+    TEST_ASSERT_EQUAL(1, (sim_lcd.pines >> POS_BACKLIGHT) & 1);
+    sim_getLine(&sim_lcd, 0, linea);
+    TEST_ASSERT_EQUAL_STRING("Hola:           ", linea);
+    TEST_ASSERT_EQUAL(0, sim_lcd.violaciones);
+}
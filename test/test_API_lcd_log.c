@@ -0,0 +1,171 @@
+/**
+ * @file test_API_lcd_log.c
+ * @brief Implementación de funciones de test del registro de líneas
+ */
+
+/*
+    Requerimientos a probar:
+    1- Agregar una línea no debe acceder al hardware y la debe guardar recortada o
+       completada al ancho de la pantalla
+    2- El registro debe guardar sólo las últimas líneas que entran en su buffer
+    3- La vista debe mostrar las líneas más nuevas y al dibujarla sólo se deben
+       reescribir los tramos que cambian
+    4- Se debe poder mover la vista de a líneas o de a páginas dentro del registro, y
+       mientras está atrás las líneas nuevas no la deben mover
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "unity.h"
+
+/**
+ * @brief Include del módulo que va a ser probado.
+ */
+#include "API_lcd_log.h"
+
+/**
+ * @brief Includes de los módulos utilizados por el registro.
+ */
+#include "API_lcd.h"
+#include "API_lcd_buffer.h"
+#include "API_lcd_pool.h"
+#include "API_lcd_profile.h"
+#include "API_lcd_queue.h"
+
+/**
+ * @brief Include de un mock para las funciones que acceden al hardware.
+ */
+#include "mock_API_lcd_port.h"
+
+/**
+ * @brief Include del simulador de LCD.
+ */
+#include "sim_lcd.h"
+
+// líneas del registro de las pruebas
+#define LINEAS 6
+
+static LCD_LogTypedef registro;
+static char buffer[LCD_LOG_TAM_BUFFER(LINEAS)];
+
+/**
+ * @brief Inicializa el LCD sobre el simulador y un registro vacío.
+ */
+void setUp(void) {
+    sim_init(&sim_lcd);
+    port_init_IgnoreAndReturn(true);
+    port_i2cWriteByte_StubWithCallback(sim_port_i2cWriteByte);
+    port_delay_StubWithCallback(sim_port_delay);
+    port_getTick_StubWithCallback(sim_port_getTick);
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_init());
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_logInit(&registro, buffer, LINEAS));
+}
+
+/**
+ * @brief Línea del simulador.
+ */
+static const char * linea(uint8_t fila) {
+    static char texto[SIM_MAX_COLUMNAS + 1];
+
+    sim_getLine(&sim_lcd, fila, texto);
+    return texto;
+}
+
+/**
+ * @brief Agrega las líneas "evento 1" a "evento <cantidad>".
+ */
+static void agregarEventos(uint8_t desde, uint8_t hasta) {
+    char texto[LCD_CANTIDAD_COLUMNAS + 1];
+
+    for (uint8_t evento = desde; evento <= hasta; evento++) {
+        strcpy(texto, "evento  ");
+        texto[7] = '0' + evento;
+        LCD_logAppend(&registro, texto);
+    }
+}
+
+/**
+ * @brief Test para verificar que agregar sólo guarda la línea,
+ * según el requerimiento 1.
+ */
+void test_agregar_linea() {
+    char texto[LCD_CANTIDAD_COLUMNAS + 1];
+    sim_resetStats(&sim_lcd);
+
+    LCD_logAppend(&registro, "corto");
+    LCD_logAppend(&registro, "una linea demasiado larga");
+
+    TEST_ASSERT_EQUAL(0, sim_lcd.bytesI2C);
+    TEST_ASSERT_TRUE(LCD_logGetLine(&registro, 0, texto));
+    TEST_ASSERT_EQUAL_STRING("una linea demasi", texto);
+    TEST_ASSERT_TRUE(LCD_logGetLine(&registro, 1, texto));
+    TEST_ASSERT_EQUAL_STRING("corto           ", texto);
+    TEST_ASSERT_FALSE(LCD_logGetLine(&registro, 2, texto));
+}
+
+/**
+ * @brief Test para verificar que se guardan las últimas líneas,
+ * según el requerimiento 2.
+ */
+void test_ultimas_lineas() {
+    char texto[LCD_CANTIDAD_COLUMNAS + 1];
+
+    agregarEventos(1, 9);
+
+    TEST_ASSERT_TRUE(LCD_logGetLine(&registro, LINEAS - 1, texto));
+    TEST_ASSERT_EQUAL_STRING("evento 4        ", texto);
+    TEST_ASSERT_FALSE(LCD_logGetLine(&registro, LINEAS, texto));
+}
+
+/**
+ * @brief Test para verificar el dibujo de las líneas nuevas,
+ * según el requerimiento 3.
+ */
+void test_dibujo_minimo() {
+    agregarEventos(1, 1);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_logProcess(&registro));
+    TEST_ASSERT_EQUAL_STRING("                ", linea(0));
+    TEST_ASSERT_EQUAL_STRING("evento 1        ", linea(1));
+
+    agregarEventos(2, 2);
+    sim_resetStats(&sim_lcd);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_logProcess(&registro));
+    TEST_ASSERT_EQUAL_STRING("evento 1        ", linea(0));
+    TEST_ASSERT_EQUAL_STRING("evento 2        ", linea(1));
+    TEST_ASSERT_EQUAL(8 + 1, sim_lcd.datos); // la fila de arriba completa y una cifra
+
+    sim_resetStats(&sim_lcd);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_logProcess(&registro));
+    TEST_ASSERT_EQUAL(0, sim_lcd.bytesI2C);
+}
+
+/**
+ * @brief Test para verificar el movimiento de la vista,
+ * según el requerimiento 4.
+ */
+void test_mover_vista() {
+    agregarEventos(1, 9);
+
+    LCD_logPage(&registro, 1);
+    LCD_logProcess(&registro);
+    TEST_ASSERT_EQUAL_STRING("evento 6        ", linea(0));
+    TEST_ASSERT_EQUAL_STRING("evento 7        ", linea(1));
+
+    LCD_logScroll(&registro, 100);
+    LCD_logProcess(&registro);
+    TEST_ASSERT_EQUAL_STRING("evento 4        ", linea(0));
+
+    LCD_logScroll(&registro, -1);
+    agregarEventos(1, 1);
+    LCD_logProcess(&registro);
+    TEST_ASSERT_EQUAL_STRING("evento 5        ", linea(0));
+    TEST_ASSERT_EQUAL_STRING("evento 6        ", linea(1));
+
+    LCD_logFollow(&registro);
+    LCD_logProcess(&registro);
+    TEST_ASSERT_EQUAL_STRING("evento 9        ", linea(0));
+    TEST_ASSERT_EQUAL_STRING("evento 1        ", linea(1));
+}
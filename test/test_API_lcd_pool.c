@@ -0,0 +1,134 @@
+/**
+ * @file test_API_lcd_pool.c
+ * @brief Implementación de funciones de test del pool de memoria del LCD
+ */
+
+/*
+    Requerimientos a probar:
+    1- Se debe entregar un bloque de la clase más chica que alcance
+    2- Si una clase se agota se debe usar la siguiente más grande
+    3- Si el pool se agota se debe devolver NULL y contar el fallo
+    4- Un bloque liberado se debe poder volver a reservar
+    5- Se debe registrar la marca de agua máxima por clase
+    6- Se deben ignorar liberaciones inválidas
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "unity.h"
+
+/**
+ * @brief Include del módulo que va a ser probado.
+ */
+#include "API_lcd_pool.h"
+
+/**
+ * @brief Inicializa el pool antes de cada test.
+ */
+void setUp(void) {
+    LCD_poolInit();
+}
+
+/**
+ * @brief Test para verificar la elección de la clase según el tamaño,
+ * según el requerimiento 1.
+ */
+void test_reserva_en_clase_mas_chica() {
+    LCD_PoolStatsTypedef stats;
+
+    TEST_ASSERT_NOT_NULL(LCD_poolAlloc(2));
+    TEST_ASSERT_NOT_NULL(LCD_poolAlloc(LCD_POOL_TAM_CLASE_1));
+    TEST_ASSERT_NOT_NULL(LCD_poolAlloc(LCD_POOL_TAM_CLASE_2));
+
+    LCD_poolGetStats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.enUso[0]);
+    TEST_ASSERT_EQUAL(1, stats.enUso[1]);
+    TEST_ASSERT_EQUAL(1, stats.enUso[2]);
+}
+
+/**
+ * @brief Test para verificar que se usa la clase siguiente al agotarse una,
+ * según el requerimiento 2.
+ */
+void test_clase_agotada_usa_la_siguiente() {
+    LCD_PoolStatsTypedef stats;
+
+    for (uint8_t indice = 0; indice < LCD_POOL_BLOQUES_CLASE_0; indice++)
+        TEST_ASSERT_NOT_NULL(LCD_poolAlloc(1));
+    TEST_ASSERT_NOT_NULL(LCD_poolAlloc(1));
+
+    LCD_poolGetStats(&stats);
+    TEST_ASSERT_EQUAL(LCD_POOL_BLOQUES_CLASE_0, stats.enUso[0]);
+    TEST_ASSERT_EQUAL(1, stats.enUso[1]);
+}
+
+/**
+ * @brief Test para verificar el comportamiento con el pool agotado,
+ * según el requerimiento 3.
+ */
+void test_pool_agotado_devuelve_null() {
+    LCD_PoolStatsTypedef stats;
+
+    for (uint8_t indice = 0; indice < LCD_POOL_BLOQUES_CLASE_2; indice++)
+        TEST_ASSERT_NOT_NULL(LCD_poolAlloc(LCD_POOL_TAM_CLASE_2));
+
+    TEST_ASSERT_NULL(LCD_poolAlloc(LCD_POOL_TAM_CLASE_2));
+    TEST_ASSERT_NULL(LCD_poolAlloc(LCD_POOL_TAM_CLASE_2 + 1));
+
+    LCD_poolGetStats(&stats);
+    TEST_ASSERT_EQUAL(2, stats.fallos);
+}
+
+/**
+ * @brief Test para verificar que un bloque liberado se reutiliza,
+ * según el requerimiento 4.
+ */
+void test_bloque_liberado_se_reutiliza() {
+    for (uint8_t indice = 0; indice < LCD_POOL_BLOQUES_CLASE_2 - 1; indice++)
+        LCD_poolAlloc(LCD_POOL_TAM_CLASE_2);
+    void * bloque = LCD_poolAlloc(LCD_POOL_TAM_CLASE_2);
+    TEST_ASSERT_NULL(LCD_poolAlloc(LCD_POOL_TAM_CLASE_2));
+
+    LCD_poolFree(bloque);
+    TEST_ASSERT_EQUAL_PTR(bloque, LCD_poolAlloc(LCD_POOL_TAM_CLASE_2));
+}
+
+/**
+ * @brief Test para verificar la marca de agua máxima,
+ * según el requerimiento 5.
+ */
+void test_marca_de_agua_maxima() {
+    LCD_PoolStatsTypedef stats;
+
+    void * bloque1 = LCD_poolAlloc(1);
+    void * bloque2 = LCD_poolAlloc(1);
+    void * bloque3 = LCD_poolAlloc(1);
+    LCD_poolFree(bloque1);
+    LCD_poolFree(bloque2);
+    LCD_poolFree(bloque3);
+    LCD_poolAlloc(1);
+
+    LCD_poolGetStats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.enUso[0]);
+    TEST_ASSERT_EQUAL(3, stats.maximoUso[0]);
+}
+
+/**
+ * @brief Test para verificar que se ignoran liberaciones inválidas,
+ * según el requerimiento 6.
+ */
+void test_liberaciones_invalidas() {
+    LCD_PoolStatsTypedef stats;
+    uint8_t ajeno[4];
+
+    uint8_t * bloque = LCD_poolAlloc(1);
+    LCD_poolFree(bloque);
+    LCD_poolFree(bloque);
+    LCD_poolFree(ajeno);
+    LCD_poolFree(NULL);
+    LCD_poolFree((uint8_t *)LCD_poolAlloc(1) + 1);
+
+    LCD_poolGetStats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.enUso[0]);
+}
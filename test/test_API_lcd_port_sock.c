@@ -0,0 +1,332 @@
+/**
+ * @file test_API_lcd_port_sock.c
+ * @brief Implementación de funciones de test del port sobre el socket
+ *        del servicio de displays simulados
+ */
+
+/*
+    Requerimientos a probar:
+    1- El driver sobre el port del socket debe dibujar en el display elegido del servicio,
+       y el tick debe seguir el tiempo simulado de ese display
+    2- Una escritura o lectura a una dirección sin display debe fallar y contarse en las
+       estadísticas, y un display que no existe debe rechazar los pedidos
+    3- Las transmisiones por interrupciones y por DMA circular deben llegar completas al
+       display y terminar con el callback de fin
+    4- Varios clientes conectados al mismo tiempo a distintos displays deben ver cada uno
+       sólo su display, con estadísticas separadas
+    5- La latencia inyectada debe demorar cada pedido en tiempo real, y con escala 100 las
+       esperas simuladas deben durar lo mismo en tiempo real
+*/
+
+#define _POSIX_C_SOURCE 200809L // sockets y clock_gettime
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "unity.h"
+
+/**
+ * @brief Include del módulo que va a ser probado.
+ */
+#include "API_lcd_port_sock.h"
+
+/**
+ * @brief Includes del driver que corre sobre el port.
+ */
+#include "API_lcd.h"
+#include "API_lcd_buffer.h"
+#include "API_lcd_cmd.h"
+#include "API_lcd_pool.h"
+#include "API_lcd_profile.h"
+#include "API_lcd_queue.h"
+#include "API_lcd_stream.h"
+
+/**
+ * @brief Include del servicio de displays simulados.
+ */
+#include "sim_server.h"
+
+#define RUTA_PRUEBA "/tmp/test_API_lcd_port_sock.sock"
+#define PANTALLAS   4
+
+// textos que escribe cada hilo en su display, y cuántas veces
+#define CLIENTES   3
+#define REPETICION 50
+
+// tramas que ocupa un byte en 4 bits detrás del PCF8574
+#define TRAMAS_X_BYTE 4
+
+static SIM_ServidorTypedef servidor;
+static SIM_ServidorConfigTypedef config;
+
+/**
+ * @brief Levanta el servicio con cuatro displays y conecta el port al primero.
+ */
+void setUp(void) {
+    sim_serverDefaults(&config);
+    config.ruta = RUTA_PRUEBA;
+    config.pantallas = PANTALLAS;
+    TEST_ASSERT_TRUE(sim_serverStart(&servidor, &config));
+
+    port_sockConfig(RUTA_PRUEBA, 0);
+    port_setAddress(LCD_ADDRESS);
+}
+
+/**
+ * @brief Desconecta el port y detiene el servicio.
+ */
+void tearDown(void) {
+    port_sockClose();
+    sim_serverStop(&servidor);
+}
+
+/**
+ * @brief Tiempo real en microsegundos.
+ */
+static uint64_t ahoraUs() {
+    struct timespec ahora;
+    clock_gettime(CLOCK_MONOTONIC, &ahora);
+    return (uint64_t)ahora.tv_sec * 1000000 + ahora.tv_nsec / 1000;
+}
+
+/**
+ * @brief Conexión propia de un cliente, sin pasar por el port.
+ */
+static int conectar() {
+    struct sockaddr_un direccion;
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    memset(&direccion, 0, sizeof(direccion));
+    direccion.sun_family = AF_UNIX;
+    strcpy(direccion.sun_path, RUTA_PRUEBA);
+    if (fd >= 0 && connect(fd, (struct sockaddr *)&direccion, sizeof(direccion)) != 0) {
+        close(fd);
+        fd = -1;
+    }
+    return fd;
+}
+
+/**
+ * @brief Envía una escritura a un display y espera la respuesta.
+ *
+ * @return resultado del pedido
+ */
+static uint8_t escribir(int fd, uint8_t pantalla, const uint8_t * tramas, uint16_t cantidad) {
+    uint8_t mensaje[sizeof(SOCK_EncabezadoTypedef) + 1 + TRAMAS_X_BYTE];
+    SOCK_EncabezadoTypedef encabezado = {SOCK_OP_ESCRIBIR, pantalla, cantidad + 1};
+
+    memcpy(mensaje, &encabezado, sizeof(encabezado));
+    mensaje[sizeof(encabezado)] = LCD_ADDRESS;
+    memcpy(&mensaje[sizeof(encabezado) + 1], tramas, cantidad);
+
+    if (send(fd, mensaje, sizeof(encabezado) + 1 + cantidad, MSG_NOSIGNAL) < 0 ||
+        recv(fd, &encabezado, sizeof(encabezado), MSG_WAITALL) != sizeof(encabezado))
+        return SOCK_RESPUESTA_ERROR;
+    return encabezado.operacion;
+}
+
+/**
+ * @brief Arma las tramas de un byte en 4 bits, como el driver.
+ */
+static void armarByte(uint8_t * tramas, uint8_t valor, uint8_t rs) {
+    uint8_t fijo = (1 << POS_BACKLIGHT) | rs;
+
+    tramas[0] = (valor & 0xF0) | fijo | ENABLE;
+    tramas[1] = (valor & 0xF0) | fijo;
+    tramas[2] = (valor << 4) | fijo | ENABLE;
+    tramas[3] = (valor << 4) | fijo;
+}
+
+/**
+ * @brief Hilo de un cliente: pasa su display a 4 bits y escribe
+ * REPETICION veces su número al principio de la primera fila.
+ */
+static void * escribirPantalla(void * argumento) {
+    uint8_t pantalla = (uint8_t)(uintptr_t)argumento;
+    uint8_t tramas[TRAMAS_X_BYTE];
+    int fd = conectar();
+    uintptr_t errores = 0;
+
+    // FUNCTION SET de 4 bits con un solo flanco, todavía en 8 bits
+    tramas[0] = 0x20 | (1 << POS_BACKLIGHT) | ENABLE;
+    tramas[1] = 0x20 | (1 << POS_BACKLIGHT);
+    errores += escribir(fd, pantalla, tramas, 2) != SOCK_RESPUESTA_OK;
+
+    for (uint8_t vez = 0; vez < REPETICION; vez++) {
+        armarByte(tramas, SET_CURSOR, COMMAND);
+        errores += escribir(fd, pantalla, tramas, TRAMAS_X_BYTE) != SOCK_RESPUESTA_OK;
+        armarByte(tramas, '0' + pantalla, DATA);
+        errores += escribir(fd, pantalla, tramas, TRAMAS_X_BYTE) != SOCK_RESPUESTA_OK;
+    }
+
+    close(fd);
+    return (void *)errores;
+}
+
+/**
+ * @brief Test para verificar el dibujo a través del servicio,
+ * según el requerimiento 1.
+ */
+void test_driver_sobre_el_socket() {
+    char linea[SOCK_MAX_COLUMNAS + 1];
+    SOCK_EstadisticasTypedef estadisticas;
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_init());
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_printText("Hola"));
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_printAt(LCD_FILA_2, 3, "mundo"));
+
+    TEST_ASSERT_TRUE(port_sockGetLine(0, linea));
+    TEST_ASSERT_EQUAL_STRING("Hola            ", linea);
+    TEST_ASSERT_TRUE(port_sockGetLine(1, linea));
+    TEST_ASSERT_EQUAL_STRING("   mundo        ", linea);
+    TEST_ASSERT_FALSE(port_sockGetLine(2, linea));
+
+    TEST_ASSERT_TRUE(port_sockGetStats(&estadisticas));
+    TEST_ASSERT_EQUAL(1, estadisticas.clientes);
+    TEST_ASSERT_EQUAL(0, estadisticas.violaciones);
+    TEST_ASSERT_GREATER_THAN(0, estadisticas.tiempoEsperaUs);
+    TEST_ASSERT_EQUAL((estadisticas.tiempoBusUs + estadisticas.tiempoEsperaUs) / 1000,
+                      port_getTick());
+
+    // el resto de los displays no recibió nada
+    TEST_ASSERT_TRUE(sim_serverGetStats(&servidor, 1, &estadisticas));
+    TEST_ASSERT_EQUAL(0, estadisticas.pedidos);
+}
+
+/**
+ * @brief Test para verificar los errores de dirección y de display,
+ * según el requerimiento 2.
+ */
+void test_nack_y_display_inexistente() {
+    SOCK_EstadisticasTypedef estadisticas;
+    uint8_t dato;
+
+    TEST_ASSERT_TRUE(port_init());
+    port_setAddress(0x20);
+    TEST_ASSERT_FALSE(port_i2cWriteByte(1 << POS_BACKLIGHT));
+    TEST_ASSERT_FALSE(port_i2cReadByte(&dato));
+
+    port_setAddress(LCD_ADDRESS);
+    TEST_ASSERT_TRUE(port_i2cWriteByte(1 << POS_BACKLIGHT));
+
+    // el pedido de las estadísticas también se cuenta
+    TEST_ASSERT_TRUE(port_sockGetStats(&estadisticas));
+    TEST_ASSERT_EQUAL(4, estadisticas.pedidos);
+    TEST_ASSERT_EQUAL(2, estadisticas.nacks);
+
+    port_sockConfig(RUTA_PRUEBA, PANTALLAS);
+    TEST_ASSERT_FALSE(port_i2cWriteByte(1 << POS_BACKLIGHT));
+    TEST_ASSERT_FALSE(port_sockGetStats(&estadisticas));
+    TEST_ASSERT_EQUAL(0, port_getTick());
+}
+
+/**
+ * @brief Test para verificar las transmisiones en segundo plano,
+ * según el requerimiento 3.
+ */
+void test_transmisiones_en_segundo_plano() {
+    static LCD_BufferTypedef sombra;
+    uint8_t tramasDma[2 * LCD_TRAMAS_X_MENSAJE];
+    char linea[SOCK_MAX_COLUMNAS + 1];
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_init());
+    LCD_bufferInit(&sombra, 2, 16);
+
+    LCD_bufferWrite(&sombra, 0, 0, 'I');
+    LCD_bufferWrite(&sombra, 0, 1, 'T');
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_streamFlush(&sombra));
+    TEST_ASSERT_FALSE(LCD_streamBusy());
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_streamResult());
+
+    LCD_bufferWrite(&sombra, 1, 10, 'D');
+    LCD_bufferWrite(&sombra, 1, 11, 'M');
+    LCD_bufferWrite(&sombra, 1, 12, 'A');
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_streamFlushDma(&sombra, tramasDma, sizeof(tramasDma)));
+    TEST_ASSERT_FALSE(LCD_streamBusy());
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_streamResult());
+    TEST_ASSERT_FALSE(LCD_bufferIsDirty(&sombra));
+
+    TEST_ASSERT_TRUE(port_sockGetLine(0, linea));
+    TEST_ASSERT_EQUAL_STRING("IT              ", linea);
+    TEST_ASSERT_TRUE(port_sockGetLine(1, linea));
+    TEST_ASSERT_EQUAL_STRING("          DMA   ", linea);
+}
+
+/**
+ * @brief Test para verificar clientes simultáneos en distintos displays,
+ * según el requerimiento 4.
+ */
+void test_clientes_simultaneos() {
+    pthread_t hilos[CLIENTES];
+    SOCK_EstadisticasTypedef estadisticas;
+    char linea[SIM_MAX_COLUMNAS + 1];
+    void * errores;
+
+    for (uintptr_t indice = 0; indice < CLIENTES; indice++)
+        pthread_create(&hilos[indice], NULL, escribirPantalla, (void *)(indice + 1));
+
+    // mientras tanto el driver dibuja en el display 0
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_init());
+    for (uint8_t vez = 0; vez < REPETICION; vez++) {
+        TEST_ASSERT_EQUAL(LCD_OK, LCD_setCursor(LCD_FILA_1, 0));
+        TEST_ASSERT_EQUAL(LCD_OK, LCD_printChar('0'));
+    }
+
+    for (uint8_t indice = 0; indice < CLIENTES; indice++) {
+        pthread_join(hilos[indice], &errores);
+        TEST_ASSERT_EQUAL(0, (uintptr_t)errores);
+    }
+
+    for (uint8_t pantalla = 0; pantalla < PANTALLAS; pantalla++) {
+        char esperado[] = "0               ";
+        esperado[0] += pantalla;
+
+        TEST_ASSERT_TRUE(sim_serverGetStats(&servidor, pantalla, &estadisticas));
+        if (pantalla > CLIENTES) {
+            TEST_ASSERT_EQUAL(0, estadisticas.clientes);
+            continue;
+        }
+
+        sim_serverGetLine(&servidor, pantalla, 0, linea);
+        TEST_ASSERT_EQUAL_STRING(esperado, linea);
+        TEST_ASSERT_EQUAL(1, estadisticas.clientes);
+        TEST_ASSERT_EQUAL(0, estadisticas.violaciones);
+        if (pantalla > 0) {
+            TEST_ASSERT_EQUAL(1 + 2 * REPETICION, estadisticas.pedidos);
+            TEST_ASSERT_EQUAL(2 + 2 * REPETICION * TRAMAS_X_BYTE, estadisticas.bytesI2C);
+        }
+    }
+}
+
+/**
+ * @brief Test para verificar la latencia inyectada,
+ * según el requerimiento 5.
+ */
+void test_latencia_inyectada() {
+    sim_serverStop(&servidor);
+    config.latenciaUs = 2000;
+    TEST_ASSERT_TRUE(sim_serverStart(&servidor, &config));
+
+    TEST_ASSERT_TRUE(port_init());
+    uint64_t inicio = ahoraUs();
+    for (uint8_t pedido = 0; pedido < 10; pedido++)
+        port_getTick();
+    TEST_ASSERT_GREATER_OR_EQUAL(10 * 2000, ahoraUs() - inicio);
+
+    port_sockClose();
+    sim_serverStop(&servidor);
+    config.latenciaUs = 0;
+    config.escalaTiempo = 100;
+    TEST_ASSERT_TRUE(sim_serverStart(&servidor, &config));
+
+    inicio = ahoraUs();
+    port_delay(30);
+    TEST_ASSERT_GREATER_OR_EQUAL(30000, ahoraUs() - inicio);
+    TEST_ASSERT_EQUAL(30, port_getTick());
+}
@@ -0,0 +1,478 @@
+/**
+ * @file test_API_lcd_queue.c
+ * @brief Implementación de funciones de test de la cola de pedidos del LCD
+ */
+
+/*
+    Requerimientos a probar:
+    1- Un pedido encolado no se debe enviar hasta procesar la cola
+    2- Los pedidos se deben enviar en el orden en que se encolaron
+    3- Con la cola llena se debe rechazar el pedido de inmediato
+    4- Con el pool agotado se debe rechazar el pedido de inmediato
+    5- Al procesar un pedido se debe liberar su memoria
+    6- Las estadísticas se deben poder leer con LCD_getStats
+    7- Con sobrecarga sostenida, cada política debe comportarse como se define:
+       descartar nuevo, descartar viejo, bloquear con espera acotada y coalescer
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "unity.h"
+
+/**
+ * @brief Include del módulo que va a ser probado.
+ */
+#include "API_lcd_queue.h"
+
+/**
+ * @brief Includes de los módulos utilizados por la cola.
+ */
+#include "API_lcd.h"
+#include "API_lcd_buffer.h"
+#include "API_lcd_pool.h"
+#include "API_lcd_profile.h"
+
+/**
+ * @brief Include de un mock para las funciones que acceden al hardware.
+ */
+#include "mock_API_lcd_port.h"
+
+/**
+ * @brief Include del simulador de LCD para las pruebas de sobrecarga.
+ */
+#include "sim_lcd.h"
+
+/**
+ * @brief Constantes utilizadas para controlar el LCD. Obtenidas del archivo API_lcd.c
+ */
+#define COMMAND       0
+#define DATA          1
+#define ENABLE        (1 << 2)
+#define POS_BACKLIGHT (3)
+#define SET_CURSOR    (1 << 7)
+
+/**
+ * @brief Parámetros de las pruebas de sobrecarga: cantidad de actualizaciones
+ * y cuántas produce la aplicación por cada pedido que se envía al LCD.
+ */
+#define ACTUALIZACIONES          60
+#define ACTUALIZACIONES_X_ENVIO  4
+
+/**
+ * @brief Función que simula el comportamiento de la función privada LCD_sendMsg
+ *
+ * @param dato dato que se quiere envíar
+ * @param rs Indicador de COMMAND o DATA
+ */
+static void LCD_sendMsg_ExpectAndReturn(uint8_t dato, uint8_t rs) {
+    uint8_t alto = rs | (1 << POS_BACKLIGHT) | (dato & 0xF0);
+    uint8_t bajo = rs | (1 << POS_BACKLIGHT) | (dato & 0x0F) << 4;
+    port_i2cWriteByte_ExpectAndReturn(alto | ENABLE, true);
+    port_i2cWriteByte_ExpectAndReturn(alto, true);
+    port_i2cWriteByte_ExpectAndReturn(bajo | ENABLE, true);
+    port_i2cWriteByte_ExpectAndReturn(bajo, true);
+}
+
+/**
+ * @brief Inicializa la cola antes de cada test.
+ */
+void setUp(void) {
+    port_delay_Ignore();
+    LCD_queueSetPolicy(LCD_COLA_DESCARTAR_NUEVO, LCD_COLA_ESPERA_MAXIMA);
+    LCD_queueInit();
+}
+
+/**
+ * @brief Reemplaza las funciones del port por el simulador de LCD.
+ */
+static void usarSimulador(void) {
+    sim_init(&sim_lcd);
+    sim_lcd.modo4Bits = true;
+    port_i2cWriteByte_StubWithCallback(sim_port_i2cWriteByte);
+    port_delay_StubWithCallback(sim_port_delay);
+    port_getTick_StubWithCallback(sim_port_getTick);
+}
+
+/**
+ * @brief Simula una aplicación que actualiza un contador en la fila 2 más
+ * rápido de lo que el LCD puede mostrarlo.
+ *
+ * @param ultimoAceptado último valor que la cola aceptó
+ * @return cantidad de actualizaciones aceptadas
+ */
+static uint16_t producirSobrecarga(uint16_t * ultimoAceptado) {
+    char texto[LCD_CANTIDAD_COLUMNAS + 1];
+    uint16_t aceptadas = 0;
+
+    for (uint16_t valor = 1; valor <= ACTUALIZACIONES; valor++) {
+        snprintf(texto, sizeof(texto), "Valor: %5u", valor);
+        if (LCD_queuePrintAt(LCD_FILA_2, 0, texto) == LCD_OK) {
+            aceptadas++;
+            *ultimoAceptado = valor;
+        }
+        if (valor % ACTUALIZACIONES_X_ENVIO == 0)
+            LCD_queueProcess();
+    }
+
+    while (LCD_queuePending() > 0)
+        LCD_queueProcess();
+
+    return aceptadas;
+}
+
+/**
+ * @brief Test para verificar que encolar no accede al hardware,
+ * según el requerimiento 1.
+ */
+void test_encolar_no_envia() {
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_queuePrintChar('a'));
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_queueSetCursor(LCD_FILA_2, 0));
+    TEST_ASSERT_EQUAL(2, LCD_queuePending());
+}
+
+/**
+ * @brief Test para verificar el orden de envío de los pedidos,
+ * según el requerimiento 2.
+ */
+void test_envio_en_orden() {
+    LCD_queueSetCursor(LCD_FILA_2, 0);
+    LCD_queuePrintChar('x');
+
+    LCD_sendMsg_ExpectAndReturn(SET_CURSOR | LCD_FILA_2, COMMAND);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_queueProcess());
+
+    LCD_sendMsg_ExpectAndReturn('x', DATA);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_queueProcess());
+
+    TEST_ASSERT_EQUAL(0, LCD_queuePending());
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_queueProcess());
+}
+
+/**
+ * @brief Test para verificar el rechazo con la cola llena,
+ * según el requerimiento 3.
+ */
+void test_cola_llena_rechaza() {
+    for (uint8_t indice = 0; indice < LCD_COLA_CAPACIDAD; indice++)
+        TEST_ASSERT_EQUAL(LCD_OK, LCD_queuePrintChar('a'));
+
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_queuePrintChar('b'));
+    TEST_ASSERT_EQUAL(LCD_COLA_CAPACIDAD, LCD_queuePending());
+}
+
+/**
+ * @brief Test para verificar el rechazo con el pool agotado,
+ * según el requerimiento 4.
+ */
+void test_pool_agotado_rechaza() {
+    LCD_PoolStatsTypedef stats;
+
+    for (uint8_t indice = 0; indice < LCD_POOL_BLOQUES_CLASE_2; indice++)
+        TEST_ASSERT_EQUAL(LCD_OK, LCD_queuePrintText("Texto largo que ocupa un bloque"));
+
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_queuePrintText("Texto largo que ocupa un bloque"));
+
+    LCD_poolGetStats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.fallos);
+}
+
+/**
+ * @brief Test para verificar que se libera la memoria del pedido,
+ * según el requerimiento 5.
+ */
+void test_procesar_libera_memoria() {
+    LCD_PoolStatsTypedef stats;
+
+    LCD_queuePrintChar('a');
+    LCD_poolGetStats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.enUso[0]);
+
+    port_i2cWriteByte_IgnoreAndReturn(true);
+    LCD_queueProcess();
+
+    LCD_poolGetStats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.enUso[0]);
+    TEST_ASSERT_EQUAL(1, stats.maximoUso[0]);
+}
+
+/**
+ * @brief Test para verificar las estadísticas del driver,
+ * según el requerimiento 6.
+ */
+void test_estadisticas_del_driver() {
+    LCD_StatsTypedef stats;
+    const uint8_t patron[LCD_ALTO_CARACTER] = {0};
+
+    for (uint8_t indice = 0; indice < LCD_COLA_CAPACIDAD + 2; indice++)
+        LCD_queueCreateChar(0, patron);
+
+    port_i2cWriteByte_IgnoreAndReturn(true);
+    LCD_queueProcess();
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_getStats(&stats));
+    TEST_ASSERT_EQUAL(LCD_COLA_CAPACIDAD, stats.cola.encolados);
+    TEST_ASSERT_EQUAL(2, stats.cola.descartados);
+    TEST_ASSERT_EQUAL(1, stats.cola.procesados);
+    TEST_ASSERT_EQUAL(LCD_COLA_CAPACIDAD - 1, stats.cola.pendientes);
+    TEST_ASSERT_EQUAL(LCD_COLA_CAPACIDAD, stats.cola.maximoPendientes);
+    TEST_ASSERT_EQUAL(LCD_COLA_CAPACIDAD, stats.pool.maximoUso[1]);
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_getStats(NULL));
+}
+
+/**
+ * @brief Test de sobrecarga con la política de descartar el pedido nuevo,
+ * según el requerimiento 7.
+ */
+void test_sobrecarga_descartar_nuevo() {
+    LCD_ColaStatsTypedef stats;
+    char linea[SIM_MAX_COLUMNAS + 1];
+    uint16_t ultimo = 0;
+
+    usarSimulador();
+    uint16_t aceptadas = producirSobrecarga(&ultimo);
+
+    LCD_queueGetStats(&stats);
+    TEST_ASSERT_EQUAL(ACTUALIZACIONES - aceptadas, stats.descartados);
+    TEST_ASSERT_GREATER_THAN(0, stats.descartados);
+    TEST_ASSERT_EQUAL(aceptadas, stats.procesados);
+    TEST_ASSERT_TRUE(ultimo < ACTUALIZACIONES);
+
+    sim_getLine(&sim_lcd, 1, linea);
+    TEST_ASSERT_EQUAL_STRING_LEN("Valor:", linea, 6);
+}
+
+/**
+ * @brief Test de sobrecarga con la política de descartar los pedidos viejos,
+ * según el requerimiento 7.
+ */
+void test_sobrecarga_descartar_viejo() {
+    LCD_ColaStatsTypedef stats;
+    char linea[SIM_MAX_COLUMNAS + 1];
+    uint16_t ultimo = 0;
+
+    usarSimulador();
+    LCD_queueSetPolicy(LCD_COLA_DESCARTAR_VIEJO, 0);
+    uint16_t aceptadas = producirSobrecarga(&ultimo);
+
+    LCD_queueGetStats(&stats);
+    TEST_ASSERT_EQUAL(ACTUALIZACIONES, aceptadas);
+    TEST_ASSERT_EQUAL(0, stats.descartados);
+    TEST_ASSERT_GREATER_THAN(0, stats.descartadosViejos);
+    TEST_ASSERT_EQUAL(ACTUALIZACIONES, stats.procesados + stats.descartadosViejos);
+
+    sim_getLine(&sim_lcd, 1, linea);
+    TEST_ASSERT_EQUAL_STRING("Valor:    60    ", linea);
+}
+
+/**
+ * @brief Test de sobrecarga con la política de bloquear al llamador,
+ * según el requerimiento 7.
+ */
+void test_sobrecarga_bloquear() {
+    LCD_ColaStatsTypedef stats;
+    char linea[SIM_MAX_COLUMNAS + 1];
+    uint16_t ultimo = 0;
+
+    usarSimulador();
+    LCD_queueSetPolicy(LCD_COLA_BLOQUEAR, 100);
+    uint16_t aceptadas = producirSobrecarga(&ultimo);
+
+    LCD_queueGetStats(&stats);
+    TEST_ASSERT_EQUAL(ACTUALIZACIONES, aceptadas);
+    TEST_ASSERT_EQUAL(ACTUALIZACIONES, stats.procesados);
+    TEST_ASSERT_EQUAL(0, stats.descartados);
+    TEST_ASSERT_GREATER_THAN(0, stats.bloqueos);
+    TEST_ASSERT_EQUAL(0, stats.bloqueosVencidos);
+    TEST_ASSERT_LESS_OR_EQUAL(100, stats.esperaMaxima);
+
+    sim_getLine(&sim_lcd, 1, linea);
+    TEST_ASSERT_EQUAL_STRING("Valor:    60    ", linea);
+}
+
+/**
+ * @brief Test para verificar que la espera de la política de bloqueo está acotada,
+ * según el requerimiento 7.
+ */
+void test_bloquear_espera_acotada() {
+    LCD_ColaStatsTypedef stats;
+
+    usarSimulador();
+    LCD_queueSetPolicy(LCD_COLA_BLOQUEAR, 1);
+
+    LCD_queuePrintChar('a');
+    LCD_queuePrintChar('b');
+    for (uint8_t indice = 0; indice < LCD_POOL_BLOQUES_CLASE_2; indice++)
+        LCD_queuePrintText("Texto largo que ocupa un bloque");
+
+    // procesar los caracteres no libera bloques de la clase que hace falta
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_queuePrintText("Texto largo que ocupa un bloque"));
+
+    LCD_queueGetStats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.bloqueos);
+    TEST_ASSERT_EQUAL(1, stats.bloqueosVencidos);
+    TEST_ASSERT_EQUAL(1, stats.descartados);
+}
+
+/**
+ * @brief Test para verificar que la política de bloqueo no empieza un envío que
+ * terminaría después del plazo, según el requerimiento 7.
+ */
+void test_bloquear_no_excede_el_plazo() {
+    LCD_ColaStatsTypedef stats;
+
+    usarSimulador();
+    LCD_queueSetPolicy(LCD_COLA_BLOQUEAR, 20);
+
+    // 35 mensajes de 2 ms adelante de la cola llena
+    LCD_queuePrintText("Texto largo que ocupa la pantall");
+    for (uint8_t indice = 1; indice < LCD_COLA_CAPACIDAD; indice++)
+        LCD_queuePrintChar('a');
+
+    uint32_t inicio = sim_lcd.tiempoUs;
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_queuePrintChar('b'));
+    TEST_ASSERT_EQUAL(inicio, sim_lcd.tiempoUs);
+    TEST_ASSERT_EQUAL(LCD_COLA_CAPACIDAD, LCD_queuePending());
+
+    // con un plazo que alcanza se envía el texto y se hace lugar
+    LCD_queueSetPolicy(LCD_COLA_BLOQUEAR, 100);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_queuePrintChar('b'));
+
+    LCD_queueGetStats(&stats);
+    TEST_ASSERT_EQUAL(2, stats.bloqueos);
+    TEST_ASSERT_EQUAL(1, stats.bloqueosVencidos);
+    TEST_ASSERT_EQUAL(1, stats.procesados);
+    TEST_ASSERT_LESS_OR_EQUAL(100, stats.esperaMaxima);
+    TEST_ASSERT_GREATER_THAN(20, stats.esperaMaxima);
+}
+
+/**
+ * @brief Test de sobrecarga con la política de coalescer por región,
+ * según el requerimiento 7.
+ */
+void test_sobrecarga_coalescer() {
+    LCD_ColaStatsTypedef stats;
+    char linea[SIM_MAX_COLUMNAS + 1];
+    uint16_t ultimo = 0;
+
+    usarSimulador();
+    LCD_queueSetPolicy(LCD_COLA_COALESCER, 0);
+    uint16_t aceptadas = producirSobrecarga(&ultimo);
+
+    LCD_queueGetStats(&stats);
+    TEST_ASSERT_EQUAL(ACTUALIZACIONES, aceptadas);
+    TEST_ASSERT_EQUAL(0, stats.descartados);
+    TEST_ASSERT_EQUAL(1, stats.maximoPendientes);
+    TEST_ASSERT_EQUAL(ACTUALIZACIONES, stats.procesados + stats.coalescidos);
+
+    sim_getLine(&sim_lcd, 1, linea);
+    TEST_ASSERT_EQUAL_STRING("Valor:    60    ", linea);
+}
+
+/**
+ * @brief Test para verificar que no se coalesce si un pedido posterior
+ * escribe sobre la misma región, según el requerimiento 7.
+ */
+void test_coalescer_respeta_superposicion() {
+    LCD_ColaStatsTypedef stats;
+
+    LCD_queueSetPolicy(LCD_COLA_COALESCER, 0);
+    LCD_queuePrintAt(LCD_FILA_1, 0, "AAAA");
+    LCD_queuePrintAt(LCD_FILA_1, 2, "BB");
+    LCD_queuePrintAt(LCD_FILA_2, 0, "CCCC");
+    LCD_queuePrintAt(LCD_FILA_1, 0, "DDDD");
+    LCD_queuePrintAt(LCD_FILA_2, 0, "EEEE");
+
+    LCD_queueGetStats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.coalescidos);
+    TEST_ASSERT_EQUAL(4, LCD_queuePending());
+}
+
+/**
+ * @brief Test para verificar que no se coalesce por delante de un movimiento
+ * del cursor ni de un caracter suelto, según el requerimiento 7.
+ */
+void test_coalescer_respeta_cursor() {
+    LCD_ColaStatsTypedef stats;
+    char linea[SIM_MAX_COLUMNAS + 1];
+
+    usarSimulador();
+    LCD_queueSetPolicy(LCD_COLA_COALESCER, 0);
+    LCD_queuePrintAt(LCD_FILA_1, 0, "ab");
+    LCD_queueSetCursor(LCD_FILA_2, 5);
+    LCD_queuePrintAt(LCD_FILA_1, 0, "cd"); // deja el cursor en (0, 2)
+    LCD_queuePrintChar('x');
+    LCD_queuePrintAt(LCD_FILA_1, 0, "ef");
+
+    LCD_queueGetStats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.coalescidos);
+    TEST_ASSERT_EQUAL(5, LCD_queuePending());
+
+    while (LCD_queuePending() > 0)
+        LCD_queueProcess();
+
+    sim_getLine(&sim_lcd, 0, linea);
+    TEST_ASSERT_EQUAL_STRING("efx             ", linea);
+    sim_getLine(&sim_lcd, 1, linea);
+    TEST_ASSERT_EQUAL_STRING("                ", linea);
+}
+
+/**
+ * @brief Test para verificar que no se coalesce una región por delante de una
+ * carga de la CGRAM, que deja el cursor en (0, 0), según el requerimiento 7.
+ */
+void test_coalescer_respeta_cgram() {
+    static const uint8_t patron[LCD_ALTO_CARACTER] = {1, 2, 3, 4, 5, 6, 7, 8};
+    LCD_ColaStatsTypedef stats;
+    char linea[SIM_MAX_COLUMNAS + 1];
+
+    usarSimulador();
+    LCD_queueSetPolicy(LCD_COLA_COALESCER, 0);
+    LCD_queuePrintAt(LCD_FILA_2, 0, "AB");
+    LCD_queueCreateChar(0, patron);
+    LCD_queuePrintAt(LCD_FILA_2, 0, "CD"); // deja el cursor en (1, 2)
+    LCD_queuePrintChar('x');
+
+    LCD_queueGetStats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.coalescidos);
+    TEST_ASSERT_EQUAL(4, LCD_queuePending());
+
+    while (LCD_queuePending() > 0)
+        LCD_queueProcess();
+
+    sim_getLine(&sim_lcd, 1, linea);
+    TEST_ASSERT_EQUAL_STRING("CDx             ", linea);
+}
+
+/**
+ * @brief Test para verificar que una carga de la CGRAM no se coalesce por
+ * delante de un movimiento del cursor, según el requerimiento 7.
+ */
+void test_coalescer_cgram_respeta_cursor() {
+    static const uint8_t viejo[LCD_ALTO_CARACTER] = {1, 2, 3, 4, 5, 6, 7, 8};
+    static const uint8_t nuevo[LCD_ALTO_CARACTER] = {8, 7, 6, 5, 4, 3, 2, 1};
+    LCD_ColaStatsTypedef stats;
+    char linea[SIM_MAX_COLUMNAS + 1];
+
+    usarSimulador();
+    LCD_queueSetPolicy(LCD_COLA_COALESCER, 0);
+    LCD_queueCreateChar(0, viejo);
+    LCD_queueCreateChar(0, nuevo); // sin nada en el medio se combina
+    LCD_queueSetCursor(LCD_FILA_2, 5);
+    LCD_queueCreateChar(0, viejo); // deja el cursor en (0, 0)
+    LCD_queuePrintChar('y');
+
+    LCD_queueGetStats(&stats);
+    TEST_ASSERT_EQUAL(1, stats.coalescidos);
+    TEST_ASSERT_EQUAL(4, LCD_queuePending());
+
+    while (LCD_queuePending() > 0)
+        LCD_queueProcess();
+
+    TEST_ASSERT_EQUAL_MEMORY(viejo, sim_lcd.cgram, LCD_ALTO_CARACTER);
+    sim_getLine(&sim_lcd, 0, linea);
+    TEST_ASSERT_EQUAL_STRING("y               ", linea);
+    sim_getLine(&sim_lcd, 1, linea);
+    TEST_ASSERT_EQUAL_STRING("                ", linea);
+}
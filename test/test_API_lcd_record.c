@@ -0,0 +1,342 @@
+/**
+ * @file test_API_lcd_record.c
+ * @brief Implementación de funciones de test del registro de llamadas y del
+ *        banco de reproducción en el host
+ */
+
+/*
+    Requerimientos a probar:
+    1- Cada llamada de la aplicación se debe grabar con el tiempo desde la anterior y
+       sus argumentos en un formato compacto, sin grabar las que el driver hace dentro
+       de otra, las que se hacen sin una grabación en curso ni las que reciben un
+       texto NULL
+    2- Si el buffer se llena se deben contar las llamadas perdidas y el registro debe
+       seguir siendo válido
+    3- Se deben poder leer las llamadas de un registro y reproducirlas, obteniendo la
+       misma pantalla
+    4- Se debe poder reproducir un registro con distintas configuraciones del driver
+       (bloqueante, por lotes, con diff y asíncrona, a 100 y 400 kHz) e informar el
+       tiempo de bus, los percentiles de latencia y los cuadros perdidos
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "unity.h"
+
+/**
+ * @brief Include del módulo que va a ser probado.
+ */
+#include "API_lcd_record.h"
+
+/**
+ * @brief Includes de los módulos utilizados en la reproducción.
+ */
+#include "API_lcd.h"
+#include "API_lcd_buffer.h"
+#include "API_lcd_pool.h"
+#include "API_lcd_profile.h"
+#include "API_lcd_queue.h"
+#include "API_lcd_stream.h"
+
+/**
+ * @brief Include de un mock para las funciones que acceden al hardware.
+ */
+#include "mock_API_lcd_port.h"
+
+/**
+ * @brief Include del simulador de LCD y del banco de reproducción.
+ */
+#include "sim_lcd.h"
+#include "sim_replay.h"
+
+// tamaño del registro de las pruebas
+#define TAMANIO_REGISTRO 4096
+
+// tamaño máximo del flujo de un envío por interrupciones
+#define MAX_TRAMAS 1024
+
+// filas completas que se dibujan en la ráfaga
+#define RAFAGA_FILAS 20
+
+static uint8_t registro[TAMANIO_REGISTRO];
+static uint32_t largoRegistro;
+
+/**
+ * @brief Callbacks que recibió el port en el último envío.
+ */
+static port_TramaCallbackTypedef tramaSiguiente;
+static port_FinCallbackTypedef finTransmision;
+
+/**
+ * @brief Reemplaza a port_i2cStreamStart guardando los callbacks.
+ */
+static bool_t capturarEnvio(port_TramaCallbackTypedef trama, port_FinCallbackTypedef fin,
+                            int llamadas) {
+    tramaSiguiente = trama;
+    finTransmision = fin;
+    return true;
+}
+
+/**
+ * @brief Hace el trabajo de la ISR: pasa todas las tramas al simulador
+ * en una única transacción.
+ */
+static void atenderInterrupciones() {
+    static uint8_t flujo[MAX_TRAMAS];
+    uint16_t cantidad = 0;
+
+    while (cantidad < MAX_TRAMAS && tramaSiguiente(&flujo[cantidad]))
+        cantidad++;
+
+    sim_i2cWrite(&sim_lcd, flujo, cantidad);
+    finTransmision(true);
+}
+
+/**
+ * @brief Avanza el tiempo simulado hasta el instante indicado, si no pasó.
+ */
+static void esperarHasta(uint32_t instanteUs) {
+    if (sim_lcd.tiempoUs < instanteUs)
+        sim_lcd.tiempoUs = instanteUs;
+}
+
+/**
+ * @brief Graba una carga como la de una aplicación: un reloj con décimas que
+ * se actualiza cada 100 ms, una medición cada 500 ms y un menú a mitad de la
+ * grabación.
+ */
+static void grabarCarga() {
+    static const uint8_t flecha[LCD_ALTO_CARACTER] = {0x04, 0x0E, 0x1F, 0x04,
+                                                      0x04, 0x04, 0x04, 0x00};
+    char texto[LCD_CANTIDAD_COLUMNAS + 1];
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_recordStart(registro, sizeof(registro)));
+    LCD_init();
+    LCD_createChar(1, flecha);
+
+    for (uint16_t decimas = 0; decimas < 40; decimas++) {
+        esperarHasta(decimas * 100000);
+
+        if (decimas == 20) {
+            LCD_printText("Menu\nOpciones");
+            continue;
+        }
+
+        snprintf(texto, sizeof(texto), "00:00:%02u.%u", decimas / 10, decimas % 10);
+        LCD_printAt(LCD_FILA_1, 0, texto);
+        if (decimas % 5 == 0) {
+            snprintf(texto, sizeof(texto), "T %2u.%u C", 20 + decimas / 8, decimas % 10);
+            LCD_printAt(LCD_FILA_2, 0, texto);
+            LCD_setCursor(LCD_FILA_2, 15);
+            LCD_printChar(1);
+        }
+    }
+
+    largoRegistro = LCD_recordStop();
+    TEST_ASSERT_EQUAL(0, LCD_recordLost());
+}
+
+/**
+ * @brief Graba una ráfaga que cambia una fila completa cada 5 ms.
+ */
+static void grabarRafaga() {
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_recordStart(registro, sizeof(registro)));
+    LCD_init();
+
+    uint32_t inicio = sim_lcd.tiempoUs;
+    for (uint8_t indice = 0; indice < RAFAGA_FILAS; indice++) {
+        esperarHasta(inicio + indice * 5000);
+        LCD_printAt(LCD_FILA_1, 0, (indice % 2) ? "1111111111111111" : "0000000000000000");
+    }
+
+    largoRegistro = LCD_recordStop();
+}
+
+/**
+ * @brief Conecta el port al simulador antes de cada test.
+ */
+void setUp(void) {
+    sim_init(&sim_lcd);
+    port_init_StubWithCallback(sim_port_init);
+    port_i2cWrite_StubWithCallback(sim_port_i2cWrite);
+    port_i2cWriteByte_StubWithCallback(sim_port_i2cWriteByte);
+    port_delay_StubWithCallback(sim_port_delay);
+    port_getTick_StubWithCallback(sim_port_getTick);
+    port_setClockSpeed_StubWithCallback(sim_port_setClockSpeed);
+    port_i2cStreamStart_StubWithCallback(capturarEnvio);
+    LCD_queueInit();
+}
+
+/**
+ * @brief Test para verificar el formato de las llamadas grabadas,
+ * según el requerimiento 1.
+ */
+void test_formato_compacto() {
+    static const uint8_t esperado[] = {
+        'L', 'R', LCD_GRABACION_VERSION,
+        LCD_LLAMADA_SET_ENTRY_MODE, 0, LCD_ENTRADA_INCREMENTO,
+        LCD_LLAMADA_PRINT_AT, 0, LCD_FILA_2, 3, 4, 'H', 'o', 'l', 'a',
+        LCD_LLAMADA_PRINT_CHAR, 0xAC, 0x02, 'x',
+        LCD_LLAMADA_PRINT_TEXT, 100, 2, 'a', 'b'};
+
+    LCD_printChar('-'); // sin grabación en curso
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_recordStart(registro, sizeof(registro)));
+    uint32_t inicio = sim_lcd.tiempoUs;
+    LCD_setEntryMode(LCD_ENTRADA_INCREMENTO); // sin cambio: no usa el bus
+    LCD_printAt(LCD_FILA_2, 3, "Hola");
+    esperarHasta(inicio + 300 * 1000); // 300 ms: dos bytes
+    LCD_printChar('x');
+    esperarHasta(inicio + 400 * 1000); // 100 ms: un byte
+    LCD_printText(NULL);               // la API lo rechaza: no se graba
+    LCD_printAt(LCD_FILA_1, 0, NULL);
+    LCD_printText("ab");               // sus LCD_printChar no se graban
+
+    TEST_ASSERT_EQUAL(sizeof(esperado), LCD_recordStop());
+    TEST_ASSERT_EQUAL_HEX8_ARRAY(esperado, registro, sizeof(esperado));
+
+    LCD_printChar('-');
+    TEST_ASSERT_EQUAL(0, LCD_recordLost());
+}
+
+/**
+ * @brief Test para verificar el registro lleno, según el requerimiento 2.
+ */
+void test_registro_lleno() {
+    LCD_LectorTypedef lector;
+    LCD_RegistroTypedef llamada;
+    uint8_t leidas = 0;
+
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_recordStart(registro, LCD_GRABACION_ENCABEZADO - 1));
+
+    // entran el encabezado y dos LCD_printChar de 3 bytes
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_recordStart(registro, LCD_GRABACION_ENCABEZADO + 7));
+    LCD_printChar('a');
+    LCD_printChar('b');
+    LCD_printAt(LCD_FILA_1, 0, "no entra");
+    LCD_printChar('c');
+    uint32_t largo = LCD_recordStop();
+
+    TEST_ASSERT_EQUAL(2, LCD_recordLost());
+    TEST_ASSERT_EQUAL(LCD_GRABACION_ENCABEZADO + 6, largo);
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_recordOpen(&lector, registro, largo));
+    while (LCD_recordNext(&lector, &llamada))
+        leidas++;
+    TEST_ASSERT_EQUAL(2, leidas);
+
+    // un registro truncado termina sin leer fuera de los datos
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_recordOpen(&lector, registro, largo - 1));
+    TEST_ASSERT_TRUE(LCD_recordNext(&lector, &llamada));
+    TEST_ASSERT_FALSE(LCD_recordNext(&lector, &llamada));
+
+    registro[0] = 'X';
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_recordOpen(&lector, registro, largo));
+}
+
+/**
+ * @brief Test para verificar la lectura y reproducción de un registro,
+ * según el requerimiento 3.
+ */
+void test_lectura_y_reproduccion() {
+    LCD_LectorTypedef lector;
+    LCD_RegistroTypedef llamada;
+    char original[LCD_CANTIDAD_FILAS][SIM_MAX_COLUMNAS + 1];
+    char linea[SIM_MAX_COLUMNAS + 1];
+    uint32_t tickAnterior = 0;
+    uint16_t llamadas = 0;
+
+    grabarCarga();
+    sim_getLine(&sim_lcd, 0, original[0]);
+    sim_getLine(&sim_lcd, 1, original[1]);
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_recordOpen(&lector, registro, largoRegistro));
+    sim_init(&sim_lcd);
+    while (LCD_recordNext(&lector, &llamada)) {
+        TEST_ASSERT_TRUE(llamada.tick >= tickAnterior);
+        tickAnterior = llamada.tick;
+        esperarHasta(llamada.tick * 1000);
+        TEST_ASSERT_EQUAL(LCD_OK, LCD_recordReplay(&llamada));
+        llamadas++;
+    }
+
+    // init, createChar, 39 relojes, 7 mediciones de 3 llamadas y el menú
+    TEST_ASSERT_EQUAL(2 + 39 + 7 * 3 + 1, llamadas);
+    TEST_ASSERT_EQUAL(3900, tickAnterior);
+
+    sim_getLine(&sim_lcd, 0, linea);
+    TEST_ASSERT_EQUAL_STRING(original[0], linea);
+    sim_getLine(&sim_lcd, 1, linea);
+    TEST_ASSERT_EQUAL_STRING(original[1], linea);
+    TEST_ASSERT_EQUAL(0x04, sim_lcd.cgram[LCD_ALTO_CARACTER]);
+    TEST_ASSERT_EQUAL(0x0E, sim_lcd.cgram[LCD_ALTO_CARACTER + 1]);
+}
+
+/**
+ * @brief Test para verificar el banco de reproducción con distintas
+ * configuraciones del driver, según el requerimiento 4.
+ */
+void test_banco_de_reproduccion() {
+    static const uint32_t clocks[] = {100000, 400000};
+    SIM_ReproduccionTypedef config = {.periodoMs = 20, .atender = atenderInterrupciones};
+    SIM_ReporteTypedef reportes[SIM_MODOS][2];
+    char esperado[LCD_CANTIDAD_FILAS][SIM_MAX_COLUMNAS + 1];
+    char linea[SIM_MAX_COLUMNAS + 1];
+
+    grabarCarga();
+    sim_getLine(&sim_lcd, 0, esperado[0]);
+    sim_getLine(&sim_lcd, 1, esperado[1]);
+
+    for (config.modo = 0; config.modo < SIM_MODOS; config.modo++) {
+        for (uint8_t clock = 0; clock < 2; clock++) {
+            SIM_ReporteTypedef * reporte = &reportes[config.modo][clock];
+
+            config.clockI2C = clocks[clock];
+            TEST_ASSERT_TRUE(sim_replay(registro, largoRegistro, &config, reporte));
+
+            sim_getLine(&sim_lcd, 0, linea);
+            TEST_ASSERT_EQUAL_STRING(esperado[0], linea);
+            sim_getLine(&sim_lcd, 1, linea);
+            TEST_ASSERT_EQUAL_STRING(esperado[1], linea);
+            TEST_ASSERT_EQUAL(2 + 39 + 7 * 3 + 1, reporte->llamadas);
+            TEST_ASSERT_TRUE(reporte->latenciaP50Us <= reporte->latenciaP95Us);
+            TEST_ASSERT_TRUE(reporte->latenciaP95Us <= reporte->latenciaP99Us);
+            TEST_ASSERT_TRUE(reporte->latenciaP99Us <= reporte->latenciaMaximaUs);
+        }
+
+        // el mismo tráfico tarda menos en el bus a 400 kHz
+        TEST_ASSERT_EQUAL(reportes[config.modo][0].bytesI2C, reportes[config.modo][1].bytesI2C);
+        TEST_ASSERT_TRUE(reportes[config.modo][1].tiempoBusUs <
+                         reportes[config.modo][0].tiempoBusUs);
+    }
+
+    // el diff sólo envía las celdas que cambiaron
+    TEST_ASSERT_TRUE(reportes[SIM_MODO_DIFF][0].bytesI2C <
+                     reportes[SIM_MODO_BLOQUEANTE][0].bytesI2C);
+    TEST_ASSERT_TRUE(reportes[SIM_MODO_DIFF][0].bytesI2C < reportes[SIM_MODO_LOTES][0].bytesI2C);
+    TEST_ASSERT_EQUAL(0, reportes[SIM_MODO_LOTES][0].cuadrosPerdidos);
+
+    // el envío asíncrono no bloquea a la aplicación
+    TEST_ASSERT_TRUE(reportes[SIM_MODO_ASINCRONO][0].tiempoBloqueadoUs <
+                     reportes[SIM_MODO_DIFF][0].tiempoBloqueadoUs);
+
+    // con una fila completa cada 5 ms el bus de 100 kHz no llega, el de 400 kHz sí
+    SIM_ReporteTypedef rafaga;
+    grabarRafaga();
+    config.modo = SIM_MODO_ASINCRONO;
+    config.periodoMs = 5;
+    config.clockI2C = 100000;
+    TEST_ASSERT_TRUE(sim_replay(registro, largoRegistro, &config, &rafaga));
+    TEST_ASSERT_TRUE(rafaga.cuadrosPerdidos > 0);
+    config.clockI2C = 400000;
+    TEST_ASSERT_TRUE(sim_replay(registro, largoRegistro, &config, &rafaga));
+    TEST_ASSERT_EQUAL(0, rafaga.cuadrosPerdidos);
+    TEST_ASSERT_EQUAL(RAFAGA_FILAS, rafaga.cuadros);
+
+    // un registro inválido no se reproduce
+    registro[0] = 'X';
+    TEST_ASSERT_FALSE(sim_replay(registro, largoRegistro, &config, &rafaga));
+}
@@ -0,0 +1,234 @@
+/**
+ * @file test_API_lcd_shell.c
+ * @brief Implementación de funciones de test de la consola de comandos
+ */
+
+/*
+    Requerimientos a probar:
+    1- Los caracteres recibidos se deben juntar en una línea que se ejecuta al llegar
+       el fin de línea, borrando con backspace y descartando lo que llega mientras la
+       línea espera; un comando desconocido debe informar el error
+    2- Se deben mostrar las estadísticas de la cola y del pool, y el resultado de la
+       medición del port
+    3- Se debe mostrar el buffer de sombra con sus celdas sucias
+    4- Se debe poder consultar y cambiar la velocidad del bus y el período de refresco
+       de la aplicación, rechazando los valores inválidos
+    5- Se deben grabar las llamadas a la API entre "traza on" y "traza off" y mostrar
+       una línea por llamada
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "unity.h"
+
+/**
+ * @brief Include del módulo que va a ser probado.
+ */
+#include "API_lcd_shell.h"
+
+/**
+ * @brief Includes de los módulos utilizados por la consola.
+ */
+#include "API_lcd.h"
+#include "API_lcd_buffer.h"
+#include "API_lcd_pool.h"
+#include "API_lcd_profile.h"
+#include "API_lcd_queue.h"
+#include "API_lcd_record.h"
+
+/**
+ * @brief Includes de mocks para las funciones que acceden al hardware y
+ * para la medición del port, que usa el contador de ciclos del núcleo.
+ */
+#include "mock_API_lcd_bench.h"
+#include "mock_API_lcd_port.h"
+
+/**
+ * @brief Include del simulador de LCD.
+ */
+#include "sim_lcd.h"
+
+#define MAX_LINEAS 16
+
+/**
+ * @brief Líneas que escribió la consola.
+ */
+static char lineas[MAX_LINEAS][LCD_SHELL_MAX_SALIDA];
+static uint8_t cantidadLineas;
+
+/**
+ * @brief Último período que recibió la aplicación.
+ */
+static uint32_t periodoAplicado;
+
+/**
+ * @brief Callback de salida: guarda cada línea.
+ */
+static void guardarLinea(const char * linea) {
+    if (cantidadLineas < MAX_LINEAS)
+        strcpy(lineas[cantidadLineas++], linea);
+}
+
+/**
+ * @brief Callback de refresco: la aplicación acepta de 10 ms a 1 s.
+ */
+static bool_t aplicarRefresco(uint32_t periodo) {
+    if (periodo < 10 || periodo > 1000)
+        return false;
+    periodoAplicado = periodo;
+    return true;
+}
+
+/**
+ * @brief Reemplaza a LCD_benchPort con una medición fija.
+ */
+static LCD_StatusTypedef medir(uint16_t tramas, LCD_BenchTypedef * resultado, int llamadas) {
+    *resultado = (LCD_BenchTypedef){.ciclosPorTrama = 900,
+                                    .ciclosBusPorTrama = 25200,
+                                    .ciclosPorTramaLote = 300,
+                                    .ciclosBusPorTramaLote = 8400};
+    return LCD_OK;
+}
+
+/**
+ * @brief Pasa un texto a la consola caracter por caracter.
+ */
+static void recibir(const char * texto) {
+    while (*texto != '\0')
+        LCD_shellInput(*texto++);
+}
+
+void setUp(void) {
+    sim_init(&sim_lcd);
+    port_init_StubWithCallback(sim_port_init);
+    port_i2cWrite_StubWithCallback(sim_port_i2cWrite);
+    port_i2cWriteByte_StubWithCallback(sim_port_i2cWriteByte);
+    port_delay_StubWithCallback(sim_port_delay);
+    port_getTick_StubWithCallback(sim_port_getTick);
+    port_setClockSpeed_StubWithCallback(sim_port_setClockSpeed);
+    port_getClockSpeed_StubWithCallback(sim_port_getClockSpeed);
+    LCD_queueInit();
+    LCD_shellInit(guardarLinea, aplicarRefresco);
+    cantidadLineas = 0;
+    periodoAplicado = 0;
+}
+
+/**
+ * @brief Test para verificar la recepción de la línea de comando,
+ * según el requerimiento 1.
+ */
+void test_linea_de_comando() {
+    recibir("bux\b\bus");
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_shellProcess());
+    TEST_ASSERT_EQUAL(0, cantidadLineas); // sin fin de línea no se ejecuta
+
+    recibir("\r\nayuda\n"); // el "\n" vacío y lo que sigue se descartan
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_shellProcess());
+    TEST_ASSERT_EQUAL(1, cantidadLineas);
+    TEST_ASSERT_EQUAL_STRING("bus: 100000 Hz\r\n", lineas[0]);
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_shellProcess());
+    TEST_ASSERT_EQUAL(1, cantidadLineas);
+
+    recibir("  \n");
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_shellProcess());
+    TEST_ASSERT_EQUAL(1, cantidadLineas);
+
+    recibir("borrar todo\n");
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_shellProcess());
+    TEST_ASSERT_EQUAL_STRING("comando desconocido: borrar\r\n", lineas[1]);
+}
+
+/**
+ * @brief Test para verificar las estadísticas y la medición del port, según el
+ * requerimiento 2.
+ */
+void test_estadisticas() {
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_init());
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_queuePrintAt(LCD_FILA_1, 0, "Hola"));
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_queuePrintAt(LCD_FILA_2, 0, "mundo"));
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_queueProcess());
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_shellExecute("stats"));
+    TEST_ASSERT_EQUAL(3, cantidadLineas);
+    TEST_ASSERT_EQUAL_STRING(
+        "cola: encolados=2 procesados=1 descartados=0 viejos=0 coalescidos=0\r\n", lineas[0]);
+    TEST_ASSERT_EQUAL_STRING(
+        "cola: bloqueos=0 vencidos=0 espera=0 pendientes=1 maximo=2\r\n", lineas[1]);
+    TEST_ASSERT_EQUAL_STRING("pool: uso=0/1/0 maximo=0/2/0 fallos=0\r\n", lineas[2]);
+
+    LCD_benchPort_StubWithCallback(medir);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_shellExecute("bench 32"));
+    TEST_ASSERT_EQUAL_STRING(
+        "bench: tramas=32 ciclos=900 bus=25200 lote=300 bus=8400 errores=0\r\n", lineas[3]);
+}
+
+/**
+ * @brief Test para verificar el buffer de sombra, según el requerimiento 3.
+ */
+void test_buffer_de_sombra() {
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_initLazy(LCD_INICIO_EN_SEGUNDO_PLANO));
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_printAt(LCD_FILA_2, 3, "Hola"));
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_printAt(LCD_FILA_1, 0, "\x01"));
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_shellExecute("sombra"));
+    TEST_ASSERT_EQUAL(3, cantidadLineas);
+    TEST_ASSERT_EQUAL_STRING("estado: listo=0 entrada=2 energia=0\r\n", lineas[0]);
+    TEST_ASSERT_EQUAL_STRING("0 |?               | *...............\r\n", lineas[1]);
+    TEST_ASSERT_EQUAL_STRING("1 |   Hola         | ...****.........\r\n", lineas[2]);
+}
+
+/**
+ * @brief Test para verificar los cambios de velocidad del bus y de período de
+ * refresco, según el requerimiento 4.
+ */
+void test_bus_y_refresco() {
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_shellExecute("bus 400000"));
+    TEST_ASSERT_EQUAL(400000, sim_lcd.clockI2C);
+    TEST_ASSERT_EQUAL_STRING("bus: 400000 Hz\r\n", lineas[0]);
+
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_shellExecute("bus 1000000"));
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_shellExecute("bus rapido"));
+    TEST_ASSERT_EQUAL(400000, sim_lcd.clockI2C);
+    TEST_ASSERT_EQUAL_STRING("bus: 400000 Hz (error)\r\n", lineas[2]);
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_shellExecute("refresco"));
+    TEST_ASSERT_EQUAL_STRING("refresco: sin cambios\r\n", lineas[3]);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_shellExecute("refresco 50"));
+    TEST_ASSERT_EQUAL(50, periodoAplicado);
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_shellExecute("refresco 5"));
+    TEST_ASSERT_EQUAL(50, periodoAplicado);
+    TEST_ASSERT_EQUAL_STRING("refresco: 50 ms (error)\r\n", lineas[5]);
+
+    LCD_shellInit(guardarLinea, NULL);
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_shellExecute("refresco 50"));
+    TEST_ASSERT_EQUAL_STRING("refresco: no disponible\r\n", lineas[6]);
+}
+
+/**
+ * @brief Test para verificar la traza de llamadas, según el requerimiento 5.
+ */
+void test_traza() {
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_init());
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_shellExecute("traza off"));
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_shellExecute("traza on"));
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_shellExecute("traza on"));
+    uint32_t inicio = sim_lcd.tiempoUs;
+    LCD_printAt(LCD_FILA_2, 3, "Hola");
+    sim_lcd.tiempoUs = inicio + 250 * 1000;
+    LCD_setCursor(LCD_FILA_1, 5);
+    sim_lcd.tiempoUs = inicio + 500 * 1000;
+    LCD_clear();
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_shellExecute("traza off"));
+
+    TEST_ASSERT_EQUAL(7, cantidadLineas);
+    TEST_ASSERT_EQUAL_STRING("traza: error\r\n", lineas[0]);
+    TEST_ASSERT_EQUAL_STRING("traza: on\r\n", lineas[1]);
+    TEST_ASSERT_EQUAL_STRING("0 printAt 64 3 \"Hola\"\r\n", lineas[3]);
+    TEST_ASSERT_EQUAL_STRING("250 setCursor 0 5\r\n", lineas[4]);
+    TEST_ASSERT_EQUAL_STRING("500 clear\r\n", lineas[5]);
+    TEST_ASSERT_EQUAL_STRING("traza: off perdidas=0\r\n", lineas[6]);
+}
@@ -0,0 +1,290 @@
+/**
+ * @file test_API_lcd_stream.c
+ * @brief Implementación de funciones de test del envío por interrupciones
+ */
+
+/*
+    Requerimientos a probar:
+    1- Si no hay celdas sucias no se debe acceder al bus
+    2- Se deben enviar los tramos sucios en una única transmisión y dejar el buffer limpio
+    3- No se debe iniciar un envío mientras hay otro en curso
+    4- Si el envío falla todo el buffer debe quedar sucio, y si el port no puede
+       iniciarlo se debe informar el error
+    5- Por DMA se deben enviar los tramos sucios en una única transmisión, llenando
+       cada mitad del buffer mientras se transmite la otra
+    6- Con el cursor retrocediendo cada tramo se debe enviar desde su última celda sin
+       cambiar el modo, y con los modos que desplazan la pantalla no se debe enviar
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "unity.h"
+
+/**
+ * @brief Include del módulo que va a ser probado.
+ */
+#include "API_lcd_stream.h"
+
+/**
+ * @brief Includes de los módulos utilizados por el envío.
+ */
+#include "API_lcd.h"
+#include "API_lcd_buffer.h"
+#include "API_lcd_pool.h"
+#include "API_lcd_profile.h"
+#include "API_lcd_queue.h"
+
+/**
+ * @brief Include de un mock para las funciones que acceden al hardware.
+ */
+#include "mock_API_lcd_port.h"
+
+/**
+ * @brief Include del simulador de LCD.
+ */
+#include "sim_lcd.h"
+
+// tamaño máximo del flujo que se junta para pasarlo al simulador
+#define MAX_TRAMAS 512
+
+static LCD_BufferTypedef sombra;
+
+/**
+ * @brief Callbacks que recibió el port en el último envío.
+ */
+static port_TramaCallbackTypedef tramaSiguiente;
+static port_FinCallbackTypedef finTransmision;
+static port_MitadCallbackTypedef mitadLista;
+static const uint8_t * bufferDma;
+static uint16_t largoDma;
+
+/**
+ * @brief Reemplaza a port_i2cStreamStart guardando los callbacks,
+ * como lo haría el port antes de habilitar la interrupción.
+ */
+static bool_t capturarEnvio(port_TramaCallbackTypedef trama, port_FinCallbackTypedef fin,
+                            int llamadas) {
+    tramaSiguiente = trama;
+    finTransmision = fin;
+    return true;
+}
+
+/**
+ * @brief Reemplaza a port_i2cDmaStart guardando el buffer y los callbacks.
+ */
+static bool_t capturarEnvioDma(const uint8_t * buffer, uint16_t largo,
+                               port_MitadCallbackTypedef mitad, port_FinCallbackTypedef fin,
+                               int llamadas) {
+    bufferDma = buffer;
+    largoDma = largo;
+    mitadLista = mitad;
+    finTransmision = fin;
+    return true;
+}
+
+/**
+ * @brief Hace el trabajo de la ISR: pide tramas hasta que no quedan y las
+ * pasa al simulador como una única transacción.
+ *
+ * @return cantidad de tramas enviadas
+ */
+static uint16_t atenderInterrupciones(bool_t exito) {
+    static uint8_t flujo[MAX_TRAMAS];
+    uint16_t cantidad = 0;
+
+    while (cantidad < MAX_TRAMAS && tramaSiguiente(&flujo[cantidad]))
+        cantidad++;
+
+    if (exito)
+        sim_i2cWrite(&sim_lcd, flujo, cantidad);
+    finTransmision(exito);
+    return cantidad;
+}
+
+/**
+ * @brief Inicializa el buffer y el simulador antes de cada test.
+ */
+void setUp(void) {
+    LCD_bufferInit(&sombra, LCD_CANTIDAD_FILAS, LCD_CANTIDAD_COLUMNAS);
+    sim_init(&sim_lcd);
+    sim_lcd.modo4Bits = true;
+    tramaSiguiente = NULL;
+    finTransmision = NULL;
+}
+
+/**
+ * @brief Test para verificar que un buffer limpio no inicia un envío,
+ * según el requerimiento 1.
+ */
+void test_buffer_limpio_no_envia() {
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_streamFlush(&sombra));
+    TEST_ASSERT_FALSE(LCD_streamBusy());
+}
+
+/**
+ * @brief Test para verificar el envío de los tramos sucios,
+ * según el requerimiento 2.
+ */
+void test_envio_de_tramos_sucios() {
+    char linea[LCD_CANTIDAD_COLUMNAS + 1];
+
+    LCD_bufferWrite(&sombra, 0, 0, 'x');
+    LCD_bufferWrite(&sombra, 1, 3, 'H');
+    LCD_bufferWrite(&sombra, 1, 4, 'o');
+    LCD_bufferWrite(&sombra, 1, 5, 'l');
+    LCD_bufferWrite(&sombra, 1, 6, 'a');
+
+    port_i2cStreamStart_StubWithCallback(capturarEnvio);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_streamFlush(&sombra));
+    TEST_ASSERT_TRUE(LCD_streamBusy());
+
+    // 2 posicionamientos y 5 caracteres
+    TEST_ASSERT_EQUAL(7 * LCD_TRAMAS_X_MENSAJE, atenderInterrupciones(true));
+
+    TEST_ASSERT_FALSE(LCD_streamBusy());
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_streamResult());
+    TEST_ASSERT_FALSE(LCD_bufferIsDirty(&sombra));
+    TEST_ASSERT_EQUAL(1, sim_lcd.transacciones);
+    TEST_ASSERT_EQUAL(0, sim_lcd.violaciones);
+
+    sim_getLine(&sim_lcd, 0, linea);
+    TEST_ASSERT_EQUAL_STRING("x               ", linea);
+    sim_getLine(&sim_lcd, 1, linea);
+    TEST_ASSERT_EQUAL_STRING("   Hola         ", linea);
+}
+
+/**
+ * @brief Test para verificar que no se superponen envíos,
+ * según el requerimiento 3.
+ */
+void test_envio_en_curso_rechaza() {
+    LCD_bufferWrite(&sombra, 0, 0, 'x');
+
+    port_i2cStreamStart_StubWithCallback(capturarEnvio);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_streamFlush(&sombra));
+
+    LCD_bufferWrite(&sombra, 0, 1, 'y');
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_streamFlush(&sombra));
+
+    atenderInterrupciones(true);
+    TEST_ASSERT_FALSE(LCD_streamBusy());
+}
+
+/**
+ * @brief Test para verificar que un envío fallido deja todo por reenviar,
+ * según el requerimiento 4.
+ */
+void test_envio_fallido_marca_sucio() {
+    uint8_t inicio;
+    uint8_t largo;
+
+    LCD_bufferWrite(&sombra, 0, 0, 'x');
+
+    port_i2cStreamStart_StubWithCallback(capturarEnvio);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_streamFlush(&sombra));
+    atenderInterrupciones(false);
+
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_streamResult());
+    TEST_ASSERT_TRUE(LCD_bufferNextDirtyRun(&sombra, 1, 0, &inicio, &largo));
+    TEST_ASSERT_EQUAL(LCD_CANTIDAD_COLUMNAS, largo);
+
+    port_i2cStreamStart_IgnoreAndReturn(false);
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_streamFlush(&sombra));
+    TEST_ASSERT_FALSE(LCD_streamBusy());
+}
+
+/**
+ * @brief Test para verificar el envío por DMA de la pantalla completa,
+ * según el requerimiento 5.
+ */
+void test_envio_por_dma() {
+    uint8_t tramasDma[2 * 16];
+    char linea[LCD_CANTIDAD_COLUMNAS + 1];
+    const char * texto[] = {"Linea uno 16 car", "Linea dos 16 car"};
+
+    for (uint8_t fila = 0; fila < LCD_CANTIDAD_FILAS; fila++) {
+        for (uint8_t columna = 0; columna < LCD_CANTIDAD_COLUMNAS; columna++)
+            LCD_bufferWrite(&sombra, fila, columna, texto[fila][columna]);
+    }
+
+    port_i2cDmaStart_StubWithCallback(capturarEnvioDma);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_streamFlushDma(&sombra, tramasDma, sizeof(tramasDma)));
+    TEST_ASSERT_TRUE(LCD_streamBusy());
+    TEST_ASSERT_EQUAL(sizeof(tramasDma), largoDma);
+
+    uint32_t enviados = sim_i2cWriteCircular(&sim_lcd, bufferDma, largoDma, mitadLista);
+    finTransmision(true);
+
+    // 2 posicionamientos y 32 caracteres, más el relleno de la última mitad
+    uint32_t tramas = (2 + 32) * LCD_TRAMAS_X_MENSAJE;
+    TEST_ASSERT_GREATER_OR_EQUAL(tramas, enviados);
+    TEST_ASSERT_LESS_OR_EQUAL(tramas + sizeof(tramasDma) / 2 + 1, enviados);
+
+    TEST_ASSERT_FALSE(LCD_streamBusy());
+    TEST_ASSERT_FALSE(LCD_bufferIsDirty(&sombra));
+    TEST_ASSERT_EQUAL(1, sim_lcd.transacciones);
+    TEST_ASSERT_EQUAL(0, sim_lcd.violaciones);
+    for (uint8_t fila = 0; fila < LCD_CANTIDAD_FILAS; fila++) {
+        sim_getLine(&sim_lcd, fila, linea);
+        TEST_ASSERT_EQUAL_STRING(texto[fila], linea);
+    }
+}
+
+/**
+ * @brief Test para verificar el cierre por DMA cuando el último dato
+ * completa justo una mitad, según el requerimiento 5.
+ */
+void test_envio_por_dma_mitad_justa() {
+    uint8_t tramasDma[2 * LCD_TRAMAS_X_MENSAJE];
+    char linea[LCD_CANTIDAD_COLUMNAS + 1];
+
+    LCD_bufferWrite(&sombra, 0, 0, 'x');
+
+    port_i2cDmaStart_StubWithCallback(capturarEnvioDma);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_streamFlushDma(&sombra, tramasDma, sizeof(tramasDma)));
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_streamFlushDma(&sombra, tramasDma, 3));
+
+    // posicionamiento y caracter, una mitad de relleno y el byte ya cargado
+    TEST_ASSERT_EQUAL(sizeof(tramasDma) + 1,
+                      sim_i2cWriteCircular(&sim_lcd, bufferDma, largoDma, mitadLista));
+    finTransmision(true);
+
+    TEST_ASSERT_EQUAL(0, sim_lcd.violaciones);
+    sim_getLine(&sim_lcd, 0, linea);
+    TEST_ASSERT_EQUAL_STRING("x               ", linea);
+}
+
+/**
+ * @brief Test para verificar el envío según el modo de entrada,
+ * según el requerimiento 6.
+ */
+void test_envio_segun_modo_de_entrada() {
+    char linea[LCD_CANTIDAD_COLUMNAS + 1];
+
+    port_delay_Ignore();
+    port_i2cWriteByte_StubWithCallback(sim_port_i2cWriteByte);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_setEntryMode(LCD_ENTRADA_DECREMENTO));
+
+    LCD_bufferWrite(&sombra, 1, 3, 'H');
+    LCD_bufferWrite(&sombra, 1, 4, 'o');
+    LCD_bufferWrite(&sombra, 1, 5, 'l');
+    LCD_bufferWrite(&sombra, 1, 6, 'a');
+
+    port_i2cStreamStart_StubWithCallback(capturarEnvio);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_streamFlush(&sombra));
+
+    // el mismo costo que avanzando: 1 posicionamiento y 4 caracteres
+    TEST_ASSERT_EQUAL(5 * LCD_TRAMAS_X_MENSAJE, atenderInterrupciones(true));
+    sim_getLine(&sim_lcd, 1, linea);
+    TEST_ASSERT_EQUAL_STRING("   Hola         ", linea);
+    TEST_ASSERT_EQUAL(LCD_FILA_2 + 2, sim_lcd.direccion);
+    TEST_ASSERT_EQUAL(2, sim_lcd.instrucciones); // el modo de entrada y el posicionamiento
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_setEntryMode(LCD_ENTRADA_INCREMENTO_DESPLAZA));
+    LCD_bufferWrite(&sombra, 0, 0, 'x');
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_streamFlush(&sombra));
+    TEST_ASSERT_FALSE(LCD_streamBusy());
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_setEntryMode(LCD_ENTRADA_INCREMENTO));
+}
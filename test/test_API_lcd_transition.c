@@ -0,0 +1,179 @@
+/**
+ * @file test_API_lcd_transition.c
+ * @brief Implementación de funciones de test de las transiciones con el
+ *        desplazamiento del display
+ */
+
+/*
+    Requerimientos a probar:
+    1- Cargar la pantalla nueva no debe cambiar lo que se ve
+    2- Cada paso debe enviar un único comando de desplazamiento y sólo al cumplirse
+       el período
+    3- Al terminar se debe ver la pantalla nueva sin desplazamiento, y el driver debe
+       seguir dibujando donde corresponde
+    4- La pantalla nueva debe poder entrar por la izquierda
+    5- No se debe empezar una transición con otra en curso
+*/
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "unity.h"
+
+/**
+ * @brief Include del módulo que va a ser probado.
+ */
+#include "API_lcd_transition.h"
+
+/**
+ * @brief Includes de los módulos utilizados por las transiciones.
+ */
+#include "API_lcd.h"
+#include "API_lcd_buffer.h"
+#include "API_lcd_pool.h"
+#include "API_lcd_profile.h"
+#include "API_lcd_queue.h"
+
+/**
+ * @brief Include de un mock para las funciones que acceden al hardware.
+ */
+#include "mock_API_lcd_port.h"
+
+/**
+ * @brief Include del simulador de LCD.
+ */
+#include "sim_lcd.h"
+
+// ms entre desplazamientos
+#define PERIODO 20
+
+static LCD_TransicionTypedef transicion;
+
+/**
+ * @brief Inicializa el LCD sobre el simulador con la pantalla anterior.
+ */
+void setUp(void) {
+    sim_init(&sim_lcd);
+    port_init_IgnoreAndReturn(true);
+    port_i2cWriteByte_StubWithCallback(sim_port_i2cWriteByte);
+    port_i2cWrite_StubWithCallback(sim_port_i2cWrite);
+    port_delay_StubWithCallback(sim_port_delay);
+    port_getTick_StubWithCallback(sim_port_getTick);
+
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_init());
+    LCD_printAt(LCD_FILA_1, 0, "Menu principal");
+    LCD_printAt(LCD_FILA_2, 0, "> Ajustes");
+    memset(&transicion, 0, sizeof(transicion));
+}
+
+/**
+ * @brief Línea del simulador.
+ */
+static const char * linea(uint8_t fila) {
+    static char texto[SIM_MAX_COLUMNAS + 1];
+
+    sim_getLine(&sim_lcd, fila, texto);
+    return texto;
+}
+
+/**
+ * @brief Avanza el tiempo del simulador y procesa la transición.
+ */
+static void esperar(uint32_t milisegundos) {
+    sim_delay(&sim_lcd, milisegundos);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_transitionProcess(&transicion));
+}
+
+/**
+ * @brief Test para verificar que la carga no se ve,
+ * según el requerimiento 1.
+ */
+void test_carga_fuera_de_la_vista() {
+    sim_resetStats(&sim_lcd);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_transitionStart(&transicion, LCD_TRANSICION_IZQUIERDA,
+                                                  "Ajustes", "> Brillo", PERIODO));
+
+    TEST_ASSERT_TRUE(LCD_transitionBusy(&transicion));
+    TEST_ASSERT_EQUAL_STRING("Menu principal  ", linea(0));
+    TEST_ASSERT_EQUAL_STRING("> Ajustes       ", linea(1));
+    TEST_ASSERT_EQUAL(2, sim_lcd.transacciones);
+}
+
+/**
+ * @brief Test para verificar los pasos de la transición,
+ * según el requerimiento 2.
+ */
+void test_un_comando_por_paso() {
+    LCD_transitionStart(&transicion, LCD_TRANSICION_IZQUIERDA, "Ajustes", "> Brillo", PERIODO);
+    sim_resetStats(&sim_lcd);
+
+    esperar(PERIODO - 1);
+    TEST_ASSERT_EQUAL(0, sim_lcd.instrucciones);
+
+    esperar(1);
+    TEST_ASSERT_EQUAL(1, sim_lcd.instrucciones);
+    TEST_ASSERT_EQUAL(0, sim_lcd.datos);
+    TEST_ASSERT_EQUAL(LCD_TRAMAS_X_MENSAJE, sim_lcd.bytesI2C);
+
+    for (uint8_t paso = 1; paso < LCD_CANTIDAD_COLUMNAS / 2; paso++)
+        esperar(PERIODO);
+    TEST_ASSERT_EQUAL_STRING("ncipal  Ajustes ", linea(0));
+    TEST_ASSERT_EQUAL_STRING("s       > Brillo", linea(1));
+}
+
+/**
+ * @brief Test para verificar el final de la transición,
+ * según el requerimiento 3.
+ */
+void test_final_sin_desplazamiento() {
+    LCD_transitionStart(&transicion, LCD_TRANSICION_IZQUIERDA, "Ajustes", "> Brillo", PERIODO);
+
+    for (uint8_t paso = 0; paso < LCD_CANTIDAD_COLUMNAS; paso++)
+        esperar(PERIODO);
+
+    TEST_ASSERT_FALSE(LCD_transitionBusy(&transicion));
+    TEST_ASSERT_EQUAL(0, sim_lcd.desplazamiento);
+    TEST_ASSERT_EQUAL_STRING("Ajustes         ", linea(0));
+    TEST_ASSERT_EQUAL_STRING("> Brillo        ", linea(1));
+    TEST_ASSERT_EQUAL('B', LCD_bufferGet(LCD_getBuffer(), 1, 2));
+
+    LCD_printChar('*');
+    LCD_printAt(LCD_FILA_2, 12, "50%");
+    TEST_ASSERT_EQUAL_STRING("*justes         ", linea(0));
+    TEST_ASSERT_EQUAL_STRING("> Brillo    50% ", linea(1));
+}
+
+/**
+ * @brief Test para verificar la transición hacia la derecha,
+ * según el requerimiento 4.
+ */
+void test_entrada_por_la_izquierda() {
+    LCD_transitionStart(&transicion, LCD_TRANSICION_DERECHA, "Inicio", NULL, PERIODO);
+
+    esperar(PERIODO);
+    esperar(PERIODO);
+    TEST_ASSERT_EQUAL_STRING("  Menu principal", linea(0));
+
+    for (uint8_t paso = 2; paso < LCD_CANTIDAD_COLUMNAS; paso++)
+        esperar(PERIODO);
+    TEST_ASSERT_EQUAL_STRING("Inicio          ", linea(0));
+    TEST_ASSERT_EQUAL_STRING("                ", linea(1));
+    TEST_ASSERT_EQUAL(0, sim_lcd.desplazamiento);
+}
+
+/**
+ * @brief Test para verificar que no se empieza una transición en curso,
+ * según el requerimiento 5.
+ */
+void test_transicion_en_curso() {
+    LCD_transitionStart(&transicion, LCD_TRANSICION_IZQUIERDA, "Ajustes", "", PERIODO);
+
+    TEST_ASSERT_EQUAL(LCD_ERROR, LCD_transitionStart(&transicion, LCD_TRANSICION_DERECHA,
+                                                     "Inicio", "", PERIODO));
+
+    for (uint8_t paso = 0; paso < LCD_CANTIDAD_COLUMNAS; paso++)
+        esperar(PERIODO);
+    TEST_ASSERT_EQUAL(LCD_OK, LCD_transitionStart(&transicion, LCD_TRANSICION_DERECHA, "Inicio",
+                                                  "", PERIODO));
+}
@@ -0,0 +1,112 @@
+/**
+ * @file sim_lcdd.c
+ * @brief Servicio de displays simulados para probar en la PC la
+ *        aplicación compilada con LCD_PORT_SOCKET. Crea los
+ *        displays, atiende a los clientes hasta recibir SIGINT o
+ *        SIGTERM, y muestra las pantallas y las estadísticas de
+ *        cada display al recibir SIGUSR1 y al terminar.
+ *
+ *        Uso: sim_lcdd [-s socket] [-n displays] [-g COLxFIL]
+ *                      [-c clock] [-l latencia_us] [-e escala_%]
+ *
+ *        Se compila para el host con el CMakeLists.txt de la raíz
+ *        (objetivo sim_lcdd), o a mano con los includes de la PC y
+ *        el soporte de los tests:
+ *            gcc -Ihost/inc -Itest/support -Isrc/LCD16x2_driver/Inc tools/sim_lcdd.c
+ *                test/support/sim_server.c test/support/sim_lcd.c -lpthread
+ */
+
+#define _POSIX_C_SOURCE 200809L // sigwait y getopt
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "sim_server.h"
+
+/**
+ * @brief Muestra las filas y las estadísticas de cada display.
+ */
+static void mostrarPantallas(SIM_ServidorTypedef * servidor) {
+    char linea[SIM_MAX_COLUMNAS + 1];
+    SOCK_EstadisticasTypedef estadisticas;
+
+    for (uint8_t indice = 0; indice < servidor->config.pantallas; indice++) {
+        sim_serverGetStats(servidor, indice, &estadisticas);
+        printf("display %u: %u clientes, %u pedidos, %u transacciones, %u bytes, %u nacks, "
+               "%u violaciones, bus %u us, espera %u us\n",
+               indice, estadisticas.clientes, estadisticas.pedidos, estadisticas.transacciones,
+               estadisticas.bytesI2C, estadisticas.nacks, estadisticas.violaciones,
+               estadisticas.tiempoBusUs, estadisticas.tiempoEsperaUs);
+
+        for (uint8_t fila = 0; fila < servidor->config.filas; fila++) {
+            sim_serverGetLine(servidor, indice, fila, linea);
+            printf("  |%s|\n", linea);
+        }
+    }
+    fflush(stdout);
+}
+
+int main(int argc, char * argv[]) {
+    static SIM_ServidorTypedef servidor;
+    SIM_ServidorConfigTypedef config;
+    unsigned columnas, filas;
+    int opcion;
+
+    sim_serverDefaults(&config);
+    while ((opcion = getopt(argc, argv, "s:n:g:c:l:e:")) != -1) {
+        switch (opcion) {
+        case 's':
+            config.ruta = optarg;
+            break;
+        case 'n':
+            config.pantallas = atoi(optarg);
+            break;
+        case 'g':
+            if (sscanf(optarg, "%ux%u", &columnas, &filas) != 2)
+                columnas = filas = 0;
+            config.columnas = columnas;
+            config.filas = filas;
+            break;
+        case 'c':
+            config.clockI2C = strtoul(optarg, NULL, 10);
+            break;
+        case 'l':
+            config.latenciaUs = strtoul(optarg, NULL, 10);
+            break;
+        case 'e':
+            config.escalaTiempo = atoi(optarg);
+            break;
+        default:
+            fprintf(stderr, "uso: %s [-s socket] [-n displays] [-g COLxFIL] [-c clock] "
+                            "[-l latencia_us] [-e escala_%%]\n",
+                    argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    // las señales se atienden con sigwait: los hilos del servicio las heredan bloqueadas
+    sigset_t senales;
+    sigemptyset(&senales);
+    sigaddset(&senales, SIGINT);
+    sigaddset(&senales, SIGTERM);
+    sigaddset(&senales, SIGUSR1);
+    pthread_sigmask(SIG_BLOCK, &senales, NULL);
+
+    if (!sim_serverStart(&servidor, &config)) {
+        fprintf(stderr, "%s: no se pudo crear el servicio en %s\n", argv[0], config.ruta);
+        return EXIT_FAILURE;
+    }
+    printf("%u displays de %ux%u en %s\n", config.pantallas, config.columnas, config.filas,
+           config.ruta);
+    fflush(stdout);
+
+    int senal = 0;
+    while (sigwait(&senales, &senal) == 0 && senal == SIGUSR1)
+        mostrarPantallas(&servidor);
+
+    mostrarPantallas(&servidor);
+    sim_serverStop(&servidor);
+    return EXIT_SUCCESS;
+}